@@ -26,6 +26,36 @@ Type checked and converted:
    Returns: 0 if OK, -1 otherwise. */
 int
 SbArgs_Parse(const char *spec, SbObject *args, SbObject *kwds, ...);
+int
+SbArgs_ParseVa(const char *spec, SbObject *args, SbObject *kwds, va_list va);
+
+/* A single argument descriptor produced from the spec. */
+typedef struct _SbArgsEntry {
+    const char *name; /* Points into the spec; not NUL-terminated */
+    Sb_ssize_t name_length;
+    long name_hash;
+    char conv;
+} SbArgsEntry;
+
+/* A spec compiled on first use; keep these in static storage,
+   one per call site, to avoid reparsing the spec on every call. */
+typedef struct _SbArgsSpec {
+    const char *spec;
+    Sb_ssize_t count; /* -1 until compiled */
+    Sb_ssize_t required;
+    SbArgsEntry *entries;
+} SbArgsSpec;
+
+/* Static initializer for SbArgsSpec. */
+#define SbArgs_SPEC(spec) \
+    { (spec), -1, 0, NULL }
+
+/* Same as SbArgs_Parse, but with a precompiled spec.
+   Returns: 0 if OK, -1 otherwise. */
+int
+SbArgs_ParseSpec(SbArgsSpec *spec, SbObject *args, SbObject *kwds, ...);
+int
+SbArgs_ParseSpecVa(SbArgsSpec *spec, SbObject *args, SbObject *kwds, va_list va);
 
 /* Ensure the function was not passed any args.
    Returns: 0 if OK, -1 otherwise. */
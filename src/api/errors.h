@@ -31,13 +31,13 @@ SbErr_Restore(SbTypeObject *type, SbObject *value, SbObject *tb);
 
 
 /* Raise an exception of the given type with the associated value and traceback.
-   Note: the reference to `value` is stolen.
+   Note: the reference to `value` is NOT stolen.
 */
 void
 SbErr_Raise(SbTypeObject *type, SbObject *value, SbObject *tb);
 
 /* Raise an exception of the given type with the associated value.
-   Note: the reference to `value` is stolen.
+   Note: the reference to `value` is NOT stolen.
 */
 void
 SbErr_RaiseWithObject(SbTypeObject *type, SbObject *value);
@@ -21,12 +21,17 @@ void
 _Sb_UnloadModule(const char *name);
 
 /* Imports a module with the given name.
-   This either results in a cached module or a new one.
+   This either results in a cached module or a new one, looked up in `sys.path`.
    Returns: New reference.
 */
 SbObject *
 SB_Import(const char *name);
 
+/* Forgets cached directory listings and modules known to be missing.
+   Call this after modules were added to the directories in `sys.path`. */
+void
+Sb_InvalidateImportCaches(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -38,8 +38,21 @@ typedef struct _SbVarObject {
 #define Sb_OBJECT(op) ((SbObject *)(op))
 #define Sb_REFCNT(op) \
     (Sb_OBJECT(op)->ob_refcount)
+
+#if SUPPORTS(TAGGED_INTS)
+/* Objects are at least word aligned, so a pointer with the low bit set
+   is not an object at all but a small int; see object_int.h.
+   Such values have no storage: the type is implied, refcounting is a no-op. */
+#define Sb_IS_TAGGED(op) \
+    ((Sb_size_t)(op) & 1)
+extern SbTypeObject *SbInt_Type;
+#define Sb_TYPE(op) \
+    (Sb_IS_TAGGED(op) ? SbInt_Type : Sb_OBJECT(op)->ob_type)
+#else
+#define Sb_IS_TAGGED(op) 0
 #define Sb_TYPE(op) \
     (Sb_OBJECT(op)->ob_type)
+#endif
 #define Sb_VAROBJECT(op) ((SbVarObject *)(op))
 #define Sb_COUNT(op) \
     (Sb_VAROBJECT(op)->ob_itemcount)
@@ -47,12 +60,22 @@ typedef struct _SbVarObject {
 /* INTERNAL: Decrease the refcount and deallocate the instance if required. */
 extern void _SbObject_DecRef(SbObject *op);
 
+/* Objects with the refcount at or above this value are immortal:
+   Sb_INCREF/Sb_DECREF do not touch them and they are never destroyed. */
+#define Sb_IMMORTAL_REFCNT \
+    ((Sb_ssize_t)1 << (sizeof(Sb_ssize_t) * 8 - 2))
+#define Sb_IS_IMMORTAL(op) \
+    (Sb_IS_TAGGED(op) || Sb_REFCNT(op) >= Sb_IMMORTAL_REFCNT)
+/* Make the object immortal; this cannot be undone. */
+#define Sb_SET_IMMORTAL(op) \
+    (Sb_REFCNT(op) = Sb_IMMORTAL_REFCNT)
+
 #define Sb_INCREF(op) \
-    (Sb_OBJECT(op)->ob_refcount++)
+    ((void)(Sb_IS_IMMORTAL(op) || Sb_OBJECT(op)->ob_refcount++))
 #define Sb_XINCREF(op) \
     do { if ((op) == NULL) break; Sb_INCREF(op); } while (0)
 #define Sb_DECREF(op) \
-    _SbObject_DecRef(Sb_OBJECT(op))
+    (Sb_IS_IMMORTAL(op) ? (void)0 : _SbObject_DecRef(Sb_OBJECT(op)))
 #define Sb_XDECREF(op) \
     do { if ((op) == NULL) break; Sb_DECREF(op); } while (0)
 #define Sb_CLEAR(op) \
@@ -66,14 +89,20 @@ extern void _SbObject_DecRef(SbObject *op);
 
 /* Initialize the object's fields */
 #define SbObject_INIT(op, type) \
-    do { Sb_REFCNT(op) = 1; Sb_TYPE(op) = (type); Sb_INCREF(type); } while(0)
+    do { Sb_REFCNT(op) = 1; Sb_OBJECT(op)->ob_type = (type); Sb_INCREF(type); } while(0)
 #define SbObject_INIT_VAR(op, type, count) \
     do { SbObject_INIT((op), (type)); Sb_COUNT(op) = (count); } while (0)
 
 /* Defines object allocation/freeing interface */
+#if SUPPORTS(SMALL_OBJECT_ALLOCATOR)
+#define SbObject_Malloc SbRT_ObjMalloc
+#define SbObject_Realloc SbRT_ObjRealloc
+#define SbObject_Free SbRT_ObjFree
+#else
 #define SbObject_Malloc Sb_Malloc
 #define SbObject_Realloc Sb_Realloc
 #define SbObject_Free Sb_Free
+#endif
 
 /* Base "object" type. */
 extern SbTypeObject *SbObject_Type;
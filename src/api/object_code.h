@@ -20,6 +20,7 @@ typedef struct _SbCodeObject {
     /* TBD: closures */
 } SbCodeObject;
 
+#define SbCode_OPTIMIZED    (1 << 0)
 #define SbCode_NEWLOCALS    (1 << 1)
 #define SbCode_VARARGS      (1 << 2)
 #define SbCode_VARKWDS      (1 << 3)
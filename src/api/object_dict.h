@@ -19,6 +19,12 @@ extern SbTypeObject *SbDict_Type;
 SbObject *
 SbDict_New(void);
 
+/* Create a new dictionary object with room for `size` items,
+   so that filling it up does not grow the table.
+   Returns: New reference or NULL on failure. */
+SbObject *
+SbDict_NewPresized(Sb_ssize_t size);
+
 /* Remove all elements from the dict. */
 void
 SbDict_Clear(SbObject *p);
@@ -61,6 +67,12 @@ SbDict_DelItem(SbObject *p, SbObject *key);
 SbObject *
 SbDict_GetItemString(SbObject *p, const char *key);
 
+/* Retrieve an item keyed by a string of known length and hash
+   (as computed by _SbStr_HashString); the key need not be NUL-terminated.
+   Returns: Borrowed reference. */
+SbObject *
+_SbDict_GetItemStringKnownHash(SbObject *p, const char *key, Sb_ssize_t length, long hash);
+
 /* Insert the object at the given key.
    Returns: 0 if OK, -1 otherwise. */
 int
@@ -71,11 +83,37 @@ SbDict_SetItemString(SbObject *p, const char *key, SbObject *value);
 int
 SbDict_DelItemString(SbObject *p, const char *key);
 
+/* A string key for lookups from C, with its length fixed at compile time
+   and its hash computed on first use. Keep keys in static storage:
+       static SbDictKey key_stdout = SbDictKey_INIT("stdout");
+   The initializer only takes string literals. */
+typedef struct _SbDictKey {
+    const char *text;
+    Sb_ssize_t length;
+    long hash;
+} SbDictKey;
+
+#define SbDictKey_INIT(s) \
+    { (s), sizeof(s) - 1, -1 }
+
+/* Obtain the key's hash, computing it the first time. */
+#define SbDictKey_Hash(k) \
+    ((k)->hash != -1 ? (k)->hash : _SbDictKey_ComputeHash(k))
+
+/* Same as the *ItemString functions, keyed by an SbDictKey. */
+SbObject *
+SbDict_GetItemKey(SbObject *p, SbDictKey *key);
+int
+SbDict_SetItemKey(SbObject *p, SbDictKey *key, SbObject *value);
+int
+SbDict_DelItemKey(SbObject *p, SbDictKey *key);
+
 
 /* Iterates through all key-value pairs in the dict.
    `state` must be initialized to 0 to start iteration.
    Note: References in `key` and `value` are borrowed.
-   Returns: 0 when finished. */
+   Returns: 1 with an item, 0 when finished, -1 if the dict changed
+   in a way that iteration cannot follow. */
 int
 SbDict_Next(SbObject *p, Sb_ssize_t *state, SbObject **key, SbObject **value);
 
@@ -89,6 +127,35 @@ SbDict_Copy(SbObject *p);
 int
 SbDict_Merge(SbObject *dst, SbObject *src, int update);
 
+/* METHODS USED INTERNALLY */
+
+long
+_SbDictKey_ComputeHash(SbDictKey *key);
+
+/* Create a key table for the instance dicts of a class to share.
+   Returns: the table with one reference, or NULL on failure. */
+SbDictSharedKeys *
+_SbDictSharedKeys_New(void);
+
+/* Drop a reference to a shared key table. */
+void
+_SbDictSharedKeys_Release(SbDictSharedKeys *keys);
+
+/* Create a new dictionary object that keeps its keys in `keys`.
+   Returns: New reference or NULL on failure. */
+SbObject *
+_SbDict_NewSplit(SbDictSharedKeys *keys);
+
+/* Same as the *ItemString functions, keyed by a str object; its cached
+   hash is used, and a new entry takes the object itself as the key.
+   WARNING: no type checks are performed on `key`. */
+SbObject *
+_SbDict_GetItemStr(SbObject *p, SbObject *key);
+int
+_SbDict_SetItemStr(SbObject *p, SbObject *key, SbObject *value);
+int
+_SbDict_DelItemStr(SbObject *p, SbObject *key);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,6 +26,7 @@ extern SbTypeObject     *SbExc_KeyError;
 extern SbTypeObject    *SbExc_MemoryError;
 extern SbTypeObject    *SbExc_NameError;
 extern SbTypeObject     *SbExc_UnboundLocalError;
+extern SbTypeObject    *SbExc_RuntimeError;
 extern SbTypeObject    *SbExc_SystemError;
 extern SbTypeObject    *SbExc_TypeError;
 extern SbTypeObject    *SbExc_ValueError;
@@ -10,13 +10,21 @@ typedef Sb_ssize_t SbInt_Native_t;
 #define SbInt_NATIVE_MAX Sb_SSIZE_MAX
 
 /* Type for digits not carrying the sign bit. */
-typedef unsigned short SbInt_Digit_t;
+typedef unsigned int SbInt_Digit_t;
 /* Type for digits carrying the sign bit. */
-typedef signed short SbInt_SignDigit_t;
+typedef signed int SbInt_SignDigit_t;
 /* Type to contain double-digit result. */
-typedef unsigned long SbInt_DoubleDigit_t;
+typedef Sb_ulong64_t SbInt_DoubleDigit_t;
+/* Type to contain signed double-digit result. */
+typedef Sb_long64_t SbInt_SignDoubleDigit_t;
 
-#define SbInt_DIGIT_BITS 16
+#define SbInt_DIGIT_BITS 32
+#define SbInt_DIGIT_MASK 0xFFFFFFFFu
+
+/* Digits in the serialized (marshal) form are half-size. */
+typedef unsigned short SbInt_HalfDigit_t;
+
+#define SbInt_HALF_DIGIT_BITS 16
 
 typedef struct {
     Sb_ssize_t length;
@@ -34,6 +42,19 @@ typedef struct _SbIntObject {
 
 extern SbTypeObject *SbInt_Type;
 
+#if SUPPORTS(TAGGED_INTS)
+/* Small ints travel as (value << 1) | 1 in the object pointer itself;
+   only values with the top bit to spare can be encoded this way. */
+#define SbInt_TAGGED_MIN (SbInt_NATIVE_MIN >> 1)
+#define SbInt_TAGGED_MAX (SbInt_NATIVE_MAX >> 1)
+#define SbInt_FITS_TAGGED(v) \
+    ((v) >= SbInt_TAGGED_MIN && (v) <= SbInt_TAGGED_MAX)
+#define SbInt_TAG(v) \
+    ((SbObject *)(((Sb_size_t)(v) << 1) | 1))
+#define SbInt_UNTAG(op) \
+    ((SbInt_Native_t)(Sb_size_t)(op) >> 1)
+#endif
+
 /* Verify the given object is of type int.
    Returns: 1 if true, 0 otherwise. */
 #define SbInt_CheckExact(p) \
@@ -51,10 +72,17 @@ SbObject *
 SbInt_FromNative(SbInt_Native_t ival);
 
 /* Construct an int object from a length in digits and possibly data.
+   If digits is NULL, the caller is expected to fill them in.
    Returns: New reference. */
 SbObject *
 SbInt_FromLengthAndDigits(Sb_ssize_t length, SbInt_Digit_t *digits);
 
+/* Construct an int object from 2-complement half-digits, least significant first.
+   This is the representation used by the marshal TYPE_LONG record.
+   Returns: New reference. */
+SbObject *
+SbInt_FromHalfDigits(Sb_ssize_t count, const SbInt_HalfDigit_t *halves);
+
 /* Return the object's value as C SbInt_Native_t.
    Returns: value; if out of bounds -- -1 and sets overflow_flag */
 SbInt_Native_t
@@ -66,10 +94,17 @@ SbInt_Native_t
 SbInt_AsNative(SbObject *op);
 
 /* Construct an int object from a C string.
+   Base 0 guesses the radix from the prefix; base 2, 8 or 16 allow their prefix.
+   If pend is NULL, anything but whitespace after the digits is an error.
    Returns: New reference. */
 SbObject *
 SbInt_FromString(const char *str, const char **pend, unsigned base);
 
+/* Convert an int object to a string in base 2, 8, 10 or 16.
+   Returns: New reference. */
+SbObject *
+SbInt_ToString(SbObject *op, unsigned base);
+
 #ifdef __cplusplus
 }
 #endif
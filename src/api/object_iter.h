@@ -24,6 +24,7 @@ struct _SbIterObject {
             SbInt_Native_t index;
         } with_iterable;
         struct {
+            SbObject *owner;
             SbObject **cursor;
             SbObject **end;
         } with_array;
@@ -41,11 +42,21 @@ SbIter_New(SbObject *o);
    Returns: New reference. */
 SbObject *
 SbIter_New2(SbObject *o, SbObject *sentinel);
-/* Construct an iterator over an array starting at `base`.
+/* Construct an iterator over an array starting at `base`, kept alive by `owner`.
+   NOTE: For internal use only; the array must not move while `owner` lives.
+   Returns: New reference. */
+SbObject *
+SbArrayIter_New(SbObject *owner, SbObject **base, SbObject **end);
+/* Construct an iterator over a list, tolerating changes to the list.
    NOTE: For internal use only.
    Returns: New reference. */
 SbObject *
-SbArrayIter_New(SbObject **base, SbObject **end);
+SbListIter_New(SbObject *list);
+
+/* Estimate the number of items the iterator `o` has yet to produce.
+   Returns: The count, or -1 if it cannot be told cheaply. */
+Sb_ssize_t
+SbIter_LengthHint(SbObject *o);
 
 /* Return the next value from the iteration `o`.
    Returns: New reference or NULL on no more items or failure. */
@@ -68,6 +68,35 @@ SbList_SetItem(SbObject *p, Sb_ssize_t pos, SbObject *o);
 int
 SbList_Append(SbObject *p, SbObject *o);
 
+/* Insert an item before the given position; like list.insert(),
+   a negative position counts from the end and the position is clamped.
+   Returns: 0 if OK, -1 otherwise. */
+int
+SbList_Insert(SbObject *p, Sb_ssize_t pos, SbObject *o);
+
+/* Append all items produced by `iterable` to the list.
+   Returns: 0 if OK, -1 otherwise. */
+int
+SbList_Extend(SbObject *p, SbObject *iterable);
+
+/* Replace the items between `low` and `high` with the items of `v`;
+   the items are deleted if `v` is NULL. Bounds are clamped to the list.
+   Returns: 0 if OK, -1 otherwise. */
+int
+SbList_SetSlice(SbObject *p, Sb_ssize_t low, Sb_ssize_t high, SbObject *v);
+
+/* Sort the list in place; the sort is stable. If `key` is not NULL,
+   items are ordered by the results of calling it once on each item.
+   Returns: 0 if OK, -1 otherwise. */
+int
+SbList_Sort(SbObject *p, SbObject *key, int reverse);
+
+/* Make room for at least `count` items, so that growing the list up to
+   that size does not reallocate. The list size is not changed.
+   Returns: 0 if OK, -1 otherwise. */
+int
+SbList_Reserve(SbObject *p, Sb_ssize_t count);
+
 /* METHODS USED INTERNALLY */
 
 #define SbList_GetAllocated(p) \
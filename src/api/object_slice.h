@@ -19,6 +19,9 @@ extern SbTypeObject *SbSlice_Type;
 SbObject *
 SbSlice_New(SbObject *start, SbObject *end, SbObject *step);
 
+/* Resolve the slice against a sequence of `seq_length` items, with the
+   usual defaults, negative index adjustment and clamping applied.
+   Returns: 0 if OK, -1 otherwise. */
 int
 SbSlice_GetIndices(SbObject *self, SbInt_Native_t seq_length, 
     SbInt_Native_t *start, SbInt_Native_t *end, SbInt_Native_t *step, SbInt_Native_t *slice_length);
@@ -71,6 +71,45 @@ SbStr_StartsWithString(SbObject *p1, const char *p2);
 SbObject *
 SbStr_Join(SbObject *glue, SbObject *iterable);
 
+/* Accumulates a str piece by piece.
+   The str is overallocated and grown geometrically, so building a str
+   of N bytes costs O(N) no matter how small the pieces are.
+   The builder owns `str` until it is finished or cleared. */
+typedef struct _SbStrBuilder {
+    SbObject *str;
+    Sb_ssize_t length;
+} SbStrBuilder;
+
+/* Prepare the builder, preallocating room for `size_hint` bytes.
+   Returns: 0 if OK, -1 otherwise. */
+int
+SbStrBuilder_Init(SbStrBuilder *sb, Sb_ssize_t size_hint);
+
+/* Make room for `extra` more bytes.
+   Returns: 0 if OK, -1 otherwise (the builder is cleared). */
+int
+SbStrBuilder_Reserve(SbStrBuilder *sb, Sb_ssize_t extra);
+
+/* Append bytes, a str object, a single char or `count` copies of a char.
+   Returns: 0 if OK, -1 otherwise (the builder is cleared). */
+int
+SbStrBuilder_Append(SbStrBuilder *sb, const void *v, Sb_ssize_t len);
+int
+SbStrBuilder_AppendStr(SbStrBuilder *sb, SbObject *p);
+int
+SbStrBuilder_AppendChar(SbStrBuilder *sb, char c);
+int
+SbStrBuilder_AppendFill(SbStrBuilder *sb, char c, Sb_ssize_t count);
+
+/* Finish building; the builder is left empty.
+   Returns: New reference. */
+SbObject *
+SbStrBuilder_Finish(SbStrBuilder *sb);
+
+/* Abandon whatever has been built so far. */
+void
+SbStrBuilder_Clear(SbStrBuilder *sb);
+
 /* Create a new string, which is the same as the source but jsutified.
    Returns: New reference. */
 SbObject *
@@ -86,15 +125,36 @@ SbStr_JustifyRight(SbObject *p, Sb_ssize_t width, char filler);
 long
 _SbStr_Hash(SbObject *p);
 
+/* Hash bytes the way a str holding them hashes; the hash is keyed per process. */
 long
 _SbStr_HashString(const Sb_byte_t *v, Sb_ssize_t len);
 
 int
 _SbStr_Eq(SbObject *p1, SbObject *p2);
 
+/* Compare two strings bytewise, like memcmp() with the length as a tie-break.
+   WARNING: no type checks are performed.
+   Returns: <0, 0 or >0. */
+int
+_SbStr_Compare(SbObject *p1, SbObject *p2);
+
 int
 _SbStr_EqString(SbObject *p1, const char *p2);
 
+/* Change the length of a str, reallocating it.
+   NOTE: ONLY to be used on strs nobody else holds a reference to.
+   On failure, the str is released and `*pp` is set to NULL.
+   Returns: 0 if OK, -1 otherwise. */
+int
+_SbStr_Resize(SbObject **pp, Sb_ssize_t new_length);
+
+/* Append `rhs` to the str at `*pp`, growing it in place.
+   NOTE: ONLY to be used on strs nobody else holds a reference to.
+   On failure, the str is released and `*pp` is set to NULL.
+   Returns: 0 if OK, -1 otherwise. */
+int
+_SbStr_ConcatInPlace(SbObject **pp, SbObject *rhs);
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,6 +11,15 @@ typedef SbObject *(*SbAllocFunc)(SbTypeObject *self, Sb_ssize_t nitems);
 typedef void (*SbDestroyFunc)(SbObject *self);
 typedef void (*SbFreeFunc)(void *);
 
+/* SbTypeObject's tp_traverse and tp_clear */
+typedef int (*SbVisitFunc)(SbObject *o, void *arg);
+typedef int (*SbTraverseFunc)(SbObject *self, SbVisitFunc visit, void *arg);
+typedef int (*SbClearFunc)(SbObject *self);
+
+/* Keys shared by instance dicts; see object_dict.h. */
+struct _SbDictSharedKeys;
+typedef struct _SbDictSharedKeys SbDictSharedKeys;
+
 struct _SbTypeObject {
     SbObject_HEAD;
 
@@ -44,19 +53,43 @@ struct _SbTypeObject {
     /* An optional pointer to an instance deallocation function. */
     SbFreeFunc tp_free;
 
+    /* For types with SbType_FLAGS_HAVE_GC only. */
+    /* Calls `visit` on each object the instance holds a reference to. */
+    SbTraverseFunc tp_traverse;
+    /* Drops the references the instance holds, to break reference cycles. */
+    SbClearFunc tp_clear;
+
     /* Type object instance's dict. */
     SbObject *tp_dict;
+
+    /* Keys shared by the instances' dicts, or NULL if they get plain dicts. */
+    SbDictSharedKeys *tp_dict_keys;
 };
 
 extern SbTypeObject *SbType_Type;
 
 enum {
     SbType_FLAGS_HAS_DICT           = (1 << 2),
+    /* Instances have a `__del__` method; maintained by _SbType_UpdateFlags(). */
+    SbType_FLAGS_HAS_FINALIZER      = (1 << 3),
+    /* Instances are tracked by the cycle collector. */
+    SbType_FLAGS_HAVE_GC            = (1 << 4),
 };
 
 #define SbType_Check(p) \
     (Sb_TYPE(p) == SbType_Type)
 
+/* Visit an object reference from within tp_traverse; NULLs are skipped. */
+#define Sb_VISIT(op) \
+    do { \
+        if (op) { \
+            int _vret = visit(Sb_OBJECT(op), arg); \
+            if (_vret) { \
+                return _vret; \
+            } \
+        } \
+    } while (0)
+
 SbObject *
 SbType_GenericAlloc(SbTypeObject *type, Sb_ssize_t nitems);
 
@@ -72,6 +105,11 @@ SbType_New(const char *name, SbTypeObject *base_type, SbObject *dict);
 SbObject *
 _SbType_New(SbObject *name, SbObject *base, SbObject *dict);
 
+/* Recompute the flags derived from the type's dict.
+   Call this whenever the type's dict is modified. */
+void
+_SbType_UpdateFlags(SbTypeObject *tp);
+
 /* Check whether `a` is a subtype of `b`. */
 int
 SbType_IsSubtype(SbTypeObject *a, SbTypeObject *b);
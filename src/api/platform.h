@@ -12,7 +12,13 @@ extern "C" {
 #define PLATFORM_WINNT 1
 #define PLATFORM_LINUX 2
 
+#if defined(_WIN32)
 #include "platform_win32.h"
+#elif defined(__linux__)
+#include "platform_linux.h"
+#else
+#error "Unsupported platform"
+#endif
 
 /* Error handling kludges */
 
@@ -38,6 +44,14 @@ Sb_Realloc(void *ptr, Sb_size_t new_size);
 void
 Sb_Free(void *ptr);
 
+/* Allocates zeroed pages aligned on the given size, which is a power of two
+   not above 64Kb (the allocation granularity on Windows). */
+void *
+Sb_AllocArena(Sb_size_t size);
+
+void
+Sb_FreeArena(void *ptr, Sb_size_t size);
+
 /* File operations abstraction */
 
 /* NOTE: Currently, this fails to handle files larger than 2Gb. */
@@ -62,6 +76,41 @@ Sb_FileSeek(OSFileHandle_t handle, Sb_ssize_t offset, int whence, Sb_ssize_t *ne
 void
 Sb_FileClose(OSFileHandle_t handle);
 
+/* Directory listing abstraction */
+
+typedef void *OSDirHandle_t;
+
+/* Opens the directory for enumeration; an empty path means the current directory. */
+OSError_t
+Sb_DirOpen(const char *path, OSDirHandle_t *handle);
+
+/* Retrieves the next entry name; sets *name to NULL when no entries remain.
+   NOTE: The name is valid until the next call on the same handle. */
+OSError_t
+Sb_DirRead(OSDirHandle_t handle, const char **name);
+
+void
+Sb_DirClose(OSDirHandle_t handle);
+
+/* Time measurement */
+
+/* Returns a monotonic timestamp in microseconds. */
+Sb_ulong64_t
+Sb_GetTimeMicroseconds(void);
+
+/* Process environment */
+
+/* Retrieves an environment variable.
+   NOTE: The value may live in a statically allocated buffer.
+   Returns: the value, or NULL if the variable is not set. */
+const char *
+Sb_GetEnv(const char *name);
+
+/* Fills the buffer with bytes from the OS cryptographic random source.
+   Returns: 0 if OK, -1 otherwise. */
+int
+Sb_GetRandomBytes(void *buffer, Sb_size_t count);
+
 /* Standard input/output/error */
 
 OSFileHandle_t
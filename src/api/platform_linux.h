@@ -0,0 +1,58 @@
+#ifndef __SNAKEBED_PLATFORM_LINUX_H
+#define __SNAKEBED_PLATFORM_LINUX_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+
+#ifdef PLATFORM_CURRENT
+#undef PLATFORM_CURRENT
+#endif
+#define PLATFORM_CURRENT PLATFORM_LINUX
+
+#ifndef NULL
+#define NULL (void *)0
+#endif
+
+typedef unsigned char Sb_byte_t;
+
+typedef size_t Sb_size_t;
+
+/* Pointer-sized: 64 bits on LP64, which keeps most int arithmetic native. */
+typedef ptrdiff_t Sb_ssize_t;
+#define Sb_SSIZE_MIN PTRDIFF_MIN
+#define Sb_SSIZE_MAX PTRDIFF_MAX
+
+typedef long long Sb_long64_t;
+typedef unsigned long long Sb_ulong64_t;
+
+#define Sb_Mul32x32As64(a, b) \
+    ((Sb_long64_t)(int32_t)(a) * (Sb_long64_t)(int32_t)(b))
+
+#define Sb_Mulu32x32As64(a, b) \
+    ((Sb_ulong64_t)(uint32_t)(a) * (Sb_ulong64_t)(uint32_t)(b))
+
+/* Checked signed arithmetic; each evaluates to nonzero on overflow.
+   The wrapped result is stored into *r either way. */
+#define Sb_AddOverflow(a, b, r) \
+    __builtin_add_overflow((a), (b), (r))
+
+#define Sb_SubOverflow(a, b, r) \
+    __builtin_sub_overflow((a), (b), (r))
+
+#define Sb_MulOverflow(a, b, r) \
+    __builtin_mul_overflow((a), (b), (r))
+
+#define Sb_DebugBreak() \
+    __builtin_trap()
+
+#ifdef __cplusplus
+}
+#endif
+#endif // __SNAKEBED_PLATFORM_LINUX_H
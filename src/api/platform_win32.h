@@ -38,6 +38,9 @@ typedef unsigned long long Sb_ulong64_t;
 #define Sb_Mulu32x32As64(a, b) \
     ((Sb_ulong64_t)__emulu((a), (b)))
 
+#define Sb_DebugBreak() \
+    __debugbreak()
+
 #ifdef __cplusplus
 }
 #endif
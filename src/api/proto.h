@@ -91,6 +91,10 @@ SbNumber_TrueDivide(SbObject * lhs, SbObject *rhs);
 SbObject *
 SbNumber_Remainder(SbObject * lhs, SbObject *rhs);
 SbObject *
+SbNumber_DivMod(SbObject * lhs, SbObject *rhs);
+SbObject *
+SbNumber_Power(SbObject * base, SbObject *exp, SbObject *mod);
+SbObject *
 SbNumber_And(SbObject * lhs, SbObject *rhs);
 SbObject *
 SbNumber_Or(SbObject * lhs, SbObject *rhs);
@@ -152,6 +156,23 @@ SbSequence_SetSlice2(SbObject *o, Sb_ssize_t i1, Sb_ssize_t i2, SbObject *values
 int
 SbSequence_DelSlice2(SbObject *o, Sb_ssize_t i1, Sb_ssize_t i2);
 
+/*
+ METHODS USED INTERNALLY
+ */
+
+/* Attribute access by a str name.
+   WARNING: no type checks are performed on `name`. */
+SbObject *
+_SbObject_GetAttr(SbObject *o, SbObject *name);
+int
+_SbObject_SetAttr(SbObject *o, SbObject *name, SbObject *v);
+int
+_SbObject_DelAttr(SbObject *o, SbObject *name);
+
+/* Call a method found via a static key; see SbDictKey. */
+SbObject *
+_SbObject_CallMethodKey(SbObject *o, SbDictKey *method_key, SbObject *args, SbObject *kwargs);
+
 #ifdef __cplusplus
 }
 #endif
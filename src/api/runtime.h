@@ -4,9 +4,40 @@
 /* SnakeBed runtime support, abstracts OS services and replaces (not so standard) C library */
 
 #include "platform.h"
+#include "supports.h"
 
 #define Sb_OffsetOf(type, member) ((Sb_size_t)(&((type *)0)->member))
 
+/* Small object allocator */
+
+typedef struct _SbRT_ObjAllocStats {
+    /* Arenas currently held */
+    Sb_size_t arenas;
+    /* Arenas obtained from / returned to the OS so far */
+    Sb_size_t arenas_allocated;
+    Sb_size_t arenas_released;
+    /* Pools holding at least one block, and their size */
+    Sb_size_t pools;
+    Sb_size_t pool_bytes;
+    /* Blocks in use and their size; maintained with ALLOC_STATISTICS only */
+    Sb_size_t blocks;
+    Sb_size_t block_bytes;
+} SbRT_ObjAllocStats;
+
+/* Allocates a block; small requests are served from size-class pools. */
+void *
+SbRT_ObjMalloc(Sb_size_t size);
+
+void *
+SbRT_ObjRealloc(void *p, Sb_size_t new_size);
+
+void
+SbRT_ObjFree(void *p);
+
+/* Retrieves the allocator counters. */
+void
+SbRT_ObjAllocGetStats(SbRT_ObjAllocStats *stats);
+
 /* NUL-terminated string manipulation routines */
 
 Sb_size_t
@@ -20,9 +51,32 @@ SbRT_StrCmp(const char *s1, const char *s2);
 
 /* Buffer manipulation routines */
 
+/* The SSE2/AVX2 variants are built for x86-64 with GCC-compatible compilers. */
+#if SUPPORTS(SIMD_STRING_ROUTINES) && PLATFORM(PLATFORM_LINUX) && defined(__x86_64__)
+#define SbRT_HAVE_X86_SIMD 1
+#else
+#define SbRT_HAVE_X86_SIMD 0
+#endif
+
+/* Instruction set levels the buffer routines come in. */
+#define SbRT_ISA_WORD 0
+#define SbRT_ISA_SSE2 1
+#define SbRT_ISA_AVX2 2
+#define SbRT_ISA_BEST SbRT_ISA_AVX2
+
+/* Switch the buffer routines to the best variant the CPU runs, but no
+   higher than `max_level`. Until this is called, the word variant is used.
+   Returns: the level selected. */
+int
+SbRT_SelectStringRoutines(int max_level);
+
 void
 SbRT_MemCpy(void *dst, const void *src, Sb_size_t count);
 
+/* Same as SbRT_MemCpy, but the buffers may overlap. */
+void
+SbRT_MemMove(void *dst, const void *src, Sb_size_t count);
+
 int
 SbRT_MemCmp(const void *p1, const void *p2, Sb_size_t count);
 
@@ -42,8 +96,36 @@ SbRT_MemMem(const char *str, Sb_ssize_t str_len, const char *pat, Sb_ssize_t pat
 Sb_ssize_t
 SbRT_MemRMem(const char *str, Sb_ssize_t str_len, const char *pat, Sb_ssize_t pat_len);
 
+/* Keyed hashing */
+
+/* A decimal number in this environment variable fixes the hash key,
+   making hashes (and dict order) repeat from run to run. Unset or empty
+   means a random key; any other value is refused at startup. */
+#define SbRT_HASHSEED_ENV "SNAKEBED_HASHSEED"
+
+/* Pick the process-wide hash key: derived from SbRT_HASHSEED_ENV if set,
+   random otherwise. Must run before anything is hashed; later calls keep the key.
+   Returns: 1 if the key came from the environment, 0 if random,
+   -1 if the variable holds something other than a 64-bit decimal number. */
+int
+SbRT_InitHashKey(void);
+
+/* Hash a buffer with SipHash-1-3 under the given key. */
+Sb_ulong64_t
+SbRT_SipHash13(Sb_ulong64_t k0, Sb_ulong64_t k1, const void *p, Sb_size_t len);
+
+/* Hash a buffer with SipHash-1-3 under the process-wide key. */
+Sb_ulong64_t
+SbRT_HashBytes(const void *p, Sb_size_t len);
+
 /* Numeric conversion routines */
 
+/* Write the decimal digits of x so that they end right before end,
+   zero-padding to at least min_digits. Nothing is NUL-terminated.
+   Returns: pointer to the first digit written. */
+char *
+Sb_FormatDecimal(char *end, Sb_size_t x, int min_digits);
+
 char *
 Sb_ULtoA(unsigned long x, unsigned radix);
 char *
@@ -35,6 +35,7 @@ extern "C" {
 
 #include "module/builtin.h"
 #include "module/sys.h"
+#include "module/gc.h"
 #include "module/_string.h"
 
 
@@ -10,6 +10,21 @@
 /* Build with object allocation statistics */
 #define ALLOC_STATISTICS ON
 
+/* Build with the size-class allocator for small objects */
+#define SMALL_OBJECT_ALLOCATOR ON
+
+/* Build with freelists recycling int, method, iterator and frame objects */
+#define OBJECT_FREELISTS ON
+
+/* Build with the generational cycle collector and the `gc` module */
+#define CYCLE_GC ON
+
+/* Build with small ints encoded in tagged object pointers instead of heap objects */
+#define TAGGED_INTS OFF
+
+/* Build with SSE2/AVX2 buffer routines, picked at startup by CPU features */
+#define SIMD_STRING_ROUTINES ON
+
 /* Build with type checks in internal methods */
 #define BUILTIN_TYPECHECKS ON
 
@@ -27,13 +42,20 @@
 #define STRING_INTERPOLATION ON
 #define STR_FORMAT ON
 
+/* Build with per-module import timing exposed as `sys.import_times` */
+#define IMPORT_STATISTICS ON
+
 /* Builtin pretty traceback support */
 #define TRACEBACKS ON
 
 /* Compiled-in modules support */
 
-/* Around 4k on x86 */
+/* Around 4k on x86; built on winsock, so Windows only for now */
+#if defined(_WIN32)
 #define MODULE_SOCKET ON
+#else
+#define MODULE_SOCKET OFF
+#endif
 
 #if SUPPORTS(TRACEBACKS)
 #define MODULE_TRACEBACK ON
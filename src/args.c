@@ -1,151 +1,251 @@
 #include "snakebed.h"
 
-int
-SbArgs_ParseVa(const char *spec, SbObject *args, SbObject *kwds, va_list va)
+/* Specs parsed on the fly are compiled into a stack buffer of this many entries. */
+#define ARGS_MAX_ENTRIES 16
+
+static int
+args_is_valid_conv(char conv)
 {
-    char name_buffer[128];
-    char *name_buffer_limit = &name_buffer[sizeof(name_buffer) / sizeof(name_buffer[0]) - 1];
-    Sb_ssize_t arg_pos;
-    Sb_ssize_t posarg_count;
-    SbObject *arg;
-    const char *expected_arg_type;
-    int doing_optionals = 0;
+    switch (conv) {
+    case 'O':
+    case 'S':
+    case 'T':
+    case 'L':
+    case 'D':
+    case 'i':
+    case 's':
+    case 'z':
+    case 'c':
+        return 1;
+    }
+    return 0;
+}
+
+static Sb_ssize_t
+args_count_entries(const char *spec)
+{
+    Sb_ssize_t count = 0;
 
-    posarg_count = args ? SbTuple_GetSizeUnsafe(args) : 0;
-    arg_pos = 0;
     while (*spec) {
-        char conv;
-        char *name_ptr;
+        if (*spec == ':') {
+            count++;
+        }
+        spec++;
+    }
+    return count;
+}
+
+/* Split the spec into entries, precomputing the name hashes.
+   Returns: entry count if OK, -1 otherwise. */
+static Sb_ssize_t
+args_compile(const char *spec, SbArgsEntry *entries, Sb_ssize_t max_count, Sb_ssize_t *required)
+{
+    Sb_ssize_t count = 0;
+
+    *required = -1;
+    while (*spec) {
+        SbArgsEntry *entry;
 
         /* Check for the delimiters */
         if (*spec == '|') {
-            doing_optionals = 1;
+            if (*required < 0) {
+                *required = count;
+            }
             ++spec;
         }
         if (*spec == ',') {
             ++spec;
         }
 
+        if (count >= max_count) {
+            SbErr_RaiseWithString(SbExc_SystemError, "too many entries in args spec");
+            return -1;
+        }
+        entry = &entries[count];
+
         /* Keep conv specifier */
-        conv = *spec++;
+        entry->conv = *spec++;
+        if (!args_is_valid_conv(entry->conv)) {
+            SbErr_RaiseWithFormat(SbExc_SystemError, "unexpected conversion: %c", entry->conv);
+            return -1;
+        }
         /* Skip colon */
-        spec++;
-        /* Copy the name */
-        name_ptr = name_buffer;
+        if (*spec++ != ':') {
+            SbErr_RaiseWithString(SbExc_SystemError, "malformed args spec");
+            return -1;
+        }
+        /* Remember the name */
+        entry->name = spec;
         while (*spec && *spec != ',' && *spec != '|') {
-            *name_ptr = *spec;
             spec++;
-            if (name_ptr < name_buffer_limit) {
-                name_ptr++;
-            }
         }
-        *name_ptr = '\0';
+        entry->name_length = spec - entry->name;
+        entry->name_hash = _SbStr_HashString((const Sb_byte_t *)entry->name, entry->name_length);
+
+        count++;
+    }
+
+    if (*required < 0) {
+        *required = count;
+    }
+    return count;
+}
+
+/* Copy the entry name out for error messages. */
+static const char *
+args_entry_name(const SbArgsEntry *entry, char *buffer, Sb_ssize_t buffer_size)
+{
+    Sb_ssize_t length = entry->name_length;
+
+    if (length >= buffer_size) {
+        length = buffer_size - 1;
+    }
+    SbRT_MemCpy(buffer, entry->name, length);
+    buffer[length] = '\0';
+    return buffer;
+}
+
+static int
+args_parse_entries(const SbArgsEntry *entries, Sb_ssize_t count, Sb_ssize_t required,
+    SbObject *args, SbObject *kwds, va_list va)
+{
+    char name_buffer[64];
+    Sb_ssize_t arg_pos;
+    Sb_ssize_t posarg_count;
+    const SbArgsEntry *entry;
+    SbObject *arg;
+    const char *expected_arg_type;
+
+    posarg_count = args ? SbTuple_GetSizeUnsafe(args) : 0;
+    if (kwds && SbDict_GetSizeUnsafe(kwds) == 0) {
+        kwds = NULL;
+    }
+
+    for (arg_pos = 0; arg_pos < count; ++arg_pos) {
+        entry = &entries[arg_pos];
 
         /* Get the object */
-        arg = NULL;
         if (arg_pos < posarg_count) {
             arg = SbTuple_GetItemUnsafe(args, arg_pos);
         }
         else if (kwds) {
-            arg = SbDict_GetItemString(kwds, name_buffer);
+            arg = _SbDict_GetItemStringKnownHash(kwds, entry->name, entry->name_length, entry->name_hash);
+        }
+        else if (arg_pos >= required) {
+            /* Positional args ran out and there is nothing else to look at. */
+            break;
+        }
+        else {
+            arg = NULL;
         }
 
-        if (arg) {
-            switch (conv) {
-            case 'S':
-                if (!SbStr_CheckExact(arg)) {
-                    expected_arg_type = "str";
-                    goto invalid_arg_type;
-                }
-                goto store_ptr;
-
-            case 'T':
-                if (!SbTuple_CheckExact(arg)) {
-                    expected_arg_type = "tuple";
-                    goto invalid_arg_type;
-                }
-                goto store_ptr;
-
-            case 'L':
-                if (!SbList_CheckExact(arg)) {
-                    expected_arg_type = "list";
-                    goto invalid_arg_type;
-                }
-                goto store_ptr;
-
-            case 'D':
-                if (!SbDict_CheckExact(arg)) {
-                    expected_arg_type = "dict";
-                    goto invalid_arg_type;
-                }
-                goto store_ptr;
-
-            case 'O':
-store_ptr:
-                *va_arg(va, SbObject **) = arg;
-                break;
+        if (!arg) {
+            if (arg_pos < required) {
+                SbErr_RaiseWithFormat(SbExc_TypeError, "argument '%s' is required",
+                    args_entry_name(entry, name_buffer, sizeof(name_buffer)));
+                return -1;
+            }
+            /* Skip the output pointer so later entries stay aligned. */
+            (void)va_arg(va, void *);
+            continue;
+        }
 
-            case 'i':
-                if (!SbInt_CheckExact(arg)) {
-                    expected_arg_type = "int";
-                    goto invalid_arg_type;
-                }
-                *va_arg(va, SbInt_Native_t *) = SbInt_AsNative(arg);
-                if (SbErr_Occurred()) {
-                    return -1;
-                }
-                break;
+        switch (entry->conv) {
+        case 'S':
+            if (!SbStr_CheckExact(arg)) {
+                expected_arg_type = "str";
+                goto invalid_arg_type;
+            }
+            goto store_ptr;
 
-            case 'z':
-                if (arg == Sb_None) {
-                    *va_arg(va, const char **) = NULL;
-                    break;
-                }
-                /* Fall through */
-            case 's':
-                if (!SbStr_CheckExact(arg)) {
-                    expected_arg_type = "str";
-                    goto invalid_arg_type;
-                }
-                *va_arg(va, const char **) = (const char *)SbStr_AsStringUnsafe(arg);
-                break;
+        case 'T':
+            if (!SbTuple_CheckExact(arg)) {
+                expected_arg_type = "tuple";
+                goto invalid_arg_type;
+            }
+            goto store_ptr;
 
-            case 'c':
-                if (!SbStr_CheckExact(arg)) {
-                    expected_arg_type = "str";
-                    goto invalid_arg_type;
-                }
-                if (SbStr_GetSizeUnsafe(arg) != 1) {
-                    SbErr_RaiseWithFormat(SbExc_ValueError, "expected arg '%s' to be of length 1, got %d",
-                        name_buffer, SbStr_GetSizeUnsafe(arg));
-                    return -1;
-                }
-                *va_arg(va, char *) = SbStr_AsStringUnsafe(arg)[0];
-                break;
+        case 'L':
+            if (!SbList_CheckExact(arg)) {
+                expected_arg_type = "list";
+                goto invalid_arg_type;
+            }
+            goto store_ptr;
+
+        case 'D':
+            if (!SbDict_CheckExact(arg)) {
+                expected_arg_type = "dict";
+                goto invalid_arg_type;
+            }
+            goto store_ptr;
 
-            default:
-                SbErr_RaiseWithFormat(SbExc_ValueError, "unexpected conversion: %c", conv);
+        case 'O':
+store_ptr:
+            *va_arg(va, SbObject **) = arg;
+            break;
+
+        case 'i':
+            if (!SbInt_CheckExact(arg)) {
+                expected_arg_type = "int";
+                goto invalid_arg_type;
+            }
+            *va_arg(va, SbInt_Native_t *) = SbInt_AsNative(arg);
+            if (SbErr_Occurred()) {
                 return -1;
             }
-        }
-        else {
-            if (!doing_optionals) {
-                SbErr_RaiseWithFormat(SbExc_TypeError, "argument '%s' is required", name_buffer);
+            break;
+
+        case 'z':
+            if (arg == Sb_None) {
+                *va_arg(va, const char **) = NULL;
+                break;
+            }
+            /* Fall through */
+        case 's':
+            if (!SbStr_CheckExact(arg)) {
+                expected_arg_type = "str";
+                goto invalid_arg_type;
+            }
+            *va_arg(va, const char **) = (const char *)SbStr_AsStringUnsafe(arg);
+            break;
+
+        case 'c':
+            if (!SbStr_CheckExact(arg)) {
+                expected_arg_type = "str";
+                goto invalid_arg_type;
+            }
+            if (SbStr_GetSizeUnsafe(arg) != 1) {
+                SbErr_RaiseWithFormat(SbExc_ValueError, "expected arg '%s' to be of length 1, got %d",
+                    args_entry_name(entry, name_buffer, sizeof(name_buffer)), SbStr_GetSizeUnsafe(arg));
                 return -1;
             }
+            *va_arg(va, char *) = SbStr_AsStringUnsafe(arg)[0];
+            break;
         }
-
-        ++arg_pos;
     }
 
     return 0;
 
 invalid_arg_type:
     SbErr_RaiseWithFormat(SbExc_TypeError, "expected arg '%s' to be %s, got %s",
-        name_buffer, expected_arg_type, Sb_TYPE(arg)->tp_name);
+        args_entry_name(entry, name_buffer, sizeof(name_buffer)), expected_arg_type, Sb_TYPE(arg)->tp_name);
     return -1;
 }
 
+int
+SbArgs_ParseVa(const char *spec, SbObject *args, SbObject *kwds, va_list va)
+{
+    SbArgsEntry entries[ARGS_MAX_ENTRIES];
+    Sb_ssize_t count;
+    Sb_ssize_t required;
+
+    count = args_compile(spec, entries, ARGS_MAX_ENTRIES, &required);
+    if (count < 0) {
+        return -1;
+    }
+    return args_parse_entries(entries, count, required, args, kwds, va);
+}
+
 int
 SbArgs_Parse(const char *spec, SbObject *args, SbObject *kwds, ...)
 {
@@ -158,6 +258,55 @@ SbArgs_Parse(const char *spec, SbObject *args, SbObject *kwds, ...)
     return result;
 }
 
+static int
+args_compile_spec(SbArgsSpec *spec)
+{
+    SbArgsEntry *entries = NULL;
+    Sb_ssize_t count;
+    Sb_ssize_t required;
+
+    count = args_count_entries(spec->spec);
+    if (count > 0) {
+        entries = (SbArgsEntry *)Sb_Malloc(count * sizeof(SbArgsEntry));
+        if (!entries) {
+            SbErr_NoMemory();
+            return -1;
+        }
+    }
+
+    count = args_compile(spec->spec, entries, count, &required);
+    if (count < 0) {
+        Sb_Free(entries);
+        return -1;
+    }
+
+    spec->entries = entries;
+    spec->required = required;
+    spec->count = count;
+    return 0;
+}
+
+int
+SbArgs_ParseSpecVa(SbArgsSpec *spec, SbObject *args, SbObject *kwds, va_list va)
+{
+    if (spec->count < 0 && args_compile_spec(spec) < 0) {
+        return -1;
+    }
+    return args_parse_entries(spec->entries, spec->count, spec->required, args, kwds, va);
+}
+
+int
+SbArgs_ParseSpec(SbArgsSpec *spec, SbObject *args, SbObject *kwds, ...)
+{
+    int result;
+    va_list va;
+
+    va_start(va, kwds);
+    result = SbArgs_ParseSpecVa(spec, args, kwds, va);
+    va_end(va);
+    return result;
+}
+
 int
 SbArgs_NoArgs(SbObject *args, SbObject *kwds)
 {
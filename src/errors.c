@@ -94,7 +94,6 @@ SbErr_Raise(SbTypeObject *type, SbObject *value, SbObject *tb)
 
                 packed = SbTuple_Pack(1, value);
                 /* TODO: How to handle a double fault? */
-                Sb_DECREF(value);
                 SbErr_Value = packed;
             }
         }
@@ -142,6 +141,7 @@ SbErr_RaiseWithString(SbTypeObject *type, const char *value)
     }
 
     SbErr_RaiseWithObject(type, s);
+    Sb_XDECREF(s);
 }
 
 void
@@ -158,6 +158,7 @@ SbErr_RaiseWithFormat(SbTypeObject *type, const char *format, ...)
     }
 
     SbErr_RaiseWithObject(type, s);
+    Sb_XDECREF(s);
 }
 
 void
@@ -179,6 +180,7 @@ SbErr_RaiseIOError(SbInt_Native_t error_code, const char *error_text)
     Sb_DECREF(o_errno);
     Sb_DECREF(o_strerror);
     SbErr_RaiseWithObject(SbExc_IOError, value);
+    Sb_XDECREF(value);
 }
 
 static SbObject *
@@ -86,11 +86,196 @@ _Sb_UnloadModule(const char *name)
     SbDict_DelItemString(SbSys_Modules, name);
 }
 
+/* Maps `sys.path` entries to dicts keyed by the module names found there;
+   None marks a directory that could not be listed. */
+static SbObject *import_dir_cache = NULL;
+/* Maps names of modules known to be missing to None. */
+static SbObject *import_miss_cache = NULL;
+/* The `sys.path` items the miss cache has been built against. */
+static SbObject *import_miss_path = NULL;
+
+static int
+import_init_caches(void)
+{
+    if (!import_dir_cache) {
+        import_dir_cache = SbDict_New();
+        if (!import_dir_cache) {
+            return -1;
+        }
+    }
+    if (!import_miss_cache) {
+        import_miss_cache = SbDict_New();
+        if (!import_miss_cache) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Drop the recorded misses if `sys.path` was modified since they were recorded. */
+static int
+import_validate_misses(SbObject *search_path)
+{
+    Sb_ssize_t count;
+    Sb_ssize_t pos;
+
+    count = SbList_GetSizeUnsafe(search_path);
+    if (import_miss_path && SbTuple_GetSizeUnsafe(import_miss_path) == count) {
+        for (pos = 0; pos < count; ++pos) {
+            if (SbTuple_GetItemUnsafe(import_miss_path, pos) != SbList_GetItemUnsafe(search_path, pos)) {
+                break;
+            }
+        }
+        if (pos == count) {
+            return 0;
+        }
+    }
+
+    SbDict_Clear(import_miss_cache);
+    Sb_CLEAR(import_miss_path);
+    import_miss_path = SbTuple_New(count);
+    if (!import_miss_path) {
+        return -1;
+    }
+    for (pos = 0; pos < count; ++pos) {
+        SbObject *o;
+
+        o = SbList_GetItemUnsafe(search_path, pos);
+        Sb_INCREF(o);
+        SbTuple_SetItemUnsafe(import_miss_path, pos, o);
+    }
+    return 0;
+}
+
+/* Scan the directory for compiled modules.
+   Returns: New reference. */
+static SbObject *
+import_list_dir(SbObject *dir)
+{
+    OSDirHandle_t handle;
+    SbObject *names;
+    const char *entry;
+
+    if (Sb_DirOpen(SbStr_AsStringUnsafe(dir), &handle) != OS_NO_ERROR) {
+        goto unlistable;
+    }
+
+    names = SbDict_New();
+    if (!names) {
+        goto fail0;
+    }
+
+    for (;;) {
+        Sb_size_t length;
+        SbObject *name;
+
+        if (Sb_DirRead(handle, &entry) != OS_NO_ERROR) {
+            Sb_DECREF(names);
+            Sb_DirClose(handle);
+            goto unlistable;
+        }
+        if (!entry) {
+            break;
+        }
+
+        length = SbRT_StrLen(entry);
+        if (length <= 3 || SbRT_StrCmp(entry + length - 3, ".sb")) {
+            continue;
+        }
+
+        name = SbStr_FromStringAndSize(entry, length - 3);
+        if (!name) {
+            goto fail1;
+        }
+        if (SbDict_SetItem(names, name, Sb_None) < 0) {
+            Sb_DECREF(name);
+            goto fail1;
+        }
+        Sb_DECREF(name);
+    }
+
+    Sb_DirClose(handle);
+    return names;
+
+unlistable:
+    Sb_INCREF(Sb_None);
+    return Sb_None;
+
+fail1:
+    Sb_DECREF(names);
+fail0:
+    Sb_DirClose(handle);
+    return NULL;
+}
+
+/* Fetch the cached listing for the directory, scanning it on first use.
+   Returns: Borrowed reference. */
+static SbObject *
+import_get_listing(SbObject *dir)
+{
+    SbObject *listing;
+
+    listing = SbDict_GetItem(import_dir_cache, dir);
+    if (listing) {
+        return listing;
+    }
+
+    listing = import_list_dir(dir);
+    if (!listing) {
+        return NULL;
+    }
+    if (SbDict_SetItem(import_dir_cache, dir, listing) < 0) {
+        Sb_DECREF(listing);
+        return NULL;
+    }
+    Sb_DECREF(listing);
+    return listing;
+}
+
+static SbObject *
+import_load(const char *name, SbObject *dir)
+{
+    SbObject *path;
+    SbObject *module;
+#if SUPPORTS(IMPORT_STATISTICS)
+    Sb_ulong64_t started;
+    SbObject *elapsed;
+#endif
+
+    if (SbStr_GetSizeUnsafe(dir) != 0) {
+        path = SbStr_FromFormat("%s/%s.sb", SbStr_AsStringUnsafe(dir), name);
+    }
+    else {
+        path = SbStr_FromFormat("%s.sb", name);
+    }
+    if (!path) {
+        return NULL;
+    }
+
+#if SUPPORTS(IMPORT_STATISTICS)
+    started = Sb_GetTimeMicroseconds();
+#endif
+    module = Sb_LoadModule(name, SbStr_AsStringUnsafe(path));
+    Sb_DECREF(path);
+#if SUPPORTS(IMPORT_STATISTICS)
+    if (module) {
+        /* Statistics are best effort; never fail an import because of them. */
+        elapsed = SbInt_FromNative((SbInt_Native_t)(Sb_GetTimeMicroseconds() - started));
+        if (!elapsed || SbDict_SetItemString(SbSys_ImportTimes, name, elapsed) < 0) {
+            SbErr_Clear();
+        }
+        Sb_XDECREF(elapsed);
+    }
+#endif
+    return module;
+}
+
 SbObject *
 SB_Import(const char *name)
 {
     SbObject *module;
-    SbObject *path;
+    SbObject *search_path;
+    Sb_ssize_t pos;
 
     module = Sb_GetModule(name);
     if (module) {
@@ -98,19 +283,74 @@ SB_Import(const char *name)
         return module;
     }
 
-    path = SbStr_FromFormat("%s.sb", name);
-    if (!path) {
+    search_path = SbDict_GetItemString(SbModule_GetDict(Sb_ModuleSys), "path");
+    if (!search_path || !SbList_CheckExact(search_path)) {
+        SbErr_RaiseWithString(SbExc_ImportError, "sys.path must be a list");
         return NULL;
     }
 
-    module = Sb_LoadModule(name, SbStr_AsStringUnsafe(path));
-    Sb_DECREF(path);
-    if (module) {
-        return module;
+    if (import_init_caches() < 0) {
+        return NULL;
+    }
+    if (import_validate_misses(search_path) < 0) {
+        return NULL;
+    }
+    if (SbDict_GetItemString(import_miss_cache, name)) {
+        goto not_found;
     }
 
-    if (SbExc_ExceptionTypeMatches(SbErr_Occurred(), (SbObject *)SbExc_IOError)) {
-        SbErr_RaiseWithFormat(SbExc_ImportError, "module '%s' not found", name);
+    for (pos = 0; pos < SbList_GetSizeUnsafe(search_path); ++pos) {
+        SbObject *dir;
+        SbObject *listing;
+
+        dir = SbList_GetItemUnsafe(search_path, pos);
+        if (!SbStr_CheckExact(dir)) {
+            continue;
+        }
+
+        listing = import_get_listing(dir);
+        if (!listing) {
+            return NULL;
+        }
+        if (listing != Sb_None && !SbDict_GetItemString(listing, name)) {
+            continue;
+        }
+
+        module = import_load(name, dir);
+        if (module) {
+            return module;
+        }
+        if (!SbExc_ExceptionTypeMatches(SbErr_Occurred(), (SbObject *)SbExc_IOError)) {
+            return NULL;
+        }
+        SbErr_Clear();
+    }
+
+    if (SbDict_SetItemString(import_miss_cache, name, Sb_None) < 0) {
+        return NULL;
     }
+
+not_found:
+    SbErr_RaiseWithFormat(SbExc_ImportError, "module '%s' not found", name);
     return NULL;
 }
+
+void
+Sb_InvalidateImportCaches(void)
+{
+    if (import_dir_cache) {
+        SbDict_Clear(import_dir_cache);
+    }
+    if (import_miss_cache) {
+        SbDict_Clear(import_miss_cache);
+    }
+    Sb_CLEAR(import_miss_path);
+}
+
+void
+_Sb_ImportFini(void)
+{
+    Sb_CLEAR(import_dir_cache);
+    Sb_CLEAR(import_miss_cache);
+    Sb_CLEAR(import_miss_path);
+}
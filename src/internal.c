@@ -1,4 +1,5 @@
 #include "snakebed.h"
+#include "internal.h"
 
 SbObject *
 _SbTuple_Prepend(SbObject *o, SbObject *tuple)
@@ -91,6 +92,63 @@ _SbType_FromCDefs(const char *name, SbTypeObject *base_type, const SbCMethodDef
 
     tp->tp_basicsize = basic_size;
     tp->tp_destroy = SbObject_DefaultDestroy;
+    /* Built-in types live as long as the interpreter does. */
+    Sb_SET_IMMORTAL(tp);
 
     return tp;
 }
+
+#if SUPPORTS(OBJECT_FREELISTS)
+
+SbObject *
+_SbFreeList_Alloc(SbFreeList *fl, SbTypeObject *type, Sb_size_t size)
+{
+    void *p;
+
+#if SUPPORTS(CYCLE_GC)
+    if (type->tp_flags & SbType_FLAGS_HAVE_GC) {
+        size += sizeof(SbGCHead);
+    }
+#endif
+
+    p = fl->head;
+    if (p) {
+        fl->head = *(void **)p;
+        fl->count--;
+    }
+    else {
+        p = SbObject_Malloc(size);
+        if (!p) {
+            return SbErr_NoMemory();
+        }
+    }
+
+    SbRT_BZero(p, size);
+#if SUPPORTS(CYCLE_GC)
+    if (type->tp_flags & SbType_FLAGS_HAVE_GC) {
+        return _SbGC_Link(p);
+    }
+#endif
+    return (SbObject *)p;
+}
+
+void
+_SbFreeList_Free(SbFreeList *fl, void *p)
+{
+#if SUPPORTS(CYCLE_GC)
+    /* The type is still there when tp_free gets called. */
+    if (SbObject_IS_GC(p)) {
+        p = _SbGC_Unlink(p);
+    }
+#endif
+    if (fl->count >= fl->limit) {
+        SbObject_Free(p);
+        return;
+    }
+
+    *(void **)p = fl->head;
+    fl->head = p;
+    fl->count++;
+}
+
+#endif /* SUPPORTS(OBJECT_FREELISTS) */
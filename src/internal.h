@@ -14,12 +14,50 @@ _SbTuple_Prepend(SbObject *o, SbObject *tuple);
 SbObject *
 _SbErr_IncorrectSubscriptType(SbObject *sub);
 
+/* Compare the values of two int objects.
+   Returns: -1 on error, 0 if the result is false, 1 otherwise. */
+int
+SbInt_CompareBool(SbObject *p1, SbObject *p2, SbObjectCompareOp op);
+
 SbObject *
 _SbType_BuildMethodDict(const SbCMethodDef *methods);
 
+/* Create a built-in type; the type is made immortal. */
 SbTypeObject *
 _SbType_FromCDefs(const char *name, SbTypeObject *base_type, const SbCMethodDef *methods, Sb_size_t basic_size);
 
+/* Make the type's instances tracked by the cycle collector. */
+#if SUPPORTS(CYCLE_GC)
+void
+_SbType_EnableGC(SbTypeObject *tp, SbTraverseFunc traverse, SbClearFunc clear);
+#else
+#define _SbType_EnableGC(tp, traverse, clear) ((void)0)
+#endif
+
+#if SUPPORTS(OBJECT_FREELISTS)
+
+/* A cache of freed objects of one size; blocks are chained through their first word. */
+typedef struct _SbFreeList {
+    void *head;
+    Sb_ssize_t count;
+    Sb_ssize_t limit;
+} SbFreeList;
+
+#define SbFreeList_INIT(limit) \
+    { NULL, 0, (limit) }
+
+/* Take zeroed memory for a `size` bytes instance of `type` from the freelist,
+   or from the allocator if it is empty. Instances of GC types get tracked.
+   Returns: Pointer to the instance; NULL and raises on failure. */
+SbObject *
+_SbFreeList_Alloc(SbFreeList *fl, SbTypeObject *type, Sb_size_t size);
+
+/* Keep the instance memory for reuse, or release it if the freelist is full. */
+void
+_SbFreeList_Free(SbFreeList *fl, void *p);
+
+#endif /* SUPPORTS(OBJECT_FREELISTS) */
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,79 @@ SbFrameObject *SbInterp_TopFrame = NULL;
 #define STACK_POP() *sp++
 #define STACK_TOP() *sp
 
+#if SUPPORTS(TAGGED_INTS)
+/* Compare two tagged ints without going through the method dispatch. */
+static int
+tagged_compare(SbObject *lhs, SbObject *rhs, int op)
+{
+    SbInt_Native_t a = SbInt_UNTAG(lhs);
+    SbInt_Native_t b = SbInt_UNTAG(rhs);
+
+    switch (op) {
+    case SbCmp_LT:
+        return a < b;
+    case SbCmp_LE:
+        return a <= b;
+    case SbCmp_EQ:
+        return a == b;
+    case SbCmp_NE:
+        return a != b;
+    case SbCmp_GT:
+        return a > b;
+    default:
+        return a >= b;
+    }
+}
+#endif
+
+/* Check whether the str `lhs` of `s += t` or `s = s + t` can be grown in place.
+   The stack holds one reference; if the only other one is the variable
+   the result is about to be stored to, that reference is dropped here. */
+static int
+str_is_resizable(SbFrameObject *frame, const Sb_byte_t *ip, SbObject *lhs)
+{
+    SbObject *scope;
+    SbObject *names;
+    SbObject *name;
+
+    if (Sb_REFCNT(lhs) == 1) {
+        return 1;
+    }
+    if (Sb_REFCNT(lhs) != 2) {
+        return 0;
+    }
+
+    switch (ip[0]) {
+    case StoreFast:
+        scope = frame->locals;
+        names = frame->code->varnames;
+        break;
+    case StoreName:
+        scope = frame->locals;
+        names = frame->code->names;
+        break;
+    case StoreGlobal:
+        scope = frame->globals;
+        names = frame->code->names;
+        break;
+    default:
+        return 0;
+    }
+    if (!scope) {
+        return 0;
+    }
+    name = SbTuple_GetItemUnsafe(names, ip[1] | (ip[2] << 8));
+    if (_SbDict_GetItemStr(scope, name) != lhs) {
+        return 0;
+    }
+    /* The store that follows rebinds it anyway. */
+    if (_SbDict_SetItemStr(scope, name, Sb_None) < 0) {
+        SbErr_Clear();
+        return 0;
+    }
+    return Sb_REFCNT(lhs) == 1;
+}
+
 enum SbUnwindReason {
     Reason_Unknown,
 
@@ -51,8 +124,9 @@ SbInterp_Execute(SbFrameObject *frame)
     /* Loop until a return is executed or an exception is raised. */
     for (;;) {
         SbOpcode opcode;
-        unsigned opcode_arg;
+        Sb_ssize_t opcode_arg;
         SbObject *scope;
+        SbObject *o_name;
         const char *name;
         int test_value;
         Sb_ssize_t pos;
@@ -179,45 +253,48 @@ PopJumpIfXxx:
 
             case LoadFast:
                 /* Tries: locals */
+                o_name = SbTuple_GetItem(code->varnames, opcode_arg);
                 if (locals) {
-                    name = SbStr_AsString(SbTuple_GetItem(code->varnames, opcode_arg));
-                    o_result = SbDict_GetItemString(locals, name);
+                    o_result = _SbDict_GetItemStr(locals, o_name);
                     if (o_result) {
                         goto Xxx_incref_push_continue;
                     }
                 }
+                name = SbStr_AsString(o_name);
                 SbErr_RaiseWithFormat(SbExc_UnboundLocalError, "name '%s' used before being bound", name);
                 break;
             case LoadName:
                 /* Tries: locals, globals, builtins */
-                name = SbStr_AsString(SbTuple_GetItem(names, opcode_arg));
+                o_name = SbTuple_GetItem(names, opcode_arg);
                 if (locals) {
-                    o_result = SbDict_GetItemString(locals, name);
+                    o_result = _SbDict_GetItemStr(locals, o_name);
                     if (o_result) {
                         goto Xxx_incref_push_continue;
                     }
                 }
-                o_result = SbDict_GetItemString(globals, name);
+                o_result = _SbDict_GetItemStr(globals, o_name);
                 if (o_result) {
                     goto Xxx_incref_push_continue;
                 }
-                o_result = SbDict_GetItemString(SbModule_GetDict(Sb_ModuleBuiltin), name);
+                o_result = _SbDict_GetItemStr(SbModule_GetDict(Sb_ModuleBuiltin), o_name);
                 if (o_result) {
                     goto Xxx_incref_push_continue;
                 }
+                name = SbStr_AsString(o_name);
                 SbErr_RaiseWithFormat(SbExc_NameError, "name '%s' not found", name);
                 break;
             case LoadGlobal:
                 /* Tries: globals, builtins */
-                name = SbStr_AsString(SbTuple_GetItem(names, opcode_arg));
-                o_result = SbDict_GetItemString(globals, name);
+                o_name = SbTuple_GetItem(names, opcode_arg);
+                o_result = _SbDict_GetItemStr(globals, o_name);
                 if (o_result) {
                     goto Xxx_incref_push_continue;
                 }
-                o_result = SbDict_GetItemString(SbModule_GetDict(Sb_ModuleBuiltin), name);
+                o_result = _SbDict_GetItemStr(SbModule_GetDict(Sb_ModuleBuiltin), o_name);
                 if (o_result) {
                     goto Xxx_incref_push_continue;
                 }
+                name = SbStr_AsString(o_name);
                 SbErr_RaiseWithFormat(SbExc_NameError, "global name '%s' not found", name);
                 break;
 
@@ -233,9 +310,10 @@ PopJumpIfXxx:
                 scope = globals;
                 tmp = names;
 StoreXxx_common:
-                name = SbStr_AsString(SbTuple_GetItem(tmp, opcode_arg));
+                o_name = SbTuple_GetItem(tmp, opcode_arg);
+                name = SbStr_AsString(o_name);
                 op1 = STACK_POP();
-                i_result = SbDict_SetItemString(scope, name, op1);
+                i_result = _SbDict_SetItemStr(scope, o_name, op1);
                 goto XxxName_drop1_check_iresult;
 
             case DeleteFast:
@@ -243,8 +321,8 @@ StoreXxx_common:
                 tmp = code->varnames;
                 goto DeleteXxx_common;
             case DeleteName:
-                name = SbStr_AsString(SbTuple_GetItem(names, opcode_arg));
-                i_result = SbDict_DelItemString(locals, name);
+                o_name = SbTuple_GetItem(names, opcode_arg);
+                i_result = _SbDict_DelItemStr(locals, o_name);
                 if (i_result >= 0) {
                     continue;
                 }
@@ -257,35 +335,38 @@ StoreXxx_common:
                 scope = globals;
                 tmp = names;
 DeleteXxx_common:
-                name = SbStr_AsString(SbTuple_GetItem(tmp, opcode_arg));
-                i_result = SbDict_DelItemString(scope, name);
+                o_name = SbTuple_GetItem(tmp, opcode_arg);
+                name = SbStr_AsString(o_name);
+                i_result = _SbDict_DelItemStr(scope, o_name);
                 goto XxxName_check_iresult;
 
             case LoadAttr:
                 /* X -> X.attr */
-                name = SbStr_AsString(SbTuple_GetItem(names, opcode_arg));
+                o_name = SbTuple_GetItem(names, opcode_arg);
                 op1 = STACK_POP();
-                o_result = SbObject_GetAttrString(op1, name);
+                o_result = _SbObject_GetAttr(op1, o_name);
                 Sb_DECREF(op1);
                 if (o_result) {
                     goto Xxx_push_continue;
                 }
-                /* No need to clear - SbObject_GetAttrString() doesn't raise */
-                SbErr_RaiseWithString(SbExc_AttributeError, name);
+                /* No need to clear - _SbObject_GetAttr() doesn't raise */
+                SbErr_RaiseWithObject(SbExc_AttributeError, o_name);
                 break;
             case StoreAttr:
                 /* X Y -> */
-                name = SbStr_AsString(SbTuple_GetItem(names, opcode_arg));
+                o_name = SbTuple_GetItem(names, opcode_arg);
+                name = SbStr_AsString(o_name);
                 op1 = STACK_POP();
                 op2 = STACK_POP();
-                i_result = SbObject_SetAttrString(op1, name, op2);
+                i_result = _SbObject_SetAttr(op1, o_name, op2);
                 Sb_DECREF(op2);
                 goto XxxName_drop1_check_iresult;
             case DeleteAttr:
                 /* X -> */
-                name = SbStr_AsString(SbTuple_GetItem(names, opcode_arg));
+                o_name = SbTuple_GetItem(names, opcode_arg);
+                name = SbStr_AsString(o_name);
                 op1 = STACK_POP();
-                i_result = SbObject_DelAttrString(op1, name);
+                i_result = _SbObject_DelAttr(op1, o_name);
 
 XxxName_drop1_check_iresult:
                 Sb_DECREF(op1);
@@ -326,8 +407,8 @@ XxxName_check_iresult:
                 goto Xxx_push_continue;
             case BuildMap:
                 /* Nothing is pushed on the stack. */
-                o_result = SbDict_New();
-                /* NOTE: the compiler provides a sizing hint via opcode arg, which is ignored for now. */
+                /* NOTE: the compiler provides a sizing hint via opcode arg. */
+                o_result = SbDict_NewPresized(opcode_arg);
                 goto Xxx_check_oresult;
 
             case StoreMap:
@@ -382,7 +463,12 @@ XxxName_check_iresult:
                     }
 
                     kwargs_passed = (opcode_arg >> 8) & 0xFF;
-                    op3 = SbDict_New();
+                    /* Size the kwargs dict for everything that goes in */
+                    pos = kwargs_passed;
+                    if (kwds) {
+                        pos += SbDict_GetSizeUnsafe(kwds);
+                    }
+                    op3 = SbDict_NewPresized(pos);
                     if (!op3) {
                         Sb_XDECREF(vargs);
                         Sb_XDECREF(kwds);
@@ -410,7 +496,7 @@ XxxName_check_iresult:
                             value = STACK_POP();
                             key = STACK_POP();
                             /* NOTE: This overrides whatever was passed via **kwds */
-                            SbDict_SetItemString(op3, SbStr_AsString(key), value);
+                            _SbDict_SetItemStr(op3, key, value);
                             Sb_DECREF(key);
                             Sb_DECREF(value);
                             ++pos;
@@ -457,14 +543,14 @@ XxxName_check_iresult:
 
             case ImportFrom:
                 /* Mod -> Attr Mod */
-                name = SbStr_AsString(SbTuple_GetItem(names, opcode_arg));
+                o_name = SbTuple_GetItem(names, opcode_arg);
                 /* assert(Sb_TYPE(STACK_TOP()) == SbModule_Type); */
-                o_result = SbDict_GetItemString(SbModule_GetDict(STACK_TOP()), name);
+                o_result = _SbDict_GetItemStr(SbModule_GetDict(STACK_TOP()), o_name);
                 if (o_result) {
                     goto Xxx_incref_push_continue;
                 }
                 if (!SbErr_Occurred()) {
-                    SbErr_RaiseWithString(SbExc_NameError, name);
+                    SbErr_RaiseWithObject(SbExc_NameError, o_name);
                 }
                 break;
 
@@ -515,6 +601,12 @@ UnaryXxx_common:
                 op2 = STACK_POP();
                 op1 = STACK_POP();
 
+#if SUPPORTS(TAGGED_INTS)
+                if (opcode_arg <= SbCmp_GE && Sb_IS_TAGGED(op1) && Sb_IS_TAGGED(op2)) {
+                    o_result = SbBool_FromLong(tagged_compare(op1, op2, opcode_arg));
+                    goto Xxx_check_oresult;
+                }
+#endif
                 if (opcode_arg <= SbCmp_GE) {
                     o_result = SbObject_Compare(op1, op2, (SbObjectCompareOp)opcode_arg);
                     goto Xxx_drop2_check_oresult;
@@ -537,19 +629,59 @@ UnaryXxx_common:
                 }
                 Sb_DECREF(op2);
                 Sb_DECREF(op1);
-                SbErr_RaiseWithFormat(SbExc_SystemError, "compare op %d not implemented", opcode_arg);
+                SbErr_RaiseWithFormat(SbExc_SystemError, "compare op %d not implemented", (int)opcode_arg);
                 break;
 
+            case InPlacePower:
+            case BinaryPower:
+                op1 = STACK_POP();
+                op2 = STACK_POP();
+                o_result = SbNumber_Power(op2, op1, NULL);
+                goto Xxx_drop2_check_oresult;
+
             case InPlaceAdd:
             case BinaryAdd:
+#if SUPPORTS(TAGGED_INTS)
+                /* Tagged values have a bit to spare: neither this nor the difference can overflow. */
+                if (Sb_IS_TAGGED(sp[0]) && Sb_IS_TAGGED(sp[1])) {
+                    o_result = SbInt_FromNative(SbInt_UNTAG(sp[1]) + SbInt_UNTAG(sp[0]));
+                    sp += 2;
+                    goto Xxx_check_oresult;
+                }
+#endif
+                if (SbStr_CheckExact(sp[1]) && SbStr_CheckExact(sp[0]) && sp[0] != sp[1]
+                    && str_is_resizable(frame, ip, sp[1])) {
+                    op1 = STACK_POP();
+                    o_result = STACK_POP();
+                    _SbStr_ConcatInPlace(&o_result, op1);
+                    goto Xxx_drop1_check_oresult;
+                }
                 bfunc = &SbNumber_Add;
                 goto BinaryXxx_common;
             case InPlaceSubtract:
             case BinarySubtract:
+#if SUPPORTS(TAGGED_INTS)
+                if (Sb_IS_TAGGED(sp[0]) && Sb_IS_TAGGED(sp[1])) {
+                    o_result = SbInt_FromNative(SbInt_UNTAG(sp[1]) - SbInt_UNTAG(sp[0]));
+                    sp += 2;
+                    goto Xxx_check_oresult;
+                }
+#endif
                 bfunc = &SbNumber_Subtract;
                 goto BinaryXxx_common;
             case InPlaceMultiply:
             case BinaryMultiply:
+#if SUPPORTS(TAGGED_INTS) && defined(Sb_MulOverflow)
+                if (Sb_IS_TAGGED(sp[0]) && Sb_IS_TAGGED(sp[1])) {
+                    SbInt_Native_t product;
+
+                    if (!Sb_MulOverflow(SbInt_UNTAG(sp[1]), SbInt_UNTAG(sp[0]), &product)) {
+                        o_result = SbInt_FromNative(product);
+                        sp += 2;
+                        goto Xxx_check_oresult;
+                    }
+                }
+#endif
                 bfunc = &SbNumber_Multiply;
                 goto BinaryXxx_common;
             case InPlaceDivide:
@@ -637,15 +769,26 @@ BinaryXxx_common:
                 if (o_result) {
                     goto Xxx_push_continue;
                 }
-                else {
-                    ++sp;
-                    Sb_DECREF(op1);
-                    ip += opcode_arg;
-                    continue;
+                if (SbErr_Occurred()) {
+                    /* The iterator failed rather than ran out; it stays on the stack for unwinding. */
+                    break;
                 }
+                ++sp;
+                Sb_DECREF(op1);
+                ip += opcode_arg;
+                continue;
 
             case ListAppend:
                 op2 = sp[opcode_arg];
+                /* On the first append, size a comprehension's list after the iterator below it.
+                   That iterator has already yielded the item being appended. */
+                if (!SbList_GetSizeUnsafe(op2) && opcode_arg >= 2) {
+                    pos = SbIter_LengthHint(sp[opcode_arg - 1]);
+                    if (pos > 0 && SbList_Reserve(op2, pos + 1) < 0) {
+                        /* Only a missed hint; the appends below still grow the list. */
+                        SbErr_Clear();
+                    }
+                }
                 op1 = STACK_POP();
                 i_result = SbList_Append(op2, op1);
                 goto Xxx_drop1_check_iresult;
@@ -866,7 +1009,7 @@ StoreSliceXxx:
                 op3 = tmp;
                 op2 = STACK_POP();
                 op1 = STACK_POP();
-                i_result = SbObject_SetItem(op2, op1, op3);
+                i_result = SbObject_SetItem(op2, op3, op1);
                 goto Xxx_drop3_check_iresult;
 
             case DeleteSlice:
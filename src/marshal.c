@@ -8,6 +8,7 @@
 #define TYPE_ELLIPSIS           '.'
 
 #define TYPE_INT                'i'
+#define TYPE_INT64              'I'
 #define TYPE_LONG               'l'
 #define TYPE_STRING8            's'
 #define TYPE_STRING32           'S'
@@ -61,6 +62,41 @@ read_int(SbObject *input, SbInt_Native_t *value)
     return 0;
 }
 
+static int
+read_int64(SbObject *input, Sb_long64_t *value)
+{
+    Sb_byte_t buffer[8];
+    Sb_ulong64_t v;
+    int i;
+
+    if (SbFile_Read(input, buffer, sizeof(buffer)) < sizeof(buffer)) {
+        /* Raise something */
+        return -1;
+    }
+    v = 0;
+    for (i = 7; i >= 0; --i) {
+        v = (v << 8) | buffer[i];
+    }
+    *value = (Sb_long64_t)v;
+    return 0;
+}
+
+static SbObject *
+int_from_long64(Sb_long64_t value)
+{
+    SbInt_HalfDigit_t halves[4];
+    int i;
+
+    if (value >= SbInt_NATIVE_MIN && value <= SbInt_NATIVE_MAX) {
+        return SbInt_FromNative((SbInt_Native_t)value);
+    }
+    /* Only reached where the native type is narrower than 64 bits. */
+    for (i = 0; i < 4; ++i) {
+        halves[i] = (SbInt_HalfDigit_t)((Sb_ulong64_t)value >> (i * 16));
+    }
+    return SbInt_FromHalfDigits(4, halves);
+}
+
 static int
 read_string(SbObject *input, void *buffer, Sb_size_t size)
 {
@@ -106,20 +142,41 @@ read_object(SbObject *input, marshal_state *state)
         result = SbInt_FromNative(n);
         break;
 
+    case TYPE_INT64:
+        {
+            Sb_long64_t value;
+
+            if (read_int64(input, &value) < 0) {
+                break;
+            }
+            result = int_from_long64(value);
+        }
+        break;
+
     case TYPE_LONG:
         if (read_half(input, &n) < 0) {
             break;
         }
-        result = SbInt_FromLengthAndDigits(n, NULL);
-        if (result) {
-            SbInt_Digit_t *digits;
-            long digit;
-
-            digits = SbInt_DIGITS(result);
-            while (n--) {
-                read_half(input, &digit);
-                *digits++ = (SbInt_Digit_t)digit;
+        {
+            SbInt_HalfDigit_t *halves;
+            long i, digit;
+
+            /* Serialized digits are half-size; the int object converts them. */
+            halves = (SbInt_HalfDigit_t *)Sb_Malloc(n * sizeof(SbInt_HalfDigit_t));
+            if (!halves) {
+                SbErr_NoMemory();
+                break;
+            }
+            for (i = 0; i < n; ++i) {
+                if (read_half(input, &digit) < 0) {
+                    break;
+                }
+                halves[i] = (SbInt_HalfDigit_t)digit;
+            }
+            if (i == n) {
+                result = SbInt_FromHalfDigits(n, halves);
             }
+            Sb_Free(halves);
         }
         break;
 
@@ -45,6 +45,7 @@ socket_raise_error(void)
     int error_id;
     SbObject *o_errno;
     SbObject *o_text;
+    SbObject *value;
     
 #if PLATFORM(PLATFORM_WINNT)
     error_id = WSAGetLastError();
@@ -53,9 +54,11 @@ socket_raise_error(void)
 #endif
     o_errno = SbInt_FromNative(error_id);
     o_text = SbStr_FromString("<strerror not available>");
-    SbErr_RaiseWithObject(SbExc_SocketError, SbTuple_Pack(2, o_errno, o_text));
+    value = SbTuple_Pack(2, o_errno, o_text);
     Sb_DECREF(o_errno);
     Sb_DECREF(o_text);
+    SbErr_RaiseWithObject(SbExc_SocketError, value);
+    Sb_XDECREF(value);
     return NULL;
 }
 
@@ -64,6 +67,7 @@ socket_raise_error(void)
 static int
 addr2sa_ipv4(SbObject *addr, struct sockaddr *sa)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("s:address,i:port");
     struct sockaddr_in *sa_ipv4 = (struct sockaddr_in *)sa;
     const char *ipaddr;
     const char *cursor;
@@ -71,7 +75,7 @@ addr2sa_ipv4(SbObject *addr, struct sockaddr *sa)
     unsigned long tmp;
 
     /* Reduces code bloat at expense of more cryptic error messages... */
-    if (SbArgs_Parse("s:address,i:port", addr, NULL, &ipaddr, &port) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, addr, NULL, &ipaddr, &port) < 0) {
         return -1;
     }
     if ((unsigned long)port > 65535) {
@@ -205,11 +209,12 @@ socketobj_new(int s, int family, int type, int proto)
 static SbObject *
 socketobj_init(socket_object *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("|i:family,i:type,i:proto");
     int family = AF_INET;
     int type = SOCK_STREAM;
     int proto = 0;
 
-    if (SbArgs_Parse("|i:family,i:type,i:proto", args, kwargs, &family, &type, &proto) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &family, &type, &proto) < 0) {
         return NULL;
     }
 
@@ -226,10 +231,11 @@ socketobj_init(socket_object *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 socketobj_getattr(socket_object *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("s:name");
     const char *attr_str;
     SbObject *value;
 
-    if (SbArgs_Parse("s:name", args, kwargs, &attr_str) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &attr_str) < 0) {
         return NULL;
     }
 
@@ -259,11 +265,12 @@ socketobj_del(socket_object *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 socketobj_bind(socket_object *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("T:addr");
     SbObject *o_address;
     struct sockaddr sa;
     int call_result;
 
-    if (SbArgs_Parse("T:addr", args, kwargs, &o_address) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_address) < 0) {
         return NULL;
     }
 
@@ -296,10 +303,11 @@ socketobj_close(socket_object *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 socketobj_shutdown(socket_object *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("i:how");
     int how;
     int call_result;
 
-    if (SbArgs_Parse("i:how", args, kwargs, &how) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &how) < 0) {
         return NULL;
     }
 
@@ -314,10 +322,11 @@ socketobj_shutdown(socket_object *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 socketobj_listen(socket_object *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("i:backlog");
     int backlog = 0;
     int call_result;
 
-    if (SbArgs_Parse("i:backlog", args, kwargs, &backlog) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &backlog) < 0) {
         return NULL;
     }
 
@@ -466,11 +475,12 @@ socketobj_recvfrom_internal(socket_object *self, Sb_ssize_t maxsize, int flags,
 static SbObject *
 socketobj_recv(socket_object *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("i:bufsize|i:flags");
     SbObject *o_buffer;
     int maxsize;
     int flags = 0;
 
-    if (SbArgs_Parse("i:bufsize|i:flags", args, kwargs, &maxsize, &flags) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &maxsize, &flags) < 0) {
         return NULL;
     }
 
@@ -481,6 +491,7 @@ socketobj_recv(socket_object *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 socketobj_recvfrom(socket_object *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("i:bufsize|i:flags");
     SbObject *o_buffer;
     SbObject *o_address;
     int maxsize;
@@ -488,7 +499,7 @@ socketobj_recvfrom(socket_object *self, SbObject *args, SbObject *kwargs)
     struct sockaddr sa;
     int sa_len = sizeof(sa);
 
-    if (SbArgs_Parse("i:bufsize|i:flags", args, kwargs, &maxsize, &flags) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &maxsize, &flags) < 0) {
         return NULL;
     }
 
@@ -505,11 +516,12 @@ socketobj_recvfrom(socket_object *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 socketobj_connect(socket_object *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("T:addr");
     SbObject *o_address;
     struct sockaddr sa;
     int call_result;
 
-    if (SbArgs_Parse("T:addr", args, kwargs, &o_address) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_address) < 0) {
         return NULL;
     }
 
@@ -562,10 +574,11 @@ socketobj_sendto_internal(socket_object *self, SbObject *buffer, int flags, stru
 static SbObject *
 socketobj_send(socket_object *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("S:buffer|i:flags");
     SbObject *o_buffer;
     int flags = 0;
 
-    if (SbArgs_Parse("S:buffer|i:flags", args, kwargs, &o_buffer, &flags) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_buffer, &flags) < 0) {
         return NULL;
     }
 
@@ -575,12 +588,13 @@ socketobj_send(socket_object *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 socketobj_sendto(socket_object *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("S:buffer,T:address|i:flags");
     SbObject *o_buffer;
     SbObject *o_address;
     int flags = 0;
     struct sockaddr sa;
 
-    if (SbArgs_Parse("S:buffer,T:address|i:flags", args, kwargs, &o_buffer, &o_address, &flags) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_buffer, &o_address, &flags) < 0) {
         return NULL;
     }
 
@@ -605,10 +619,11 @@ socketobj_apply_timeout(socket_object *self, int timeout)
 static SbObject *
 socketobj_settimeout(socket_object *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:timeout");
     SbObject *o_timeout;
     int timeout;
 
-    if (SbArgs_Parse("O:timeout", args, kwargs, &o_timeout) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_timeout) < 0) {
         return NULL;
     }
 
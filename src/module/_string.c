@@ -222,7 +222,7 @@ formatter_convert(SbObject *o, SbObject *conv)
 {
     char conv_type;
 
-    conv_type = SbStr_AsStringUnsafe(conv)[0];
+    conv_type = conv != Sb_None ? SbStr_AsStringUnsafe(conv)[0] : '\0';
     switch (conv_type) {
     case 's':
         return SbObject_Str(o);
@@ -244,15 +244,18 @@ SbObject *
 Formatter_VFormat(SbObject *self, SbObject *args, SbObject *kwargs)
 {
     SbObject *items;
-    SbObject *parts;
-    SbObject *result;
+    SbStrBuilder sb;
     Sb_ssize_t pos, item_count;
-    Sb_ssize_t posarg_counter;
 
     items = formatter_parse(self);
-    parts = SbList_New(0);
+    if (!items) {
+        return NULL;
+    }
+    if (SbStrBuilder_Init(&sb, SbStr_GetSizeUnsafe(self)) < 0) {
+        Sb_DECREF(items);
+        return NULL;
+    }
 
-    posarg_counter = 0;
     pos = 0;
     /* Relies on items being a list. */
     item_count = SbList_GetSizeUnsafe(items);
@@ -266,13 +269,14 @@ Formatter_VFormat(SbObject *self, SbObject *args, SbObject *kwargs)
         o_conv = SbTuple_GetItemUnsafe(item, 3);
 
         o_literal = SbTuple_GetItemUnsafe(item, 0);
-        if (SbStr_GetSize(o_literal) > 0) {
-            SbList_Append(parts, o_literal);
+        if (SbStrBuilder_AppendStr(&sb, o_literal) < 0) {
+            goto error;
         }
 
         if (o_name != Sb_None) {
             SbObject *o;
             SbObject *o_converted;
+            int rv;
 
             o = formatter_get_field(o_name, args, kwargs);
             if (!o) {
@@ -281,24 +285,29 @@ Formatter_VFormat(SbObject *self, SbObject *args, SbObject *kwargs)
 
             o_converted = formatter_convert(o, o_conv);
             Sb_DECREF(o);
+            if (!o_converted) {
+                goto error;
+            }
 
             o = formatter_format_value(o_converted, o_spec);
             Sb_DECREF(o_converted);
             if (!o) {
                 goto error;
             }
-            SbList_Append(parts, o);
+            rv = SbStrBuilder_AppendStr(&sb, o);
+            Sb_DECREF(o);
+            if (rv < 0) {
+                goto error;
+            }
         }
     }
     Sb_DECREF(items);
 
-    result = SbStr_Join(SbStr_FromString(""), parts);
-    Sb_DECREF(parts);
-    return result;
+    return SbStrBuilder_Finish(&sb);
 
 error:
     Sb_DECREF(items);
-    Sb_DECREF(parts);
+    SbStrBuilder_Clear(&sb);
     return NULL;
 }
 
@@ -5,6 +5,8 @@
 SbObject *Sb_ModuleBuiltin = NULL;
 
 #if SUPPORTS(BUILTIN_PRINT)
+static SbDictKey key_stdout = SbDictKey_INIT("stdout");
+
 static SbObject *
 _builtin_print(SbObject *self, SbObject *args, SbObject *kwargs)
 {
@@ -16,7 +18,7 @@ _builtin_print(SbObject *self, SbObject *args, SbObject *kwargs)
     sep = SbStr_FromString(" ");
     end = SbStr_FromString("\n");
 
-    out = SbDict_GetItemString(SbModule_GetDict(Sb_ModuleSys), "stdout");
+    out = SbDict_GetItemKey(SbModule_GetDict(Sb_ModuleSys), &key_stdout);
     if (out) {
         Sb_ssize_t pos, count;
         
@@ -49,9 +51,10 @@ _builtin_print(SbObject *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 _builtin_id(SbObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:o");
     SbObject *o;
 
-    if (SbArgs_Parse("O:o", args, kwargs, &o) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o) < 0) {
         return NULL;
     }
 
@@ -61,10 +64,11 @@ _builtin_id(SbObject *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 _builtin_len(SbObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:o");
     SbObject *o;
     Sb_ssize_t len;
 
-    if (SbArgs_Parse("O:o", args, kwargs, &o) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o) < 0) {
         return NULL;
     }
 
@@ -79,10 +83,11 @@ _builtin_len(SbObject *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 _builtin_hash(SbObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:o");
     SbObject *o;
     SbInt_Native_t hash;
 
-    if (SbArgs_Parse("O:o", args, kwargs, &o) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o) < 0) {
         return NULL;
     }
 
@@ -94,19 +99,49 @@ _builtin_hash(SbObject *self, SbObject *args, SbObject *kwargs)
     return SbInt_FromNative(hash);
 }
 
+static SbObject *
+_builtin_divmod(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:a,O:b");
+    SbObject *a;
+    SbObject *b;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &a, &b) < 0) {
+        return NULL;
+    }
+
+    return SbNumber_DivMod(a, b);
+}
+
+static SbObject *
+_builtin_pow(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:x,O:y|O:z");
+    SbObject *x;
+    SbObject *y;
+    SbObject *z = NULL;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &x, &y, &z) < 0) {
+        return NULL;
+    }
+
+    return SbNumber_Power(x, y, z);
+}
+
 
 static SbObject *
 _builtin_getattr(SbObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:o,S:name|O:default");
     SbObject *o;
     SbObject *o_name;
     SbObject *o_default = NULL;
 
-    if (SbArgs_Parse("O:o,S:name|O:default", args, kwargs, &o, &o_name, &o_default) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o, &o_name, &o_default) < 0) {
         return NULL;
     }
 
-    o = SbObject_GetAttrString(o, SbStr_AsStringUnsafe(o_name));
+    o = _SbObject_GetAttr(o, o_name);
     if (o) {
         return o;
     }
@@ -121,6 +156,40 @@ _builtin_getattr(SbObject *self, SbObject *args, SbObject *kwargs)
     return NULL;
 }
 
+static SbObject *
+_builtin_sorted(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:iterable|O:key,O:reverse");
+    SbObject *iterable;
+    SbObject *key = NULL;
+    SbObject *reverse = NULL;
+    int reverse_flag = 0;
+    SbObject *result;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &iterable, &key, &reverse) < 0) {
+        return NULL;
+    }
+    if (key == Sb_None) {
+        key = NULL;
+    }
+    if (reverse) {
+        reverse_flag = SbObject_IsTrue(reverse);
+        if (reverse_flag < 0) {
+            return NULL;
+        }
+    }
+
+    result = SbList_New(0);
+    if (!result) {
+        return NULL;
+    }
+    if (SbList_Extend(result, iterable) < 0 || SbList_Sort(result, key, reverse_flag) < 0) {
+        Sb_DECREF(result);
+        return NULL;
+    }
+    return result;
+}
+
 SbObject *
 SbBuiltin_Format(SbObject *self, SbObject *spec)
 {
@@ -130,9 +199,10 @@ SbBuiltin_Format(SbObject *self, SbObject *spec)
 static SbObject *
 _builtin_format(SbObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("S:spec");
     SbObject *o_spec;
 
-    if (SbArgs_Parse("S:spec", args, kwargs, &o_spec) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_spec) < 0) {
         return NULL;
     }
 
@@ -174,6 +244,9 @@ _Sb_ModuleInit_Builtin()
     SbDict_SetItemString(dict, "BaseException", (SbObject *)SbExc_BaseException);
     SbDict_SetItemString(dict, "Exception", (SbObject *)SbExc_Exception);
     SbDict_SetItemString(dict, "StandardError", (SbObject *)SbExc_StandardError);
+    SbDict_SetItemString(dict, "ArithmeticError", (SbObject *)SbExc_ArithmeticError);
+    SbDict_SetItemString(dict, "OverflowError", (SbObject *)SbExc_OverflowError);
+    SbDict_SetItemString(dict, "ZeroDivisionError", (SbObject *)SbExc_ZeroDivisionError);
     SbDict_SetItemString(dict, "AttributeError", (SbObject *)SbExc_AttributeError);
     SbDict_SetItemString(dict, "EnvironmentError", (SbObject *)SbExc_EnvironmentError);
     SbDict_SetItemString(dict, "IOError", (SbObject *)SbExc_IOError);
@@ -184,6 +257,7 @@ _Sb_ModuleInit_Builtin()
     SbDict_SetItemString(dict, "MemoryError", (SbObject *)SbExc_MemoryError);
     SbDict_SetItemString(dict, "NameError", (SbObject *)SbExc_NameError);
     SbDict_SetItemString(dict, "UnboundLocalError", (SbObject *)SbExc_UnboundLocalError);
+    SbDict_SetItemString(dict, "RuntimeError", (SbObject *)SbExc_RuntimeError);
     SbDict_SetItemString(dict, "SystemError", (SbObject *)SbExc_SystemError);
     SbDict_SetItemString(dict, "TypeError", (SbObject *)SbExc_TypeError);
     SbDict_SetItemString(dict, "ValueError", (SbObject *)SbExc_ValueError);
@@ -210,7 +284,10 @@ _Sb_ModuleInit_Builtin()
     add_func(dict, "id", _builtin_id);
     add_func(dict, "len", _builtin_len);
     add_func(dict, "hash", _builtin_hash);
+    add_func(dict, "divmod", _builtin_divmod);
+    add_func(dict, "pow", _builtin_pow);
     add_func(dict, "getattr", _builtin_getattr);
+    add_func(dict, "sorted", _builtin_sorted);
 #if SUPPORTS(STR_FORMAT)
     add_func(dict, "format", _builtin_format);
 #endif
@@ -0,0 +1,666 @@
+#include "snakebed.h"
+#include "internal.h"
+
+#if SUPPORTS(CYCLE_GC)
+
+/* Ref: https://docs.python.org/2/library/gc.html */
+
+/*
+ * The collector follows the classic generational scheme.
+ *
+ * Every instance of a GC type carries a header linking it into one of
+ * the generation lists. A collection of generation N merges the younger
+ * generations into N, then for each object in there computes how many of
+ * its references come from outside the collected set: tp_traverse is used
+ * to subtract the references the objects hold to each other. Objects with
+ * outside references, and everything reachable from them, survive and get
+ * promoted; the rest is garbage and is torn down with tp_clear.
+ *
+ * Garbage with `__del__` methods is not freed; as the order of finalization
+ * can not be determined, it is moved to `gc.garbage` instead.
+ */
+
+#define NUM_GENERATIONS 3
+
+/* Special values of SbGCHead.gc.refs; nonnegative values are only seen mid-collection. */
+#define GC_REACHABLE                (-3)
+#define GC_TENTATIVELY_UNREACHABLE  (-4)
+
+typedef struct _gc_generation {
+    SbGCHead head;
+    /* Collect when the count goes above this */
+    Sb_ssize_t threshold;
+    /* Generation 0: allocations minus deallocations; others: collections of the younger one */
+    Sb_ssize_t count;
+} gc_generation;
+
+typedef struct _gc_generation_stats {
+    Sb_ssize_t collections;
+    Sb_ssize_t collected;
+    Sb_ssize_t uncollectable;
+} gc_generation_stats;
+
+#define GEN_HEAD(n) (&generations[n].head)
+
+static gc_generation generations[NUM_GENERATIONS] = {
+    { { { GEN_HEAD(0), GEN_HEAD(0), 0 } }, 700, 0 },
+    { { { GEN_HEAD(1), GEN_HEAD(1), 0 } }, 10, 0 },
+    { { { GEN_HEAD(2), GEN_HEAD(2), 0 } }, 10, 0 },
+};
+
+static gc_generation_stats generation_stats[NUM_GENERATIONS];
+
+static int enabled = 1;
+static int collecting = 0;
+
+SbObject *Sb_ModuleGC = NULL;
+SbObject *SbGC_Garbage = NULL;
+
+/*
+ * Object lists
+ */
+
+static void
+gc_list_init(SbGCHead *list)
+{
+    list->gc.prev = list;
+    list->gc.next = list;
+}
+
+static int
+gc_list_is_empty(SbGCHead *list)
+{
+    return list->gc.next == list;
+}
+
+static void
+gc_list_append(SbGCHead *node, SbGCHead *list)
+{
+    node->gc.next = list;
+    node->gc.prev = list->gc.prev;
+    node->gc.prev->gc.next = node;
+    list->gc.prev = node;
+}
+
+static void
+gc_list_remove(SbGCHead *node)
+{
+    node->gc.prev->gc.next = node->gc.next;
+    node->gc.next->gc.prev = node->gc.prev;
+    node->gc.next = NULL;
+}
+
+static void
+gc_list_move(SbGCHead *node, SbGCHead *list)
+{
+    node->gc.prev->gc.next = node->gc.next;
+    node->gc.next->gc.prev = node->gc.prev;
+    gc_list_append(node, list);
+}
+
+/* Append all of `from` to `to`, leaving `from` empty. */
+static void
+gc_list_merge(SbGCHead *from, SbGCHead *to)
+{
+    if (!gc_list_is_empty(from)) {
+        SbGCHead *tail = to->gc.prev;
+
+        tail->gc.next = from->gc.next;
+        tail->gc.next->gc.prev = tail;
+        to->gc.prev = from->gc.prev;
+        to->gc.prev->gc.next = to;
+    }
+    gc_list_init(from);
+}
+
+static Sb_ssize_t
+gc_list_size(SbGCHead *list)
+{
+    SbGCHead *gc;
+    Sb_ssize_t n = 0;
+
+    for (gc = list->gc.next; gc != list; gc = gc->gc.next) {
+        n++;
+    }
+    return n;
+}
+
+#define IS_TRACKED(op) \
+    (SbObject_IS_GC(op) && SbGC_HEAD(op)->gc.next != NULL)
+
+/*
+ * Collection
+ */
+
+/* Start off with each object's own reference count. */
+static void
+update_refs(SbGCHead *containers)
+{
+    SbGCHead *gc;
+
+    for (gc = containers->gc.next; gc != containers; gc = gc->gc.next) {
+        gc->gc.refs = Sb_REFCNT(SbGC_OBJECT(gc));
+    }
+}
+
+static int
+visit_decref(SbObject *op, void *arg)
+{
+    if (IS_TRACKED(op)) {
+        SbGCHead *gc = SbGC_HEAD(op);
+
+        /* Objects outside of the collected set are marked reachable; skip them. */
+        if (gc->gc.refs > 0) {
+            gc->gc.refs--;
+        }
+    }
+    return 0;
+}
+
+/* Take away references held by the objects being collected. */
+static void
+subtract_refs(SbGCHead *containers)
+{
+    SbGCHead *gc;
+
+    for (gc = containers->gc.next; gc != containers; gc = gc->gc.next) {
+        SbObject *op = SbGC_OBJECT(gc);
+
+        Sb_TYPE(op)->tp_traverse(op, visit_decref, NULL);
+    }
+}
+
+static int
+visit_reachable(SbObject *op, void *arg)
+{
+    SbGCHead *reachable = (SbGCHead *)arg;
+
+    if (IS_TRACKED(op)) {
+        SbGCHead *gc = SbGC_HEAD(op);
+
+        if (gc->gc.refs == 0) {
+            /* Not scanned yet; will be, as the scan has not got to it. */
+            gc->gc.refs = 1;
+        }
+        else if (gc->gc.refs == GC_TENTATIVELY_UNREACHABLE) {
+            /* Moved away by mistake; put it back to be scanned again. */
+            gc_list_move(gc, reachable);
+            gc->gc.refs = 1;
+        }
+    }
+    return 0;
+}
+
+/* Move the objects with no outside references, direct or indirect, to `unreachable`. */
+static void
+move_unreachable(SbGCHead *young, SbGCHead *unreachable)
+{
+    SbGCHead *gc;
+    SbGCHead *next;
+
+    gc = young->gc.next;
+    while (gc != young) {
+        if (gc->gc.refs) {
+            SbObject *op = SbGC_OBJECT(gc);
+
+            gc->gc.refs = GC_REACHABLE;
+            Sb_TYPE(op)->tp_traverse(op, visit_reachable, young);
+            next = gc->gc.next;
+        }
+        else {
+            next = gc->gc.next;
+            gc_list_move(gc, unreachable);
+            gc->gc.refs = GC_TENTATIVELY_UNREACHABLE;
+        }
+        gc = next;
+    }
+}
+
+/* Move the unreachable objects with `__del__` to `finalizers`. */
+static void
+move_finalizers(SbGCHead *unreachable, SbGCHead *finalizers)
+{
+    SbGCHead *gc;
+    SbGCHead *next;
+
+    for (gc = unreachable->gc.next; gc != unreachable; gc = next) {
+        next = gc->gc.next;
+        if (Sb_TYPE(SbGC_OBJECT(gc))->tp_flags & SbType_FLAGS_HAS_FINALIZER) {
+            gc_list_move(gc, finalizers);
+            gc->gc.refs = GC_REACHABLE;
+        }
+    }
+}
+
+static int
+visit_move(SbObject *op, void *arg)
+{
+    SbGCHead *to = (SbGCHead *)arg;
+
+    if (IS_TRACKED(op)) {
+        SbGCHead *gc = SbGC_HEAD(op);
+
+        if (gc->gc.refs == GC_TENTATIVELY_UNREACHABLE) {
+            gc_list_move(gc, to);
+            gc->gc.refs = GC_REACHABLE;
+        }
+    }
+    return 0;
+}
+
+/* Move everything reachable from the finalizers to them as well. */
+static void
+move_finalizer_reachable(SbGCHead *finalizers)
+{
+    SbGCHead *gc;
+
+    for (gc = finalizers->gc.next; gc != finalizers; gc = gc->gc.next) {
+        SbObject *op = SbGC_OBJECT(gc);
+
+        Sb_TYPE(op)->tp_traverse(op, visit_move, finalizers);
+    }
+}
+
+/* Expose the objects with finalizers in `gc.garbage`; keep them all in `old`. */
+static void
+handle_finalizers(SbGCHead *finalizers, SbGCHead *old)
+{
+    SbGCHead *gc;
+
+    for (gc = finalizers->gc.next; gc != finalizers; gc = gc->gc.next) {
+        SbObject *op = SbGC_OBJECT(gc);
+
+        if (SbGC_Garbage && (Sb_TYPE(op)->tp_flags & SbType_FLAGS_HAS_FINALIZER)) {
+            if (SbList_Append(SbGC_Garbage, op) < 0) {
+                SbErr_Clear();
+            }
+        }
+    }
+    gc_list_merge(finalizers, old);
+}
+
+/* Break the reference cycles; objects get destroyed as their counts drop. */
+static void
+delete_garbage(SbGCHead *collectable, SbGCHead *old)
+{
+    while (!gc_list_is_empty(collectable)) {
+        SbGCHead *gc = collectable->gc.next;
+        SbObject *op = SbGC_OBJECT(gc);
+        SbClearFunc clear;
+
+        clear = Sb_TYPE(op)->tp_clear;
+        if (clear) {
+            Sb_INCREF(op);
+            clear(op);
+            Sb_DECREF(op);
+        }
+        if (collectable->gc.next == gc) {
+            /* Still alive; something kept it. */
+            gc_list_move(gc, old);
+            gc->gc.refs = GC_REACHABLE;
+        }
+    }
+}
+
+static Sb_ssize_t
+collect(int generation)
+{
+    SbGCHead *young;
+    SbGCHead *old;
+    SbGCHead unreachable;
+    SbGCHead finalizers;
+    SbTypeObject *exc_type;
+    SbObject *exc_value;
+    SbObject *exc_tb;
+    Sb_ssize_t collected;
+    Sb_ssize_t uncollectable;
+    int i;
+
+    collecting = 1;
+    /* NOTE: Finalizers of the garbage may run Python code. */
+    SbErr_Fetch(&exc_type, &exc_value, &exc_tb);
+
+    if (generation + 1 < NUM_GENERATIONS) {
+        generations[generation + 1].count += 1;
+    }
+    for (i = 0; i <= generation; i++) {
+        generations[i].count = 0;
+    }
+
+    young = GEN_HEAD(generation);
+    for (i = 0; i < generation; i++) {
+        gc_list_merge(GEN_HEAD(i), young);
+    }
+    old = generation + 1 < NUM_GENERATIONS ? GEN_HEAD(generation + 1) : young;
+
+    update_refs(young);
+    subtract_refs(young);
+    gc_list_init(&unreachable);
+    move_unreachable(young, &unreachable);
+    if (young != old) {
+        gc_list_merge(young, old);
+    }
+
+    gc_list_init(&finalizers);
+    move_finalizers(&unreachable, &finalizers);
+    move_finalizer_reachable(&finalizers);
+
+    collected = gc_list_size(&unreachable);
+    uncollectable = gc_list_size(&finalizers);
+    handle_finalizers(&finalizers, old);
+    delete_garbage(&unreachable, old);
+
+    generation_stats[generation].collections++;
+    generation_stats[generation].collected += collected;
+    generation_stats[generation].uncollectable += uncollectable;
+
+    SbErr_Restore(exc_type, exc_value, exc_tb);
+    collecting = 0;
+    return collected + uncollectable;
+}
+
+/* Collect the oldest generation whose count went above its threshold. */
+static void
+collect_generations(void)
+{
+    int i;
+
+    for (i = NUM_GENERATIONS - 1; i >= 0; i--) {
+        if (generations[i].count > generations[i].threshold) {
+            collect(i);
+            break;
+        }
+    }
+}
+
+/*
+ * C interface implementations
+ */
+
+SbObject *
+_SbGC_Link(void *block)
+{
+    SbGCHead *gc = (SbGCHead *)block;
+
+    generations[0].count++;
+    if (enabled && !collecting && generations[0].threshold
+        && generations[0].count > generations[0].threshold) {
+        collect_generations();
+    }
+
+    gc->gc.refs = GC_REACHABLE;
+    gc_list_append(gc, GEN_HEAD(0));
+    return SbGC_OBJECT(gc);
+}
+
+void
+_SbGC_Untrack(SbObject *op)
+{
+    SbGCHead *gc = SbGC_HEAD(op);
+
+    if (gc->gc.next) {
+        gc_list_remove(gc);
+    }
+}
+
+void *
+_SbGC_Unlink(void *op)
+{
+    _SbGC_Untrack((SbObject *)op);
+    if (generations[0].count > 0) {
+        generations[0].count--;
+    }
+    return SbGC_HEAD(op);
+}
+
+SbObject *
+SbGC_Alloc(SbTypeObject *type, Sb_ssize_t nitems)
+{
+    void *block;
+    Sb_size_t size;
+
+    size = sizeof(SbGCHead) + type->tp_basicsize + nitems * type->tp_itemsize;
+    block = SbObject_Malloc(size);
+    if (!block) {
+        return SbErr_NoMemory();
+    }
+    SbRT_BZero(block, size);
+
+    return _SbGC_Link(block);
+}
+
+void
+SbGC_Free(void *p)
+{
+    SbObject_Free(_SbGC_Unlink(p));
+}
+
+Sb_ssize_t
+SbGC_Collect(int generation)
+{
+    if (collecting) {
+        return 0;
+    }
+    return collect(generation);
+}
+
+void
+_SbType_EnableGC(SbTypeObject *tp, SbTraverseFunc traverse, SbClearFunc clear)
+{
+    tp->tp_flags |= SbType_FLAGS_HAVE_GC;
+    tp->tp_alloc = SbGC_Alloc;
+    tp->tp_free = SbGC_Free;
+    tp->tp_traverse = traverse;
+    tp->tp_clear = clear;
+}
+
+/*
+ * Python interface
+ */
+
+static SbObject *
+gc_collect(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("|i:generation");
+    SbInt_Native_t generation = NUM_GENERATIONS - 1;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &generation) < 0) {
+        return NULL;
+    }
+    if (generation < 0 || generation >= NUM_GENERATIONS) {
+        SbErr_RaiseWithString(SbExc_ValueError, "invalid generation");
+        return NULL;
+    }
+
+    return SbInt_FromNative(SbGC_Collect((int)generation));
+}
+
+static SbObject *
+gc_enable(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    enabled = 1;
+    Sb_RETURN_NONE;
+}
+
+static SbObject *
+gc_disable(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    enabled = 0;
+    Sb_RETURN_NONE;
+}
+
+static SbObject *
+gc_isenabled(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    return SbBool_FromLong(enabled);
+}
+
+/* Build a tuple holding one int per generation.
+   Returns: New reference or NULL on failure. */
+static SbObject *
+gc_pack_generations(const SbInt_Native_t *values)
+{
+    SbObject *result;
+    SbObject *value;
+    int i;
+
+    result = SbTuple_New(NUM_GENERATIONS);
+    if (!result) {
+        return NULL;
+    }
+    for (i = 0; i < NUM_GENERATIONS; ++i) {
+        value = SbInt_FromNative(values[i]);
+        if (!value) {
+            Sb_DECREF(result);
+            return NULL;
+        }
+        SbTuple_SetItemUnsafe(result, i, value);
+    }
+    return result;
+}
+
+static SbObject *
+gc_get_count(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    SbInt_Native_t counts[NUM_GENERATIONS];
+    int i;
+
+    for (i = 0; i < NUM_GENERATIONS; ++i) {
+        counts[i] = generations[i].count;
+    }
+    return gc_pack_generations(counts);
+}
+
+static SbObject *
+gc_get_threshold(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    SbInt_Native_t thresholds[NUM_GENERATIONS];
+    int i;
+
+    for (i = 0; i < NUM_GENERATIONS; ++i) {
+        thresholds[i] = generations[i].threshold;
+    }
+    return gc_pack_generations(thresholds);
+}
+
+static SbObject *
+gc_set_threshold(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("i:threshold0|i:threshold1,i:threshold2");
+    SbInt_Native_t thresholds[NUM_GENERATIONS];
+    int i;
+
+    for (i = 0; i < NUM_GENERATIONS; i++) {
+        thresholds[i] = generations[i].threshold;
+    }
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &thresholds[0], &thresholds[1], &thresholds[2]) < 0) {
+        return NULL;
+    }
+    for (i = 0; i < NUM_GENERATIONS; i++) {
+        generations[i].threshold = thresholds[i];
+    }
+    Sb_RETURN_NONE;
+}
+
+static int
+set_stat(SbObject *dict, const char *name, Sb_ssize_t value)
+{
+    SbObject *o;
+    int rv;
+
+    o = SbInt_FromNative(value);
+    if (!o) {
+        return -1;
+    }
+    rv = SbDict_SetItemString(dict, name, o);
+    Sb_DECREF(o);
+    return rv;
+}
+
+static SbObject *
+gc_get_stats(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    SbObject *result;
+    int i;
+
+    result = SbList_New(NUM_GENERATIONS);
+    if (!result) {
+        return NULL;
+    }
+    for (i = 0; i < NUM_GENERATIONS; i++) {
+        gc_generation_stats *st = &generation_stats[i];
+        SbObject *dict;
+
+        dict = SbDict_New();
+        if (!dict) {
+            goto fail;
+        }
+        SbList_SetItemUnsafe(result, i, dict);
+        if (set_stat(dict, "collections", st->collections) < 0
+            || set_stat(dict, "collected", st->collected) < 0
+            || set_stat(dict, "uncollectable", st->uncollectable) < 0) {
+            goto fail;
+        }
+    }
+    return result;
+
+fail:
+    Sb_DECREF(result);
+    return NULL;
+}
+
+static const SbCMethodDef gc_functions[] = {
+    { "collect", gc_collect },
+    { "enable", gc_enable },
+    { "disable", gc_disable },
+    { "isenabled", gc_isenabled },
+    { "get_count", gc_get_count },
+    { "get_threshold", gc_get_threshold },
+    { "set_threshold", gc_set_threshold },
+    { "get_stats", gc_get_stats },
+    /* Sentinel */
+    { NULL, NULL },
+};
+
+int
+_Sb_ModuleInit_GC()
+{
+    SbObject *m;
+    SbObject *dict;
+    SbObject *methods;
+
+    m = Sb_InitModule("gc");
+    if (!m) {
+        return -1;
+    }
+    dict = SbModule_GetDict(m);
+
+    methods = _SbType_BuildMethodDict(gc_functions);
+    if (!methods) {
+        return -1;
+    }
+    if (SbDict_Merge(dict, methods, 1) < 0) {
+        Sb_DECREF(methods);
+        return -1;
+    }
+    Sb_DECREF(methods);
+
+    SbGC_Garbage = SbList_New(0);
+    if (!SbGC_Garbage) {
+        return -1;
+    }
+    SbDict_SetItemString(dict, "garbage", SbGC_Garbage);
+    Sb_DECREF(SbGC_Garbage);
+
+    Sb_ModuleGC = m;
+    return 0;
+}
+
+void
+_Sb_ModuleFini_GC()
+{
+    Sb_CLEAR(Sb_ModuleGC);
+    SbGC_Garbage = NULL;
+}
+
+#endif /* SUPPORTS(CYCLE_GC) */
@@ -0,0 +1,65 @@
+#ifndef __SNAKEBED_MODULE_GC_H
+#define __SNAKEBED_MODULE_GC_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Implements the `gc` module and the cycle collector behind it. */
+
+#if SUPPORTS(CYCLE_GC)
+
+/* Precedes every instance of a type with SbType_FLAGS_HAVE_GC. */
+typedef union _SbGCHead {
+    struct {
+        union _SbGCHead *next;
+        union _SbGCHead *prev;
+        Sb_ssize_t refs;
+    } gc;
+    /* Keeps the object that follows suitably aligned. */
+    Sb_long64_t dummy;
+} SbGCHead;
+
+#define SbGC_HEAD(op) \
+    ((SbGCHead *)(op) - 1)
+#define SbGC_OBJECT(g) \
+    ((SbObject *)((SbGCHead *)(g) + 1))
+
+#define SbObject_IS_GC(op) \
+    (Sb_TYPE(op)->tp_flags & SbType_FLAGS_HAVE_GC)
+
+/* The `gc` module itself. */
+extern SbObject *Sb_ModuleGC;
+/* The `gc.garbage` list: unreachable objects with `__del__`, left alone by the collector. */
+extern SbObject *SbGC_Garbage;
+
+/* The tp_alloc/tp_free pair for types with SbType_FLAGS_HAVE_GC.
+   The instance is tracked from the start; this may run a collection. */
+SbObject *
+SbGC_Alloc(SbTypeObject *type, Sb_ssize_t nitems);
+void
+SbGC_Free(void *p);
+
+/* For types keeping their own freelists: turn a zeroed block of
+   sizeof(SbGCHead) + instance size bytes into a tracked instance.
+   This may run a collection. */
+SbObject *
+_SbGC_Link(void *block);
+/* Untrack the instance and return the block it lives in. */
+void *
+_SbGC_Unlink(void *op);
+
+/* Stop tracking the instance; done before it is destroyed. */
+void
+_SbGC_Untrack(SbObject *op);
+
+/* Collect generations 0 through `generation`.
+   Returns: the count of unreachable objects found. */
+Sb_ssize_t
+SbGC_Collect(int generation);
+
+#endif /* SUPPORTS(CYCLE_GC) */
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __SNAKEBED_MODULE_GC_H */
@@ -3,6 +3,9 @@
 
 SbObject *Sb_ModuleSys = NULL;
 SbObject *SbSys_Modules = NULL;
+#if SUPPORTS(IMPORT_STATISTICS)
+SbObject *SbSys_ImportTimes = NULL;
+#endif
 SbObject *SbSys_StdIn = NULL;
 SbObject *SbSys_StdOut = NULL;
 SbObject *SbSys_StdErr = NULL;
@@ -52,6 +55,49 @@ _sys_exit(SbObject *self, SbObject *args, SbObject *kwargs)
     return NULL;
 }
 
+#if SUPPORTS(SMALL_OBJECT_ALLOCATOR) && SUPPORTS(ALLOC_STATISTICS)
+static int
+set_stat(SbObject *dict, const char *name, Sb_size_t value)
+{
+    SbObject *o;
+    int rv;
+
+    o = SbInt_FromNative((SbInt_Native_t)value);
+    if (!o) {
+        return -1;
+    }
+    rv = SbDict_SetItemString(dict, name, o);
+    Sb_DECREF(o);
+    return rv;
+}
+
+/* Reports the small object allocator state; the difference between
+   `pool_bytes` and `block_bytes` is what fragmentation costs. */
+static SbObject *
+_sys_getallocstats(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    SbRT_ObjAllocStats stats;
+    SbObject *dict;
+
+    SbRT_ObjAllocGetStats(&stats);
+    dict = SbDict_New();
+    if (!dict) {
+        return NULL;
+    }
+    if (set_stat(dict, "arenas", stats.arenas) < 0
+        || set_stat(dict, "arenas_allocated", stats.arenas_allocated) < 0
+        || set_stat(dict, "arenas_released", stats.arenas_released) < 0
+        || set_stat(dict, "pools", stats.pools) < 0
+        || set_stat(dict, "pool_bytes", stats.pool_bytes) < 0
+        || set_stat(dict, "blocks", stats.blocks) < 0
+        || set_stat(dict, "block_bytes", stats.block_bytes) < 0) {
+        Sb_DECREF(dict);
+        return NULL;
+    }
+    return dict;
+}
+#endif
+
 static int
 add_func(SbObject *dict, const char *name, SbCFunction func)
 {
@@ -74,6 +120,7 @@ _Sb_ModuleInit_Sys()
     SbObject *m;
     SbObject *dict;
     SbObject *o;
+    SbObject *path;
 
     /* Needs to be available beforehand. */
     o = SbDict_New();
@@ -117,8 +164,34 @@ _Sb_ModuleInit_Sys()
     SbDict_SetItemString(dict, "modules", SbSys_Modules);
     Sb_DECREF(SbSys_Modules);
 
+    /* An empty entry stands for the current directory. */
+    o = SbStr_FromString("");
+    if (!o) {
+        return -1;
+    }
+    path = SbList_Pack(1, o);
+    if (!path) {
+        Sb_DECREF(o);
+        return -1;
+    }
+    SbDict_SetItemString(dict, "path", path);
+    Sb_DECREF(path);
+
+#if SUPPORTS(IMPORT_STATISTICS)
+    o = SbDict_New();
+    if (!o) {
+        return -1;
+    }
+    SbDict_SetItemString(dict, "import_times", o);
+    Sb_DECREF(o);
+    SbSys_ImportTimes = o;
+#endif
+
     add_func(dict, "exc_info", exc_info);
     add_func(dict, "exit", _sys_exit);
+#if SUPPORTS(SMALL_OBJECT_ALLOCATOR) && SUPPORTS(ALLOC_STATISTICS)
+    add_func(dict, "getallocstats", _sys_getallocstats);
+#endif
 
     Sb_ModuleSys = m;
     return 0;
@@ -133,6 +206,9 @@ _Sb_ModuleFini_Sys()
     dict = SbModule_GetDict(Sb_ModuleSys);
     SbDict_DelItemString(dict, "modules");
     Sb_CLEAR(Sb_ModuleSys);
+#if SUPPORTS(IMPORT_STATISTICS)
+    SbSys_ImportTimes = NULL;
+#endif
     SbSys_StdIn = NULL;
     SbSys_StdOut = NULL;
     SbSys_StdErr = NULL;
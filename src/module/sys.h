@@ -10,6 +10,11 @@ extern "C" {
 extern SbObject *Sb_ModuleSys;
 /* The `sys.modules` attribute. */
 extern SbObject *SbSys_Modules;
+#if SUPPORTS(IMPORT_STATISTICS)
+/* The `sys.import_times` attribute: microseconds spent loading each module,
+   nested imports included. */
+extern SbObject *SbSys_ImportTimes;
+#endif
 /* The `sys.stdin` and friends. */
 extern SbObject *SbSys_StdIn;
 extern SbObject *SbSys_StdOut;
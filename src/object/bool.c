@@ -32,9 +32,20 @@ bool_new(long val)
     return (SbObject *)myself;
 }
 
+/* Python accessible methods */
+
+static SbObject *
+bool_str(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    return SbStr_FromString(self == Sb_True ? "True" : "False");
+}
+
 /* Type initializer */
 
 static const SbCMethodDef bool_methods[] = {
+    { "__str__", bool_str },
+    { "__repr__", bool_str },
+
     /* Sentinel */
     { NULL, NULL },
 };
@@ -43,8 +54,9 @@ int
 _Sb_TypeInit_Bool()
 {
     SbTypeObject *tp;
+    SbObject *dict;
 
-    tp = _SbType_FromCDefs("bool", SbInt_Type, bool_methods, sizeof(SbBoolObject));
+    tp = _SbType_FromCDefs("bool", SbInt_Type, NULL, sizeof(SbBoolObject));
     if (!tp) {
         return -1;
     }
@@ -53,5 +65,21 @@ _Sb_TypeInit_Bool()
 
     Sb_False = bool_new(0);
     Sb_True = bool_new(1);
+    if (!Sb_False || !Sb_True) {
+        return -1;
+    }
+    Sb_SET_IMMORTAL(Sb_False);
+    Sb_SET_IMMORTAL(Sb_True);
+
+    /* Overriding int methods compares their names, which needs the singletons above. */
+    dict = _SbType_BuildMethodDict(bool_methods);
+    if (!dict) {
+        return -1;
+    }
+    if (SbDict_Merge(tp->tp_dict, dict, 1) < 0) {
+        Sb_DECREF(dict);
+        return -1;
+    }
+    Sb_DECREF(dict);
     return 0;
 }
@@ -30,6 +30,7 @@ _SbNone_BuiltinInit()
     if (!Sb_None) {
         return -1;
     }
+    Sb_SET_IMMORTAL(Sb_None);
 
     return 0;
 }
@@ -63,6 +64,7 @@ _SbNotImplemented_BuiltinInit()
     if (!Sb_NotImplemented) {
         return -1;
     }
+    Sb_SET_IMMORTAL(Sb_NotImplemented);
 
     return 0;
 }
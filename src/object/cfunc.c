@@ -58,6 +58,7 @@ _Sb_TypeInit_CFunction()
     if (!tp) {
         return -1;
     }
+    Sb_SET_IMMORTAL(tp);
 
     tp->tp_basicsize = sizeof(SbCFunctionObject);
     tp->tp_destroy = SbObject_DefaultDestroy;
@@ -11,13 +11,28 @@ The implementation is your good old hash table. Since the hash function
 is believed to be "random enough", the bucket count is chosen to be
 a power of 2, to avoid high cost modulo when looking up the bucket.
 
+Small dicts keep their buckets inside the object. Once there are more
+entries than buckets, the table doubles and the entries are relinked;
+each entry remembers its hash, so nothing is hashed again. Callers that
+know the final size up front can skip the growth with SbDict_NewPresized().
+
+Instances of one class tend to have the same attribute names, so their
+dicts can be split: the class owns the keys (SbDictSharedKeys), and each
+instance dict only holds its values, indexed by the key's slot. Up to
+DICT_MINSIZE values fit in the space of the inline buckets. A split dict
+turns into a plain one when it gets a non-str key, or a key that does
+not fit the shared keys any more.
+
 Memory costs estimate (32-bit systems):
-- Base object: sizeof(void *) * (2 + 1 + BUCKET_COUNT) = sizeof(void *) * 35 = 140
+- Base object: sizeof(void *) * (2 + 5 + DICT_MINSIZE) = sizeof(void *) * 15 = 60
+- Table, when grown: sizeof(void *) * bucket count
 - Each entry: sizeof(void *) * 4 = 16
+- Split dict values beyond DICT_MINSIZE: sizeof(void *) * DICT_SHARED_MAX = 64
 
 */
 
-#define BUCKET_COUNT 32U
+#define DICT_MINSIZE 8U
+#define DICT_SHARED_MAX 16
 
 typedef struct _bucket_entry {
     struct _bucket_entry *e_next;
@@ -26,13 +41,35 @@ typedef struct _bucket_entry {
     SbObject *e_value;
 } bucket_entry;
 
+/* Keys shared by the instance dicts of one class.
+   Keys are only ever appended, so a key keeps its slot for as long as the table lives. */
+struct _SbDictSharedKeys {
+    Sb_ssize_t refcount;
+    Sb_ssize_t count;
+    long hashes[DICT_SHARED_MAX];
+    SbObject *keys[DICT_SHARED_MAX];
+};
+
 /* Define the dict object structure. */
 struct _SbDictObject {
     SbObject_HEAD;
     Sb_ssize_t count;
-    bucket_entry *buckets[BUCKET_COUNT];
+    /* Bucket count minus one */
+    Sb_size_t mask;
+    bucket_entry **buckets;
+    /* If not NULL, the dict is split: `values` holds the value for each
+       slot of `shared`, and there is no bucket table. */
+    SbDictSharedKeys *shared;
+    SbObject **values;
+    union {
+        bucket_entry *buckets[DICT_MINSIZE];
+        SbObject *values[DICT_MINSIZE];
+    } small;
 };
 
+#define DICT_IS_SPLIT(op) \
+    ((op)->shared != NULL)
+
 /* Keep the type object here. */
 SbTypeObject *SbDict_Type = NULL;
 
@@ -40,14 +77,250 @@ SbTypeObject *SbDict_Type = NULL;
  * C interface implementations
  */
 
+static void
+dict_link_entry(SbDictObject *op, bucket_entry *entry);
+
+static void
+dict_init_table(SbDictObject *op)
+{
+    op->mask = DICT_MINSIZE - 1;
+    op->buckets = op->small.buckets;
+}
+
+/* Compute the bucket count that holds `count` entries without growing. */
+static Sb_size_t
+dict_size_for(Sb_ssize_t count)
+{
+    Sb_size_t size = DICT_MINSIZE;
+
+    while (size < (Sb_size_t)count) {
+        size <<= 1;
+    }
+    return size;
+}
+
+/* Relink all entries into a fresh table of `new_size` buckets.
+   Returns: 0 if OK, -1 if out of memory (the old table is kept). */
+static int
+dict_resize(SbDictObject *op, Sb_size_t new_size)
+{
+    bucket_entry **new_buckets;
+    Sb_size_t new_mask = new_size - 1;
+    Sb_size_t bucket;
+
+    new_buckets = (bucket_entry **)Sb_Calloc(new_size, sizeof(bucket_entry *));
+    if (!new_buckets) {
+        return -1;
+    }
+    for (bucket = 0; bucket <= op->mask; ++bucket) {
+        bucket_entry *entry;
+
+        while ((entry = op->buckets[bucket]) != NULL) {
+            bucket_entry **link;
+
+            op->buckets[bucket] = entry->e_next;
+            link = &new_buckets[((unsigned long)entry->e_hash) & new_mask];
+            entry->e_next = *link;
+            *link = entry;
+        }
+    }
+    if (op->buckets != op->small.buckets) {
+        Sb_Free(op->buckets);
+    }
+    op->buckets = new_buckets;
+    op->mask = new_mask;
+    return 0;
+}
+
+/* Make sure `count` entries fit without further growth.
+   Failing to grow is not an error -- the chains just get longer. */
+static void
+dict_reserve(SbDictObject *op, Sb_ssize_t count)
+{
+    if ((Sb_size_t)count > op->mask + 1) {
+        dict_resize(op, dict_size_for(count));
+    }
+}
+
+SbDictSharedKeys *
+_SbDictSharedKeys_New(void)
+{
+    SbDictSharedKeys *keys;
+
+    keys = (SbDictSharedKeys *)Sb_Malloc(sizeof(*keys));
+    if (!keys) {
+        SbErr_NoMemory();
+        return NULL;
+    }
+    keys->refcount = 1;
+    keys->count = 0;
+    return keys;
+}
+
+void
+_SbDictSharedKeys_Release(SbDictSharedKeys *keys)
+{
+    Sb_ssize_t slot;
+
+    if (--keys->refcount > 0) {
+        return;
+    }
+    for (slot = 0; slot < keys->count; ++slot) {
+        Sb_DECREF(keys->keys[slot]);
+    }
+    Sb_Free(keys);
+}
+
+/* Find the slot of a string key of known length and hash.
+   Returns: the slot, or -1 if the key is not shared. */
+static Sb_ssize_t
+shared_find_string(SbDictSharedKeys *keys, const char *key, Sb_ssize_t length, long hash)
+{
+    Sb_ssize_t slot;
+
+    for (slot = 0; slot < keys->count; ++slot) {
+        if (keys->hashes[slot] == hash) {
+            SbObject *s_key = keys->keys[slot];
+
+            if (SbStr_GetSizeUnsafe(s_key) == length
+                && SbRT_MemCmp(SbStr_AsStringUnsafe(s_key), key, length) == 0) {
+                return slot;
+            }
+        }
+    }
+    return -1;
+}
+
+/* How many slots a split dict has room for. */
+static Sb_ssize_t
+dict_values_capacity(SbDictObject *op)
+{
+    Sb_ssize_t capacity;
+
+    capacity = op->values == op->small.values ? DICT_MINSIZE : DICT_SHARED_MAX;
+    return capacity < op->shared->count ? capacity : op->shared->count;
+}
+
+/* Obtain the value of a split dict at `slot`, which may be -1. */
+static SbObject *
+dict_split_value(SbDictObject *op, Sb_ssize_t slot)
+{
+    return slot >= 0 && slot < dict_values_capacity(op) ? op->values[slot] : NULL;
+}
+
+/* Find the slot of any key in a split dict.
+   Returns: the slot, or -1 if the key is not there. */
+static Sb_ssize_t
+dict_split_lookup(SbDictObject *op, SbObject *key, long hash)
+{
+    Sb_ssize_t capacity;
+    Sb_ssize_t slot;
+
+    if (SbStr_CheckExact(key)) {
+        return shared_find_string(op->shared, SbStr_AsStringUnsafe(key), SbStr_GetSizeUnsafe(key), hash);
+    }
+    capacity = dict_values_capacity(op);
+    for (slot = 0; slot < capacity; ++slot) {
+        if (op->values[slot] && op->shared->hashes[slot] == hash) {
+            if (SbObject_CompareBool(op->shared->keys[slot], key, Sb_EQ) == 1) {
+                return slot;
+            }
+        }
+    }
+    return -1;
+}
+
+/* Move the items of a split dict into a bucket table of its own.
+   Returns: 0 if OK, -1 otherwise. */
+static int
+dict_unshare(SbDictObject *op)
+{
+    SbDictSharedKeys *keys = op->shared;
+    bucket_entry *entries = NULL;
+    bucket_entry *entry;
+    Sb_ssize_t capacity;
+    Sb_ssize_t slot;
+
+    /* Allocate all entries first, so running out of memory leaves the dict as it was. */
+    capacity = dict_values_capacity(op);
+    for (slot = 0; slot < capacity; ++slot) {
+        if (!op->values[slot]) {
+            continue;
+        }
+        entry = (bucket_entry *)SbObject_Malloc(sizeof(*entry));
+        if (!entry) {
+            while ((entry = entries) != NULL) {
+                entries = entry->e_next;
+                SbObject_Free(entry);
+            }
+            SbErr_NoMemory();
+            return -1;
+        }
+        entry->e_key = keys->keys[slot];
+        Sb_INCREF(entry->e_key);
+        /* The reference to the value moves over. */
+        entry->e_value = op->values[slot];
+        entry->e_hash = keys->hashes[slot];
+        entry->e_next = entries;
+        entries = entry;
+    }
+
+    if (op->values != op->small.values) {
+        Sb_Free(op->values);
+    }
+    op->values = NULL;
+    op->shared = NULL;
+    _SbDictSharedKeys_Release(keys);
+
+    SbRT_BZero(op->small.buckets, sizeof(op->small.buckets));
+    dict_init_table(op);
+    op->count = 0;
+    while ((entry = entries) != NULL) {
+        entries = entry->e_next;
+        dict_link_entry(op, entry);
+    }
+    return 0;
+}
+
 SbObject *
 SbDict_New(void)
 {
     SbObject *p;
 
+    p = SbObject_New(SbDict_Type);
+    if (p) {
+        dict_init_table((SbDictObject *)p);
+    }
+    return p;
+}
+
+SbObject *
+_SbDict_NewSplit(SbDictSharedKeys *keys)
+{
+    SbObject *p;
+
     p = SbObject_New(SbDict_Type);
     if (p) {
         SbDictObject *op = (SbDictObject *)p;
+
+        ++keys->refcount;
+        op->shared = keys;
+        op->values = op->small.values;
+    }
+    return p;
+}
+
+SbObject *
+SbDict_NewPresized(Sb_ssize_t size)
+{
+    SbObject *p;
+
+    p = SbDict_New();
+    if (p && (Sb_size_t)size > DICT_MINSIZE) {
+        if (dict_resize((SbDictObject *)p, dict_size_for(size)) < 0) {
+            Sb_DECREF(p);
+            return SbErr_NoMemory();
+        }
     }
     return p;
 }
@@ -59,6 +332,40 @@ dict_destroy(SbDictObject *self)
     SbObject_DefaultDestroy((SbObject *)self);
 }
 
+static int
+dict_traverse(SbDictObject *self, SbVisitFunc visit, void *arg)
+{
+    Sb_size_t bucket;
+
+    if (DICT_IS_SPLIT(self)) {
+        Sb_ssize_t capacity = dict_values_capacity(self);
+        Sb_ssize_t slot;
+
+        /* Keys belong to the shared table. */
+        for (slot = 0; slot < capacity; ++slot) {
+            Sb_VISIT(self->values[slot]);
+        }
+        return 0;
+    }
+
+    for (bucket = 0; bucket <= self->mask; ++bucket) {
+        bucket_entry *entry;
+
+        for (entry = self->buckets[bucket]; entry; entry = entry->e_next) {
+            Sb_VISIT(entry->e_key);
+            Sb_VISIT(entry->e_value);
+        }
+    }
+    return 0;
+}
+
+static int
+dict_clear(SbDictObject *self)
+{
+    _SbDict_Clear(self);
+    return 0;
+}
+
 Sb_ssize_t
 SbDict_GetSize(SbObject *p)
 {
@@ -81,21 +388,54 @@ SbDict_GetSizeUnsafe(SbObject *p)
 void
 _SbDict_Clear(SbDictObject *myself)
 {
-    Sb_ssize_t bucket;
+    Sb_size_t bucket;
+
+    if (DICT_IS_SPLIT(myself)) {
+        SbDictSharedKeys *keys = myself->shared;
+        Sb_ssize_t capacity = dict_values_capacity(myself);
+        SbObject *small_values[DICT_MINSIZE];
+        SbObject **values = myself->values;
+        Sb_ssize_t slot;
+
+        /* Detach the values before releasing any: a finalizer may come back to this dict. */
+        if (values == myself->small.values) {
+            SbRT_MemCpy(small_values, values, sizeof(small_values));
+            values = small_values;
+        }
+        myself->values = NULL;
+        myself->shared = NULL;
+
+        /* A cleared dict starts over as a plain one. */
+        SbRT_BZero(myself->small.buckets, sizeof(myself->small.buckets));
+        dict_init_table(myself);
+        myself->count = 0;
+
+        for (slot = 0; slot < capacity; ++slot) {
+            Sb_XDECREF(values[slot]);
+        }
+        if (values != small_values) {
+            Sb_Free(values);
+        }
+        _SbDictSharedKeys_Release(keys);
+        return;
+    }
 
-    for (bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+    for (bucket = 0; bucket <= myself->mask; ++bucket) {
         bucket_entry *entry;
 
-        entry = myself->buckets[bucket];
-        while (entry) {
+        while ((entry = myself->buckets[bucket]) != NULL) {
             myself->buckets[bucket] = entry->e_next;
             Sb_DECREF(entry->e_key);
             Sb_DECREF(entry->e_value);
-            entry = entry->e_next;
+            SbObject_Free(entry);
         }
     }
 
     myself->count = 0;
+    if (myself->buckets != myself->small.buckets) {
+        Sb_Free(myself->buckets);
+        dict_init_table(myself);
+    }
 }
 
 void
@@ -114,38 +454,88 @@ SbDict_Clear(SbObject *p)
 static bucket_entry **
 dict_bucket_ptr(SbDictObject *op, long hash)
 {
-    return &op->buckets[((unsigned long)hash) % BUCKET_COUNT];
+    return &op->buckets[((unsigned long)hash) & op->mask];
 }
 
-static SbObject *
-dict_getitem_common(SbDictObject *myself, long hash, void *key, int (*cmp)(SbObject *e_key, void *key))
+/* Link in a new entry, growing the table once entries outnumber buckets. */
+static void
+dict_link_entry(SbDictObject *op, bucket_entry *entry)
+{
+    bucket_entry **link;
+
+    link = dict_bucket_ptr(op, entry->e_hash);
+    entry->e_next = *link;
+    *link = entry;
+    op->count++;
+    if ((Sb_size_t)op->count > op->mask + 1) {
+        dict_resize(op, (op->mask + 1) << 1);
+    }
+}
+
+/* Find the entry keyed by an object of known hash.
+   Returns: the link pointing at the entry, or NULL if there is none. */
+static bucket_entry **
+dict_lookup(SbDictObject *myself, SbObject *key, long hash)
 {
+    bucket_entry **link;
     bucket_entry *entry;
 
-    entry = *dict_bucket_ptr(myself, hash);
-    while (entry) {
+    link = dict_bucket_ptr(myself, hash);
+    while ((entry = *link) != NULL) {
         if (entry->e_hash == hash) {
-            if (cmp(entry->e_key, key)) {
-                return entry->e_value;
+            if (entry->e_key == key || SbObject_CompareBool(entry->e_key, key, Sb_EQ) == 1) {
+                return link;
             }
         }
-        entry = entry->e_next;
+        link = &entry->e_next;
     }
+    return NULL;
+}
+
+/* Find the entry keyed by a string of known length and hash.
+   Returns: the link pointing at the entry, or NULL if there is none. */
+static bucket_entry **
+dict_lookup_string(SbDictObject *myself, const char *key, Sb_ssize_t length, long hash)
+{
+    bucket_entry **link;
+    bucket_entry *entry;
 
+    link = dict_bucket_ptr(myself, hash);
+    while ((entry = *link) != NULL) {
+        if (entry->e_hash == hash) {
+            SbObject *e_key = entry->e_key;
+
+            if (SbStr_CheckExact(e_key)
+                && SbStr_GetSizeUnsafe(e_key) == length
+                && SbRT_MemCmp(SbStr_AsStringUnsafe(e_key), key, length) == 0) {
+                return link;
+            }
+        }
+        link = &entry->e_next;
+    }
     return NULL;
 }
 
-static int
-dict_getitemstring_cmp(SbObject *e_key, void *key)
+long
+_SbDictKey_ComputeHash(SbDictKey *key)
 {
-    return SbStr_CheckExact(e_key) && _SbStr_EqString(e_key, (const char *)key) == 1;
+    key->hash = _SbStr_HashString((const Sb_byte_t *)key->text, key->length);
+    return key->hash;
 }
 
 SbObject *
 SbDict_GetItemString(SbObject *p, const char *key)
 {
-    SbDictObject *myself = (SbDictObject *)p;
-    long hash;
+    Sb_ssize_t length;
+
+    length = SbRT_StrLen(key);
+    return _SbDict_GetItemStringKnownHash(p, key, length, _SbStr_HashString(key, length));
+}
+
+SbObject *
+_SbDict_GetItemStringKnownHash(SbObject *p, const char *key, Sb_ssize_t length, long hash)
+{
+    bucket_entry **link;
 
 #if SUPPORTS(BUILTIN_TYPECHECKS)
     if (!SbDict_CheckExact(p)) {
@@ -154,20 +544,32 @@ SbDict_GetItemString(SbObject *p, const char *key)
     }
 #endif
 
-    hash = _SbStr_HashString(key, SbRT_StrLen(key));
-    return dict_getitem_common(myself, hash, (void *)key, dict_getitemstring_cmp);
+    if (DICT_IS_SPLIT((SbDictObject *)p)) {
+        SbDictObject *op = (SbDictObject *)p;
+
+        return dict_split_value(op, shared_find_string(op->shared, key, length, hash));
+    }
+    link = dict_lookup_string((SbDictObject *)p, key, length, hash);
+    return link ? (*link)->e_value : NULL;
 }
 
-static int
-dict_getitem_cmp(SbObject *e_key, void *key)
+SbObject *
+SbDict_GetItemKey(SbObject *p, SbDictKey *key)
 {
-    return SbObject_CompareBool(e_key, (SbObject *)key, Sb_EQ) == 1;
+    return _SbDict_GetItemStringKnownHash(p, key->text, key->length, SbDictKey_Hash(key));
+}
+
+SbObject *
+_SbDict_GetItemStr(SbObject *p, SbObject *key)
+{
+    return _SbDict_GetItemStringKnownHash(p, SbStr_AsStringUnsafe(key), SbStr_GetSizeUnsafe(key), _SbStr_Hash(key));
 }
 
 SbObject *
 SbDict_GetItem(SbObject *p, SbObject *key)
 {
     SbDictObject *myself = (SbDictObject *)p;
+    bucket_entry **link;
     long hash;
 
 #if SUPPORTS(BUILTIN_TYPECHECKS)
@@ -178,20 +580,87 @@ SbDict_GetItem(SbObject *p, SbObject *key)
 #endif
 
     hash = SbObject_Hash(key);
-    if (hash != -1) {
-        return dict_getitem_common(myself, hash, key, dict_getitem_cmp);
+    if (hash == -1) {
+        return NULL;
     }
-    return NULL;
+    if (DICT_IS_SPLIT(myself)) {
+        return dict_split_value(myself, dict_split_lookup(myself, key, hash));
+    }
+    link = dict_lookup(myself, key, hash);
+    return link ? (*link)->e_value : NULL;
 }
 
 
-int
-SbDict_SetItemString(SbObject *p, const char *key, SbObject *value)
+/* Make up a str key for a new entry, or take a reference to `o_key`. */
+static SbObject *
+dict_make_key(const char *key, Sb_ssize_t length, long hash, SbObject *o_key)
+{
+    if (o_key) {
+        Sb_INCREF(o_key);
+        return o_key;
+    }
+    o_key = SbStr_FromStringAndSize(key, length);
+    if (o_key) {
+        ((SbStrObject *)o_key)->stored_hash = hash;
+    }
+    return o_key;
+}
+
+/* Insert into a split dict by a string key of known length and hash.
+   Returns: 0 if OK, 1 if the key does not fit the shared keys, -1 otherwise. */
+static int
+dict_split_setitem_string(SbDictObject *op, const char *key, Sb_ssize_t length, long hash, SbObject *o_key, SbObject *value)
+{
+    SbDictSharedKeys *keys = op->shared;
+    SbObject *old_value;
+    Sb_ssize_t slot;
+
+    slot = shared_find_string(keys, key, length, hash);
+    if (slot < 0) {
+        if (keys->count == DICT_SHARED_MAX) {
+            return 1;
+        }
+        o_key = dict_make_key(key, length, hash, o_key);
+        if (!o_key) {
+            return -1;
+        }
+        slot = keys->count++;
+        keys->keys[slot] = o_key;
+        keys->hashes[slot] = hash;
+    }
+    if (slot >= DICT_MINSIZE && op->values == op->small.values) {
+        SbObject **values;
+
+        values = (SbObject **)Sb_Calloc(DICT_SHARED_MAX, sizeof(SbObject *));
+        if (!values) {
+            SbErr_NoMemory();
+            return -1;
+        }
+        SbRT_MemCpy(values, op->small.values, sizeof(op->small.values));
+        SbRT_BZero(op->small.values, sizeof(op->small.values));
+        op->values = values;
+    }
+
+    old_value = op->values[slot];
+    Sb_INCREF(value);
+    op->values[slot] = value;
+    if (old_value) {
+        Sb_DECREF(old_value);
+    }
+    else {
+        op->count++;
+    }
+    return 0;
+}
+
+/* Insert by a string key of known length and hash.
+   If `o_key` is NULL, a str key is made up from `key` when the entry is new. */
+static int
+dict_setitem_string(SbObject *p, const char *key, Sb_ssize_t length, long hash, SbObject *o_key, SbObject *value)
 {
     SbDictObject *myself = (SbDictObject *)p;
+    bucket_entry **link;
     bucket_entry *entry;
-    bucket_entry **bucket;
-    long hash;
 
 #if SUPPORTS(BUILTIN_TYPECHECKS)
     if (!SbDict_CheckExact(p)) {
@@ -200,53 +669,105 @@ SbDict_SetItemString(SbObject *p, const char *key, SbObject *value)
     }
 #endif
 
-    Sb_INCREF(value);
-
-    hash = _SbStr_HashString(key, SbRT_StrLen(key));
-    bucket = dict_bucket_ptr(myself, hash);
-    entry = *bucket;
-    while (entry) {
-        if (entry->e_hash == hash) {
-            SbObject *o_key = entry->e_key;
+    if (DICT_IS_SPLIT(myself)) {
+        int result;
 
-            if (SbStr_CheckExact(o_key) && _SbStr_EqString(o_key, key) == 1) {
-                Sb_CLEAR(entry->e_value);
-                entry->e_value = value;
-                return 0;
-            }
+        result = dict_split_setitem_string(myself, key, length, hash, o_key, value);
+        if (result <= 0) {
+            return result;
+        }
+        if (dict_unshare(myself) < 0) {
+            return -1;
         }
-        entry = entry->e_next;
     }
 
-    entry = (bucket_entry *)Sb_Malloc(sizeof(*entry));
+    link = dict_lookup_string(myself, key, length, hash);
+    if (link) {
+        SbObject *old_value;
+
+        entry = *link;
+        old_value = entry->e_value;
+        Sb_INCREF(value);
+        entry->e_value = value;
+        Sb_DECREF(old_value);
+        return 0;
+    }
+
+    entry = (bucket_entry *)SbObject_Malloc(sizeof(*entry));
     if (!entry) {
         SbErr_NoMemory();
-        goto fail0;
+        return -1;
     }
-    entry->e_key = SbStr_FromString(key);
-    if (!entry->e_key) {
-        SbErr_NoMemory();
-        goto fail1;
+    o_key = dict_make_key(key, length, hash, o_key);
+    if (!o_key) {
+        SbObject_Free(entry);
+        return -1;
     }
+    Sb_INCREF(value);
+    entry->e_key = o_key;
     entry->e_value = value;
     entry->e_hash = hash;
-    entry->e_next = *bucket;
-    *bucket = entry;
-    myself->count++;
+    dict_link_entry(myself, entry);
     return 0;
+}
 
-fail1:
-    Sb_Free(entry);
-fail0:
-    return -1;
+int
+SbDict_SetItemString(SbObject *p, const char *key, SbObject *value)
+{
+    Sb_ssize_t length;
+
+    length = SbRT_StrLen(key);
+    return dict_setitem_string(p, key, length, _SbStr_HashString(key, length), NULL, value);
 }
 
 int
-SbDict_SetItem(SbObject *p, SbObject *key, SbObject *value)
+SbDict_SetItemKey(SbObject *p, SbDictKey *key, SbObject *value)
 {
-    SbDictObject *myself = (SbDictObject *)p;
+    return dict_setitem_string(p, key->text, key->length, SbDictKey_Hash(key), NULL, value);
+}
+
+int
+_SbDict_SetItemStr(SbObject *p, SbObject *key, SbObject *value)
+{
+    return dict_setitem_string(p, SbStr_AsStringUnsafe(key), SbStr_GetSizeUnsafe(key), _SbStr_Hash(key), key, value);
+}
+
+/* Insert by an object key of known hash. */
+static int
+dict_setitem_known_hash(SbDictObject *myself, SbObject *key, long hash, SbObject *value)
+{
+    bucket_entry **link;
     bucket_entry *entry;
-    bucket_entry **bucket;
+
+    link = dict_lookup(myself, key, hash);
+    if (link) {
+        SbObject *old_value;
+
+        entry = *link;
+        old_value = entry->e_value;
+        Sb_INCREF(value);
+        entry->e_value = value;
+        Sb_DECREF(old_value);
+        return 0;
+    }
+
+    entry = (bucket_entry *)SbObject_Malloc(sizeof(*entry));
+    if (!entry) {
+        SbErr_NoMemory();
+        return -1;
+    }
+    Sb_INCREF(key);
+    Sb_INCREF(value);
+    entry->e_key = key;
+    entry->e_value = value;
+    entry->e_hash = hash;
+    dict_link_entry(myself, entry);
+    return 0;
+}
+
+int
+SbDict_SetItem(SbObject *p, SbObject *key, SbObject *value)
+{
     long hash;
 
 #if SUPPORTS(BUILTIN_TYPECHECKS)
@@ -256,49 +777,31 @@ SbDict_SetItem(SbObject *p, SbObject *key, SbObject *value)
     }
 #endif
 
-    Sb_INCREF(value);
-
-    hash = SbObject_Hash(key);
-    if (hash == -1) {
-        return -1;
-    }
-    bucket = dict_bucket_ptr(myself, hash);
-    entry = *bucket;
-    while (entry) {
-        if (entry->e_hash == hash) {
-            if (SbObject_CompareBool(entry->e_key, key, Sb_EQ) == 1) {
-                Sb_CLEAR(entry->e_value);
-                entry->e_value = value;
-                return 0;
-            }
+    if (DICT_IS_SPLIT((SbDictObject *)p)) {
+        if (SbStr_CheckExact(key)) {
+            return _SbDict_SetItemStr(p, key, value);
+        }
+        if (dict_unshare((SbDictObject *)p) < 0) {
+            return -1;
         }
-        entry = entry->e_next;
     }
 
-    entry = (bucket_entry *)Sb_Malloc(sizeof(*entry));
-    if (!entry) {
-        SbErr_NoMemory();
+    hash = SbObject_Hash(key);
+    if (hash == -1) {
         return -1;
     }
-    Sb_INCREF(key);
-    entry->e_key = key;
-    entry->e_value = value;
-    entry->e_hash = hash;
-    entry->e_next = *bucket;
-    *bucket = entry;
-    myself->count++;
-    return 0;
+    return dict_setitem_known_hash((SbDictObject *)p, key, hash, value);
 }
 
 
-int
-SbDict_DelItemString(SbObject *p, const char *key)
+/* Delete by a string key of known length and hash.
+   If `o_key` is not NULL, it is the key reported in the KeyError. */
+static int
+dict_delitem_string(SbObject *p, const char *key, Sb_ssize_t length, long hash, SbObject *o_key)
 {
     SbDictObject *myself = (SbDictObject *)p;
+    bucket_entry **link;
     bucket_entry *entry;
-    bucket_entry **bucket;
-    long hash;
-    bucket_entry *prev_entry;
 
 #if SUPPORTS(BUILTIN_TYPECHECKS)
     if (!SbDict_CheckExact(p)) {
@@ -307,30 +810,66 @@ SbDict_DelItemString(SbObject *p, const char *key)
     }
 #endif
 
-    hash = _SbStr_HashString(key, SbRT_StrLen(key));
-    bucket = dict_bucket_ptr(myself, hash);
-    entry = *bucket;
-    /* This exploits the fact that e_next is located at offset zero in entry. */
-    prev_entry = (bucket_entry *)bucket;
-    while (entry) {
-        if (entry->e_hash == hash) {
-            SbObject *o_key = entry->e_key;
-
-            if (SbStr_CheckExact(o_key) && _SbStr_EqString(o_key, key) == 1) {
-                prev_entry->e_next = entry->e_next;
-                /* Safe to decref -- the entry is no longer in. */
-                Sb_DECREF(entry->e_key);
-                Sb_DECREF(entry->e_value);
-                myself->count--;
-                return 0;
+    if (DICT_IS_SPLIT(myself)) {
+        SbObject *old_value;
+        Sb_ssize_t slot;
+
+        slot = shared_find_string(myself->shared, key, length, hash);
+        old_value = dict_split_value(myself, slot);
+        if (old_value) {
+            myself->values[slot] = NULL;
+            myself->count--;
+            Sb_DECREF(old_value);
+            return 0;
+        }
+        link = NULL;
+    }
+    else {
+        link = dict_lookup_string(myself, key, length, hash);
+    }
+    if (!link) {
+        if (o_key) {
+            SbErr_RaiseWithObject(SbExc_KeyError, o_key);
+        }
+        else {
+            o_key = SbStr_FromStringAndSize(key, length);
+            if (o_key) {
+                SbErr_RaiseWithObject(SbExc_KeyError, o_key);
+                Sb_DECREF(o_key);
             }
         }
-        prev_entry = entry;
-        entry = entry->e_next;
+        return -1;
     }
 
-    SbErr_RaiseWithString(SbExc_KeyError, key);
-    return -1;
+    entry = *link;
+    *link = entry->e_next;
+    /* Safe to decref -- the entry is no longer in. */
+    Sb_DECREF(entry->e_key);
+    Sb_DECREF(entry->e_value);
+    SbObject_Free(entry);
+    myself->count--;
+    return 0;
+}
+
+int
+SbDict_DelItemString(SbObject *p, const char *key)
+{
+    Sb_ssize_t length;
+
+    length = SbRT_StrLen(key);
+    return dict_delitem_string(p, key, length, _SbStr_HashString(key, length), NULL);
+}
+
+int
+SbDict_DelItemKey(SbObject *p, SbDictKey *key)
+{
+    return dict_delitem_string(p, key->text, key->length, SbDictKey_Hash(key), NULL);
+}
+
+int
+_SbDict_DelItemStr(SbObject *p, SbObject *key)
+{
+    return dict_delitem_string(p, SbStr_AsStringUnsafe(key), SbStr_GetSizeUnsafe(key), _SbStr_Hash(key), key);
 }
 
 int
@@ -349,6 +888,15 @@ SbDict_DelItem(SbObject *p, SbObject *key)
     }
 #endif
 
+    if (DICT_IS_SPLIT(myself)) {
+        if (SbStr_CheckExact(key)) {
+            return _SbDict_DelItemStr(p, key);
+        }
+        if (dict_unshare(myself) < 0) {
+            return -1;
+        }
+    }
+
     hash = SbObject_Hash(key);
     if (hash == -1) {
         return -1;
@@ -364,6 +912,7 @@ SbDict_DelItem(SbObject *p, SbObject *key)
                 /* Safe to decref -- the entry is no longer in. */
                 Sb_DECREF(entry->e_key);
                 Sb_DECREF(entry->e_value);
+                SbObject_Free(entry);
                 myself->count--;
                 return 0;
             }
@@ -413,18 +962,32 @@ SbDict_Next(SbObject *p, Sb_ssize_t *state, SbObject **key, SbObject **value)
         bucket = -1;
         entry = NULL;
         /* It is known there is at least one entry. */
+        if (DICT_IS_SPLIT(myself)) {
+            goto search_values;
+        }
         goto search_buckets;
     }
 
     s = (dict_iteration_state *)*state;
     bucket = s->bucket;
+    if (DICT_IS_SPLIT(myself)) {
+        goto search_values;
+    }
+    if (!s->entry) {
+        /* The dict was split when the iteration started; its items have moved since,
+           and there is no telling which of them were already produced. */
+        Sb_Free(s);
+        *state = 0;
+        SbErr_RaiseWithString(SbExc_RuntimeError, "dictionary changed size during iteration");
+        return -1;
+    }
     entry = s->entry->e_next;
 
 search_buckets:
     if (!entry) {
         do {
             ++bucket;
-            if (bucket == BUCKET_COUNT) {
+            if ((Sb_size_t)bucket > myself->mask) {
                 goto iteration_end;
             }
         } while (myself->buckets[bucket] == NULL);
@@ -437,6 +1000,21 @@ search_buckets:
     *value = entry->e_value;
     return 1;
 
+search_values:
+    /* For split dicts, `bucket` is the slot. */
+    do {
+        ++bucket;
+        if (bucket >= dict_values_capacity(myself)) {
+            goto iteration_end;
+        }
+    } while (myself->values[bucket] == NULL);
+
+    s->bucket = bucket;
+    s->entry = NULL;
+    *key = myself->shared->keys[bucket];
+    *value = myself->values[bucket];
+    return 1;
+
 iteration_end:
     Sb_Free(s);
     *state = 0;
@@ -447,21 +1025,73 @@ iteration_end0:
     return 0;
 }
 
+/* Merge one item through the public interface, which copes with split dicts. */
+static int
+dict_merge_item(SbObject *dst, SbObject *key, SbObject *value, int update)
+{
+    if (!update && SbDict_GetItem(dst, key)) {
+        return 0;
+    }
+    return SbDict_SetItem(dst, key, value);
+}
+
 int
 SbDict_Merge(SbObject *dst, SbObject *src, int update)
 {
-    Sb_ssize_t bucket;
+    SbDictObject *_dst = (SbDictObject *)dst;
     SbDictObject *_src = (SbDictObject *)src;
+    Sb_size_t bucket;
+    int split_dst;
+    int fresh;
+
+    if (DICT_IS_SPLIT(_src)) {
+        Sb_ssize_t slot;
 
-    for (bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        for (slot = 0; slot < dict_values_capacity(_src); ++slot) {
+            if (_src->values[slot]) {
+                if (dict_merge_item(dst, _src->shared->keys[slot], _src->values[slot], update) < 0) {
+                    return -1;
+                }
+            }
+        }
+        return 0;
+    }
+
+    split_dst = DICT_IS_SPLIT(_dst);
+    /* Keys in `src` are distinct, so nothing needs a lookup if `dst` starts out empty. */
+    fresh = !split_dst && _dst->count == 0;
+    if (!split_dst) {
+        dict_reserve(_dst, _dst->count + _src->count);
+    }
+
+    for (bucket = 0; bucket <= _src->mask; ++bucket) {
         bucket_entry *src_entry;
 
         for (src_entry = _src->buckets[bucket]; src_entry; src_entry = src_entry->e_next) {
-            SbObject *o;
+            if (split_dst) {
+                if (dict_merge_item(dst, src_entry->e_key, src_entry->e_value, update) < 0) {
+                    return -1;
+                }
+                continue;
+            }
+            if (fresh) {
+                bucket_entry *entry;
 
-            o = SbDict_GetItem(dst, src_entry->e_key);
-            if (!o || update) {
-                if (SbDict_SetItem(dst, src_entry->e_key, src_entry->e_value) < 0) {
+                entry = (bucket_entry *)SbObject_Malloc(sizeof(*entry));
+                if (!entry) {
+                    SbErr_NoMemory();
+                    return -1;
+                }
+                Sb_INCREF(src_entry->e_key);
+                Sb_INCREF(src_entry->e_value);
+                entry->e_key = src_entry->e_key;
+                entry->e_value = src_entry->e_value;
+                entry->e_hash = src_entry->e_hash;
+                dict_link_entry(_dst, entry);
+                continue;
+            }
+            if (update || !dict_lookup(_dst, src_entry->e_key, src_entry->e_hash)) {
+                if (dict_setitem_known_hash(_dst, src_entry->e_key, src_entry->e_hash, src_entry->e_value) < 0) {
                     return -1;
                 }
             }
@@ -475,7 +1105,7 @@ SbDict_Copy(SbObject *p)
 {
     SbObject *dict;
 
-    dict = SbDict_New();
+    dict = SbDict_NewPresized(SbDict_GetSizeUnsafe(p));
     if (!dict) {
         goto fail0;
     }
@@ -493,6 +1123,24 @@ fail0:
 }
 
 
+static SbObject *
+dict_new(SbObject *dummy, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:cls");
+    SbObject *cls;
+    SbObject *p;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &cls) < 0) {
+        return NULL;
+    }
+
+    p = SbObject_New((SbTypeObject *)cls);
+    if (p) {
+        dict_init_table((SbDictObject *)p);
+    }
+    return p;
+}
+
 static SbObject *
 dict_len(SbObject *self, SbObject *args, SbObject *kwargs)
 {
@@ -502,10 +1150,11 @@ dict_len(SbObject *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 dict_getitem(SbObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:key");
     SbObject *key;
     SbObject *result;
 
-    if (SbArgs_Parse("O:key", args, kwargs, &key) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &key) < 0) {
         return NULL;
     }
     result = SbDict_GetItem(self, key);
@@ -518,11 +1167,12 @@ dict_getitem(SbObject *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 dict_setitem(SbObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:key,O:value");
     SbObject *key;
     SbObject *value;
     int result;
 
-    if (SbArgs_Parse("O:key,O:value", args, kwargs, &key, &value) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &key, &value) < 0) {
         return NULL;
     }
     result = SbDict_SetItem(self, key, value);
@@ -535,10 +1185,11 @@ dict_setitem(SbObject *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 dict_delitem(SbObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:key");
     SbObject *key;
     int result;
 
-    if (SbArgs_Parse("O:key", args, kwargs, &key) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &key) < 0) {
         return NULL;
     }
     result = SbDict_DelItem(self, key);
@@ -594,6 +1245,7 @@ dict_iteritems(SbObject *self, SbObject *args, SbObject *kwargs)
 
 
 static const SbCMethodDef dict_methods[] = {
+    { "__new__", dict_new },
     { "__len__", dict_len },
     { "__getitem__", dict_getitem },
     { "__setitem__", dict_setitem },
@@ -616,9 +1268,11 @@ _Sb_TypeInit_Dict()
     if (!tp) {
         return -1;
     }
+    Sb_SET_IMMORTAL(tp);
 
     tp->tp_basicsize = sizeof(SbDictObject);
     tp->tp_destroy = (SbDestroyFunc)dict_destroy;
+    _SbType_EnableGC(tp, (SbTraverseFunc)dict_traverse, (SbClearFunc)dict_clear);
 
     SbDict_Type = tp;
     return 0;
@@ -17,6 +17,7 @@ SbTypeObject     *SbExc_KeyError = NULL;
 SbTypeObject    *SbExc_MemoryError = NULL;
 SbTypeObject    *SbExc_NameError = NULL;
 SbTypeObject     *SbExc_UnboundLocalError = NULL;
+SbTypeObject    *SbExc_RuntimeError = NULL;
 SbTypeObject    *SbExc_SystemError = NULL;
 SbTypeObject    *SbExc_TypeError = NULL;
 SbTypeObject    *SbExc_ValueError = NULL;
@@ -40,6 +41,20 @@ exception_destroy(SbBaseExceptionObject *self)
     SbObject_DefaultDestroy((SbObject *)self);
 }
 
+static int
+exception_traverse(SbBaseExceptionObject *self, SbVisitFunc visit, void *arg)
+{
+    Sb_VISIT(self->args);
+    return 0;
+}
+
+static int
+exception_clear(SbBaseExceptionObject *self)
+{
+    Sb_CLEAR(self->args);
+    return 0;
+}
+
 static SbObject *
 exception_init(SbBaseExceptionObject *self, SbObject *args, SbObject *kwargs)
 {
@@ -68,10 +83,11 @@ exception_getattr_internal(SbBaseExceptionObject *self, SbObject *attr_name)
 static SbObject *
 exception_getattr(SbBaseExceptionObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("S:name");
     SbObject *attr_name;
     SbObject *result;
 
-    if (SbArgs_Parse("S:name", args, kwargs, &attr_name) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &attr_name) < 0) {
         return NULL;
     }
     result = exception_getattr_internal(self, attr_name);
@@ -151,10 +167,11 @@ do_return:
 static SbObject *
 enverror_getattr(SbBaseExceptionObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("S:name");
     SbObject *attr_name;
     SbObject *result;
 
-    if (SbArgs_Parse("S:name", args, kwargs, &attr_name) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &attr_name) < 0) {
         return NULL;
     }
     result = enverror_getattr_internal(self, attr_name);
@@ -205,6 +222,7 @@ _Sb_TypeInit_Exceptions()
 
     tp = _SbType_FromCDefs("BaseException", NULL, exception_methods, sizeof(SbBaseExceptionObject));
     tp->tp_destroy = (SbDestroyFunc)exception_destroy;
+    _SbType_EnableGC(tp, (SbTraverseFunc)exception_traverse, (SbClearFunc)exception_clear);
     SbExc_BaseException = tp;
 
     SbExc_Exception = SbExc_NewException("Exception", SbExc_BaseException);
@@ -224,6 +242,7 @@ _Sb_TypeInit_Exceptions()
     SbExc_LookupError = SbExc_NewException("LookupError", SbExc_StandardError);
     SbExc_MemoryError = SbExc_NewException("MemoryError", SbExc_StandardError);
     SbExc_NameError = SbExc_NewException("NameError", SbExc_StandardError);
+    SbExc_RuntimeError = SbExc_NewException("RuntimeError", SbExc_StandardError);
     SbExc_SystemError = SbExc_NewException("SystemError", SbExc_StandardError);
     SbExc_TypeError = SbExc_NewException("TypeError", SbExc_StandardError);
     SbExc_ValueError = SbExc_NewException("ValueError", SbExc_StandardError);
@@ -255,5 +274,6 @@ SbExc_NewException(const char *name, SbTypeObject *base)
     if (!tp) {
         return NULL;
     }
+    Sb_SET_IMMORTAL(tp);
     return tp;
 }
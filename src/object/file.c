@@ -157,12 +157,13 @@ SbFile_Close(SbObject *self)
 static SbObject *
 file_read(SbObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("|i:maxcount");
     SbObject *o_result;
     void *buffer;
     Sb_ssize_t maxcount = 16384;
     Sb_ssize_t transferred;
 
-    if (SbArgs_Parse("|i:maxcount", args, kwargs, &maxcount) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &maxcount) < 0) {
         return NULL;
     }
 
@@ -189,10 +190,11 @@ file_read(SbObject *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 file_write(SbObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("S:data");
     SbObject *o_data = NULL;
     Sb_ssize_t transferred;
 
-    if (SbArgs_Parse("S:data", args, kwargs, &o_data) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_data) < 0) {
         return NULL;
     }
 
@@ -208,10 +210,11 @@ file_write(SbObject *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 file_seek(SbObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("i:offset|i:whence");
     Sb_ssize_t offset = 0;
     int whence = 0;
 
-    if (SbArgs_Parse("i:offset|i:whence", args, kwargs, &offset, &whence) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &offset, &whence) < 0) {
         return NULL;
     }
 
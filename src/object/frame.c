@@ -1,4 +1,5 @@
 #include "snakebed.h"
+#include "internal.h"
 
 /* Keep the type object here. */
 SbTypeObject *SbFrame_Type = NULL;
@@ -53,6 +54,70 @@ frame_destroy(SbFrameObject *f)
     SbObject_DefaultDestroy((SbObject *)f);
 }
 
+/* NOTE: The value stack is not visited: the interpreter keeps the stack
+   pointer to itself while the frame runs, and a finished frame has it empty. */
+static int
+frame_traverse(SbFrameObject *f, SbVisitFunc visit, void *arg)
+{
+    Sb_VISIT(f->prev);
+    Sb_VISIT(f->code);
+    Sb_VISIT(f->globals);
+    Sb_VISIT(f->locals);
+    return 0;
+}
+
+static int
+frame_clear(SbFrameObject *f)
+{
+    Sb_CLEAR(f->prev);
+    Sb_CLEAR(f->locals);
+    Sb_CLEAR(f->globals);
+    return 0;
+}
+
+#if SUPPORTS(OBJECT_FREELISTS)
+/* Frame stacks are rounded up to a multiple of this many slots,
+   so frames of different code objects can reuse each other's memory. */
+#define FRAME_STACK_QUANTUM 8
+#define FRAME_FREELIST_CLASSES 4
+
+static SbFreeList frame_freelists[FRAME_FREELIST_CLASSES] = {
+    SbFreeList_INIT(8),
+    SbFreeList_INIT(8),
+    SbFreeList_INIT(4),
+    SbFreeList_INIT(4),
+};
+/* Larger frames are never kept; this one only saves on special-casing them. */
+static SbFreeList frame_oversized = SbFreeList_INIT(0);
+
+#define FRAME_CLASS(nitems) \
+    ((nitems) > 0 ? ((nitems) - 1) / FRAME_STACK_QUANTUM : 0)
+
+static SbObject *
+frame_alloc(SbTypeObject *type, Sb_ssize_t nitems)
+{
+    Sb_ssize_t cls;
+
+    cls = FRAME_CLASS(nitems);
+    if (cls >= FRAME_FREELIST_CLASSES) {
+        return _SbFreeList_Alloc(&frame_oversized, type,
+            type->tp_basicsize + nitems * type->tp_itemsize);
+    }
+    return _SbFreeList_Alloc(&frame_freelists[cls], type,
+        type->tp_basicsize + (cls + 1) * FRAME_STACK_QUANTUM * type->tp_itemsize);
+}
+
+static void
+frame_free(void *p)
+{
+    Sb_ssize_t cls;
+
+    /* The item count is left intact by the destructor. */
+    cls = FRAME_CLASS(Sb_COUNT(p));
+    _SbFreeList_Free(cls < FRAME_FREELIST_CLASSES ? &frame_freelists[cls] : &frame_oversized, p);
+}
+#endif
+
 int
 SbFrame_SetPrevious(SbFrameObject *myself, SbFrameObject *prev)
 {
@@ -185,7 +250,7 @@ SbFrame_PushBlock(SbFrameObject *myself, const Sb_byte_t *handler, SbObject **ol
 {
     SbCodeBlock *b;
 
-    b = (SbCodeBlock *)Sb_Malloc(sizeof(*b));
+    b = (SbCodeBlock *)SbObject_Malloc(sizeof(*b));
     if (!b) {
         SbErr_NoMemory();
         return -1;
@@ -209,7 +274,7 @@ SbFrame_PopBlock(SbFrameObject *myself)
     /* assert(b != NULL); */
     myself->blocks = b->next;
 
-    Sb_Free(b);
+    SbObject_Free(b);
 }
 
 /* Type initializer */
@@ -223,10 +288,16 @@ _SbFrame_TypeInit()
     if (!tp) {
         return -1;
     }
+    Sb_SET_IMMORTAL(tp);
 
     tp->tp_basicsize = sizeof(SbFrameObject);
     tp->tp_itemsize = sizeof(SbObject *);
     tp->tp_destroy = (SbDestroyFunc)frame_destroy;
+    _SbType_EnableGC(tp, (SbTraverseFunc)frame_traverse, (SbClearFunc)frame_clear);
+#if SUPPORTS(OBJECT_FREELISTS)
+    tp->tp_alloc = frame_alloc;
+    tp->tp_free = frame_free;
+#endif
 
     SbFrame_Type = tp;
     return 0;
@@ -6,18 +6,42 @@
 /* Keep the type object here. */
 SbTypeObject *SbInt_Type = NULL;
 
+#if !SUPPORTS(TAGGED_INTS)
+/* Small ints are preallocated and immortal; these bound the range. */
+#define SMALL_INT_MIN (-5)
+#define SMALL_INT_MAX 256
+
+static SbObject *small_ints[SMALL_INT_MAX - SMALL_INT_MIN + 1];
+#endif
+
 /*
 Implementation of multiple-precision arithmetic.
 
 The implementation uses 2-complement representation of digits.
 
-The implementation is defined to operate on half-words to allow for:
-* Easy carry/borrow computations, trading off for speed (2x addition ops).
-* Easy multiplication for machines not having a high-bits output reg.
+Digits are 32-bit words; all intermediate results are computed in 64-bit
+double digits, which allows for:
+* Carry/borrow extraction by a single shift of the double digit.
+* A full 32x32->64 product per inner loop step.
+
+Values that fit into SbInt_Native_t are always kept native; the digit form
+is always reduced to the minimal length. Comparisons rely on both.
 
 Some algorithms are taken from the awesome Hacker's Delight book.
 */
 
+/* Number of bits in a native value. */
+#define NATIVE_BITS \
+    ((int)(sizeof(SbInt_Native_t) * 8))
+
+/* Number of digits required to hold any native value. */
+#define LONG_NATIVE_DIGITS \
+    ((sizeof(SbInt_Native_t) + sizeof(SbInt_Digit_t) - 1) / sizeof(SbInt_Digit_t))
+
+/* The sign bit of a digit. */
+#define DIGIT_SIGN_BIT \
+    ((SbInt_Digit_t)1 << (SbInt_DIGIT_BITS - 1))
+
 static int
 int_native_bitcount(SbInt_Native_t x)
 {
@@ -55,12 +79,48 @@ long_free(SbInt_Digit_t *digits)
 #define LONG_IS_ZERO(o) \
     (LONG_IS_NATIVE(o) && ((o)->u.value == 0))
 
+#if SUPPORTS(TAGGED_INTS)
+/* Tagged ints have no SbInt_Value of their own; unpack one into storage. */
+static const SbInt_Value *
+int_value(const SbObject *op, SbInt_Value *storage)
+{
+    if (Sb_IS_TAGGED(op)) {
+        LONG_SET_NATIVE(storage);
+        storage->u.value = SbInt_UNTAG(op);
+        return storage;
+    }
+    return &((const SbIntObject *)op)->v;
+}
+#define INT_VALUE(op, storage) \
+    int_value((op), (storage))
+#else
+#define INT_VALUE(op, storage) \
+    ((void)(storage), (const SbInt_Value *)&((const SbIntObject *)(op))->v)
+#endif
+
+/* Trade a freshly computed result for its tagged form if it has one.
+   Returns: the value as a new reference; steals the reference to o. */
+static SbObject *
+int_pack(SbIntObject *o)
+{
+#if SUPPORTS(TAGGED_INTS)
+    if (LONG_IS_NATIVE(&o->v) && SbInt_FITS_TAGGED(o->v.u.value)) {
+        SbObject *tagged;
+
+        tagged = SbInt_TAG(o->v.u.value);
+        Sb_DECREF(o);
+        return tagged;
+    }
+#endif
+    return (SbObject *)o;
+}
+
 /* Obtain the digit filled with the sign bit.
    Returns: -1 or 0 depending on the sign. */
 static SbInt_Digit_t
 long_sign(const SbInt_Value *o)
 {
-    return -LONG_IS_NEGATIVE(o);
+    return (SbInt_Digit_t)-LONG_IS_NEGATIVE(o);
 }
 
 /* Compare two MPI values.
@@ -70,7 +130,7 @@ long_cmp(const SbInt_Value *lhs, const SbInt_Value *rhs)
 {
     int sign;
     Sb_ssize_t diff;
-    long i;
+    Sb_ssize_t i;
 
     /* Fast path:
        lhs < 0 && rhs > 0 => -1
@@ -79,7 +139,7 @@ long_cmp(const SbInt_Value *lhs, const SbInt_Value *rhs)
     sign = LONG_IS_NEGATIVE(lhs);
     diff = LONG_IS_NEGATIVE(rhs) - sign;
     if (diff) {
-        return diff;
+        return (int)diff;
     }
     /* Established: lhs and rhs have the same sign. */
 
@@ -88,84 +148,78 @@ long_cmp(const SbInt_Value *lhs, const SbInt_Value *rhs)
     if (diff) {
         /* Both negative: longer one is less */
         /* Both positive: shorter one is less. */
-        return sign ? -diff : diff;
+        return sign ? (diff < 0 ? 1 : -1) : (diff < 0 ? -1 : 1);
     }
     /* Established: lhs and rhs have the same sign and the same length. */
 
+    /* With equal signs and lengths, 2-complement digits order
+       the same way as their values, regardless of the sign. */
     for (i = lhs->length - 1; i >= 0; --i) {
-        diff = lhs->u.digits[i] - rhs->u.digits[i];
-        if (diff) {
-            /* Both positive: bigger one is +1. */
-            /* Both negative: bigger one is -1. */
-            return sign ? -diff : diff;
+        SbInt_Digit_t a, b;
+
+        a = lhs->u.digits[i];
+        b = rhs->u.digits[i];
+        if (a != b) {
+            return a > b ? 1 : -1;
         }
     }
     /* lhs and rhs are bit-equal. */
     return 0;
 }
 
-static void
-__long_copy(const SbInt_Value *src, SbInt_Value *dst)
-{
-    SbInt_Digit_t *src_ptr, *dst_ptr, *dst_limit;
-
-    src_ptr = src->u.digits;
-    dst_ptr = dst->u.digits;
-    dst_limit = dst_ptr + dst->length;
-    while (dst_ptr < dst_limit) {
-        *dst_ptr++ = *src_ptr++;
-    }
-}
-
 /* Negate an MPI value.
-   Assumes: result->length == rhs->length
+   Assumes: result->length > rhs->length, as -MIN needs an extra digit
    NOTE: Allows for operand aliasing. */
 static void
 __long_neg(const SbInt_Value *rhs, SbInt_Value *result)
 {
-    SbInt_Digit_t c;
-    SbInt_Digit_t *src, *dst, *dst_limit;
+    SbInt_DoubleDigit_t c;
+    SbInt_Digit_t *src, *src_limit, *dst, *dst_limit;
+    SbInt_Digit_t sign;
 
     src = rhs->u.digits;
+    src_limit = src + rhs->length;
     dst = result->u.digits;
     dst_limit = dst + result->length;
+    sign = long_sign(rhs);
 
     c = 1;
     while (dst < dst_limit) {
-        SbInt_DoubleDigit_t t;
-
-        t = ~(*src++) + c;
-        c = t >> SbInt_DIGIT_BITS;
-        (*dst++) = t & 0xFFFFu;
+        c += (SbInt_Digit_t)~(src < src_limit ? *src++ : sign);
+        (*dst++) = (SbInt_Digit_t)c;
+        c >>= SbInt_DIGIT_BITS;
     }
 }
 
 /* Invert an MPI value.
-   Assumes: result->length == rhs->length
+   Assumes: result->length >= rhs->length
    NOTE: Allows for operand aliasing. */
 static void
 __long_inv(const SbInt_Value *rhs, SbInt_Value *result)
 {
-    SbInt_Digit_t *src, *dst, *dst_limit;
+    SbInt_Digit_t *src, *src_limit, *dst, *dst_limit;
+    SbInt_Digit_t sign;
 
     src = rhs->u.digits;
+    src_limit = src + rhs->length;
     dst = result->u.digits;
     dst_limit = dst + result->length;
+    sign = long_sign(rhs);
 
     while (dst < dst_limit) {
-        (*dst++) = ~(*src++);
+        (*dst++) = ~(src < src_limit ? *src++ : sign);
     }
 }
 
 /* Shift left an MPI value.
-   Assumes: shift won't overflow.
+   Assumes: result->length > lhs->length + rhs / SbInt_DIGIT_BITS
    */
 static void
 __long_shl(const SbInt_Value *lhs, int rhs, SbInt_Value *result)
 {
     SbInt_Digit_t *src, *src_limit, *dst, *dst_limit;
-    SbInt_DoubleDigit_t carry;
-    SbInt_SignDigit_t sign;
+    SbInt_Digit_t carry;
+    SbInt_DoubleDigit_t t;
 
     src = lhs->u.digits;
     src_limit = src + lhs->length - 1;
@@ -179,31 +233,32 @@ __long_shl(const SbInt_Value *lhs, int rhs, SbInt_Value *result)
 
     carry = 0;
     while (src < src_limit) {
-        *dst = (SbInt_Digit_t)((*src << rhs) | carry);
-        carry = *src >> (SbInt_DIGIT_BITS - rhs);
+        t = (SbInt_DoubleDigit_t)*src << rhs;
+        *dst = (SbInt_Digit_t)t | carry;
+        carry = (SbInt_Digit_t)(t >> SbInt_DIGIT_BITS);
         ++src;
         ++dst;
     }
-    sign = *src;
-    *dst++ = (SbInt_Digit_t)((sign << rhs) | carry);
-    sign = sign >> (SbInt_DIGIT_BITS - rhs);
+    /* The top digit: shifting the sign-extended value spills the sign, too */
+    t = (SbInt_DoubleDigit_t)((SbInt_SignDoubleDigit_t)(SbInt_SignDigit_t)*src) << rhs;
+    *dst++ = (SbInt_Digit_t)t | carry;
+    *dst++ = (SbInt_Digit_t)(t >> SbInt_DIGIT_BITS);
     while (dst < dst_limit) {
-        *dst++ = (SbInt_Digit_t)sign;
+        *dst++ = (SbInt_Digit_t)-((SbInt_SignDigit_t)*src < 0);
     }
 }
 
 /* Shift right an MPI value.
-   Assumes: shift won't overflow.
+   Assumes: result->length == lhs->length - rhs / SbInt_DIGIT_BITS, and is positive
    */
 static void
 __long_shr(const SbInt_Value *lhs, int rhs, SbInt_Value *result)
 {
-    SbInt_Digit_t *src, *src_limit, *dst, *dst_limit;
+    SbInt_Digit_t *src, *src_limit, *dst;
 
     src = lhs->u.digits;
     src_limit = src + lhs->length - 1;
     dst = result->u.digits;
-    dst_limit = dst + result->length;
 
     while (rhs >= SbInt_DIGIT_BITS) {
         src++;
@@ -213,7 +268,7 @@ __long_shr(const SbInt_Value *lhs, int rhs, SbInt_Value *result)
     while (src < src_limit) {
         SbInt_DoubleDigit_t t;
 
-        t = src[0] | (src[1] << SbInt_DIGIT_BITS);
+        t = src[0] | ((SbInt_DoubleDigit_t)src[1] << SbInt_DIGIT_BITS);
         *dst = (SbInt_Digit_t)(t >> rhs);
         ++src;
         ++dst;
@@ -222,54 +277,70 @@ __long_shr(const SbInt_Value *lhs, int rhs, SbInt_Value *result)
     *dst = (SbInt_Digit_t)((SbInt_SignDigit_t)*src >> rhs);
 }
 
-/* Add two MPI values.
+/* Add two MPI values, optionally inverting the right-hand one.
+   Subtraction is lhs + ~rhs + 1.
    Assumes: result->length > max(lhs->length, rhs->length)
    NOTE: Allows for aliasing all three ops. */
 static void
-__long_add(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *result)
+__long_addsub(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *result, int subtract)
 {
-    SbInt_Digit_t *src1, *src2, *limit1, *limit2, *dst;
-    SbInt_Digit_t sign;
+    const SbInt_Digit_t *src1, *src2;
+    SbInt_Digit_t *dst;
+    SbInt_Digit_t sign1, sign2, mask;
+    Sb_ssize_t i, common, longest;
     SbInt_DoubleDigit_t c;
 
-    if (lhs->length < rhs->length) {
-        const SbInt_Value *tmp;
-
-        tmp = lhs;
-        lhs = rhs;
-        rhs = tmp;
-    }
-
     src1 = lhs->u.digits;
-    limit1 = src1 + lhs->length;
     src2 = rhs->u.digits;
-    limit2 = src2 + rhs->length;
     dst = result->u.digits;
+    mask = subtract ? SbInt_DIGIT_MASK : 0;
+    /* Fetch signs early: the result may overwrite them. */
+    sign1 = long_sign(lhs);
+    sign2 = long_sign(rhs) ^ mask;
 
-    c = 0;
-    while (src2 < limit2) {
-        SbInt_DoubleDigit_t t;
-
-        t = *src1 + *src2 + c;
-        c = t >> SbInt_DIGIT_BITS;
-        *dst = t & 0xFFFFu;
-        ++src1;
-        ++src2;
-        ++dst;
+    if (lhs->length < rhs->length) {
+        common = lhs->length;
+        longest = rhs->length;
+    }
+    else {
+        common = rhs->length;
+        longest = lhs->length;
     }
 
-    sign = ((SbInt_SignDigit_t)src2[-1]) >> (SbInt_DIGIT_BITS - 1);
-    while (src1 < limit1) {
-        SbInt_DoubleDigit_t t;
-
-        t = *src1 + sign + c;
-        c = t >> SbInt_DIGIT_BITS;
-        *dst = t & 0xFFFFu;
-        ++src1;
-        ++dst;
+    c = subtract;
+    for (i = 0; i < common; ++i) {
+        c += (SbInt_DoubleDigit_t)src1[i] + (src2[i] ^ mask);
+        dst[i] = (SbInt_Digit_t)c;
+        c >>= SbInt_DIGIT_BITS;
+    }
+    if (lhs->length > rhs->length) {
+        for (; i < longest; ++i) {
+            c += (SbInt_DoubleDigit_t)src1[i] + sign2;
+            dst[i] = (SbInt_Digit_t)c;
+            c >>= SbInt_DIGIT_BITS;
+        }
     }
+    else {
+        for (; i < longest; ++i) {
+            c += (SbInt_DoubleDigit_t)sign1 + (src2[i] ^ mask);
+            dst[i] = (SbInt_Digit_t)c;
+            c >>= SbInt_DIGIT_BITS;
+        }
+    }
+    for (; i < result->length; ++i) {
+        c += (SbInt_DoubleDigit_t)sign1 + sign2;
+        dst[i] = (SbInt_Digit_t)c;
+        c >>= SbInt_DIGIT_BITS;
+    }
+}
 
-    *dst = (SbInt_Digit_t)((((SbInt_SignDigit_t)src1[-1]) >> (SbInt_DIGIT_BITS - 1)) + sign + c);
+/* Add two MPI values.
+   Assumes: result->length > max(lhs->length, rhs->length)
+   NOTE: Allows for aliasing all three ops. */
+static void
+__long_add(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *result)
+{
+    __long_addsub(lhs, rhs, result, 0);
 }
 
 /* Subtract two MPI values.
@@ -278,48 +349,25 @@ __long_add(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *result)
 static void
 __long_sub(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *result)
 {
-    SbInt_Digit_t *src1, *src2, *limit1, *limit2, *dst;
-    SbInt_Digit_t sign;
-    SbInt_DoubleDigit_t c;
-
-    if (lhs->length < rhs->length) {
-        const SbInt_Value *tmp;
-
-        tmp = lhs;
-        lhs = rhs;
-        rhs = tmp;
-    }
-
-    src1 = lhs->u.digits;
-    limit1 = src1 + lhs->length;
-    src2 = rhs->u.digits;
-    limit2 = src2 + rhs->length;
-    dst = result->u.digits;
-
-    c = 0;
-    while (src2 < limit2) {
-        SbInt_DoubleDigit_t t;
+    __long_addsub(lhs, rhs, result, 1);
+}
 
-        t = *src1 - *src2 - c;
-        c = t >> 31;
-        *dst = t & 0xFFFFu;
-        ++src1;
-        ++src2;
-        ++dst;
-    }
+/* Subtract (unsigned) digits from the top part of the result, in place.
+   Used to correct unsigned products for negative operands. */
+static void
+__long_sub_at(SbInt_Digit_t *dst, const SbInt_Digit_t *src, Sb_ssize_t count)
+{
+    Sb_ssize_t i;
+    SbInt_Digit_t b;
 
-    sign = ((SbInt_SignDigit_t)src2[-1]) >> (SbInt_DIGIT_BITS - 1);
-    while (src1 < limit1) {
+    b = 0;
+    for (i = 0; i < count; ++i) {
         SbInt_DoubleDigit_t t;
 
-        t = *src1 - sign - c;
-        c = t >> 31;
-        *dst = t & 0xFFFFu;
-        ++src1;
-        ++dst;
+        t = (SbInt_DoubleDigit_t)dst[i] - src[i] - b;
+        dst[i] = (SbInt_Digit_t)t;
+        b = (SbInt_Digit_t)(t >> (2 * SbInt_DIGIT_BITS - 1));
     }
-
-    *dst = (SbInt_Digit_t)((((SbInt_SignDigit_t)src1[-1]) >> (SbInt_DIGIT_BITS - 1)) - sign - c);
 }
 
 /* Multiply two MPI values.
@@ -329,638 +377,2486 @@ static void
 __long_mul(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *result)
 {
     Sb_ssize_t i, j;
+    SbInt_Digit_t *dst;
+    const SbInt_Digit_t *src2;
 
+    dst = result->u.digits;
+    src2 = rhs->u.digits;
     for (i = 0; i < result->length; ++i) {
-        result->u.digits[i] = 0;
+        dst[i] = 0;
     }
 
     for (i = 0; i < lhs->length; ++i) {
         SbInt_Digit_t a;
-        SbInt_Digit_t c;
+        SbInt_DoubleDigit_t c;
 
         a = lhs->u.digits[i];
         /* Fast path: multiplying by zero digit requires no additions */
         if (!a) {
             continue;
         }
+        /* (2**32-1)**2 + 2 * (2**32-1) == 2**64-1: never overflows */
         c = 0;
         for (j = 0; j < rhs->length; ++j) {
-            SbInt_Digit_t b;
-            SbInt_DoubleDigit_t t;
-
-            b = rhs->u.digits[j];
-            t = a * b + result->u.digits[i + j] + c;
-            c = t >> SbInt_DIGIT_BITS;
-            result->u.digits[i + j] = t & 0xFFFFu;
+            c += Sb_Mulu32x32As64(a, src2[j]) + dst[i + j];
+            dst[i + j] = (SbInt_Digit_t)c;
+            c >>= SbInt_DIGIT_BITS;
         }
-        result->u.digits[i + j] = c;
+        dst[i + j] = (SbInt_Digit_t)c;
     }
-    /* subtracting v * 2**16m if u < 0; inlined */
+    /* subtracting v * 2**32m if u < 0 */
     if (long_sign(lhs)) {
-        SbInt_Digit_t b;
-        SbInt_DoubleDigit_t t;
-
-        b = 0;
-        for (i = 0; i < rhs->length; ++i) {
-            t = result->u.digits[lhs->length + i] - rhs->u.digits[i] - b;
-            result->u.digits[lhs->length + i] = t & 0xFFFFu;
-            b = t >> 31;
-        }
+        __long_sub_at(dst + lhs->length, src2, rhs->length);
     }
-    /* subtracting u * 2**16n if v < 0; inlined */
+    /* subtracting u * 2**32n if v < 0 */
     if (long_sign(rhs)) {
-        SbInt_Digit_t b;
-        SbInt_DoubleDigit_t t;
-
-        b = 0;
-        for (i = 0; i < lhs->length; ++i) {
-            t = result->u.digits[rhs->length + i] - lhs->u.digits[i] - b;
-            result->u.digits[rhs->length + i] = t & 0xFFFFu;
-            b = t >> 31;
-        }
+        __long_sub_at(dst + rhs->length, lhs->u.digits, lhs->length);
     }
 }
 
-/* Divide lhs by rhs (unsigned).
-   Assumes: 
-   */
-static void
-__long_divmod(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *q, SbInt_Value *r)
-{
-}
-
+/* Bring an MPI value to its canonical form: the minimal digit count,
+   or native if the value fits. */
 static void
 long_reduce(SbInt_Value *o)
 {
     SbInt_Digit_t sign;
-    Sb_ssize_t i;
+    Sb_ssize_t n;
 
     if (LONG_IS_NATIVE(o)) {
         return;
     }
 
     sign = long_sign(o);
-    i = o->length - 1;
-    if (o->u.digits[i] != sign) {
-        return;
-    }
-    do {
-        --i;
-    } while ((i >= 0) && (o->u.digits[i] == sign));
-    if ((i >= 0) && ((o->u.digits[i] ^ sign) & (1 << (SbInt_DIGIT_BITS - 1)))) {
-        ++i;
+    n = o->length;
+    /* A top digit is redundant if it is all sign and the next one carries the sign bit. */
+    while (n > 1 && o->u.digits[n - 1] == sign && !((o->u.digits[n - 2] ^ sign) & DIGIT_SIGN_BIT)) {
+        --n;
     }
 
-    if (i < 2) {
-        SbInt_Native_t v;
+    if (n <= (Sb_ssize_t)LONG_NATIVE_DIGITS) {
+        SbInt_DoubleDigit_t v;
 
-        if (i == 1) {
-            v = (o->u.digits[1] << SbInt_DIGIT_BITS) | (o->u.digits[0]);
-        }
-        else if (i == 0) {
-            v = (sign << SbInt_DIGIT_BITS) | (o->u.digits[0]);
-        }
-        else {
-            v = (sign << SbInt_DIGIT_BITS) | (sign);
+        v = (SbInt_DoubleDigit_t)(SbInt_SignDoubleDigit_t)(SbInt_SignDigit_t)o->u.digits[--n];
+        while (n > 0) {
+            v = (v << SbInt_DIGIT_BITS) | o->u.digits[--n];
         }
 
         long_free(o->u.digits);
         LONG_SET_NATIVE(o);
-        o->u.value = v;
+        o->u.value = (SbInt_Native_t)v;
     }
     else {
-        o->length = i + 1;
+        o->length = n;
     }
 }
 
-
 /*
- * C interface implementations
+ * Magnitude (unsigned) digit array helpers.
+ * The subquadratic algorithms work on magnitudes; the caller handles signs.
  */
 
-void
-_SbInt_SetFromNative(SbObject *self, SbInt_Native_t ival)
+/* Below this many digits in the shorter operand, schoolbook multiplication wins.
+   Picked by timing products of 32 to 512 digit operands. */
+#define KARATSUBA_CUTOFF 40
+/* Squaring does about half the work in schoolbook, so the crossover is later. */
+#define KARATSUBA_SQUARE_CUTOFF 64
+
+/* Add a[0..na) to r[0..nr) in place; na <= nr.
+   Returns: the carry out of r. */
+static SbInt_Digit_t
+__mag_add_in(SbInt_Digit_t *r, Sb_ssize_t nr, const SbInt_Digit_t *a, Sb_ssize_t na)
 {
-    SbIntObject *myself = (SbIntObject *)self;
+    Sb_ssize_t i;
+    SbInt_DoubleDigit_t c;
 
-    LONG_SET_NATIVE(&myself->v);
-    myself->v.u.value = ival;
+    c = 0;
+    for (i = 0; i < na; ++i) {
+        c += (SbInt_DoubleDigit_t)r[i] + a[i];
+        r[i] = (SbInt_Digit_t)c;
+        c >>= SbInt_DIGIT_BITS;
+    }
+    for (; c && i < nr; ++i) {
+        c += r[i];
+        r[i] = (SbInt_Digit_t)c;
+        c >>= SbInt_DIGIT_BITS;
+    }
+    return (SbInt_Digit_t)c;
 }
 
-SbObject *
-SbInt_FromNative(SbInt_Native_t ival)
+/* Subtract a[0..na) from r[0..nr) in place; na <= nr.
+   Returns: the borrow out of r. */
+static SbInt_Digit_t
+__mag_sub_in(SbInt_Digit_t *r, Sb_ssize_t nr, const SbInt_Digit_t *a, Sb_ssize_t na)
 {
-    SbIntObject *myself;
-    myself = (SbIntObject *)SbObject_New(SbInt_Type);
-    if (myself) {
-        _SbInt_SetFromNative((SbObject *)myself, ival);
+    Sb_ssize_t i;
+    SbInt_Digit_t b;
+
+    b = 0;
+    for (i = 0; i < na; ++i) {
+        SbInt_DoubleDigit_t t;
+
+        t = (SbInt_DoubleDigit_t)r[i] - a[i] - b;
+        r[i] = (SbInt_Digit_t)t;
+        b = (SbInt_Digit_t)(t >> (2 * SbInt_DIGIT_BITS - 1));
     }
-    return (SbObject *)myself;
+    for (; b && i < nr; ++i) {
+        b = r[i] == 0;
+        r[i] -= 1;
+    }
+    return b;
 }
 
-SbObject *
-SbInt_FromLengthAndDigits(Sb_ssize_t length, SbInt_Digit_t *digits)
+/* Schoolbook multiply two magnitudes.
+   Assumes: r has na + nb digits; r doesn't overlap a or b. */
+static void
+__mag_mul(const SbInt_Digit_t *a, Sb_ssize_t na, const SbInt_Digit_t *b, Sb_ssize_t nb, SbInt_Digit_t *r)
 {
-    SbIntObject *myself;
-    myself = (SbIntObject *)SbObject_New(SbInt_Type);
-    if (myself) {
-        SbInt_Digit_t *new_digits;
+    Sb_ssize_t i, j;
 
-        new_digits = long_alloc(length);
-        if (!new_digits) {
-            Sb_DECREF(myself);
-            return NULL;
+    SbRT_MemSet(r, 0, (na + nb) * sizeof(SbInt_Digit_t));
+    for (i = 0; i < na; ++i) {
+        SbInt_Digit_t x;
+        SbInt_DoubleDigit_t c;
+
+        x = a[i];
+        if (!x) {
+            continue;
         }
-        myself->v.length = length;
-        myself->v.u.digits = new_digits;
-        if (digits) {
-            SbRT_MemCpy(new_digits, digits, length * sizeof(SbInt_Digit_t));
+        c = 0;
+        for (j = 0; j < nb; ++j) {
+            c += Sb_Mulu32x32As64(x, b[j]) + r[i + j];
+            r[i + j] = (SbInt_Digit_t)c;
+            c >>= SbInt_DIGIT_BITS;
         }
+        r[i + j] = (SbInt_Digit_t)c;
     }
-    return (SbObject *)myself;
 }
 
-SbInt_Native_t
-SbInt_AsNativeOverflow(SbObject *op, int *overflow_flag)
+/* Schoolbook square a magnitude: each cross product is computed once and doubled.
+   Assumes: r has 2 * n digits; r doesn't overlap a. */
+static void
+__mag_sqr(const SbInt_Digit_t *a, Sb_ssize_t n, SbInt_Digit_t *r)
 {
-    const SbIntObject * myself;
+    Sb_ssize_t i, j;
+    SbInt_DoubleDigit_t c;
+    SbInt_Digit_t top;
 
-#if SUPPORTS(BUILTIN_TYPECHECKS)
-    if (!SbInt_Check(op)) {
-        SbErr_RaiseWithString(SbExc_SystemError, "non-int object passed to an int method");
-        return -1;
-    }
-#endif
+    SbRT_MemSet(r, 0, 2 * n * sizeof(SbInt_Digit_t));
+    /* Sum of a[i] * a[j] for i < j */
+    for (i = 0; i < n; ++i) {
+        SbInt_Digit_t x;
 
-    myself = (SbIntObject *)op;
-    if (LONG_IS_NATIVE(&myself->v)) {
-        if (overflow_flag) {
-            *overflow_flag = 0;
+        x = a[i];
+        if (!x) {
+            continue;
+        }
+        c = 0;
+        for (j = i + 1; j < n; ++j) {
+            c += Sb_Mulu32x32As64(x, a[j]) + r[i + j];
+            r[i + j] = (SbInt_Digit_t)c;
+            c >>= SbInt_DIGIT_BITS;
         }
-        return myself->v.u.value;
+        r[i + j] = (SbInt_Digit_t)c;
     }
-    /* TODO: allow for more flexibility wrt SbInt_DIGIT_BITS? */
-    if (myself->v.length < 3) {
-        SbInt_DoubleDigit_t t;
+    /* Double it; the result always fits */
+    top = 0;
+    for (i = 0; i < 2 * n; ++i) {
+        SbInt_Digit_t d;
 
-        t = myself->v.u.digits[0] | ((SbInt_DoubleDigit_t)myself->v.u.digits[1] << SbInt_DIGIT_BITS);
-        if (overflow_flag) {
-            *overflow_flag = 0;
-        }
-        return t;
+        d = r[i];
+        r[i] = (d << 1) | top;
+        top = d >> (SbInt_DIGIT_BITS - 1);
     }
-    /* Can't be represented. */
-    if (overflow_flag) {
-        *overflow_flag = 1;
+    /* Add the squares a[i] * a[i] */
+    c = 0;
+    for (i = 0; i < n; ++i) {
+        c += Sb_Mulu32x32As64(a[i], a[i]) + r[2 * i];
+        r[2 * i] = (SbInt_Digit_t)c;
+        c >>= SbInt_DIGIT_BITS;
+        c += r[2 * i + 1];
+        r[2 * i + 1] = (SbInt_Digit_t)c;
+        c >>= SbInt_DIGIT_BITS;
     }
-    return -1;
 }
 
-SbInt_Native_t
-SbInt_AsNative(SbObject *op)
+/* Karatsuba multiply two magnitudes.
+   Assumes: r has na + nb digits; r doesn't overlap a or b.
+   Returns: 0 if OK, -1 on allocation failure. */
+static int
+__mag_karatsuba(const SbInt_Digit_t *a, Sb_ssize_t na, const SbInt_Digit_t *b, Sb_ssize_t nb, SbInt_Digit_t *r)
 {
-    SbInt_Native_t result;
-    int overflow_flag;
+    Sb_ssize_t h, length;
+    SbInt_Digit_t *scratch;
+    SbInt_Digit_t *t1, *t2, *z1;
 
-    result = SbInt_AsNativeOverflow(op, &overflow_flag);
-    if (result == -1 && overflow_flag) {
-    }
-    return result;
-}
+    if (na < nb) {
+        const SbInt_Digit_t *tp;
+        Sb_ssize_t tn;
 
-static void
-long_convert_digits(SbInt_Value *value, SbInt_Native_t native_value, Sb_size_t digits_length, SbInt_Digit_t *digits)
-{
-    value->length = digits_length;
-    value->u.digits = digits;
+        tp = a; a = b; b = tp;
+        tn = na; na = nb; nb = tn;
+    }
+    if (nb < KARATSUBA_CUTOFF) {
+        __mag_mul(a, na, b, nb, r);
+        return 0;
+    }
 
-    /* NOTE: Do away with the loop and just stick to SbInt_DIGIT_BITS being 16? */
-    while (digits_length-- > 0) {
-        *digits++ = (SbInt_Digit_t)(native_value);
-        native_value >>= SbInt_DIGIT_BITS;
+    h = (na + 1) / 2;
+    if (nb <= h) {
+        /* Lopsided: only split the longer operand.
+           r = a0 * b + (a1 * b) << h */
+        scratch = (SbInt_Digit_t *)Sb_Malloc((na - h + nb) * sizeof(SbInt_Digit_t));
+        if (!scratch) {
+            return -1;
+        }
+        if (__mag_karatsuba(a, h, b, nb, r) < 0) {
+            goto fail;
+        }
+        SbRT_MemSet(r + h + nb, 0, (na - h) * sizeof(SbInt_Digit_t));
+        if (__mag_karatsuba(a + h, na - h, b, nb, scratch) < 0) {
+            goto fail;
+        }
+        __mag_add_in(r + h, na + nb - h, scratch, na - h + nb);
+        Sb_Free(scratch);
+        return 0;
     }
-}
 
-typedef int (*long_ivv)(const SbInt_Value *lhs, const SbInt_Value *rhs);
-typedef void (*long_vvr)(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *result);
+    /* a = a1 * B**h + a0; b = b1 * B**h + b0
+       z0 = a0 * b0; z2 = a1 * b1
+       z1 = (a0 + a1) * (b0 + b1) - z0 - z2
+       r = z2 * B**2h + z1 * B**h + z0 */
+    scratch = (SbInt_Digit_t *)Sb_Malloc((4 * h + 4) * sizeof(SbInt_Digit_t));
+    if (!scratch) {
+        return -1;
+    }
+    t1 = scratch;
+    t2 = t1 + (h + 1);
+    z1 = t2 + (h + 1);
 
-static int
-long_coerce_apply_ivv(const SbInt_Value *lhs, const SbInt_Value *rhs, long_ivv func)
-{
-    SbInt_Value lhs_copy;
-    SbInt_Value rhs_copy;
-    SbInt_Digit_t lhs_digits[2];
-    SbInt_Digit_t rhs_digits[2];
+    if (__mag_karatsuba(a, h, b, h, r) < 0) {
+        goto fail;
+    }
+    if (__mag_karatsuba(a + h, na - h, b + h, nb - h, r + 2 * h) < 0) {
+        goto fail;
+    }
 
-    if (LONG_IS_NATIVE(lhs)) {
-        long_convert_digits(&lhs_copy, lhs->u.value, 2, lhs_digits);
-        lhs = &lhs_copy;
+    SbRT_MemCpy(t1, a, h * sizeof(SbInt_Digit_t));
+    t1[h] = __mag_add_in(t1, h, a + h, na - h);
+    SbRT_MemCpy(t2, b, h * sizeof(SbInt_Digit_t));
+    t2[h] = __mag_add_in(t2, h, b + h, nb - h);
+    if (__mag_karatsuba(t1, h + 1, t2, h + 1, z1) < 0) {
+        goto fail;
     }
-    if (LONG_IS_NATIVE(rhs)) {
-        long_convert_digits(&rhs_copy, rhs->u.value, 2, rhs_digits);
-        rhs = &rhs_copy;
+    __mag_sub_in(z1, 2 * h + 2, r, 2 * h);
+    __mag_sub_in(z1, 2 * h + 2, r + 2 * h, na + nb - 2 * h);
+
+    /* z1 fits into what's left of r above h; its excess top digits are zero */
+    length = 2 * h + 2;
+    if (length > na + nb - h) {
+        length = na + nb - h;
     }
-    return func(lhs, rhs);
+    __mag_add_in(r + h, na + nb - h, z1, length);
+    Sb_Free(scratch);
+    return 0;
+
+fail:
+    Sb_Free(scratch);
+    return -1;
 }
 
-int
-SbInt_CompareBool(SbObject *p1, SbObject *p2, SbObjectCompareOp op)
+/* Karatsuba square a magnitude.
+   Assumes: r has 2 * n digits; r doesn't overlap a.
+   Returns: 0 if OK, -1 on allocation failure. */
+static int
+__mag_karatsuba_sqr(const SbInt_Digit_t *a, Sb_ssize_t n, SbInt_Digit_t *r)
 {
-    SbIntObject *i1, *i2;
-    SbInt_Native_t v1, v2;
+    Sb_ssize_t h, length;
+    SbInt_Digit_t *scratch;
+    SbInt_Digit_t *t1, *z1;
 
-    if (!SbInt_Check(p1) || !SbInt_Check(p2)) {
-        SbErr_RaiseWithString(SbExc_SystemError, "non-int object passed to an int method");
+    if (n < KARATSUBA_SQUARE_CUTOFF) {
+        __mag_sqr(a, n, r);
+        return 0;
+    }
+
+    /* z1 = (a0 + a1)**2 - a0**2 - a1**2 */
+    h = (n + 1) / 2;
+    scratch = (SbInt_Digit_t *)Sb_Malloc((3 * h + 3) * sizeof(SbInt_Digit_t));
+    if (!scratch) {
         return -1;
     }
+    t1 = scratch;
+    z1 = t1 + (h + 1);
 
-    i1 = (SbIntObject *)p1;
-    i2 = (SbIntObject *)p2;
-    if (LONG_IS_NATIVE(&i1->v) && LONG_IS_NATIVE(&i2->v)) {
-        v1 = i1->v.u.value;
-        v2 = i2->v.u.value;
+    if (__mag_karatsuba_sqr(a, h, r) < 0) {
+        goto fail;
     }
-    else {
-        v1 = long_coerce_apply_ivv(&i1->v, &i2->v, long_cmp);
-        v2 = 0;
+    if (__mag_karatsuba_sqr(a + h, n - h, r + 2 * h) < 0) {
+        goto fail;
     }
 
-    switch(op) {
-    case Sb_LT:
-        return v1 < v2;
-    case Sb_LE:
-        return v1 <= v2;
-    case Sb_EQ:
-        return v1 == v2;
-    case Sb_NE:
-        return v1 != v2;
-    case Sb_GT:
-        return v1 > v2;
-    case Sb_GE:
-        return v1 >= v2;
+    SbRT_MemCpy(t1, a, h * sizeof(SbInt_Digit_t));
+    t1[h] = __mag_add_in(t1, h, a + h, n - h);
+    if (__mag_karatsuba_sqr(t1, h + 1, z1) < 0) {
+        goto fail;
+    }
+    __mag_sub_in(z1, 2 * h + 2, r, 2 * h);
+    __mag_sub_in(z1, 2 * h + 2, r + 2 * h, 2 * n - 2 * h);
+
+    length = 2 * h + 2;
+    if (length > 2 * n - h) {
+        length = 2 * n - h;
     }
+    __mag_add_in(r + h, 2 * n - h, z1, length);
+    Sb_Free(scratch);
+    return 0;
 
+fail:
+    Sb_Free(scratch);
     return -1;
 }
 
-static SbObject *
-int_do_neginv(
-    const SbInt_Value *val, 
-    int (fnative)(const SbInt_Value *val, SbInt_Value *res),
-    void (flong)(const SbInt_Value *val, SbInt_Value *res))
+/* Obtain the magnitude of an MPI value.
+   If the value is negative, a new digit array is allocated into *copy.
+   Returns: pointer to the magnitude digits, NULL on allocation failure. */
+static const SbInt_Digit_t *
+long_magnitude(const SbInt_Value *o, SbInt_Digit_t **copy)
 {
-    SbIntObject *o_result;
-    SbInt_Value *res;
+    SbInt_Value tmp;
 
-    o_result = (SbIntObject *)SbObject_New(SbInt_Type);
-    if (!o_result) {
+    *copy = NULL;
+    if (!LONG_IS_NEGATIVE(o)) {
+        return o->u.digits;
+    }
+    *copy = long_alloc(o->length);
+    if (!*copy) {
         return NULL;
     }
+    tmp.length = o->length;
+    tmp.u.digits = *copy;
+    /* NOTE: the magnitude of the most negative value is its own bit pattern, which is fine unsigned. */
+    __long_neg(o, &tmp);
+    return *copy;
+}
 
-    res = &o_result->v;
-    LONG_SET_NATIVE(res);
-    if (LONG_IS_NATIVE(val)) {
-        if (fnative(val, res) < 0) {
-            Sb_DECREF(o_result);
-            return NULL;
-        }
+/* Multiply two MPI values via magnitudes, using the subquadratic paths.
+   Assumes: result->length == lhs->length + rhs->length
+   NOTE: Does NOT allow aliasing with the result.
+   Returns: 0 if OK, -1 on allocation failure. */
+static int
+__long_mul_fast(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *result)
+{
+    const SbInt_Digit_t *a, *b;
+    SbInt_Digit_t *a_copy, *b_copy;
+    int rv;
+
+    rv = -1;
+    b_copy = NULL;
+    a = long_magnitude(lhs, &a_copy);
+    if (!a) {
+        goto exit;
+    }
+    if (lhs == rhs) {
+        rv = __mag_karatsuba_sqr(a, lhs->length, result->u.digits);
+        goto exit;
+    }
+    b = long_magnitude(rhs, &b_copy);
+    if (!b) {
+        goto exit;
+    }
+    rv = __mag_karatsuba(a, lhs->length, b, rhs->length, result->u.digits);
+    if (rv == 0 && LONG_IS_NEGATIVE(lhs) != LONG_IS_NEGATIVE(rhs)) {
+        __long_neg(result, result);
     }
-    else {
-        SbInt_Digit_t *digits;
 
-        digits = long_alloc(val->length);
-        if (!digits) {
-            Sb_DECREF(o_result);
-            return NULL;
-        }
-        res->length = val->length;
-        res->u.digits = digits;
-        flong(val, res);
+exit:
+    long_free(a_copy);
+    long_free(b_copy);
+    return rv;
+}
+
+/* Count leading zero bits in a nonzero digit. */
+static int
+digit_clz(SbInt_Digit_t d)
+{
+    int n;
+
+    n = 0;
+    if (!(d & 0xFFFF0000u)) { n += 16; d <<= 16; }
+    if (!(d & 0xFF000000u)) { n += 8; d <<= 8; }
+    if (!(d & 0xF0000000u)) { n += 4; d <<= 4; }
+    if (!(d & 0xC0000000u)) { n += 2; d <<= 2; }
+    if (!(d & 0x80000000u)) { n += 1; }
+    return n;
+}
+
+/* Divide a magnitude by a single digit.
+   Assumes: q has na digits; q may alias a.
+   Returns: the remainder. */
+static SbInt_Digit_t
+__mag_divmod_1(const SbInt_Digit_t *a, Sb_ssize_t na, SbInt_Digit_t d, SbInt_Digit_t *q)
+{
+    SbInt_DoubleDigit_t rem;
+    Sb_ssize_t i;
+
+    rem = 0;
+    for (i = na - 1; i >= 0; --i) {
+        rem = (rem << SbInt_DIGIT_BITS) | a[i];
+        q[i] = (SbInt_Digit_t)(rem / d);
+        rem %= d;
     }
-    /* No length correction required */
-    return (SbObject *)o_result;
+    return (SbInt_Digit_t)rem;
 }
 
+/* Divide magnitudes with Knuth's Algorithm D (TAOCP 4.3.1).
+   Assumes: na >= nb >= 2; b[nb - 1] != 0;
+            q has na - nb + 1 digits, r has nb digits; neither overlaps a or b.
+   Returns: 0 if OK, -1 on allocation failure. */
 static int
-int_negate_native(const SbInt_Value *val, SbInt_Value *res)
+__mag_divmod(const SbInt_Digit_t *a, Sb_ssize_t na, const SbInt_Digit_t *b, Sb_ssize_t nb, SbInt_Digit_t *q, SbInt_Digit_t *r)
 {
-    if (SbInt_NATIVE_MIN == val->u.value) {
-        SbInt_Digit_t *digits;
+    SbInt_Digit_t *u, *v;
+    SbInt_Digit_t vtop, vnext;
+    Sb_ssize_t i, j;
+    int s;
 
-        digits = long_alloc(3);
-        if (!digits) {
-            return -1;
+    u = long_alloc(na + 1 + nb);
+    if (!u) {
+        return -1;
+    }
+    v = u + na + 1;
+
+    /* D1: normalize so the divisor's top bit is set; this keeps qhat within 2 of the truth. */
+    s = digit_clz(b[nb - 1]);
+    if (s) {
+        for (i = nb - 1; i > 0; --i) {
+            v[i] = (b[i] << s) | (b[i - 1] >> (SbInt_DIGIT_BITS - s));
         }
-        res->length = 3;
-        res->u.digits = digits;
-        digits[0] = (SbInt_Digit_t)SbInt_NATIVE_MIN;
-        digits[1] = (SbInt_Digit_t)(SbInt_NATIVE_MIN >> SbInt_DIGIT_BITS);
-        digits[2] = 0;
+        v[0] = b[0] << s;
+        u[na] = a[na - 1] >> (SbInt_DIGIT_BITS - s);
+        for (i = na - 1; i > 0; --i) {
+            u[i] = (a[i] << s) | (a[i - 1] >> (SbInt_DIGIT_BITS - s));
+        }
+        u[0] = a[0] << s;
     }
-    res->u.value = -val->u.value;
+    else {
+        SbRT_MemCpy(v, b, nb * sizeof(SbInt_Digit_t));
+        SbRT_MemCpy(u, a, na * sizeof(SbInt_Digit_t));
+        u[na] = 0;
+    }
+    vtop = v[nb - 1];
+    vnext = v[nb - 2];
+
+    for (j = na - nb; j >= 0; --j) {
+        SbInt_DoubleDigit_t num, qhat, rhat;
+        SbInt_SignDoubleDigit_t t, k;
+
+        /* D3: estimate the quotient digit from the top two digits */
+        num = ((SbInt_DoubleDigit_t)u[j + nb] << SbInt_DIGIT_BITS) | u[j + nb - 1];
+        qhat = num / vtop;
+        rhat = num % vtop;
+        while (qhat > SbInt_DIGIT_MASK
+            || Sb_Mulu32x32As64((SbInt_Digit_t)qhat, vnext) > ((rhat << SbInt_DIGIT_BITS) | u[j + nb - 2])) {
+            --qhat;
+            rhat += vtop;
+            if (rhat > SbInt_DIGIT_MASK) {
+                break;
+            }
+        }
+
+        /* D4: multiply and subtract */
+        k = 0;
+        for (i = 0; i < nb; ++i) {
+            SbInt_DoubleDigit_t p;
+
+            p = Sb_Mulu32x32As64((SbInt_Digit_t)qhat, v[i]);
+            t = (SbInt_SignDoubleDigit_t)u[i + j] - k - (SbInt_SignDoubleDigit_t)(p & SbInt_DIGIT_MASK);
+            u[i + j] = (SbInt_Digit_t)t;
+            k = (SbInt_SignDoubleDigit_t)(p >> SbInt_DIGIT_BITS) - (t >> SbInt_DIGIT_BITS);
+        }
+        t = (SbInt_SignDoubleDigit_t)u[j + nb] - k;
+        u[j + nb] = (SbInt_Digit_t)t;
+
+        /* D5, D6: the estimate was one too big (rare); add back */
+        q[j] = (SbInt_Digit_t)qhat;
+        if (t < 0) {
+            SbInt_DoubleDigit_t c;
+
+            q[j] -= 1;
+            c = 0;
+            for (i = 0; i < nb; ++i) {
+                c += (SbInt_DoubleDigit_t)u[i + j] + v[i];
+                u[i + j] = (SbInt_Digit_t)c;
+                c >>= SbInt_DIGIT_BITS;
+            }
+            u[j + nb] += (SbInt_Digit_t)c;
+        }
+    }
+
+    /* D8: unnormalize the remainder */
+    if (s) {
+        for (i = 0; i < nb - 1; ++i) {
+            r[i] = (u[i] >> s) | (u[i + 1] << (SbInt_DIGIT_BITS - s));
+        }
+        r[nb - 1] = u[nb - 1] >> s;
+    }
+    else {
+        SbRT_MemCpy(r, u, nb * sizeof(SbInt_Digit_t));
+    }
+
+    long_free(u);
     return 0;
 }
 
-SbObject *
-SbInt_Negate(SbObject *o)
+/* Turn a magnitude (with a spare zero top digit) into an MPI value of the given sign.
+   Takes ownership of digits. */
+static void
+long_from_magnitude(SbInt_Value *o, SbInt_Digit_t *digits, Sb_ssize_t length, int negative)
 {
-    return int_do_neginv(&((SbIntObject *)o)->v, int_negate_native, __long_neg);
+    o->length = length;
+    o->u.digits = digits;
+    if (negative) {
+        __long_neg(o, o);
+    }
+    long_reduce(o);
 }
 
+/* Divide two MPI values with floor semantics: q = floor(lhs / rhs), r = lhs - q * rhs.
+   The remainder has the sign of the divisor.
+   Assumes: rhs != 0; q and r are native (digits are not freed).
+   Returns: 0 if OK, -1 on allocation failure. */
 static int
-int_invert_native(const SbInt_Value *val, SbInt_Value *res)
+long_divmod(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *q, SbInt_Value *r)
 {
-    res->u.value = ~val->u.value;
-    return 0;
+    const SbInt_Digit_t *a, *b;
+    SbInt_Digit_t *a_copy, *b_copy;
+    SbInt_Digit_t *qd, *rd;
+    Sb_ssize_t na, nb, nq;
+    int a_negative, b_negative;
+    int rv;
+
+    rv = -1;
+    qd = rd = b_copy = NULL;
+    a_negative = LONG_IS_NEGATIVE(lhs);
+    b_negative = LONG_IS_NEGATIVE(rhs);
+    a = long_magnitude(lhs, &a_copy);
+    if (!a) {
+        goto exit;
+    }
+    b = long_magnitude(rhs, &b_copy);
+    if (!b) {
+        goto exit;
+    }
+    na = lhs->length;
+    while (na > 0 && !a[na - 1]) {
+        --na;
+    }
+    nb = rhs->length;
+    while (!b[nb - 1]) {
+        --nb;
+    }
+
+    /* Both get a spare digit for the sign, the quotient one more for the floor correction. */
+    nq = na >= nb ? na - nb + 1 : 0;
+    qd = long_alloc(nq + 2);
+    rd = long_alloc(nb + 1);
+    if (!qd || !rd) {
+        goto exit;
+    }
+
+    if (na < nb) {
+        SbRT_MemCpy(rd, a, na * sizeof(SbInt_Digit_t));
+    }
+    else if (nb == 1) {
+        rd[0] = __mag_divmod_1(a, na, b[0], qd);
+    }
+    else if (__mag_divmod(a, na, b, nb, qd, rd) < 0) {
+        goto exit;
+    }
+
+    if (a_negative != b_negative) {
+        Sb_ssize_t i;
+
+        for (i = 0; i < nb && !rd[i]; ++i) {
+        }
+        if (i < nb) {
+            /* Round towards negative infinity: q += 1, r = |b| - r */
+            SbInt_Digit_t one = 1;
+            SbInt_Value tmp;
+
+            __mag_add_in(qd, nq + 2, &one, 1);
+            __mag_sub_in(rd, nb + 1, b, nb);
+            tmp.length = nb + 1;
+            tmp.u.digits = rd;
+            __long_neg(&tmp, &tmp);
+        }
+    }
+
+    long_from_magnitude(q, qd, nq + 2, a_negative != b_negative);
+    long_from_magnitude(r, rd, nb + 1, b_negative);
+    qd = rd = NULL;
+    rv = 0;
+
+exit:
+    long_free(qd);
+    long_free(rd);
+    long_free(a_copy);
+    long_free(b_copy);
+    return rv;
+}
+
+
+/*
+ * C interface implementations
+ */
+
+void
+_SbInt_SetFromNative(SbObject *self, SbInt_Native_t ival)
+{
+    SbIntObject *myself = (SbIntObject *)self;
+
+    LONG_SET_NATIVE(&myself->v);
+    myself->v.u.value = ival;
 }
 
 SbObject *
-SbInt_Invert(SbObject *o)
+SbInt_FromNative(SbInt_Native_t ival)
 {
-    return int_do_neginv(&((SbIntObject *)o)->v, int_invert_native, __long_inv);
+    SbIntObject *myself;
+
+#if SUPPORTS(TAGGED_INTS)
+    if (SbInt_FITS_TAGGED(ival)) {
+        return SbInt_TAG(ival);
+    }
+#else
+    if (ival >= SMALL_INT_MIN && ival <= SMALL_INT_MAX && small_ints[ival - SMALL_INT_MIN]) {
+        /* No need to incref -- these are immortal. */
+        return small_ints[ival - SMALL_INT_MIN];
+    }
+#endif
+
+    myself = (SbIntObject *)SbObject_New(SbInt_Type);
+    if (myself) {
+        _SbInt_SetFromNative((SbObject *)myself, ival);
+    }
+    return (SbObject *)myself;
 }
 
 SbObject *
-SbInt_Absolute(SbObject *o)
+SbInt_FromLengthAndDigits(Sb_ssize_t length, SbInt_Digit_t *digits)
 {
-    const SbInt_Value *val = &((SbIntObject *)o)->v;
+    SbIntObject *myself;
+    myself = (SbIntObject *)SbObject_New(SbInt_Type);
+    if (myself) {
+        SbInt_Digit_t *new_digits;
 
-    if (LONG_IS_NATIVE(val)) {
-        if (val->u.value < 0) {
-            return SbInt_Negate(o);
+        new_digits = long_alloc(length);
+        if (!new_digits) {
+            Sb_DECREF(myself);
+            return NULL;
         }
-    }
-    else {
-        if (LONG_IS_NEGATIVE(val)) {
-            return SbInt_Negate(o);
+        myself->v.length = length;
+        myself->v.u.digits = new_digits;
+        if (digits) {
+            SbRT_MemCpy(new_digits, digits, length * sizeof(SbInt_Digit_t));
+            long_reduce(&myself->v);
+            return int_pack(myself);
         }
     }
-    Sb_INCREF(o);
-    return o;
+    return (SbObject *)myself;
 }
 
 SbObject *
-SbInt_ShiftLeft(SbObject *lhs, int rhs)
+SbInt_FromHalfDigits(Sb_ssize_t count, const SbInt_HalfDigit_t *halves)
 {
-    const SbInt_Value *val = &((SbIntObject *)lhs)->v;
-    SbInt_Value lhs_copy;
-    SbInt_Digit_t lhs_digits[2];
-    SbIntObject *o_result;
-    SbInt_Value *res;
+    SbIntObject *myself;
+    SbInt_Digit_t *digits;
+    Sb_ssize_t i;
 
-    o_result = (SbIntObject *)SbObject_New(SbInt_Type);
-    if (!o_result) {
+    if (count <= 0) {
+        return SbInt_FromNative(0);
+    }
+
+    myself = (SbIntObject *)SbInt_FromLengthAndDigits((count + 1) / 2, NULL);
+    if (!myself) {
         return NULL;
     }
 
-    res = &o_result->v;
-    LONG_SET_NATIVE(res);
+    digits = myself->v.u.digits;
+    for (i = 0; i + 1 < count; i += 2) {
+        *digits++ = halves[i] | ((SbInt_Digit_t)halves[i + 1] << SbInt_HALF_DIGIT_BITS);
+    }
+    if (i < count) {
+        /* Odd count: sign-extend the top half */
+        *digits = (SbInt_Digit_t)(SbInt_SignDigit_t)(signed short)halves[i];
+    }
+    long_reduce(&myself->v);
+    return int_pack(myself);
+}
 
-    if (LONG_IS_NATIVE(val)) {
-        int bitcount;
+SbInt_Native_t
+SbInt_AsNativeOverflow(SbObject *op, int *overflow_flag)
+{
+    const SbInt_Value *val;
+    SbInt_Value storage;
 
-        bitcount = int_native_bitcount(val->u.value);
-        if (bitcount + rhs < 30) {
-            res->u.value = val->u.value << rhs;
-            return (SbObject *)o_result;
-        }
-        long_convert_digits(&lhs_copy, val->u.value, 2, lhs_digits);
-        val = &lhs_copy;
+#if SUPPORTS(BUILTIN_TYPECHECKS)
+    if (!SbInt_Check(op)) {
+        SbErr_RaiseWithString(SbExc_SystemError, "non-int object passed to an int method");
+        return -1;
     }
+#endif
 
-    res->length = val->length + (rhs / SbInt_DIGIT_BITS) + 1;
-    res->u.digits = long_alloc(res->length);
-    if (!res->u.digits) {
-        Sb_DECREF(o_result);
-        return NULL;
+    val = INT_VALUE(op, &storage);
+    if (LONG_IS_NATIVE(val)) {
+        if (overflow_flag) {
+            *overflow_flag = 0;
+        }
+        return val->u.value;
     }
-    __long_shl(val, rhs, res);
-    long_reduce(res);
-    return (SbObject *)o_result;
+    /* Digit form is always reduced, thus can't be represented. */
+    if (overflow_flag) {
+        *overflow_flag = 1;
+    }
+    return -1;
 }
 
-SbObject *
-SbInt_ShiftRight(SbObject *lhs, int rhs)
+SbInt_Native_t
+SbInt_AsNative(SbObject *op)
 {
-    const SbInt_Value *val = &((SbIntObject *)lhs)->v;
-    SbIntObject *o_result;
-    SbInt_Value *res;
+    SbInt_Native_t result;
+    int overflow_flag;
 
-    o_result = (SbIntObject *)SbObject_New(SbInt_Type);
-    if (!o_result) {
-        return NULL;
+    result = SbInt_AsNativeOverflow(op, &overflow_flag);
+    if (result == -1 && overflow_flag) {
     }
+    return result;
+}
 
-    res = &o_result->v;
+static void
+long_convert_digits(SbInt_Value *value, SbInt_Native_t native_value, Sb_size_t digits_length, SbInt_Digit_t *digits)
+{
+    SbInt_SignDoubleDigit_t t;
 
-    if (LONG_IS_NATIVE(val)) {
-        /* No overflow is possible here. */
-        LONG_SET_NATIVE(res);
-        res->u.value = val->u.value >> rhs;
-        return (SbObject *)o_result;
-    }
+    value->length = digits_length;
+    value->u.digits = digits;
 
-    res->length = val->length - (rhs / SbInt_DIGIT_BITS);
-    res->u.digits = long_alloc(res->length);
-    if (!res->u.digits) {
-        Sb_DECREF(o_result);
-        return NULL;
+    /* Go through a double digit: the native type may be as wide as a digit. */
+    t = native_value;
+    while (digits_length-- > 0) {
+        *digits++ = (SbInt_Digit_t)t;
+        t >>= SbInt_DIGIT_BITS;
     }
-    __long_shr(val, rhs, res);
-    long_reduce(res);
-    return (SbObject *)o_result;
 }
 
-typedef int (*int_binary_op)(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *res);
+typedef int (*long_ivv)(const SbInt_Value *lhs, const SbInt_Value *rhs);
+typedef void (*long_vvr)(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *result);
 
-static SbObject *
-int_do_binary_op(const SbInt_Value *lhs, const SbInt_Value *rhs, int_binary_op fnative, int_binary_op flong)
+static int
+long_coerce_apply_ivv(const SbInt_Value *lhs, const SbInt_Value *rhs, long_ivv func)
 {
-    SbIntObject *result;
     SbInt_Value lhs_copy;
     SbInt_Value rhs_copy;
-    SbInt_Digit_t lhs_digits[2];
-    SbInt_Digit_t rhs_digits[2];
-
-    result = (SbIntObject *)SbObject_New(SbInt_Type);
-    if (!result) {
-        return NULL;
-    }
-    LONG_SET_NATIVE(&result->v);
-
-    if (LONG_IS_NATIVE(lhs) && LONG_IS_NATIVE(rhs)) {
-        if (!fnative(lhs, rhs, &result->v)) {
-            return (SbObject *)result;
-        }
-    }
+    SbInt_Digit_t lhs_digits[LONG_NATIVE_DIGITS];
+    SbInt_Digit_t rhs_digits[LONG_NATIVE_DIGITS];
 
     if (LONG_IS_NATIVE(lhs)) {
-        long_convert_digits(&lhs_copy, lhs->u.value, 2, lhs_digits);
+        long_convert_digits(&lhs_copy, lhs->u.value, LONG_NATIVE_DIGITS, lhs_digits);
         lhs = &lhs_copy;
     }
     if (LONG_IS_NATIVE(rhs)) {
-        long_convert_digits(&rhs_copy, rhs->u.value, 2, rhs_digits);
+        long_convert_digits(&rhs_copy, rhs->u.value, LONG_NATIVE_DIGITS, rhs_digits);
         rhs = &rhs_copy;
     }
-
-    if (flong(lhs, rhs, &result->v) < 0) {
-        Sb_DECREF(result);
-        return NULL;
-    }
-    long_reduce(&result->v);
-    return (SbObject *)result;
+    return func(lhs, rhs);
 }
 
-static int
-int_add_native(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *res)
+int
+SbInt_CompareBool(SbObject *p1, SbObject *p2, SbObjectCompareOp op)
 {
-    SbInt_Native_t a, b, rv;
+    const SbInt_Value *i1, *i2;
+    SbInt_Value s1, s2;
+    SbInt_Native_t v1, v2;
 
-    a = lhs->u.value;
-    b = rhs->u.value;
-    res->u.value = rv = a + b;
-    /* Signed integer overflow of addition occurs if and only if
-    the operands have the same sign and 
-    the sum has a sign opposite to that of the operands. */
-    return (~(a ^ b) && ((rv ^ b) & 0x80000000U));
-}
+    if (!SbInt_Check(p1) || !SbInt_Check(p2)) {
+        SbErr_RaiseWithString(SbExc_SystemError, "non-int object passed to an int method");
+        return -1;
+    }
 
-static int
+    i1 = INT_VALUE(p1, &s1);
+    i2 = INT_VALUE(p2, &s2);
+    if (LONG_IS_NATIVE(i1) && LONG_IS_NATIVE(i2)) {
+        v1 = i1->u.value;
+        v2 = i2->u.value;
+    }
+    else {
+        v1 = long_coerce_apply_ivv(i1, i2, long_cmp);
+        v2 = 0;
+    }
+
+    switch(op) {
+    case Sb_LT:
+        return v1 < v2;
+    case Sb_LE:
+        return v1 <= v2;
+    case Sb_EQ:
+        return v1 == v2;
+    case Sb_NE:
+        return v1 != v2;
+    case Sb_GT:
+        return v1 > v2;
+    case Sb_GE:
+        return v1 >= v2;
+    }
+
+    return -1;
+}
+
+static SbObject *
+int_do_neginv(
+    const SbInt_Value *val, 
+    int (fnative)(const SbInt_Value *val, SbInt_Value *res),
+    void (flong)(const SbInt_Value *val, SbInt_Value *res))
+{
+    SbIntObject *o_result;
+    SbInt_Value res;
+
+    LONG_SET_NATIVE(&res);
+    if (LONG_IS_NATIVE(val)) {
+        if (fnative(val, &res) < 0) {
+            return NULL;
+        }
+        if (LONG_IS_NATIVE(&res)) {
+            return SbInt_FromNative(res.u.value);
+        }
+    }
+    else {
+        res.length = val->length + 1;
+        res.u.digits = long_alloc(res.length);
+        if (!res.u.digits) {
+            return NULL;
+        }
+        flong(val, &res);
+        long_reduce(&res);
+        if (LONG_IS_NATIVE(&res)) {
+            return SbInt_FromNative(res.u.value);
+        }
+    }
+
+    o_result = (SbIntObject *)SbObject_New(SbInt_Type);
+    if (!o_result) {
+        long_free(res.u.digits);
+        return NULL;
+    }
+    o_result->v = res;
+    return (SbObject *)o_result;
+}
+
+static int
+int_negate_native(const SbInt_Value *val, SbInt_Value *res)
+{
+    if (SbInt_NATIVE_MIN == val->u.value) {
+        SbInt_Digit_t *digits;
+        SbInt_Value tmp;
+
+        /* -MIN is MIN's bit pattern, zero-extended by one digit. */
+        digits = long_alloc(LONG_NATIVE_DIGITS + 1);
+        if (!digits) {
+            return -1;
+        }
+        long_convert_digits(&tmp, SbInt_NATIVE_MIN, LONG_NATIVE_DIGITS, digits);
+        res->length = LONG_NATIVE_DIGITS + 1;
+        res->u.digits = digits;
+        return 0;
+    }
+    res->u.value = -val->u.value;
+    return 0;
+}
+
+SbObject *
+SbInt_Negate(SbObject *o)
+{
+    SbInt_Value storage;
+
+    return int_do_neginv(INT_VALUE(o, &storage), int_negate_native, __long_neg);
+}
+
+static int
+int_invert_native(const SbInt_Value *val, SbInt_Value *res)
+{
+    res->u.value = ~val->u.value;
+    return 0;
+}
+
+SbObject *
+SbInt_Invert(SbObject *o)
+{
+    SbInt_Value storage;
+
+    return int_do_neginv(INT_VALUE(o, &storage), int_invert_native, __long_inv);
+}
+
+SbObject *
+SbInt_Absolute(SbObject *o)
+{
+    SbInt_Value storage;
+    const SbInt_Value *val = INT_VALUE(o, &storage);
+
+    if (LONG_IS_NATIVE(val)) {
+        if (val->u.value < 0) {
+            return SbInt_Negate(o);
+        }
+    }
+    else {
+        if (LONG_IS_NEGATIVE(val)) {
+            return SbInt_Negate(o);
+        }
+    }
+    Sb_INCREF(o);
+    return o;
+}
+
+SbObject *
+SbInt_ShiftLeft(SbObject *lhs, int rhs)
+{
+    SbInt_Value storage;
+    const SbInt_Value *val = INT_VALUE(lhs, &storage);
+    SbInt_Value lhs_copy;
+    SbInt_Digit_t lhs_digits[LONG_NATIVE_DIGITS];
+    SbIntObject *o_result;
+    SbInt_Value *res;
+
+    if (LONG_IS_NATIVE(val)) {
+        int bitcount;
+
+        bitcount = int_native_bitcount(val->u.value);
+        if (bitcount + rhs < NATIVE_BITS - 2) {
+            return SbInt_FromNative(val->u.value << rhs);
+        }
+        long_convert_digits(&lhs_copy, val->u.value, LONG_NATIVE_DIGITS, lhs_digits);
+        val = &lhs_copy;
+    }
+
+    o_result = (SbIntObject *)SbObject_New(SbInt_Type);
+    if (!o_result) {
+        return NULL;
+    }
+
+    res = &o_result->v;
+    LONG_SET_NATIVE(res);
+
+    res->length = val->length + (rhs / SbInt_DIGIT_BITS) + 1;
+    res->u.digits = long_alloc(res->length);
+    if (!res->u.digits) {
+        Sb_DECREF(o_result);
+        return NULL;
+    }
+    __long_shl(val, rhs, res);
+    long_reduce(res);
+    return int_pack(o_result);
+}
+
+SbObject *
+SbInt_ShiftRight(SbObject *lhs, int rhs)
+{
+    SbInt_Value storage;
+    const SbInt_Value *val = INT_VALUE(lhs, &storage);
+    SbIntObject *o_result;
+    SbInt_Value *res;
+
+    if (LONG_IS_NATIVE(val)) {
+        /* No overflow is possible here. */
+        return SbInt_FromNative(val->u.value >> (rhs < NATIVE_BITS ? rhs : NATIVE_BITS - 1));
+    }
+    if (rhs / SbInt_DIGIT_BITS >= val->length) {
+        /* Everything is shifted out but the sign. */
+        return SbInt_FromNative(LONG_IS_NEGATIVE(val) ? -1 : 0);
+    }
+
+    o_result = (SbIntObject *)SbObject_New(SbInt_Type);
+    if (!o_result) {
+        return NULL;
+    }
+
+    res = &o_result->v;
+
+    res->length = val->length - (rhs / SbInt_DIGIT_BITS);
+    res->u.digits = long_alloc(res->length);
+    if (!res->u.digits) {
+        Sb_DECREF(o_result);
+        return NULL;
+    }
+    __long_shr(val, rhs, res);
+    long_reduce(res);
+    return int_pack(o_result);
+}
+
+typedef int (*int_binary_op)(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *res);
+
+static SbObject *
+int_do_binary_op(const SbInt_Value *lhs, const SbInt_Value *rhs, int_binary_op fnative, int_binary_op flong)
+{
+    SbIntObject *result;
+    SbInt_Value lhs_copy;
+    SbInt_Value rhs_copy;
+    SbInt_Digit_t lhs_digits[LONG_NATIVE_DIGITS];
+    SbInt_Digit_t rhs_digits[LONG_NATIVE_DIGITS];
+
+    if (LONG_IS_NATIVE(lhs) && LONG_IS_NATIVE(rhs)) {
+        SbInt_Value native_result;
+
+        if (!fnative(lhs, rhs, &native_result)) {
+            /* This picks up cached small ints, too. */
+            return SbInt_FromNative(native_result.u.value);
+        }
+    }
+
+    result = (SbIntObject *)SbObject_New(SbInt_Type);
+    if (!result) {
+        return NULL;
+    }
+    LONG_SET_NATIVE(&result->v);
+
+    if (LONG_IS_NATIVE(lhs)) {
+        long_convert_digits(&lhs_copy, lhs->u.value, LONG_NATIVE_DIGITS, lhs_digits);
+        lhs = &lhs_copy;
+    }
+    if (LONG_IS_NATIVE(rhs)) {
+        long_convert_digits(&rhs_copy, rhs->u.value, LONG_NATIVE_DIGITS, rhs_digits);
+        rhs = &rhs_copy;
+    }
+
+    if (flong(lhs, rhs, &result->v) < 0) {
+        Sb_DECREF(result);
+        return NULL;
+    }
+    long_reduce(&result->v);
+    return int_pack(result);
+}
+
+static int
+int_add_native(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *res)
+{
+#ifdef Sb_AddOverflow
+    return Sb_AddOverflow(lhs->u.value, rhs->u.value, &res->u.value);
+#else
+    SbInt_Native_t a, b, rv;
+
+    a = lhs->u.value;
+    b = rhs->u.value;
+    res->u.value = rv = (SbInt_Native_t)((Sb_size_t)a + (Sb_size_t)b);
+    /* Signed integer overflow of addition occurs if and only if
+    the operands have the same sign and 
+    the sum has a sign opposite to that of the operands. */
+    return ((rv ^ a) & (rv ^ b)) < 0;
+#endif
+}
+
+static int
 int_add_long(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *res)
 {
     Sb_ssize_t length;
 
-    length = (lhs->length > rhs->length ? lhs->length : rhs->length) + 1;
-    res->u.digits = long_alloc(length);
-    if (!res->u.digits) {
-        return -1;
+    length = (lhs->length > rhs->length ? lhs->length : rhs->length) + 1;
+    res->u.digits = long_alloc(length);
+    if (!res->u.digits) {
+        return -1;
+    }
+    res->length = length;
+    __long_add(lhs, rhs, res);
+    return 0;
+}
+
+SbObject *
+SbInt_Add(SbObject *lhs, SbObject *rhs)
+{
+    SbInt_Value lhs_storage;
+    SbInt_Value rhs_storage;
+
+    return int_do_binary_op(INT_VALUE(lhs, &lhs_storage), INT_VALUE(rhs, &rhs_storage), int_add_native, int_add_long);
+}
+
+static int
+int_sub_native(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *res)
+{
+#ifdef Sb_SubOverflow
+    return Sb_SubOverflow(lhs->u.value, rhs->u.value, &res->u.value);
+#else
+    SbInt_Native_t a, b, rv;
+
+    a = lhs->u.value;
+    b = rhs->u.value;
+    res->u.value = rv = (SbInt_Native_t)((Sb_size_t)a - (Sb_size_t)b);
+    /* Overflow occurs if and only if the operands have different signs
+    and the difference has a sign opposite to that of the minuend. */
+    return ((a ^ b) & (rv ^ a)) < 0;
+#endif
+}
+
+static int
+int_sub_long(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *res)
+{
+    Sb_ssize_t length;
+
+    length = (lhs->length > rhs->length ? lhs->length : rhs->length) + 1;
+    res->u.digits = long_alloc(length);
+    if (!res->u.digits) {
+        return -1;
+    }
+    res->length = length;
+    __long_sub(lhs, rhs, res);
+    return 0;
+}
+
+SbObject *
+SbInt_Subtract(SbObject *lhs, SbObject *rhs)
+{
+    SbInt_Value lhs_storage;
+    SbInt_Value rhs_storage;
+
+    return int_do_binary_op(INT_VALUE(lhs, &lhs_storage), INT_VALUE(rhs, &rhs_storage), int_sub_native, int_sub_long);
+}
+
+static int
+int_mul_native(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *res)
+{
+#ifdef Sb_MulOverflow
+    return Sb_MulOverflow(lhs->u.value, rhs->u.value, &res->u.value);
+#else
+    SbInt_Native_t a, b;
+
+    a = lhs->u.value;
+    b = rhs->u.value;
+
+    /* Conservative: may send a product that would still fit to the long path. */
+    if (int_native_bitcount(a) + int_native_bitcount(b) > NATIVE_BITS - 2) {
+        return 1;
+    }
+
+    res->u.value = a * b;
+    return 0;
+#endif
+}
+
+static int
+int_mul_long(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *res)
+{
+    Sb_ssize_t length;
+
+    length = lhs->length + rhs->length;
+    res->u.digits = long_alloc(length);
+    if (!res->u.digits) {
+        return -1;
+    }
+    res->length = length;
+    if (lhs == rhs || (lhs->length >= KARATSUBA_CUTOFF && rhs->length >= KARATSUBA_CUTOFF)) {
+        return __long_mul_fast(lhs, rhs, res);
+    }
+    __long_mul(lhs, rhs, res);
+    return 0;
+}
+
+SbObject *
+SbInt_Multiply(SbObject *lhs, SbObject *rhs)
+{
+    SbInt_Value lhs_storage;
+    SbInt_Value rhs_storage;
+
+    return int_do_binary_op(INT_VALUE(lhs, &lhs_storage), INT_VALUE(rhs, &rhs_storage), int_mul_native, int_mul_long);
+}
+
+/* Divide with floor semantics; either of q_out, r_out may be NULL.
+   Returns: 0 if OK, -1 on error. */
+static int
+int_divmod(SbObject *lhs, SbObject *rhs, SbObject **q_out, SbObject **r_out)
+{
+    SbInt_Value lhs_storage;
+    SbInt_Value rhs_storage;
+    const SbInt_Value *lv = INT_VALUE(lhs, &lhs_storage);
+    const SbInt_Value *rv = INT_VALUE(rhs, &rhs_storage);
+    SbInt_Value lhs_copy;
+    SbInt_Value rhs_copy;
+    SbInt_Digit_t lhs_digits[LONG_NATIVE_DIGITS];
+    SbInt_Digit_t rhs_digits[LONG_NATIVE_DIGITS];
+    SbIntObject *q, *r;
+
+    if (LONG_IS_ZERO(rv)) {
+        SbErr_RaiseWithString(SbExc_ZeroDivisionError, "integer division or modulo by zero");
+        return -1;
+    }
+
+    /* MIN / -1 is the only native quotient that overflows. */
+    if (LONG_IS_NATIVE(lv) && LONG_IS_NATIVE(rv) && !(lv->u.value == SbInt_NATIVE_MIN && rv->u.value == -1)) {
+        SbInt_Native_t a, b, nq, nr;
+
+        a = lv->u.value;
+        b = rv->u.value;
+        nq = a / b;
+        nr = a % b;
+        /* C truncates; correct towards negative infinity. */
+        if (nr && ((nr ^ b) < 0)) {
+            nr += b;
+            nq -= 1;
+        }
+        if (q_out) {
+            *q_out = SbInt_FromNative(nq);
+            if (!*q_out) {
+                return -1;
+            }
+        }
+        if (r_out) {
+            *r_out = SbInt_FromNative(nr);
+            if (!*r_out) {
+                if (q_out) {
+                    Sb_CLEAR(*q_out);
+                }
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    if (LONG_IS_NATIVE(lv)) {
+        long_convert_digits(&lhs_copy, lv->u.value, LONG_NATIVE_DIGITS, lhs_digits);
+        lv = &lhs_copy;
+    }
+    if (LONG_IS_NATIVE(rv)) {
+        long_convert_digits(&rhs_copy, rv->u.value, LONG_NATIVE_DIGITS, rhs_digits);
+        rv = &rhs_copy;
+    }
+
+    q = (SbIntObject *)SbObject_New(SbInt_Type);
+    r = (SbIntObject *)SbObject_New(SbInt_Type);
+    if (!q || !r) {
+        goto fail;
+    }
+    LONG_SET_NATIVE(&q->v);
+    LONG_SET_NATIVE(&r->v);
+    if (long_divmod(lv, rv, &q->v, &r->v) < 0) {
+        SbErr_NoMemory();
+        goto fail;
+    }
+
+    if (q_out) {
+        *q_out = int_pack(q);
+    }
+    else {
+        Sb_DECREF(q);
+    }
+    if (r_out) {
+        *r_out = int_pack(r);
+    }
+    else {
+        Sb_DECREF(r);
+    }
+    return 0;
+
+fail:
+    Sb_XDECREF(q);
+    Sb_XDECREF(r);
+    return -1;
+}
+
+SbObject *
+SbInt_FloorDivide(SbObject *lhs, SbObject *rhs)
+{
+    SbObject *q;
+
+    if (int_divmod(lhs, rhs, &q, NULL) < 0) {
+        return NULL;
+    }
+    return q;
+}
+
+SbObject *
+SbInt_Remainder(SbObject *lhs, SbObject *rhs)
+{
+    SbObject *r;
+
+    if (int_divmod(lhs, rhs, NULL, &r) < 0) {
+        return NULL;
+    }
+    return r;
+}
+
+SbObject *
+SbInt_DivMod(SbObject *lhs, SbObject *rhs)
+{
+    SbObject *q, *r;
+    SbObject *result;
+
+    if (int_divmod(lhs, rhs, &q, &r) < 0) {
+        return NULL;
+    }
+    result = SbTuple_Pack(2, q, r);
+    Sb_DECREF(q);
+    Sb_DECREF(r);
+    return result;
+}
+
+
+/*
+ * Radix conversion
+ *
+ * Decimal conversion works in chunks of 9 characters, 10^9 being the largest
+ * power of 10 to fit a digit. Short values go chunk by chunk, which is quadratic;
+ * long values are split in halves by a power 10^(9 * 2^k) and converted recursively.
+ * Parsing thus costs O(M(n) log n) with Karatsuba multiplication; printing is bound
+ * by the (schoolbook) division, but trades the per-chunk hardware divisions
+ * for Algorithm D's multiply-subtract loops.
+ */
+
+#define DEC_CHUNK_CHARS 9
+#define DEC_CHUNK_BASE 1000000000u
+
+/* Values of up to this many digits are converted chunk by chunk. */
+#define DEC_SPLIT_CUTOFF 32
+
+/* Cached powers 10^(9 * 2^k); these are kept for the lifetime of the process. */
+#define DEC_POWERS_MAX 24
+static SbObject *dec_powers[DEC_POWERS_MAX];
+
+/* Fetch 10^(9 * 2^level), computing and caching it if needed.
+   Returns: Borrowed reference. */
+static SbObject *
+dec_power(int level)
+{
+    SbObject *p;
+
+    if (dec_powers[level]) {
+        return dec_powers[level];
+    }
+    if (level == 0) {
+        p = SbInt_FromNative(DEC_CHUNK_BASE);
+    }
+    else {
+        p = dec_power(level - 1);
+        if (!p) {
+            return NULL;
+        }
+        p = SbInt_Multiply(p, p);
+    }
+    dec_powers[level] = p;
+    return p;
+}
+
+/* Length of a value in digits, natives counting as one. */
+static Sb_ssize_t
+long_length(const SbInt_Value *v)
+{
+    return LONG_IS_NATIVE(v) ? 1 : v->length;
+}
+
+/* Write the decimal digits of a nonnegative MPI value chunk by chunk,
+   so that they end right before end.
+   Returns: pointer to the first character written, NULL on error. */
+static char *
+long_write_decimal_chunks(const SbInt_Value *v, char *end)
+{
+    SbInt_Digit_t *t;
+    Sb_ssize_t n;
+    char *p;
+
+    n = v->length;
+    t = long_alloc(n);
+    if (!t) {
+        SbErr_NoMemory();
+        return NULL;
+    }
+    SbRT_MemCpy(t, v->u.digits, n * sizeof(SbInt_Digit_t));
+
+    p = end;
+    for (;;) {
+        SbInt_Digit_t rem;
+
+        while (n > 0 && !t[n - 1]) {
+            --n;
+        }
+        rem = __mag_divmod_1(t, n, DEC_CHUNK_BASE, t);
+        while (n > 0 && !t[n - 1]) {
+            --n;
+        }
+        if (!n) {
+            p = Sb_FormatDecimal(p, rem, 1);
+            break;
+        }
+        p = Sb_FormatDecimal(p, rem, DEC_CHUNK_CHARS);
+    }
+
+    long_free(t);
+    return p;
+}
+
+/* Write the decimal digits of a nonnegative int so that they end right before end.
+   If width is nonzero, the output is zero-padded to exactly width characters.
+   Returns: pointer to the first character written, NULL on error. */
+static char *
+int_write_decimal(SbObject *x, char *end, Sb_ssize_t width)
+{
+    SbInt_Value storage;
+    const SbInt_Value *v;
+    char *p;
+
+    v = INT_VALUE(x, &storage);
+    if (LONG_IS_NATIVE(v)) {
+        p = Sb_FormatDecimal(end, (Sb_size_t)v->u.value, 1);
+    }
+    else if (v->length <= DEC_SPLIT_CUTOFF) {
+        p = long_write_decimal_chunks(v, end);
+    }
+    else {
+        SbObject *q, *r;
+        int level;
+
+        /* Split by the largest cached power not longer than half the value. */
+        level = 0;
+        while (level + 1 < DEC_POWERS_MAX) {
+            SbObject *power;
+            SbInt_Value power_storage;
+
+            power = dec_power(level + 1);
+            if (!power) {
+                return NULL;
+            }
+            if (long_length(INT_VALUE(power, &power_storage)) * 2 > v->length) {
+                break;
+            }
+            ++level;
+        }
+        if (int_divmod(x, dec_power(level), &q, &r) < 0) {
+            return NULL;
+        }
+        p = int_write_decimal(r, end, (Sb_ssize_t)DEC_CHUNK_CHARS << level);
+        if (p) {
+            p = int_write_decimal(q, p, width ? width - (end - p) : 0);
+        }
+        Sb_DECREF(q);
+        Sb_DECREF(r);
+    }
+
+    if (p && width) {
+        while (end - p < width) {
+            *--p = '0';
+        }
+    }
+    return p;
+}
+
+/* Write the digits of a nonnegative int in radix 2^shift so that they end right before end.
+   Returns: pointer to the first character written. */
+static char *
+int_write_pow2(const SbInt_Value *v, int shift, char *end)
+{
+    static const char xdigits[] = "0123456789abcdef";
+    SbInt_Digit_t native_digits[LONG_NATIVE_DIGITS];
+    SbInt_Value native_copy;
+    SbInt_DoubleDigit_t acc;
+    SbInt_Digit_t mask;
+    Sb_ssize_t i;
+    int bits;
+    char *p;
+
+    if (LONG_IS_NATIVE(v)) {
+        long_convert_digits(&native_copy, v->u.value, LONG_NATIVE_DIGITS, native_digits);
+        v = &native_copy;
+    }
+
+    mask = ((SbInt_Digit_t)1 << shift) - 1;
+    p = end;
+    acc = 0;
+    bits = 0;
+    for (i = 0; i < v->length; ++i) {
+        acc |= (SbInt_DoubleDigit_t)v->u.digits[i] << bits;
+        bits += SbInt_DIGIT_BITS;
+        while (bits >= shift) {
+            *--p = xdigits[acc & mask];
+            acc >>= shift;
+            bits -= shift;
+        }
+    }
+    if (bits) {
+        *--p = xdigits[acc & mask];
+    }
+
+    while (p < end - 1 && *p == '0') {
+        ++p;
+    }
+    return p;
+}
+
+SbObject *
+SbInt_ToString(SbObject *op, unsigned base)
+{
+    SbObject *x;
+    SbInt_Value storage;
+    const SbInt_Value *xv;
+    SbObject *result;
+    Sb_ssize_t size;
+    char *buffer, *end, *p;
+    int negative, shift;
+
+    switch (base) {
+    case 2: shift = 1; break;
+    case 8: shift = 3; break;
+    case 10: shift = 0; break;
+    case 16: shift = 4; break;
+    default:
+        SbErr_RaiseWithString(SbExc_ValueError, "unsupported base for int conversion");
+        return NULL;
+    }
+
+    xv = INT_VALUE(op, &storage);
+    negative = LONG_IS_NATIVE(xv) ? xv->u.value < 0 : LONG_IS_NEGATIVE(xv);
+    if (negative) {
+        x = SbInt_Negate(op);
+        if (!x) {
+            return NULL;
+        }
+    }
+    else {
+        x = op;
+        Sb_INCREF(x);
+    }
+    xv = INT_VALUE(x, &storage);
+
+    /* A digit takes at most 10 decimal characters; one more goes to the sign. */
+    size = (LONG_IS_NATIVE(xv) ? (Sb_ssize_t)LONG_NATIVE_DIGITS : xv->length)
+        * (shift ? SbInt_DIGIT_BITS / shift + 1 : 10) + 1;
+    result = NULL;
+    buffer = (char *)Sb_Malloc(size);
+    if (!buffer) {
+        SbErr_NoMemory();
+        goto exit;
+    }
+    end = buffer + size;
+
+    p = shift ? int_write_pow2(xv, shift, end) : int_write_decimal(x, end, 0);
+    if (p) {
+        if (negative) {
+            *--p = '-';
+        }
+        result = SbStr_FromStringAndSize(p, end - p);
+    }
+    Sb_Free(buffer);
+
+exit:
+    Sb_DECREF(x);
+    return result;
+}
+
+/* Map a character to its digit value; anything else maps to 36 or above. */
+static unsigned
+int_digit_value(char ch)
+{
+    if (ch >= '0' && ch <= '9') {
+        return ch - '0';
+    }
+    ch |= 0x20;
+    if (ch >= 'a' && ch <= 'z') {
+        return ch - 'a' + 10;
+    }
+    return 36;
+}
+
+/* Parse digits of any radix by multiply-add in chunks, which is quadratic.
+   Returns: New reference. */
+static SbObject *
+int_parse_chunks(const char *s, Sb_ssize_t count, unsigned radix)
+{
+    SbIntObject *result;
+    SbInt_Digit_t *digits;
+    SbInt_Digit_t chunk_base;
+    Sb_ssize_t chunk_chars, chunk_end, pos, used;
+
+    /* The largest power of the radix to fit a digit */
+    chunk_base = radix;
+    chunk_chars = 1;
+    while ((SbInt_DoubleDigit_t)chunk_base * radix <= SbInt_DIGIT_MASK) {
+        chunk_base *= radix;
+        ++chunk_chars;
+    }
+
+    /* Each chunk adds at most a digit; a spare one keeps the sign positive. */
+    result = (SbIntObject *)SbInt_FromLengthAndDigits(count / chunk_chars + 2, NULL);
+    if (!result) {
+        return NULL;
+    }
+    digits = result->v.u.digits;
+
+    used = 0;
+    chunk_end = count % chunk_chars;
+    if (!chunk_end) {
+        chunk_end = chunk_chars;
+    }
+    for (pos = 0; pos < count; chunk_end += chunk_chars) {
+        SbInt_DoubleDigit_t carry;
+        SbInt_Digit_t scale;
+        Sb_ssize_t i;
+
+        carry = 0;
+        scale = 1;
+        for (; pos < chunk_end; ++pos) {
+            carry = carry * radix + int_digit_value(s[pos]);
+            scale *= radix;
+        }
+        for (i = 0; i < used; ++i) {
+            carry += Sb_Mulu32x32As64(digits[i], scale);
+            digits[i] = (SbInt_Digit_t)carry;
+            carry >>= SbInt_DIGIT_BITS;
+        }
+        if (carry) {
+            digits[used++] = (SbInt_Digit_t)carry;
+        }
+    }
+
+    long_reduce(&result->v);
+    return int_pack(result);
+}
+
+/* Parse digits of a power-of-two radix by packing bits, which is linear.
+   Returns: New reference. */
+static SbObject *
+int_parse_pow2(const char *s, Sb_ssize_t count, unsigned radix)
+{
+    SbIntObject *result;
+    SbInt_Digit_t *digits;
+    SbInt_DoubleDigit_t acc;
+    Sb_ssize_t i;
+    int shift, bits;
+
+    for (shift = 0; (1u << shift) < radix; ++shift) {
+    }
+
+    result = (SbIntObject *)SbInt_FromLengthAndDigits(count * shift / SbInt_DIGIT_BITS + 2, NULL);
+    if (!result) {
+        return NULL;
+    }
+    digits = result->v.u.digits;
+
+    acc = 0;
+    bits = 0;
+    for (i = count - 1; i >= 0; --i) {
+        acc |= (SbInt_DoubleDigit_t)int_digit_value(s[i]) << bits;
+        bits += shift;
+        if (bits >= SbInt_DIGIT_BITS) {
+            *digits++ = (SbInt_Digit_t)acc;
+            acc >>= SbInt_DIGIT_BITS;
+            bits -= SbInt_DIGIT_BITS;
+        }
+    }
+    if (bits) {
+        *digits = (SbInt_Digit_t)acc;
+    }
+
+    long_reduce(&result->v);
+    return int_pack(result);
+}
+
+/* Parse decimal digits, splitting long runs as high * 10^(9 * 2^k) + low.
+   Returns: New reference. */
+static SbObject *
+int_parse_decimal(const char *s, Sb_ssize_t count)
+{
+    SbObject *power, *high, *low, *tmp, *result;
+    Sb_ssize_t low_count;
+    int level;
+
+    if (count <= DEC_SPLIT_CUTOFF * DEC_CHUNK_CHARS) {
+        return int_parse_chunks(s, count, 10);
+    }
+
+    /* The low part takes the largest cached power not longer than half the run. */
+    level = 0;
+    while (level + 1 < DEC_POWERS_MAX && ((Sb_ssize_t)DEC_CHUNK_CHARS << (level + 1)) * 2 <= count) {
+        ++level;
+    }
+    power = dec_power(level);
+    if (!power) {
+        return NULL;
+    }
+    low_count = (Sb_ssize_t)DEC_CHUNK_CHARS << level;
+
+    high = int_parse_decimal(s, count - low_count);
+    if (!high) {
+        return NULL;
+    }
+    low = int_parse_decimal(s + count - low_count, low_count);
+    if (!low) {
+        Sb_DECREF(high);
+        return NULL;
+    }
+    result = NULL;
+    tmp = SbInt_Multiply(high, power);
+    if (tmp) {
+        result = SbInt_Add(tmp, low);
+        Sb_DECREF(tmp);
+    }
+    Sb_DECREF(high);
+    Sb_DECREF(low);
+    return result;
+}
+
+SbObject *
+SbInt_FromString(const char *str, const char **pend, unsigned base)
+{
+    const char *start;
+    SbObject *result;
+    Sb_ssize_t count, i;
+    Sb_size_t value, limit;
+    int negative;
+
+    if (base != 0 && (base < 2 || base > 36)) {
+        SbErr_RaiseWithString(SbExc_ValueError, "int() base must be >= 2 and <= 36");
+        return NULL;
+    }
+
+    while (Sb_IsWhiteSpace(*str)) {
+        ++str;
+    }
+    negative = 0;
+    if (*str == '-') {
+        negative = 1;
+        ++str;
+    }
+    else if (*str == '+') {
+        ++str;
+    }
+
+    /* Radix prefixes; a bare leading zero means octal when guessing. */
+    if (str[0] == '0') {
+        char prefix = str[1] | 0x20;
+
+        if ((base == 0 || base == 16) && prefix == 'x') {
+            base = 16;
+            str += 2;
+        }
+        else if ((base == 0 || base == 8) && prefix == 'o') {
+            base = 8;
+            str += 2;
+        }
+        else if ((base == 0 || base == 2) && prefix == 'b') {
+            base = 2;
+            str += 2;
+        }
+        else if (base == 0) {
+            base = 8;
+        }
+    }
+    else if (base == 0) {
+        base = 10;
+    }
+
+    start = str;
+    while (int_digit_value(*str) < base) {
+        ++str;
+    }
+    count = str - start;
+    if (!count) {
+        goto invalid;
+    }
+    if (pend) {
+        *pend = str;
+    }
+    else {
+        while (Sb_IsWhiteSpace(*str)) {
+            ++str;
+        }
+        if (*str) {
+            goto invalid;
+        }
+    }
+
+    /* Most literals fit a native value. */
+    value = 0;
+    limit = (Sb_size_t)SbInt_NATIVE_MAX / base;
+    for (i = 0; i < count && value <= limit; ++i) {
+        value = value * base + int_digit_value(start[i]);
+    }
+    if (i == count && value <= (Sb_size_t)SbInt_NATIVE_MAX) {
+        return SbInt_FromNative(negative ? -(SbInt_Native_t)value : (SbInt_Native_t)value);
+    }
+
+    if (base == 10) {
+        result = int_parse_decimal(start, count);
+    }
+    else if (!(base & (base - 1))) {
+        result = int_parse_pow2(start, count, base);
+    }
+    else {
+        result = int_parse_chunks(start, count, base);
+    }
+    if (result && negative) {
+        SbObject *tmp;
+
+        tmp = SbInt_Negate(result);
+        Sb_DECREF(result);
+        result = tmp;
+    }
+    return result;
+
+invalid:
+    SbErr_RaiseWithFormat(SbExc_ValueError, "invalid literal for int() with base %d", (int)base);
+    return NULL;
+}
+
+
+/*
+ * Exponentiation
+ *
+ * The exponent is scanned from the top bit down. Without a modulus the base
+ * is usually far shorter than the result, so plain square-and-multiply is used.
+ * With a modulus the exponent is consumed in sliding windows over a table of
+ * odd powers, and products are reduced with Montgomery's method for odd moduli,
+ * by division otherwise. Digit buffers are set up once; the loops allocate no objects.
+ */
+
+/* Results of plain pow() are limited to this many bits. */
+#define MAX_POW_BITS ((Sb_ssize_t)1 << 26)
+
+/* MACRO: extract bit i of a magnitude. */
+#define MAG_BIT(a, i) \
+    (((a)[(i) / SbInt_DIGIT_BITS] >> ((i) % SbInt_DIGIT_BITS)) & 1)
+
+/* Count significant bits of a magnitude. */
+static Sb_ssize_t
+__mag_bit_length(const SbInt_Digit_t *a, Sb_ssize_t n)
+{
+    while (n > 0 && !a[n - 1]) {
+        --n;
+    }
+    if (!n) {
+        return 0;
+    }
+    return n * SbInt_DIGIT_BITS - digit_clz(a[n - 1]);
+}
+
+/* Reduce a magnitude modulo m into r[0..n).
+   Assumes: m[n - 1] != 0; na <= 2 * n; q has n + 1 digits; r doesn't overlap a.
+   Returns: 0 if OK, -1 on allocation failure. */
+static int
+__mag_mod(const SbInt_Digit_t *a, Sb_ssize_t na, const SbInt_Digit_t *m, Sb_ssize_t n, SbInt_Digit_t *q, SbInt_Digit_t *r)
+{
+    while (na > 0 && !a[na - 1]) {
+        --na;
+    }
+    if (na < n) {
+        SbRT_MemCpy(r, a, na * sizeof(SbInt_Digit_t));
+        SbRT_MemSet(r + na, 0, (n - na) * sizeof(SbInt_Digit_t));
+        return 0;
+    }
+    if (n == 1) {
+        r[0] = __mag_divmod_1(a, na, m[0], q);
+        return 0;
+    }
+    return __mag_divmod(a, na, m, n, q, r);
+}
+
+/* Compute -m0^-1 mod 2^32 for an odd m0 by Newton's iteration. */
+static SbInt_Digit_t
+mont_inverse(SbInt_Digit_t m0)
+{
+    SbInt_Digit_t x;
+
+    /* Correct to 3 bits to begin with; each step doubles that. */
+    x = m0;
+    x *= 2 - m0 * x;
+    x *= 2 - m0 * x;
+    x *= 2 - m0 * x;
+    x *= 2 - m0 * x;
+    return (SbInt_Digit_t)0 - x;
+}
+
+typedef struct _PowContext PowContext;
+typedef int (*pow_mulfunc)(PowContext *ctx, const SbInt_Digit_t *a, const SbInt_Digit_t *b, SbInt_Digit_t *r);
+
+struct _PowContext {
+    const SbInt_Digit_t *m;
+    Sb_ssize_t n;
+    /* -m^-1 mod 2^32, for Montgomery reduction */
+    SbInt_Digit_t minv;
+    pow_mulfunc mul;
+    /* Scratch: 2n + 1 digits for products, n + 1 for quotients */
+    SbInt_Digit_t *t;
+    SbInt_Digit_t *q;
+};
+
+/* Montgomery product r = a * b / 2^(32n) mod m.
+   The product is computed first so that squares take the cheaper path,
+   then reduced by adding multiples of m that clear the low digits.
+   Assumes: a, b < m; r may alias a or b.
+   Returns: 0 if OK, -1 on allocation failure. */
+static int
+pow_mul_montgomery(PowContext *ctx, const SbInt_Digit_t *a, const SbInt_Digit_t *b, SbInt_Digit_t *r)
+{
+    const SbInt_Digit_t *m;
+    SbInt_Digit_t *t;
+    Sb_ssize_t n, i, j;
+    int rv;
+
+    m = ctx->m;
+    n = ctx->n;
+    t = ctx->t;
+    if (a == b) {
+        rv = __mag_karatsuba_sqr(a, n, t);
+    }
+    else {
+        rv = __mag_karatsuba(a, n, b, n, t);
+    }
+    if (rv < 0) {
+        return -1;
+    }
+
+    t[2 * n] = 0;
+    for (i = 0; i < n; ++i) {
+        SbInt_DoubleDigit_t c;
+        SbInt_Digit_t u;
+
+        u = t[i] * ctx->minv;
+        c = 0;
+        for (j = 0; j < n; ++j) {
+            c += Sb_Mulu32x32As64(u, m[j]) + t[i + j];
+            t[i + j] = (SbInt_Digit_t)c;
+            c >>= SbInt_DIGIT_BITS;
+        }
+        for (j = i + n; c; ++j) {
+            c += t[j];
+            t[j] = (SbInt_Digit_t)c;
+            c >>= SbInt_DIGIT_BITS;
+        }
+    }
+
+    /* Now t / 2^(32n) < 2m */
+    t += n;
+    if (!t[n]) {
+        for (j = n - 1; j > 0 && t[j] == m[j]; --j) {
+        }
+        if (t[j] < m[j]) {
+            SbRT_MemCpy(r, t, n * sizeof(SbInt_Digit_t));
+            return 0;
+        }
+    }
+    __mag_sub_in(t, n + 1, m, n);
+    SbRT_MemCpy(r, t, n * sizeof(SbInt_Digit_t));
+    return 0;
+}
+
+/* Plain modular product r = a * b mod m.
+   Assumes: a, b < m; r may alias a or b.
+   Returns: 0 if OK, -1 on allocation failure. */
+static int
+pow_mul_classic(PowContext *ctx, const SbInt_Digit_t *a, const SbInt_Digit_t *b, SbInt_Digit_t *r)
+{
+    Sb_ssize_t n;
+    int rv;
+
+    n = ctx->n;
+    if (a == b) {
+        rv = __mag_karatsuba_sqr(a, n, ctx->t);
+    }
+    else {
+        rv = __mag_karatsuba(a, n, b, n, ctx->t);
+    }
+    if (rv < 0) {
+        return -1;
+    }
+    return __mag_mod(ctx->t, 2 * n, ctx->m, n, ctx->q, r);
+}
+
+/* Pick the sliding window width for an exponent of the given length.
+   Thresholds follow HAC 14.85: wider windows only pay off for long exponents. */
+static int
+pow_window_bits(Sb_ssize_t ebits)
+{
+    if (ebits > 671) {
+        return 6;
+    }
+    if (ebits > 239) {
+        return 5;
+    }
+    if (ebits > 79) {
+        return 4;
+    }
+    if (ebits > 23) {
+        return 3;
+    }
+    return 1;
+}
+
+/* Compute r = b^e mod m over magnitudes.
+   Assumes: b < m; m > 1 and m[n - 1] != 0; e > 0; r has n digits.
+   Returns: 0 if OK, -1 on allocation failure. */
+static int
+__mag_pow_mod(const SbInt_Digit_t *b, const SbInt_Digit_t *e, Sb_ssize_t ebits, const SbInt_Digit_t *m, Sb_ssize_t n, SbInt_Digit_t *r)
+{
+    PowContext ctx;
+    SbInt_Digit_t *buffer, *table;
+    Sb_ssize_t i, j, k, table_size;
+    int window, started;
+
+    window = pow_window_bits(ebits);
+    table_size = (Sb_ssize_t)1 << (window - 1);
+
+    /* Odd powers table, product and quotient scratch */
+    buffer = long_alloc(table_size * n + 2 * n + 2 + n + 1);
+    if (!buffer) {
+        return -1;
+    }
+    table = buffer;
+    ctx.t = table + table_size * n;
+    ctx.q = ctx.t + 2 * n + 2;
+    ctx.m = m;
+    ctx.n = n;
+
+    if (m[0] & 1) {
+        /* Move into Montgomery form: b * 2^(32n) mod m */
+        ctx.minv = mont_inverse(m[0]);
+        ctx.mul = pow_mul_montgomery;
+        SbRT_MemSet(ctx.t, 0, n * sizeof(SbInt_Digit_t));
+        SbRT_MemCpy(ctx.t + n, b, n * sizeof(SbInt_Digit_t));
+        if (__mag_mod(ctx.t, 2 * n, m, n, ctx.q, table) < 0) {
+            goto fail;
+        }
+    }
+    else {
+        ctx.mul = pow_mul_classic;
+        SbRT_MemCpy(table, b, n * sizeof(SbInt_Digit_t));
+    }
+
+    /* table[i] = b^(2i + 1); r serves as b^2 meanwhile */
+    if (table_size > 1) {
+        if (ctx.mul(&ctx, table, table, r) < 0) {
+            goto fail;
+        }
+        for (i = 1; i < table_size; ++i) {
+            if (ctx.mul(&ctx, table + (i - 1) * n, r, table + i * n) < 0) {
+                goto fail;
+            }
+        }
+    }
+
+    started = 0;
+    i = ebits - 1;
+    while (i >= 0) {
+        Sb_ssize_t value;
+
+        if (!MAG_BIT(e, i)) {
+            if (ctx.mul(&ctx, r, r, r) < 0) {
+                goto fail;
+            }
+            --i;
+            continue;
+        }
+
+        /* The longest window ending in a set bit */
+        j = i - window + 1;
+        if (j < 0) {
+            j = 0;
+        }
+        while (!MAG_BIT(e, j)) {
+            ++j;
+        }
+        value = 0;
+        for (k = i; k >= j; --k) {
+            value = (value << 1) | MAG_BIT(e, k);
+        }
+
+        if (started) {
+            for (k = i; k >= j; --k) {
+                if (ctx.mul(&ctx, r, r, r) < 0) {
+                    goto fail;
+                }
+            }
+            if (ctx.mul(&ctx, r, table + (value >> 1) * n, r) < 0) {
+                goto fail;
+            }
+        }
+        else {
+            SbRT_MemCpy(r, table + (value >> 1) * n, n * sizeof(SbInt_Digit_t));
+            started = 1;
+        }
+        i = j - 1;
+    }
+
+    if (ctx.mul == pow_mul_montgomery) {
+        /* Leave Montgomery form: multiply by 1 */
+        SbRT_MemSet(table, 0, n * sizeof(SbInt_Digit_t));
+        table[0] = 1;
+        if (pow_mul_montgomery(&ctx, r, table, r) < 0) {
+            goto fail;
+        }
     }
-    res->length = length;
-    __long_add(lhs, rhs, res);
+
+    long_free(buffer);
     return 0;
-}
 
-SbObject *
-SbInt_Add(SbObject *lhs, SbObject *rhs)
-{
-    return int_do_binary_op(&((SbIntObject *)lhs)->v, &((SbIntObject *)rhs)->v, int_add_native, int_add_long);
+fail:
+    long_free(buffer);
+    return -1;
 }
 
-static int
-int_sub_native(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *res)
+/* Compute a^e over magnitudes by left-to-right square-and-multiply,
+   going back and forth between the buffers x and y.
+   Assumes: a[na - 1] != 0; e > 0; x and y have room for the result plus na + 2 digits.
+   Returns: the buffer holding the result, its length in *nr_out; NULL on allocation failure. */
+static SbInt_Digit_t *
+__mag_pow(const SbInt_Digit_t *a, Sb_ssize_t na, Sb_size_t e, SbInt_Digit_t *x, SbInt_Digit_t *y, Sb_ssize_t *nr_out)
 {
-    SbInt_Native_t a, b, rv;
+    Sb_ssize_t nr;
+    int bit;
 
-    a = lhs->u.value;
-    b = rhs->u.value;
-    res->u.value = rv = a - b;
-    return ((a ^ b) && ((rv ^ a) & 0x80000000U));
-}
+    for (bit = NATIVE_BITS - 1; !((e >> bit) & 1); --bit) {
+    }
 
-static int
-int_sub_long(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *res)
-{
-    Sb_ssize_t length;
+    SbRT_MemCpy(x, a, na * sizeof(SbInt_Digit_t));
+    nr = na;
+    while (--bit >= 0) {
+        SbInt_Digit_t *tmp;
 
-    length = (lhs->length > rhs->length ? lhs->length : rhs->length) + 1;
-    res->u.digits = long_alloc(length);
-    if (!res->u.digits) {
-        return -1;
+        if (__mag_karatsuba_sqr(x, nr, y) < 0) {
+            return NULL;
+        }
+        nr *= 2;
+        if (!y[nr - 1]) {
+            --nr;
+        }
+        tmp = x; x = y; y = tmp;
+
+        if ((e >> bit) & 1) {
+            if (__mag_karatsuba(x, nr, a, na, y) < 0) {
+                return NULL;
+            }
+            nr += na;
+            if (!y[nr - 1]) {
+                --nr;
+            }
+            tmp = x; x = y; y = tmp;
+        }
     }
-    res->length = length;
-    __long_sub(lhs, rhs, res);
-    return 0;
+
+    *nr_out = nr;
+    return x;
 }
 
-SbObject *
-SbInt_Subtract(SbObject *lhs, SbObject *rhs)
+/* Compute r = b^e mod m for m fitting a digit. */
+static SbInt_Digit_t
+pow_mod_digit(SbInt_Digit_t b, const SbInt_Digit_t *e, Sb_ssize_t ebits, SbInt_Digit_t m)
 {
-    return int_do_binary_op(&((SbIntObject *)lhs)->v, &((SbIntObject *)rhs)->v, int_sub_native, int_sub_long);
+    SbInt_DoubleDigit_t r;
+    Sb_ssize_t i;
+
+    r = b;
+    for (i = ebits - 2; i >= 0; --i) {
+        r = r * r % m;
+        if (MAG_BIT(e, i)) {
+            r = r * b % m;
+        }
+    }
+    return (SbInt_Digit_t)r;
 }
 
-static int
-int_mul_native(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *res)
-{
-    SbInt_Native_t a, b;
+/* Compute base ** exp without a modulus.
+   Returns: New reference. */
+static SbObject *
+int_pow_plain(SbObject *base, SbObject *exp)
+{
+    SbInt_Value base_storage;
+    SbInt_Value exp_storage;
+    const SbInt_Value *bv, *ev;
+    SbInt_Digit_t base_digits[LONG_NATIVE_DIGITS];
+    SbInt_Value base_copy;
+    SbInt_Digit_t *a_copy, *buffer, *p;
+    const SbInt_Digit_t *a;
+    SbIntObject *result;
+    Sb_ssize_t na, nr, abits, size;
+    Sb_size_t e;
+    int negative;
+
+    bv = INT_VALUE(base, &base_storage);
+    ev = INT_VALUE(exp, &exp_storage);
+    if (LONG_IS_NATIVE(ev) ? ev->u.value < 0 : LONG_IS_NEGATIVE(ev)) {
+        SbErr_RaiseWithString(SbExc_ValueError, "negative exponents are not supported");
+        return NULL;
+    }
 
-    a = lhs->u.value;
-    b = rhs->u.value;
+    if (LONG_IS_NATIVE(bv) && bv->u.value >= -1 && bv->u.value <= 1) {
+        int odd;
 
-    /* TODO: replace this test with multiplication on a capable machine */
-    if (int_native_bitcount(a) + int_native_bitcount(b) > 30) {
-        return 1;
+        odd = (int)((LONG_IS_NATIVE(ev) ? (Sb_size_t)ev->u.value : ev->u.digits[0]) & 1);
+        if (LONG_IS_ZERO(ev)) {
+            return SbInt_FromNative(1);
+        }
+        return SbInt_FromNative(bv->u.value == -1 && !odd ? 1 : bv->u.value);
+    }
+    if (!LONG_IS_NATIVE(ev)) {
+        SbErr_RaiseWithString(SbExc_OverflowError, "exponent too large");
+        return NULL;
+    }
+    e = (Sb_size_t)ev->u.value;
+    if (!e) {
+        return SbInt_FromNative(1);
+    }
+
+    negative = LONG_IS_NATIVE(bv) ? bv->u.value < 0 : LONG_IS_NEGATIVE(bv);
+    if (LONG_IS_NATIVE(bv)) {
+        SbInt_Native_t b, r;
+
+        b = bv->u.value;
+        /* An upper bound of the magnitude's bit length */
+        abits = int_native_bitcount(b) + 1;
+        if (e <= (Sb_size_t)(NATIVE_BITS - 2) / abits) {
+            /* Every partial result fits, too. */
+            r = 1;
+            for (;;) {
+                if (e & 1) {
+                    r *= b;
+                }
+                e >>= 1;
+                if (!e) {
+                    break;
+                }
+                b *= b;
+            }
+            return SbInt_FromNative(r);
+        }
+        long_convert_digits(&base_copy, bv->u.value, LONG_NATIVE_DIGITS, base_digits);
+        bv = &base_copy;
     }
 
-    res->u.value = a * b;
-    return 0;
-}
+    a = long_magnitude(bv, &a_copy);
+    if (!a) {
+        return SbErr_NoMemory();
+    }
+    na = bv->length;
+    while (!a[na - 1]) {
+        --na;
+    }
+    abits = __mag_bit_length(a, na);
+    if (e > (Sb_size_t)(MAX_POW_BITS / abits)) {
+        long_free(a_copy);
+        SbErr_RaiseWithString(SbExc_OverflowError, "int too large to compute");
+        return NULL;
+    }
 
-static int
-int_mul_long(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *res)
-{
-    Sb_ssize_t length;
+    result = NULL;
+    size = (Sb_ssize_t)(abits * e / SbInt_DIGIT_BITS) + na + 2;
+    buffer = long_alloc(2 * size);
+    if (!buffer) {
+        SbErr_NoMemory();
+        goto exit;
+    }
+    p = __mag_pow(a, na, e, buffer, buffer + size, &nr);
+    if (!p) {
+        SbErr_NoMemory();
+        goto exit;
+    }
 
-    length = lhs->length + rhs->length;
-    res->u.digits = long_alloc(length);
-    if (!res->u.digits) {
-        return -1;
+    result = (SbIntObject *)SbInt_FromLengthAndDigits(nr + 1, NULL);
+    if (result) {
+        SbRT_MemCpy(result->v.u.digits, p, nr * sizeof(SbInt_Digit_t));
+        if (negative && (e & 1)) {
+            __long_neg(&result->v, &result->v);
+        }
+        long_reduce(&result->v);
     }
-    res->length = length;
-    __long_mul(lhs, rhs, res);
-    return 0;
-}
 
-SbObject *
-SbInt_Multiply(SbObject *lhs, SbObject *rhs)
-{
-    return int_do_binary_op(&((SbIntObject *)lhs)->v, &((SbIntObject *)rhs)->v, int_mul_native, int_mul_long);
+exit:
+    long_free(buffer);
+    long_free(a_copy);
+    return result ? int_pack(result) : NULL;
 }
 
-static int
-int_fdiv_native(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *res)
-{
-    SbInt_Native_t a, b, rv;
+/* Compute base ** exp % mod.
+   Returns: New reference. */
+static SbObject *
+int_pow_mod(SbObject *base, SbObject *exp, SbObject *mod)
+{
+    SbInt_Value exp_storage;
+    SbInt_Value mod_storage;
+    SbInt_Value b_storage;
+    const SbInt_Value *ev, *mv, *bv;
+    SbInt_Digit_t e_digits[LONG_NATIVE_DIGITS];
+    SbInt_Value e_copy;
+    SbObject *abs_mod, *b, *result;
+    Sb_ssize_t ebits;
+
+    ev = INT_VALUE(exp, &exp_storage);
+    if (LONG_IS_NATIVE(ev) ? ev->u.value < 0 : LONG_IS_NEGATIVE(ev)) {
+        SbErr_RaiseWithString(SbExc_ValueError, "pow() 2nd argument cannot be negative when 3rd argument specified");
+        return NULL;
+    }
+    if (LONG_IS_ZERO(INT_VALUE(mod, &mod_storage))) {
+        SbErr_RaiseWithString(SbExc_ValueError, "pow() 3rd argument cannot be 0");
+        return NULL;
+    }
+    if (LONG_IS_NATIVE(ev)) {
+        long_convert_digits(&e_copy, ev->u.value, LONG_NATIVE_DIGITS, e_digits);
+        ev = &e_copy;
+    }
+    ebits = __mag_bit_length(ev->u.digits, ev->length);
 
-    a = lhs->u.value;
-    b = rhs->u.value;
-    res->u.value = rv = a / b;
-    return 0;
-}
+    abs_mod = SbInt_Absolute(mod);
+    if (!abs_mod) {
+        return NULL;
+    }
+    result = b = NULL;
+    mv = INT_VALUE(abs_mod, &mod_storage);
+    if (LONG_IS_NATIVE(mv) && mv->u.value == 1) {
+        result = SbInt_FromNative(0);
+        goto exit;
+    }
+    if (!ebits) {
+        result = SbInt_FromNative(1);
+        goto apply_sign;
+    }
+    if (int_divmod(base, abs_mod, NULL, &b) < 0) {
+        goto exit;
+    }
+    bv = INT_VALUE(b, &b_storage);
 
-static int
-int_fdiv_long(const SbInt_Value *lhs, const SbInt_Value *rhs, SbInt_Value *res)
-{
-    /* TODO: implement me. */
-    return -1;
+    if (LONG_IS_NATIVE(mv) && (Sb_size_t)mv->u.value <= SbInt_DIGIT_MASK) {
+        result = SbInt_FromNative(pow_mod_digit((SbInt_Digit_t)bv->u.value, ev->u.digits, ebits, (SbInt_Digit_t)mv->u.value));
+    }
+    else {
+        SbInt_Digit_t m_digits[LONG_NATIVE_DIGITS];
+        SbInt_Value m_copy;
+        SbInt_Digit_t *b_digits;
+        Sb_ssize_t n, nb;
+
+        if (LONG_IS_NATIVE(mv)) {
+            long_convert_digits(&m_copy, mv->u.value, LONG_NATIVE_DIGITS, m_digits);
+            mv = &m_copy;
+        }
+        n = mv->length;
+        while (!mv->u.digits[n - 1]) {
+            --n;
+        }
+
+        /* The base, zero-extended to the modulus length */
+        b_digits = long_alloc(n);
+        if (!b_digits) {
+            SbErr_NoMemory();
+            goto exit;
+        }
+        if (LONG_IS_NATIVE(bv)) {
+            SbInt_Value tmp;
+
+            long_convert_digits(&tmp, bv->u.value, n < (Sb_ssize_t)LONG_NATIVE_DIGITS ? n : LONG_NATIVE_DIGITS, b_digits);
+        }
+        else {
+            nb = bv->length < n ? bv->length : n;
+            SbRT_MemCpy(b_digits, bv->u.digits, nb * sizeof(SbInt_Digit_t));
+        }
+
+        result = SbInt_FromLengthAndDigits(n + 1, NULL);
+        if (result && __mag_pow_mod(b_digits, ev->u.digits, ebits, mv->u.digits, n, SbInt_DIGITS(result)) < 0) {
+            Sb_CLEAR(result);
+            SbErr_NoMemory();
+        }
+        if (result) {
+            long_reduce(&((SbIntObject *)result)->v);
+            result = int_pack((SbIntObject *)result);
+        }
+        long_free(b_digits);
+    }
+
+apply_sign:
+    /* The result takes the sign of the modulus. */
+    if (result && abs_mod != mod && SbObject_IsTrue(result)) {
+        SbObject *tmp;
+
+        tmp = SbInt_Add(result, mod);
+        Sb_DECREF(result);
+        result = tmp;
+    }
+
+exit:
+    Sb_XDECREF(b);
+    Sb_DECREF(abs_mod);
+    return result;
 }
 
 SbObject *
-SbInt_FloorDivide(SbObject *lhs, SbObject *rhs)
+SbInt_Power(SbObject *base, SbObject *exp, SbObject *mod)
 {
-    if (LONG_IS_ZERO(&((SbIntObject *)rhs)->v)) {
-        SbErr_RaiseWithObject(SbExc_ZeroDivisionError, NULL);
-        return NULL;
+    if (mod) {
+        return int_pow_mod(base, exp, mod);
     }
-    return int_do_binary_op(&((SbIntObject *)lhs)->v, &((SbIntObject *)rhs)->v, int_fdiv_native, int_fdiv_long);
+    return int_pow_plain(base, exp);
 }
 
-
 /* Python accessible methods */
 
+/* Ints are immutable (and small ones are shared), so the value is built here. */
 static SbObject *
-int_init(SbIntObject *self, SbObject *args, SbObject *kwargs)
+int_new(SbObject *dummy, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:cls|O:x,i:radix");
+    SbTypeObject *cls;
     SbObject *x = NULL;
-    int radix = 0;
+    SbInt_Native_t radix = -1;
+    SbObject *value;
+    SbIntObject *result;
+    SbInt_Value storage;
+    const SbInt_Value *vv;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &cls, &x, &radix) < 0) {
+        return NULL;
+    }
+
+    if (!x) {
+        value = SbInt_FromNative(0);
+    }
+    else if (SbStr_CheckExact(x)) {
+        value = SbInt_FromString((const char *)SbStr_AsStringUnsafe(x), NULL, radix < 0 ? 10 : (unsigned)radix);
+    }
+    else if (SbInt_Check(x) && radix < 0) {
+        value = x;
+        Sb_INCREF(value);
+    }
+    else {
+        SbErr_RaiseWithString(SbExc_TypeError, radix < 0
+            ? "int() argument must be a string or a number"
+            : "int() can't convert non-string with explicit base");
+        return NULL;
+    }
+    if (!value || (cls == SbInt_Type && SbInt_CheckExact(value))) {
+        return value;
+    }
 
-    if (SbArgs_Parse("|O:x,i:radix", args, kwargs, &x, &radix) < 0) {
+    /* Subtype instances get a fresh object with a copy of the value. */
+    result = (SbIntObject *)SbObject_New(cls);
+    if (!result) {
+        Sb_DECREF(value);
         return NULL;
     }
+    vv = INT_VALUE(value, &storage);
+    if (LONG_IS_NATIVE(vv)) {
+        LONG_SET_NATIVE(&result->v);
+        result->v.u.value = vv->u.value;
+    }
+    else {
+        SbInt_Digit_t *digits;
 
-    LONG_SET_NATIVE(&self->v);
-    if (x) {
+        digits = long_alloc(vv->length);
+        if (!digits) {
+            /* Leave a valid native zero for the destructor. */
+            LONG_SET_NATIVE(&result->v);
+            Sb_DECREF(result);
+            Sb_DECREF(value);
+            return SbErr_NoMemory();
+        }
+        SbRT_MemCpy(digits, vv->u.digits, vv->length * sizeof(SbInt_Digit_t));
+        result->v.length = vv->length;
+        result->v.u.digits = digits;
     }
+    Sb_DECREF(value);
+    return (SbObject *)result;
+}
 
+static SbObject *
+int_init(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    /* Nothing to do: the value was set up by __new__ and cannot change. */
     Sb_RETURN_NONE;
 }
 
@@ -970,7 +2866,24 @@ int_destroy(SbIntObject *self)
     if (!LONG_IS_NATIVE(&self->v)) {
         long_free(self->v.u.digits);
     }
+    SbObject_DefaultDestroy((SbObject *)self);
+}
+
+#if SUPPORTS(OBJECT_FREELISTS)
+static SbFreeList int_freelist = SbFreeList_INIT(256);
+
+static SbObject *
+int_alloc(SbTypeObject *type, Sb_ssize_t nitems)
+{
+    return _SbFreeList_Alloc(&int_freelist, type, type->tp_basicsize);
+}
+
+static void
+int_free(void *p)
+{
+    _SbFreeList_Free(&int_freelist, p);
 }
+#endif
 
 static SbObject *
 int_hash(SbObject *self, SbObject *args, SbObject *kwargs)
@@ -982,7 +2895,8 @@ int_hash(SbObject *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 int_nonzero(SbObject *self, SbObject *args, SbObject *kwargs)
 {
-    const SbInt_Value *val = &((SbIntObject *)self)->v;
+    SbInt_Value storage;
+    const SbInt_Value *val = INT_VALUE(self, &storage);
 
     if (LONG_IS_NATIVE(val) && val->u.value == 0) {
         Sb_RETURN_FALSE;
@@ -1081,23 +2995,91 @@ int_fdiv(SbObject *self, SbObject *args, SbObject *kwargs)
     return int_binary_wrap(self, args, SbInt_FloorDivide);
 }
 
+static SbObject *
+int_mod(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    return int_binary_wrap(self, args, SbInt_Remainder);
+}
+
+static SbObject *
+int_pow(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:exp|O:mod");
+    SbObject *exp;
+    SbObject *mod = NULL;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &exp, &mod) < 0) {
+        return NULL;
+    }
+    if (mod == Sb_None) {
+        mod = NULL;
+    }
+    if (!SbInt_Check(exp) || (mod && !SbInt_Check(mod))) {
+        Sb_INCREF(Sb_NotImplemented);
+        return Sb_NotImplemented;
+    }
+    return SbInt_Power(self, exp, mod);
+}
+
+static SbObject *
+int_rpow(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    SbObject *other;
+
+    other = SbTuple_GetItem(args, 0);
+    if (!other) {
+        return NULL;
+    }
+    if (!SbInt_Check(other)) {
+        Sb_INCREF(Sb_NotImplemented);
+        return Sb_NotImplemented;
+    }
+    return SbInt_Power(other, self, NULL);
+}
+
+static SbObject *
+int_divmod_method(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    return int_binary_wrap(self, args, SbInt_DivMod);
+}
+
+/* Arbitrary limit to keep shifts from exhausting memory. */
+#define MAX_SHIFT_COUNT (1 << 16)
+
+/* Fetch a shift count; counts beyond the native range are clamped to INT_MAX.
+   Returns: 0 if OK, -1 on a negative count. */
+static int
+int_shift_count(SbObject *other, int *count)
+{
+    SbInt_Value storage;
+    const SbInt_Value *val = INT_VALUE(other, &storage);
+
+    if (LONG_IS_NATIVE(val) ? val->u.value < 0 : LONG_IS_NEGATIVE(val)) {
+        SbErr_RaiseWithString(SbExc_ValueError, "negative shift count");
+        return -1;
+    }
+    *count = LONG_IS_NATIVE(val) && val->u.value <= INT_MAX ? (int)val->u.value : INT_MAX;
+    return 0;
+}
+
 static SbObject *
 int_shl(SbObject *self, SbObject *args, SbObject *kwargs)
 {
     SbObject *other;
-    int overflow;
-    SbInt_Native_t shift;
+    int shift;
 
     other = SbTuple_GetItem(args, 0);
     if (!other) {
         return NULL;
     }
-    shift = SbInt_AsNativeOverflow(other, &overflow);
-    if (overflow) {
-        SbErr_RaiseWithString(SbExc_OverflowError, "shift amount out of range");
+    if (!SbInt_Check(other)) {
+        Sb_INCREF(Sb_NotImplemented);
+        return Sb_NotImplemented;
+    }
+    if (int_shift_count(other, &shift) < 0) {
         return NULL;
     }
-    if ((unsigned)shift > (1 << SbInt_DIGIT_BITS)) {
+    if (shift > MAX_SHIFT_COUNT) {
         SbErr_RaiseWithString(SbExc_OverflowError, "shift amount out of range");
         return NULL;
     }
@@ -1108,22 +3090,20 @@ static SbObject *
 int_shr(SbObject *self, SbObject *args, SbObject *kwargs)
 {
     SbObject *other;
-    int overflow;
-    SbInt_Native_t shift;
+    int shift;
 
     other = SbTuple_GetItem(args, 0);
     if (!other) {
         return NULL;
     }
-    shift = SbInt_AsNativeOverflow(other, &overflow);
-    if (overflow) {
-        SbErr_RaiseWithString(SbExc_OverflowError, "shift amount out of range");
-        return NULL;
+    if (!SbInt_Check(other)) {
+        Sb_INCREF(Sb_NotImplemented);
+        return Sb_NotImplemented;
     }
-    if ((unsigned)shift > (1 << SbInt_DIGIT_BITS)) {
-        SbErr_RaiseWithString(SbExc_OverflowError, "shift amount out of range");
+    if (int_shift_count(other, &shift) < 0) {
         return NULL;
     }
+    /* Shifting right cannot grow the value; a huge count leaves just the sign. */
     return SbInt_ShiftRight(self, shift);
 }
 
@@ -1170,17 +3150,24 @@ int_inv(SbObject *self, SbObject *args, SbObject *kwargs)
     return SbInt_Invert(self);
 }
 
+static SbObject *
+int_str(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    return SbInt_ToString(self, 10);
+}
+
 #if SUPPORTS(STR_FORMAT)
 
 static SbObject *
 int_format(SbObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("z:spec");
     const char *spec_string;
     SbString_FormatSpecifier spec;
     SbObject *tmp;
     SbObject *o_result;
 
-    if (SbArgs_Parse("z:spec", args, kwargs, &spec_string) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &spec_string) < 0) {
         return NULL;
     }
     if (SbString_ParseFormatSpec(spec_string ? spec_string : "", &spec) < 0) {
@@ -1203,35 +3190,15 @@ int_format(SbObject *self, SbObject *args, SbObject *kwargs)
         SbStr_AsStringUnsafe(tmp)[0] = (char)value;
     }
     else {
-        /* NOTE: Needs to be redone completely. */
-        SbInt_Native_t value;
         int radix = 10;
         char sign = '+';
         Sb_ssize_t sign_size;
         Sb_ssize_t fill_size;
+        SbObject *o_digits;
         const char *digits;
         Sb_ssize_t digits_size;
         char *buffer;
 
-        value = SbInt_AsNative(self);
-        if (value < 0) {
-            value = -value;
-            sign = '-';
-        }
-
-        if (spec.sign_flag == '+') {
-            sign_size = 1;
-        }
-        else if (spec.sign_flag == ' ') {
-            sign_size = 1;
-            if (sign == '+') {
-                sign = ' ';
-            }
-        }
-        else {
-            sign_size = sign == '-' ? 1 : 0;
-        }
-
         switch (spec.conv_type) {
         case 'x':
         case 'X':
@@ -1250,8 +3217,30 @@ int_format(SbObject *self, SbObject *args, SbObject *kwargs)
         default:
             break;
         }
-        digits = Sb_ULtoA(value, radix);
-        digits_size = SbRT_StrLen(digits);
+        o_digits = SbInt_ToString(self, radix);
+        if (!o_digits) {
+            return NULL;
+        }
+        digits = (const char *)SbStr_AsStringUnsafe(o_digits);
+        digits_size = SbStr_GetSizeUnsafe(o_digits);
+        if (*digits == '-') {
+            sign = '-';
+            ++digits;
+            --digits_size;
+        }
+
+        if (spec.sign_flag == '+') {
+            sign_size = 1;
+        }
+        else if (spec.sign_flag == ' ') {
+            sign_size = 1;
+            if (sign == '+') {
+                sign = ' ';
+            }
+        }
+        else {
+            sign_size = sign == '-' ? 1 : 0;
+        }
 
         fill_size = spec.min_width - (sign_size + digits_size);
         if (fill_size < 0) {
@@ -1270,6 +3259,7 @@ int_format(SbObject *self, SbObject *args, SbObject *kwargs)
                 fill_size--;
             }
             SbRT_MemCpy(buffer, digits, digits_size);
+            Sb_DECREF(o_digits);
             return o_result;
         }
 
@@ -1279,6 +3269,7 @@ int_format(SbObject *self, SbObject *args, SbObject *kwargs)
             *buffer++ = sign;
         }
         SbRT_MemCpy(buffer, digits, digits_size);
+        Sb_DECREF(o_digits);
     }
 
     if (spec.align_flag == '>') {
@@ -1299,9 +3290,12 @@ int_format(SbObject *self, SbObject *args, SbObject *kwargs)
 /* Builtins initializer */
 
 static const SbCMethodDef int_methods[] = {
-    { "__init__", (SbCFunction)int_init },
+    { "__new__", int_new },
+    { "__init__", int_init },
     { "__hash__", int_hash },
     { "__nonzero__", int_nonzero },
+    { "__str__", int_str },
+    { "__repr__", int_str },
 
     { "__lt__", int_lt },
     { "__le__", int_le },
@@ -1316,8 +3310,16 @@ static const SbCMethodDef int_methods[] = {
     { "__isub__", int_sub },
     { "__mul__", int_mul },
     { "__imul__", int_mul },
+    { "__div__", int_fdiv },
+    { "__idiv__", int_fdiv },
     { "__floordiv__", int_fdiv },
     { "__ifloordiv__", int_fdiv },
+    { "__mod__", int_mod },
+    { "__imod__", int_mod },
+    { "__divmod__", int_divmod_method },
+    { "__pow__", int_pow },
+    { "__ipow__", int_pow },
+    { "__rpow__", int_rpow },
     { "__lshift__", int_shl },
     { "__ilshift__", int_shl },
     { "__rshift__", int_shr },
@@ -1346,12 +3348,30 @@ int
 _SbInt_BuiltinInit()
 {
     SbTypeObject *tp;
+    SbInt_Native_t ival;
 
     tp = _SbType_FromCDefs("int", NULL, int_methods, sizeof(SbIntObject));
     if (!tp) {
         return -1;
     }
     tp->tp_destroy = (SbDestroyFunc)int_destroy;
+#if SUPPORTS(OBJECT_FREELISTS)
+    tp->tp_alloc = int_alloc;
+    tp->tp_free = int_free;
+#endif
     SbInt_Type = tp;
+
+#if !SUPPORTS(TAGGED_INTS)
+    for (ival = SMALL_INT_MIN; ival <= SMALL_INT_MAX; ++ival) {
+        SbObject *o;
+
+        o = SbInt_FromNative(ival);
+        if (!o) {
+            return -1;
+        }
+        Sb_SET_IMMORTAL(o);
+        small_ints[ival - SMALL_INT_MIN] = o;
+    }
+#endif
     return 0;
 }
@@ -3,6 +3,10 @@
 
 SbTypeObject *SbIter_Type = NULL;
 
+static SbDictKey key_call = SbDictKey_INIT("__call__");
+static SbDictKey key_iter = SbDictKey_INIT("__iter__");
+static SbDictKey key_getitem = SbDictKey_INIT("__getitem__");
+
 static SbObject *
 iter_next_iterable(SbIterObject *myself)
 {
@@ -107,11 +111,11 @@ iter_next_array(SbIterObject *myself)
 static void
 iter_cleanup_array(SbIterObject *myself)
 {
-    /* Nothing to do */
+    Sb_CLEAR(myself->u.with_array.owner);
 }
 
 SbObject *
-SbArrayIter_New(SbObject **base, SbObject **end)
+SbArrayIter_New(SbObject *owner, SbObject **base, SbObject **end)
 {
     SbObject *self;
 
@@ -121,6 +125,8 @@ SbArrayIter_New(SbObject **base, SbObject **end)
 
         myself->cleanupproc = &iter_cleanup_array;
         myself->nextproc = &iter_next_array;
+        Sb_INCREF(owner);
+        myself->u.with_array.owner = owner;
         myself->u.with_array.cursor = base;
         myself->u.with_array.end = end;
     }
@@ -128,6 +134,61 @@ SbArrayIter_New(SbObject **base, SbObject **end)
     return self;
 }
 
+static SbObject *
+iter_next_list(SbIterObject *myself)
+{
+    SbObject *list;
+    SbObject *result;
+
+    list = myself->u.with_iterable.iterable;
+    if (myself->u.with_iterable.index >= SbList_GetSizeUnsafe(list)) {
+        return NULL;
+    }
+    result = SbList_GetItemUnsafe(list, myself->u.with_iterable.index);
+    ++myself->u.with_iterable.index;
+    Sb_INCREF(result);
+    return result;
+}
+
+SbObject *
+SbListIter_New(SbObject *list)
+{
+    SbObject *self;
+
+    self = SbObject_New(SbIter_Type);
+    if (self) {
+        SbIterObject *myself = (SbIterObject *)self;
+
+        myself->cleanupproc = &iter_cleanup_iterable;
+        myself->nextproc = &iter_next_list;
+        Sb_INCREF(list);
+        myself->u.with_iterable.iterable = list;
+        myself->u.with_iterable.index = 0;
+    }
+
+    return self;
+}
+
+Sb_ssize_t
+SbIter_LengthHint(SbObject *o)
+{
+    SbIterObject *myself = (SbIterObject *)o;
+
+    if (Sb_TYPE(o) != SbIter_Type) {
+        return -1;
+    }
+    if (myself->nextproc == &iter_next_array) {
+        return myself->u.with_array.end - myself->u.with_array.cursor;
+    }
+    if (myself->nextproc == &iter_next_list) {
+        Sb_ssize_t remaining;
+
+        remaining = SbList_GetSizeUnsafe(myself->u.with_iterable.iterable) - myself->u.with_iterable.index;
+        return remaining > 0 ? remaining : 0;
+    }
+    return -1;
+}
+
 static void
 iter_destroy(SbIterObject *self)
 {
@@ -135,14 +196,31 @@ iter_destroy(SbIterObject *self)
     SbObject_DefaultDestroy((SbObject *)self);
 }
 
+#if SUPPORTS(OBJECT_FREELISTS)
+static SbFreeList iter_freelist = SbFreeList_INIT(16);
+
+static SbObject *
+iter_alloc(SbTypeObject *type, Sb_ssize_t nitems)
+{
+    return _SbFreeList_Alloc(&iter_freelist, type, type->tp_basicsize);
+}
+
+static void
+iter_free(void *p)
+{
+    _SbFreeList_Free(&iter_freelist, p);
+}
+#endif
+
 static SbObject *
 iter_new(SbObject *cls, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:cls,O:o|O:sentinel");
     SbObject *result;
     SbTypeObject *o_type;
     SbObject *o = NULL, *sentinel = NULL;
 
-    if (SbArgs_Parse("O:cls,O:o|O:sentinel", args, kwargs, &cls, &o, &sentinel) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &cls, &o, &sentinel) < 0) {
         return NULL;
     }
 
@@ -150,7 +228,7 @@ iter_new(SbObject *cls, SbObject *args, SbObject *kwargs)
     /* https://docs.python.org/2/library/functions.html#iter */
     if (sentinel) {
         /* If the second argument, sentinel, is given, then o must be a callable object. */
-        if (!SbDict_GetItemString(o_type->tp_dict, "__call__")) {
+        if (!SbDict_GetItemKey(o_type->tp_dict, &key_call)) {
             SbErr_RaiseWithFormat(SbExc_TypeError, "'%s' object is not callable", o_type->tp_name);
             return NULL;
         }
@@ -161,11 +239,11 @@ iter_new(SbObject *cls, SbObject *args, SbObject *kwargs)
         /* Without a second argument, o must be a collection object which 
          * supports the iteration protocol (the __iter__() method), or 
          * it must support the sequence protocol (the __getitem__() method). */
-        if (SbDict_GetItemString(o_type->tp_dict, "__iter__")) {
+        if (SbDict_GetItemKey(o_type->tp_dict, &key_iter)) {
             /* Simply pass the object's iterator */
-            return SbObject_CallMethod(o, "__iter__", NULL, NULL);
+            return _SbObject_CallMethodKey(o, &key_iter, NULL, NULL);
         }
-        if (SbDict_GetItemString(o_type->tp_dict, "__getitem__")) {
+        if (SbDict_GetItemKey(o_type->tp_dict, &key_getitem)) {
             result = SbIter_New(o);
             return result;
         }
@@ -211,6 +289,10 @@ _Sb_TypeInit_Iter()
         return -1;
     }
     tp->tp_destroy = (SbDestroyFunc)iter_destroy;
+#if SUPPORTS(OBJECT_FREELISTS)
+    tp->tp_alloc = iter_alloc;
+    tp->tp_free = iter_free;
+#endif
     SbIter_Type = tp;
     return 0;
 }
@@ -4,52 +4,197 @@
 /* Keep the type object here. */
 SbTypeObject *SbList_Type = NULL;
 
+/* Reallocate the item storage to hold exactly `new_allocated` items.
+   Returns: 0 if OK, -1 otherwise. */
+static int
+list_set_allocated(SbListObject *self, Sb_ssize_t new_allocated)
+{
+    SbObject **new_items;
+
+    if (new_allocated == 0) {
+        SbObject_Free(self->items);
+        self->items = NULL;
+        self->allocated = 0;
+        return 0;
+    }
+    if ((Sb_size_t)new_allocated > Sb_SSIZE_MAX / sizeof(SbObject *)) {
+        SbErr_NoMemory();
+        return -1;
+    }
+    new_items = (SbObject **)SbObject_Realloc(self->items, new_allocated * sizeof(SbObject *));
+    if (!new_items) {
+        if (new_allocated < self->allocated) {
+            /* Failing to shrink is harmless: keep the old storage. */
+            return 0;
+        }
+        /* OOM */
+        SbErr_NoMemory();
+        return -1;
+    }
+    self->items = new_items;
+    self->allocated = new_allocated;
+    return 0;
+}
+
+/* Set the item count, growing or shrinking the storage as required.
+   Growth over-allocates in proportion to the size, which makes a run of
+   appends amortized O(1); storage is trimmed only once less than half of
+   it is in use, so alternating appends and deletes do not reallocate.
+   New slots are set to NULL; removed ones must have been released already.
+   Returns: 0 if OK, -1 otherwise. */
 static int
 list_resize(SbListObject *self, Sb_ssize_t new_length)
 {
-    Sb_ssize_t old_allocated = self->allocated;
-    if (old_allocated < new_length) {
+    Sb_ssize_t allocated = self->allocated;
+    Sb_ssize_t pos;
+
+    if (new_length > allocated || (new_length < self->count && new_length < (allocated >> 1))) {
         Sb_ssize_t new_allocated;
-        SbObject **new_items;
-        
-        new_allocated = new_length + 4;
-        new_items = (SbObject **)SbObject_Realloc(self->items, new_allocated * sizeof(SbObject *));
-        if (!new_items) {
-            /* OOM */
+
+        new_allocated = new_length ? new_length + (new_length >> 3) + (new_length < 9 ? 3 : 6) : 0;
+        if (new_allocated < new_length) {
             SbErr_NoMemory();
             return -1;
         }
-
-        while (old_allocated < new_allocated) {
-            new_items[old_allocated++] = NULL;
+        if (list_set_allocated(self, new_allocated) < 0) {
+            return -1;
         }
-
-        self->items = new_items;
-        self->allocated = new_allocated;
+    }
+    for (pos = self->count; pos < new_length; ++pos) {
+        self->items[pos] = NULL;
     }
     self->count = new_length;
     return 0;
 }
 
-static void
-list_compact(SbObject *self, SbInt_Native_t offset)
+/* Replaced items are kept here until the list is consistent again. */
+#define LIST_RECYCLE_ON_STACK 8
+
+/* Replace the items [lo, hi) with `n` items from `v`, taking new references.
+   The tail is shifted with one memmove; the replaced items are released
+   last, as their destructors may run code that looks at this list.
+   `v` must not point into this list's storage.
+   Returns: 0 if OK, -1 otherwise. */
+static int
+list_ass_slice(SbListObject *self, Sb_ssize_t lo, Sb_ssize_t hi, SbObject **v, Sb_ssize_t n)
 {
-    SbListObject * const myself = (SbListObject *)self;
-    SbObject **dst, **src;
+    SbObject *recycle_on_stack[LIST_RECYCLE_ON_STACK];
+    SbObject **recycle = recycle_on_stack;
     SbObject **items;
-    SbObject **limit;
+    Sb_ssize_t count = self->count;
+    Sb_ssize_t removed = hi - lo;
+    Sb_ssize_t delta = n - removed;
+    Sb_ssize_t pos;
+
+    if (removed > LIST_RECYCLE_ON_STACK) {
+        recycle = (SbObject **)SbObject_Malloc(removed * sizeof(SbObject *));
+        if (!recycle) {
+            SbErr_NoMemory();
+            return -1;
+        }
+    }
+    SbRT_MemCpy(recycle, self->items + lo, removed * sizeof(SbObject *));
+
+    if (delta < 0) {
+        items = self->items;
+        SbRT_MemMove(items + hi + delta, items + hi, (count - hi) * sizeof(SbObject *));
+        /* Shrinking can't fail. */
+        list_resize(self, count + delta);
+    }
+    else if (delta > 0) {
+        if (list_resize(self, count + delta) < 0) {
+            if (recycle != recycle_on_stack) {
+                SbObject_Free(recycle);
+            }
+            return -1;
+        }
+        items = self->items;
+        SbRT_MemMove(items + hi + delta, items + hi, (count - hi) * sizeof(SbObject *));
+    }
+    items = self->items;
+    for (pos = 0; pos < n; ++pos) {
+        Sb_INCREF(v[pos]);
+        items[lo + pos] = v[pos];
+    }
+
+    for (pos = removed - 1; pos >= 0; --pos) {
+        Sb_XDECREF(recycle[pos]);
+    }
+    if (recycle != recycle_on_stack) {
+        SbObject_Free(recycle);
+    }
+    return 0;
+}
+
+/* Delete `slice_length` items starting at `start`, `step` apart (step > 1):
+   the runs between the deleted items are moved down in a single pass.
+   Returns: 0 if OK, -1 otherwise. */
+static int
+list_del_extended(SbListObject *self, Sb_ssize_t start, Sb_ssize_t step, Sb_ssize_t slice_length)
+{
+    SbObject **recycle;
+    SbObject **items = self->items;
+    Sb_ssize_t count = self->count;
+    Sb_ssize_t pos, dst, src, run;
+
+    recycle = (SbObject **)SbObject_Malloc(slice_length * sizeof(SbObject *));
+    if (!recycle) {
+        SbErr_NoMemory();
+        return -1;
+    }
+
+    dst = start;
+    for (pos = 0; pos < slice_length; ++pos) {
+        src = start + pos * step;
+        recycle[pos] = items[src];
+        /* Move the run up to the next deleted item, or to the end. */
+        run = pos + 1 < slice_length ? step - 1 : count - src - 1;
+        SbRT_MemMove(items + dst, items + src + 1, run * sizeof(SbObject *));
+        dst += run;
+    }
+    list_resize(self, count - slice_length);
+
+    for (pos = slice_length - 1; pos >= 0; --pos) {
+        Sb_XDECREF(recycle[pos]);
+    }
+    SbObject_Free(recycle);
+    return 0;
+}
+
+/* Resolve `o` into a flat item array, which stays valid while *holder lives.
+   Lists and tuples are used in place, except when `o` is `self`;
+   anything else is first collected into a new list.
+   Returns: 0 if OK, -1 otherwise. */
+static int
+list_seq_items(SbListObject *self, SbObject *o, SbObject ***items, Sb_ssize_t *count, SbObject **holder)
+{
+    if (SbTuple_CheckExact(o)) {
+        Sb_INCREF(o);
+        *holder = o;
+        *items = ((SbTupleObject *)o)->items;
+        *count = SbTuple_GetSizeUnsafe(o);
+        return 0;
+    }
+    if (SbList_CheckExact(o) && o != (SbObject *)self) {
+        Sb_INCREF(o);
+    }
+    else {
+        SbObject *copy;
 
-    items = myself->items;
-    limit = items + myself->count;
-    dst = src = items + offset;
-    while (src != limit) {
-        if (*src) {
-            *dst = *src;
-            ++dst;
+        copy = SbList_New(0);
+        if (!copy) {
+            return -1;
+        }
+        if (SbList_Extend(copy, o) < 0) {
+            Sb_DECREF(copy);
+            return -1;
         }
-        ++src;
+        o = copy;
     }
-    myself->count = dst - items;
+    *holder = o;
+    *items = ((SbListObject *)o)->items;
+    *count = ((SbListObject *)o)->count;
+    return 0;
 }
 
 static int
@@ -82,6 +227,31 @@ list_destroy(SbListObject *self)
     SbObject_DefaultDestroy((SbObject *)self);
 }
 
+static int
+list_traverse(SbListObject *self, SbVisitFunc visit, void *arg)
+{
+    Sb_ssize_t pos;
+
+    for (pos = 0; pos < self->count; ++pos) {
+        Sb_VISIT(self->items[pos]);
+    }
+    return 0;
+}
+
+static int
+list_clear(SbListObject *self)
+{
+    Sb_ssize_t pos;
+    Sb_ssize_t size = SbList_GetSizeUnsafe(self);
+
+    /* Leave an empty list behind. */
+    self->count = 0;
+    for (pos = 0; pos < size; ++pos) {
+        Sb_CLEAR(self->items[pos]);
+    }
+    return 0;
+}
+
 /*
  * C interface implementations
  */
@@ -102,9 +272,12 @@ SbList_New(Sb_ssize_t length)
         goto fail0;
     }
 
-    /* Allocator returns the memory wiped with zeros, so no need to do that again. */
+    /* The size is known up front: allocate exactly, items set to NULL. */
     op = (SbListObject *)SbObject_New(SbList_Type);
     if (op) {
+        if (list_set_allocated(op, length) < 0) {
+            goto fail1;
+        }
         if (list_resize(op, length) < 0) {
             goto fail1;
         }
@@ -185,6 +358,24 @@ SbList_SetItem(SbObject *p, Sb_ssize_t pos, SbObject *o)
     return 0;
 }
 
+int
+SbList_Reserve(SbObject *p, Sb_ssize_t count)
+{
+    SbListObject *op = (SbListObject *)p;
+
+#if SUPPORTS(BUILTIN_TYPECHECKS)
+    if (!SbList_CheckExact(p)) {
+        SbErr_RaiseWithString(SbExc_SystemError, "non-list object passed to a list method");
+        return -1;
+    }
+#endif
+
+    if (count <= op->allocated) {
+        return 0;
+    }
+    return list_set_allocated(op, count);
+}
+
 int
 SbList_Append(SbObject *p, SbObject *o)
 {
@@ -210,180 +401,1319 @@ fail0:
     return -1;
 }
 
-
-static SbObject *
-list_len(SbObject *self, SbObject *args, SbObject *kwargs)
-{
-    return SbInt_FromNative(SbList_GetSizeUnsafe(self));
-}
-
-static SbObject *
-list_getitem(SbObject *self, SbObject *args, SbObject *kwargs)
+int
+SbList_Insert(SbObject *p, Sb_ssize_t pos, SbObject *o)
 {
-    SbObject *index;
-    SbObject *result;
+    Sb_ssize_t count;
 
-    if (SbArgs_Parse("O:index", args, kwargs, &index) < 0) {
-        return NULL;
+#if SUPPORTS(BUILTIN_TYPECHECKS)
+    if (!SbList_CheckExact(p)) {
+        SbErr_RaiseWithString(SbExc_SystemError, "non-list object passed to a list method");
+        return -1;
     }
-    if (SbSlice_Check(index)) {
-        SbInt_Native_t start, end, step, slice_length;
-        SbInt_Native_t my_pos, result_pos;
-
-        if (SbSlice_GetIndices(index, SbList_GetSizeUnsafe(self), &start, &end, &step, &slice_length) < 0) {
-            return NULL;
-        }
-
-        result = SbList_New(slice_length);
-        if (!result) {
-            return NULL;
-        }
+#endif
 
-        result_pos = 0;
-        my_pos = start;
-        while (my_pos < end) {
-            SbList_SetItemUnsafe(result, result_pos, SbList_GetItemUnsafe(self, my_pos));
-            result_pos += 1;
-            my_pos += step;
+    count = SbList_GetSizeUnsafe(p);
+    if (pos < 0) {
+        pos += count;
+        if (pos < 0) {
+            pos = 0;
         }
-
-        return result;
     }
-    if (SbInt_Check(index)) {
-        SbInt_Native_t pos;
-
-        pos = SbInt_AsNative(index);
-        if (pos == -1 && SbErr_Occurred()) {
-            return NULL;
-        }
-        result = SbList_GetItem(self, pos);
-        if (result) {
-            Sb_INCREF(result);
-        }
-        return result;
+    if (pos > count) {
+        pos = count;
     }
-    return _SbErr_IncorrectSubscriptType(index);
+    return list_ass_slice((SbListObject *)p, pos, pos, &o, 1);
 }
 
-static SbObject *
-list_setitem(SbObject *self, SbObject *args, SbObject *kwargs)
+int
+SbList_Extend(SbObject *p, SbObject *iterable)
 {
-    SbObject *index;
-    SbObject *value;
+    SbListObject *op = (SbListObject *)p;
+    Sb_ssize_t count;
+    Sb_ssize_t n;
+    Sb_ssize_t pos;
+    SbObject **src;
+    SbObject *it;
+    SbObject *o;
 
-    if (SbArgs_Parse("O:index,O:value", args, kwargs, &index, &value) < 0) {
-        return NULL;
+#if SUPPORTS(BUILTIN_TYPECHECKS)
+    if (!SbList_CheckExact(p)) {
+        SbErr_RaiseWithString(SbExc_SystemError, "non-list object passed to a list method");
+        return -1;
     }
-    if (SbSlice_Check(index)) {
-        SbInt_Native_t start, end, step, slice_length;
-        SbInt_Native_t my_pos;
-        SbObject *it;
-
-        if (SbSlice_GetIndices(index, SbList_GetSizeUnsafe(self), &start, &end, &step, &slice_length) < 0) {
-            return NULL;
-        }
+#endif
 
-        it = SbObject_GetIter(value);
-        if (!it) {
-            return NULL;
+    count = op->count;
+    if (SbList_CheckExact(iterable) || SbTuple_CheckExact(iterable)) {
+        n = SbList_CheckExact(iterable) ? SbList_GetSizeUnsafe(iterable) : SbTuple_GetSizeUnsafe(iterable);
+        if (list_resize(op, count + n) < 0) {
+            return -1;
         }
-
-        my_pos = start;
-        while (my_pos < end) {
-            SbObject *o;
-
-            o = SbIter_Next(it);
-            if (!o) {
-                if (SbErr_Occurred()) {
-                    return NULL;
-                }
-                /* TODO: CPython starts appending items here. */
-                break;
-            }
-            SbList_SetItemUnsafe(self, my_pos, o);
-            my_pos += step;
+        /* Fetch after resizing: `iterable` may be this very list. */
+        src = SbList_CheckExact(iterable) ? ((SbListObject *)iterable)->items : ((SbTupleObject *)iterable)->items;
+        for (pos = 0; pos < n; ++pos) {
+            Sb_INCREF(src[pos]);
+            op->items[count + pos] = src[pos];
         }
+        return 0;
+    }
 
-        Sb_RETURN_NONE;
+    it = SbObject_GetIter(iterable);
+    if (!it) {
+        return -1;
     }
-    if (SbInt_Check(index)) {
-        SbInt_Native_t pos;
+    n = SbIter_LengthHint(it);
+    if (n > 0 && SbList_Reserve(p, count + n) < 0) {
+        goto fail;
+    }
+    while ((o = SbIter_Next(it)) != NULL) {
         int result;
 
-        pos = SbInt_AsNative(index);
-        if (pos == -1 && SbErr_Occurred()) {
-            return NULL;
-        }
-        Sb_INCREF(value);
-        result = SbList_SetItem(self, pos, value);
+        result = SbList_Append(p, o);
+        Sb_DECREF(o);
         if (result < 0) {
-            return NULL;
+            goto fail;
         }
-        Sb_RETURN_NONE;
     }
-    return _SbErr_IncorrectSubscriptType(index);
+    if (SbErr_Occurred()) {
+        goto fail;
+    }
+    Sb_DECREF(it);
+    return 0;
+
+fail:
+    Sb_DECREF(it);
+    return -1;
 }
 
-static SbObject *
-list_delitem(SbObject *self, SbObject *args, SbObject *kwargs)
+int
+SbList_SetSlice(SbObject *p, Sb_ssize_t low, Sb_ssize_t high, SbObject *v)
 {
-    SbObject *index;
+    SbListObject *op = (SbListObject *)p;
+    Sb_ssize_t count;
+    SbObject **items = NULL;
+    Sb_ssize_t n = 0;
+    SbObject *holder = NULL;
+    int result;
 
-    if (SbArgs_Parse("O:index", args, kwargs, &index) < 0) {
-        return NULL;
+#if SUPPORTS(BUILTIN_TYPECHECKS)
+    if (!SbList_CheckExact(p)) {
+        SbErr_RaiseWithString(SbExc_SystemError, "non-list object passed to a list method");
+        return -1;
     }
-    if (SbSlice_Check(index)) {
-        SbInt_Native_t start, end, step, slice_length;
-        SbInt_Native_t my_pos;
+#endif
 
-        if (SbSlice_GetIndices(index, SbList_GetSizeUnsafe(self), &start, &end, &step, &slice_length) < 0) {
-            return NULL;
-        }
+    /* Collecting the items may run Python code that resizes the list,
+       so the bounds are clamped only afterwards. */
+    if (v && list_seq_items(op, v, &items, &n, &holder) < 0) {
+        return -1;
+    }
+    count = op->count;
+    if (low < 0) {
+        low = 0;
+    }
+    else if (low > count) {
+        low = count;
+    }
+    if (high < low) {
+        high = low;
+    }
+    else if (high > count) {
+        high = count;
+    }
+    result = list_ass_slice(op, low, high, items, n);
+    Sb_XDECREF(holder);
+    return result;
+}
 
-        my_pos = start;
-        while (my_pos < end) {
-            SbList_SetItemUnsafe(self, my_pos, NULL);
-            my_pos += step;
-        }
 
-        list_compact(self, start);
-        Sb_RETURN_NONE;
-    }
-    if (SbInt_Check(index)) {
-        SbInt_Native_t my_pos;
-        int result;
+/*
+ * Sorting
+ *
+ * A stable, adaptive merge sort after Tim Peters' listsort. Natural runs are
+ * detected (strictly descending ones are reversed in place), short runs are
+ * extended with binary insertion, and runs are merged so that the pending
+ * run lengths keep the invariants which make merges balanced. Once one run
+ * keeps winning during a merge, the merge switches to galloping.
+ * When a key function is given, keys are computed once and sorted in step
+ * with the items.
+ */
 
-        my_pos = SbInt_AsNative(index);
-        if (my_pos == -1 && SbErr_Occurred()) {
-            return NULL;
-        }
-        result = SbList_SetItem(self, my_pos, NULL);
-        if (result < 0) {
-            return NULL;
-        }
-        list_compact(self, my_pos);
-        Sb_RETURN_NONE;
+/* How many wins in a row switch a merge to galloping */
+#define SORT_MIN_GALLOP 7
+/* Enough pending runs for any list that fits in memory */
+#define SORT_MAX_PENDING 85
+/* Merge temp space held on the stack, in pointers */
+#define SORT_TEMP_ON_STACK 256
+
+/* Keys, and the items that move with them (NULL when sorting the items themselves) */
+typedef struct _sort_slice {
+    SbObject **keys;
+    SbObject **values;
+} sort_slice;
+
+typedef struct _sort_run {
+    sort_slice base;
+    Sb_ssize_t len;
+} sort_run;
+
+typedef int (*sort_lt_func)(SbObject *a, SbObject *b);
+
+typedef struct _sort_state {
+    sort_lt_func lt;
+    Sb_ssize_t min_gallop;
+    /* Temp space for merges; may point to temp_on_stack */
+    sort_slice temp;
+    Sb_ssize_t temp_size;
+    /* The stack of runs waiting to be merged */
+    Sb_ssize_t n;
+    sort_run pending[SORT_MAX_PENDING];
+    SbObject *temp_on_stack[SORT_TEMP_ON_STACK];
+} sort_state;
+
+/* Returns: -1 on error, 0 if the result is false, 1 otherwise. */
+static int
+sort_lt_generic(SbObject *a, SbObject *b)
+{
+    int result;
+
+    result = SbObject_CompareBool(a, b, Sb_LT);
+    if (result < 0 && !SbErr_Occurred()) {
+        SbErr_RaiseWithFormat(SbExc_TypeError, "unorderable types: %s() < %s()",
+            Sb_TYPE(a)->tp_name, Sb_TYPE(b)->tp_name);
     }
-    return _SbErr_IncorrectSubscriptType(index);
+    return result;
 }
 
-static SbObject *
-list_iter(SbObject *self, SbObject *args, SbObject *kwargs)
+static int
+sort_lt_int(SbObject *a, SbObject *b)
 {
-    SbObject **base;
+    return SbInt_CompareBool(a, b, Sb_LT);
+}
 
-    base = ((SbListObject *)self)->items;
-    return SbArrayIter_New(base, base + SbList_GetSizeUnsafe(self));
+static int
+sort_lt_str(SbObject *a, SbObject *b)
+{
+    return _SbStr_Compare(a, b) < 0;
 }
 
+#define SORT_ISLT(ms, a, b) ((ms)->lt((a), (b)))
 
-static SbObject *
-list_append(SbObject *self, SbObject *args, SbObject *kwargs)
+/* Evaluate the comparison, jumping to fail on errors. */
+#define SORT_IFLT(ms, a, b) \
+    if ((k = SORT_ISLT(ms, a, b)) < 0) goto fail; \
+    if (k)
+
+static void
+sort_slice_copy(sort_slice *dst, Sb_ssize_t i, const sort_slice *src, Sb_ssize_t j)
 {
-    SbObject *o;
+    dst->keys[i] = src->keys[j];
+    if (dst->values) {
+        dst->values[i] = src->values[j];
+    }
+}
 
-    if (SbArgs_Parse("O:o", args, kwargs, &o) < 0) {
-        return NULL;
+static void
+sort_slice_copy_incr(sort_slice *dst, sort_slice *src)
+{
+    *dst->keys++ = *src->keys++;
+    if (dst->values) {
+        *dst->values++ = *src->values++;
+    }
+}
+
+static void
+sort_slice_copy_decr(sort_slice *dst, sort_slice *src)
+{
+    *dst->keys-- = *src->keys--;
+    if (dst->values) {
+        *dst->values-- = *src->values--;
+    }
+}
+
+static void
+sort_slice_memcpy(sort_slice *dst, Sb_ssize_t i, const sort_slice *src, Sb_ssize_t j, Sb_ssize_t n)
+{
+    SbRT_MemCpy(&dst->keys[i], &src->keys[j], n * sizeof(SbObject *));
+    if (dst->values) {
+        SbRT_MemCpy(&dst->values[i], &src->values[j], n * sizeof(SbObject *));
+    }
+}
+
+static void
+sort_slice_memmove(sort_slice *dst, Sb_ssize_t i, const sort_slice *src, Sb_ssize_t j, Sb_ssize_t n)
+{
+    SbRT_MemMove(&dst->keys[i], &src->keys[j], n * sizeof(SbObject *));
+    if (dst->values) {
+        SbRT_MemMove(&dst->values[i], &src->values[j], n * sizeof(SbObject *));
+    }
+}
+
+static void
+sort_slice_advance(sort_slice *s, Sb_ssize_t n)
+{
+    s->keys += n;
+    if (s->values) {
+        s->values += n;
+    }
+}
+
+static void
+sort_reverse_items(SbObject **lo, Sb_ssize_t n)
+{
+    SbObject **hi;
+
+    if (n < 2) {
+        return;
+    }
+    hi = lo + n - 1;
+    while (lo < hi) {
+        SbObject *tmp = *lo;
+
+        *lo++ = *hi;
+        *hi-- = tmp;
+    }
+}
+
+static void
+sort_reverse_slice(sort_slice *s, Sb_ssize_t n)
+{
+    sort_reverse_items(s->keys, n);
+    if (s->values) {
+        sort_reverse_items(s->values, n);
+    }
+}
+
+/* Sort [0, n) with binary insertion, given that [0, start) is already sorted.
+   Returns: 0 if OK, -1 otherwise. */
+static int
+sort_binary_insertion(sort_state *ms, sort_slice lo, Sb_ssize_t n, Sb_ssize_t start)
+{
+    Sb_ssize_t k;
+    Sb_ssize_t l, r, p;
+    SbObject *pivot;
+
+    if (start == 0) {
+        ++start;
+    }
+    for ( ; start < n; ++start) {
+        l = 0;
+        r = start;
+        pivot = lo.keys[r];
+        /* Insert after any equal items to keep the sort stable. */
+        do {
+            p = l + ((r - l) >> 1);
+            SORT_IFLT(ms, pivot, lo.keys[p]) {
+                r = p;
+            }
+            else {
+                l = p + 1;
+            }
+        } while (l < r);
+        SbRT_MemMove(&lo.keys[l + 1], &lo.keys[l], (start - l) * sizeof(SbObject *));
+        lo.keys[l] = pivot;
+        if (lo.values) {
+            pivot = lo.values[start];
+            SbRT_MemMove(&lo.values[l + 1], &lo.values[l], (start - l) * sizeof(SbObject *));
+            lo.values[l] = pivot;
+        }
+    }
+    return 0;
+
+fail:
+    return -1;
+}
+
+/* Measure the run at the start of [lo, hi): either non-descending, or
+   strictly descending, so that reversing it cannot break stability.
+   Returns: run length if OK, -1 otherwise. */
+static Sb_ssize_t
+sort_count_run(sort_state *ms, SbObject **lo, SbObject **hi, int *descending)
+{
+    Sb_ssize_t k;
+    Sb_ssize_t n;
+
+    *descending = 0;
+    ++lo;
+    if (lo == hi) {
+        return 1;
+    }
+
+    n = 2;
+    SORT_IFLT(ms, lo[0], lo[-1]) {
+        *descending = 1;
+        for (++lo; lo < hi; ++lo, ++n) {
+            SORT_IFLT(ms, lo[0], lo[-1]) {
+                continue;
+            }
+            break;
+        }
+    }
+    else {
+        for (++lo; lo < hi; ++lo, ++n) {
+            SORT_IFLT(ms, lo[0], lo[-1]) {
+                break;
+            }
+        }
+    }
+    return n;
+
+fail:
+    return -1;
+}
+
+/* Locate where `key` goes in the sorted a[0, n), left of any equal items.
+   The search gallops out from a[hint] before doing a binary search.
+   Returns: position if OK, -1 otherwise. */
+static Sb_ssize_t
+sort_gallop_left(sort_state *ms, SbObject *key, SbObject **a, Sb_ssize_t n, Sb_ssize_t hint)
+{
+    Sb_ssize_t ofs, lastofs, maxofs;
+    Sb_ssize_t k;
+
+    a += hint;
+    lastofs = 0;
+    ofs = 1;
+    SORT_IFLT(ms, a[0], key) {
+        /* a[hint] < key: gallop right until a[hint + lastofs] < key <= a[hint + ofs] */
+        maxofs = n - hint;
+        while (ofs < maxofs) {
+            SORT_IFLT(ms, a[ofs], key) {
+                lastofs = ofs;
+                ofs = (ofs << 1) + 1;
+            }
+            else {
+                break;
+            }
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        lastofs += hint;
+        ofs += hint;
+    }
+    else {
+        /* key <= a[hint]: gallop left until a[hint - ofs] < key <= a[hint - lastofs] */
+        maxofs = hint + 1;
+        while (ofs < maxofs) {
+            SORT_IFLT(ms, a[-ofs], key) {
+                break;
+            }
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        k = lastofs;
+        lastofs = hint - ofs;
+        ofs = hint - k;
+    }
+    a -= hint;
+
+    /* Now a[lastofs] < key <= a[ofs]: binary search in between. */
+    ++lastofs;
+    while (lastofs < ofs) {
+        Sb_ssize_t m = lastofs + ((ofs - lastofs) >> 1);
+
+        SORT_IFLT(ms, a[m], key) {
+            lastofs = m + 1;
+        }
+        else {
+            ofs = m;
+        }
+    }
+    return ofs;
+
+fail:
+    return -1;
+}
+
+/* Same as sort_gallop_left, but goes right of any equal items.
+   Returns: position if OK, -1 otherwise. */
+static Sb_ssize_t
+sort_gallop_right(sort_state *ms, SbObject *key, SbObject **a, Sb_ssize_t n, Sb_ssize_t hint)
+{
+    Sb_ssize_t ofs, lastofs, maxofs;
+    Sb_ssize_t k;
+
+    a += hint;
+    lastofs = 0;
+    ofs = 1;
+    SORT_IFLT(ms, key, a[0]) {
+        /* key < a[hint]: gallop left until a[hint - ofs] <= key < a[hint - lastofs] */
+        maxofs = hint + 1;
+        while (ofs < maxofs) {
+            SORT_IFLT(ms, key, a[-ofs]) {
+                lastofs = ofs;
+                ofs = (ofs << 1) + 1;
+            }
+            else {
+                break;
+            }
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        k = lastofs;
+        lastofs = hint - ofs;
+        ofs = hint - k;
+    }
+    else {
+        /* a[hint] <= key: gallop right until a[hint + lastofs] <= key < a[hint + ofs] */
+        maxofs = n - hint;
+        while (ofs < maxofs) {
+            SORT_IFLT(ms, key, a[ofs]) {
+                break;
+            }
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        lastofs += hint;
+        ofs += hint;
+    }
+    a -= hint;
+
+    /* Now a[lastofs] <= key < a[ofs]: binary search in between. */
+    ++lastofs;
+    while (lastofs < ofs) {
+        Sb_ssize_t m = lastofs + ((ofs - lastofs) >> 1);
+
+        SORT_IFLT(ms, key, a[m]) {
+            ofs = m;
+        }
+        else {
+            lastofs = m + 1;
+        }
+    }
+    return ofs;
+
+fail:
+    return -1;
+}
+
+static void
+sort_free_temp(sort_state *ms)
+{
+    if (ms->temp.keys != ms->temp_on_stack) {
+        SbObject_Free(ms->temp.keys);
+    }
+}
+
+static void
+sort_init_state(sort_state *ms, sort_lt_func lt, int has_values)
+{
+    ms->lt = lt;
+    ms->min_gallop = SORT_MIN_GALLOP;
+    ms->n = 0;
+    ms->temp.keys = ms->temp_on_stack;
+    if (has_values) {
+        ms->temp_size = SORT_TEMP_ON_STACK / 2;
+        ms->temp.values = ms->temp_on_stack + ms->temp_size;
+    }
+    else {
+        ms->temp_size = SORT_TEMP_ON_STACK;
+        ms->temp.values = NULL;
+    }
+}
+
+/* Make sure the temp space holds at least `need` entries.
+   Returns: 0 if OK, -1 otherwise. */
+static int
+sort_get_temp(sort_state *ms, Sb_ssize_t need)
+{
+    Sb_ssize_t multiplier = ms->temp.values ? 2 : 1;
+
+    if (need <= ms->temp_size) {
+        return 0;
+    }
+    /* The old contents need not be kept. */
+    sort_free_temp(ms);
+    if ((Sb_size_t)need > Sb_SSIZE_MAX / sizeof(SbObject *) / multiplier) {
+        goto fail;
+    }
+    ms->temp.keys = (SbObject **)SbObject_Malloc(multiplier * need * sizeof(SbObject *));
+    if (!ms->temp.keys) {
+        goto fail;
+    }
+    ms->temp_size = need;
+    if (ms->temp.values) {
+        ms->temp.values = ms->temp.keys + need;
+    }
+    return 0;
+
+fail:
+    sort_init_state(ms, ms->lt, ms->temp.values != NULL);
+    SbErr_NoMemory();
+    return -1;
+}
+
+/* Merge the adjacent runs a[0, na) and b[0, nb) in place, where na <= nb,
+   b[0] < a[0] and a[na - 1] belongs at the very end; a is moved to temp.
+   On errors, whatever is left in temp is copied back, so no item is lost.
+   Returns: 0 if OK, -1 otherwise. */
+static int
+sort_merge_lo(sort_state *ms, sort_slice ssa, Sb_ssize_t na, sort_slice ssb, Sb_ssize_t nb)
+{
+    Sb_ssize_t k;
+    sort_slice dest;
+    Sb_ssize_t min_gallop;
+    int result = -1;
+
+    if (sort_get_temp(ms, na) < 0) {
+        return -1;
+    }
+    sort_slice_memcpy(&ms->temp, 0, &ssa, 0, na);
+    dest = ssa;
+    ssa = ms->temp;
+
+    sort_slice_copy_incr(&dest, &ssb);
+    --nb;
+    if (nb == 0) {
+        goto succeed;
+    }
+    if (na == 1) {
+        goto copy_b;
+    }
+
+    min_gallop = ms->min_gallop;
+    for (;;) {
+        Sb_ssize_t acount = 0;
+        Sb_ssize_t bcount = 0;
+
+        /* One pair at a time, until one run appears to win consistently. */
+        for (;;) {
+            k = SORT_ISLT(ms, ssb.keys[0], ssa.keys[0]);
+            if (k) {
+                if (k < 0) {
+                    goto fail;
+                }
+                sort_slice_copy_incr(&dest, &ssb);
+                ++bcount;
+                acount = 0;
+                --nb;
+                if (nb == 0) {
+                    goto succeed;
+                }
+                if (bcount >= min_gallop) {
+                    break;
+                }
+            }
+            else {
+                sort_slice_copy_incr(&dest, &ssa);
+                ++acount;
+                bcount = 0;
+                --na;
+                if (na == 1) {
+                    goto copy_b;
+                }
+                if (acount >= min_gallop) {
+                    break;
+                }
+            }
+        }
+
+        /* Gallop until neither run wins consistently anymore. */
+        ++min_gallop;
+        do {
+            min_gallop -= min_gallop > 1;
+            ms->min_gallop = min_gallop;
+            k = sort_gallop_right(ms, ssb.keys[0], ssa.keys, na, 0);
+            acount = k;
+            if (k) {
+                if (k < 0) {
+                    goto fail;
+                }
+                sort_slice_memcpy(&dest, 0, &ssa, 0, k);
+                sort_slice_advance(&dest, k);
+                sort_slice_advance(&ssa, k);
+                na -= k;
+                if (na == 1) {
+                    goto copy_b;
+                }
+                /* Only possible with an inconsistent comparison. */
+                if (na == 0) {
+                    goto succeed;
+                }
+            }
+            sort_slice_copy_incr(&dest, &ssb);
+            --nb;
+            if (nb == 0) {
+                goto succeed;
+            }
+
+            k = sort_gallop_left(ms, ssa.keys[0], ssb.keys, nb, 0);
+            bcount = k;
+            if (k) {
+                if (k < 0) {
+                    goto fail;
+                }
+                sort_slice_memmove(&dest, 0, &ssb, 0, k);
+                sort_slice_advance(&dest, k);
+                sort_slice_advance(&ssb, k);
+                nb -= k;
+                if (nb == 0) {
+                    goto succeed;
+                }
+            }
+            sort_slice_copy_incr(&dest, &ssa);
+            --na;
+            if (na == 1) {
+                goto copy_b;
+            }
+        } while (acount >= SORT_MIN_GALLOP || bcount >= SORT_MIN_GALLOP);
+        /* Penalize leaving the galloping mode. */
+        ++min_gallop;
+        ms->min_gallop = min_gallop;
+    }
+
+succeed:
+    result = 0;
+fail:
+    if (na) {
+        sort_slice_memcpy(&dest, 0, &ssa, 0, na);
+    }
+    return result;
+
+copy_b:
+    /* The last item of a belongs at the end of the merge. */
+    sort_slice_memmove(&dest, 0, &ssb, 0, nb);
+    sort_slice_copy(&dest, nb, &ssa, 0);
+    return 0;
+}
+
+/* Same as sort_merge_lo, but for na >= nb: b is moved to temp and the merge
+   goes from the right end.
+   Returns: 0 if OK, -1 otherwise. */
+static int
+sort_merge_hi(sort_state *ms, sort_slice ssa, Sb_ssize_t na, sort_slice ssb, Sb_ssize_t nb)
+{
+    Sb_ssize_t k;
+    sort_slice dest, basea, baseb;
+    Sb_ssize_t min_gallop;
+    int result = -1;
+
+    if (sort_get_temp(ms, nb) < 0) {
+        return -1;
+    }
+    dest = ssb;
+    sort_slice_advance(&dest, nb - 1);
+    sort_slice_memcpy(&ms->temp, 0, &ssb, 0, nb);
+    basea = ssa;
+    baseb = ms->temp;
+    ssb = ms->temp;
+    sort_slice_advance(&ssb, nb - 1);
+    sort_slice_advance(&ssa, na - 1);
+
+    sort_slice_copy_decr(&dest, &ssa);
+    --na;
+    if (na == 0) {
+        goto succeed;
+    }
+    if (nb == 1) {
+        goto copy_a;
+    }
+
+    min_gallop = ms->min_gallop;
+    for (;;) {
+        Sb_ssize_t acount = 0;
+        Sb_ssize_t bcount = 0;
+
+        /* One pair at a time, until one run appears to win consistently. */
+        for (;;) {
+            k = SORT_ISLT(ms, ssb.keys[0], ssa.keys[0]);
+            if (k) {
+                if (k < 0) {
+                    goto fail;
+                }
+                sort_slice_copy_decr(&dest, &ssa);
+                ++acount;
+                bcount = 0;
+                --na;
+                if (na == 0) {
+                    goto succeed;
+                }
+                if (acount >= min_gallop) {
+                    break;
+                }
+            }
+            else {
+                sort_slice_copy_decr(&dest, &ssb);
+                ++bcount;
+                acount = 0;
+                --nb;
+                if (nb == 1) {
+                    goto copy_a;
+                }
+                if (bcount >= min_gallop) {
+                    break;
+                }
+            }
+        }
+
+        /* Gallop until neither run wins consistently anymore. */
+        ++min_gallop;
+        do {
+            min_gallop -= min_gallop > 1;
+            ms->min_gallop = min_gallop;
+            k = sort_gallop_right(ms, ssb.keys[0], basea.keys, na, na - 1);
+            if (k < 0) {
+                goto fail;
+            }
+            k = na - k;
+            acount = k;
+            if (k) {
+                sort_slice_advance(&dest, -k);
+                sort_slice_advance(&ssa, -k);
+                sort_slice_memmove(&dest, 1, &ssa, 1, k);
+                na -= k;
+                if (na == 0) {
+                    goto succeed;
+                }
+            }
+            sort_slice_copy_decr(&dest, &ssb);
+            --nb;
+            if (nb == 1) {
+                goto copy_a;
+            }
+
+            k = sort_gallop_left(ms, ssa.keys[0], baseb.keys, nb, nb - 1);
+            if (k < 0) {
+                goto fail;
+            }
+            k = nb - k;
+            bcount = k;
+            if (k) {
+                sort_slice_advance(&dest, -k);
+                sort_slice_advance(&ssb, -k);
+                sort_slice_memcpy(&dest, 1, &ssb, 1, k);
+                nb -= k;
+                if (nb == 1) {
+                    goto copy_a;
+                }
+                /* Only possible with an inconsistent comparison. */
+                if (nb == 0) {
+                    goto succeed;
+                }
+            }
+            sort_slice_copy_decr(&dest, &ssa);
+            --na;
+            if (na == 0) {
+                goto succeed;
+            }
+        } while (acount >= SORT_MIN_GALLOP || bcount >= SORT_MIN_GALLOP);
+        /* Penalize leaving the galloping mode. */
+        ++min_gallop;
+        ms->min_gallop = min_gallop;
+    }
+
+succeed:
+    result = 0;
+fail:
+    if (nb) {
+        sort_slice_memcpy(&dest, -(nb - 1), &baseb, 0, nb);
+    }
+    return result;
+
+copy_a:
+    /* The first item of b belongs at the front of the merge. */
+    sort_slice_memmove(&dest, 1 - na, &ssa, 1 - na, na);
+    sort_slice_advance(&dest, -na);
+    sort_slice_advance(&ssa, -na);
+    sort_slice_copy(&dest, 0, &ssb, 0);
+    return 0;
+}
+
+/* Merge the pending runs i and i + 1.
+   Returns: 0 if OK, -1 otherwise. */
+static int
+sort_merge_at(sort_state *ms, Sb_ssize_t i)
+{
+    sort_slice ssa, ssb;
+    Sb_ssize_t na, nb;
+    Sb_ssize_t k;
+
+    ssa = ms->pending[i].base;
+    na = ms->pending[i].len;
+    ssb = ms->pending[i + 1].base;
+    nb = ms->pending[i + 1].len;
+
+    ms->pending[i].len = na + nb;
+    if (i == ms->n - 3) {
+        ms->pending[i + 1] = ms->pending[i + 2];
+    }
+    --ms->n;
+
+    /* Items of a already in place need not take part in the merge. */
+    k = sort_gallop_right(ms, ssb.keys[0], ssa.keys, na, 0);
+    if (k < 0) {
+        return -1;
+    }
+    sort_slice_advance(&ssa, k);
+    na -= k;
+    if (na == 0) {
+        return 0;
+    }
+
+    /* Same for the items at the end of b. */
+    nb = sort_gallop_left(ms, ssa.keys[na - 1], ssb.keys, nb, nb - 1);
+    if (nb <= 0) {
+        return (int)nb;
+    }
+
+    if (na <= nb) {
+        return sort_merge_lo(ms, ssa, na, ssb, nb);
+    }
+    return sort_merge_hi(ms, ssa, na, ssb, nb);
+}
+
+/* Merge runs until the pending stack satisfies, for the top three runs,
+   A > B + C and B > C.
+   Returns: 0 if OK, -1 otherwise. */
+static int
+sort_merge_collapse(sort_state *ms)
+{
+    sort_run *p = ms->pending;
+
+    while (ms->n > 1) {
+        Sb_ssize_t n = ms->n - 2;
+
+        if ((n > 0 && p[n - 1].len <= p[n].len + p[n + 1].len)
+            || (n > 1 && p[n - 2].len <= p[n - 1].len + p[n].len)) {
+            if (p[n - 1].len < p[n + 1].len) {
+                --n;
+            }
+        }
+        else if (p[n].len > p[n + 1].len) {
+            break;
+        }
+        if (sort_merge_at(ms, n) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Merge all pending runs into one.
+   Returns: 0 if OK, -1 otherwise. */
+static int
+sort_merge_force_collapse(sort_state *ms)
+{
+    sort_run *p = ms->pending;
+
+    while (ms->n > 1) {
+        Sb_ssize_t n = ms->n - 2;
+
+        if (n > 0 && p[n - 1].len < p[n + 1].len) {
+            --n;
+        }
+        if (sort_merge_at(ms, n) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Pick a minimum run length in [32, 64], such that n / minrun is a power
+   of two or slightly less than one, keeping the final merges balanced. */
+static Sb_ssize_t
+sort_compute_minrun(Sb_ssize_t n)
+{
+    Sb_ssize_t r = 0;
+
+    while (n >= 64) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+/* Pick the cheapest comparison that is valid for all the keys. */
+static sort_lt_func
+sort_select_lt(SbObject **keys, Sb_ssize_t n)
+{
+    Sb_ssize_t pos;
+
+    if (SbInt_CheckExact(keys[0])) {
+        for (pos = 1; pos < n; ++pos) {
+            if (!SbInt_CheckExact(keys[pos])) {
+                return sort_lt_generic;
+            }
+        }
+        return sort_lt_int;
+    }
+    if (SbStr_CheckExact(keys[0])) {
+        for (pos = 1; pos < n; ++pos) {
+            if (!SbStr_CheckExact(keys[pos])) {
+                return sort_lt_generic;
+            }
+        }
+        return sort_lt_str;
+    }
+    return sort_lt_generic;
+}
+
+/* Sort the keys (and values, if any) of `lo`, which hold n items.
+   On errors the items are left in some permutation of the input.
+   Returns: 0 if OK, -1 otherwise. */
+static int
+sort_slice_sort(sort_slice lo, Sb_ssize_t n)
+{
+    sort_state ms;
+    Sb_ssize_t minrun;
+    int result = -1;
+
+    sort_init_state(&ms, sort_select_lt(lo.keys, n), lo.values != NULL);
+    minrun = sort_compute_minrun(n);
+    do {
+        Sb_ssize_t run;
+        int descending;
+
+        run = sort_count_run(&ms, lo.keys, lo.keys + n, &descending);
+        if (run < 0) {
+            goto fail;
+        }
+        if (descending) {
+            sort_reverse_slice(&lo, run);
+        }
+        if (run < minrun) {
+            const Sb_ssize_t force = n <= minrun ? n : minrun;
+
+            if (sort_binary_insertion(&ms, lo, force, run) < 0) {
+                goto fail;
+            }
+            run = force;
+        }
+        ms.pending[ms.n].base = lo;
+        ms.pending[ms.n].len = run;
+        ++ms.n;
+        if (sort_merge_collapse(&ms) < 0) {
+            goto fail;
+        }
+        sort_slice_advance(&lo, run);
+        n -= run;
+    } while (n);
+    if (sort_merge_force_collapse(&ms) < 0) {
+        goto fail;
+    }
+    result = 0;
+
+fail:
+    sort_free_temp(&ms);
+    return result;
+}
+
+int
+SbList_Sort(SbObject *p, SbObject *key, int reverse)
+{
+    SbListObject *op = (SbListObject *)p;
+    SbObject **saved_items;
+    Sb_ssize_t saved_count;
+    Sb_ssize_t saved_allocated;
+    SbObject **final_items;
+    Sb_ssize_t final_count;
+    SbObject *keys_on_stack[SORT_TEMP_ON_STACK / 2];
+    sort_slice lo;
+    Sb_ssize_t pos;
+    int result = -1;
+
+#if SUPPORTS(BUILTIN_TYPECHECKS)
+    if (!SbList_CheckExact(p)) {
+        SbErr_RaiseWithString(SbExc_SystemError, "non-list object passed to a list method");
+        return -1;
+    }
+#endif
+
+    /* Let the list appear empty while sorting, so that key functions and
+       comparisons which modify it can be detected and can't cause damage. */
+    saved_items = op->items;
+    saved_count = op->count;
+    saved_allocated = op->allocated;
+    op->items = NULL;
+    op->count = 0;
+    op->allocated = 0;
+
+    lo.keys = saved_items;
+    lo.values = NULL;
+    if (key) {
+        if (saved_count <= SORT_TEMP_ON_STACK / 2) {
+            lo.keys = keys_on_stack;
+        }
+        else {
+            lo.keys = (SbObject **)SbObject_Malloc(saved_count * sizeof(SbObject *));
+            if (!lo.keys) {
+                SbErr_NoMemory();
+                goto restore;
+            }
+        }
+        for (pos = 0; pos < saved_count; ++pos) {
+            lo.keys[pos] = SbObject_CallObjArgs(key, 1, saved_items[pos]);
+            if (!lo.keys[pos]) {
+                while (--pos >= 0) {
+                    Sb_DECREF(lo.keys[pos]);
+                }
+                goto free_keys;
+            }
+        }
+        lo.values = saved_items;
+    }
+
+    /* Reversing before and after keeps equal items in their original order. */
+    if (reverse) {
+        sort_reverse_slice(&lo, saved_count);
+    }
+    if (saved_count > 1 && sort_slice_sort(lo, saved_count) < 0) {
+        goto unreverse;
+    }
+    result = 0;
+    if (op->items || op->count) {
+        SbErr_RaiseWithString(SbExc_ValueError, "list modified during sort");
+        result = -1;
+    }
+
+unreverse:
+    if (reverse) {
+        sort_reverse_items(saved_items, saved_count);
+    }
+    if (key) {
+        for (pos = 0; pos < saved_count; ++pos) {
+            Sb_DECREF(lo.keys[pos]);
+        }
+    }
+free_keys:
+    if (key && lo.keys != keys_on_stack) {
+        SbObject_Free(lo.keys);
+    }
+restore:
+    /* Drop whatever got into the list meanwhile. */
+    final_items = op->items;
+    final_count = op->count;
+    op->items = saved_items;
+    op->count = saved_count;
+    op->allocated = saved_allocated;
+    if (final_items) {
+        for (pos = 0; pos < final_count; ++pos) {
+            Sb_XDECREF(final_items[pos]);
+        }
+        SbObject_Free(final_items);
+    }
+    return result;
+}
+
+static SbObject *
+list_len(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    return SbInt_FromNative(SbList_GetSizeUnsafe(self));
+}
+
+static SbObject *
+list_getitem(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:index");
+    SbObject *index;
+    SbObject *result;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &index) < 0) {
+        return NULL;
+    }
+    if (SbSlice_Check(index)) {
+        SbInt_Native_t start, end, step, slice_length;
+        SbInt_Native_t my_pos, result_pos;
+
+        if (SbSlice_GetIndices(index, SbList_GetSizeUnsafe(self), &start, &end, &step, &slice_length) < 0) {
+            return NULL;
+        }
+
+        result = SbList_New(slice_length);
+        if (!result) {
+            return NULL;
+        }
+
+        my_pos = start;
+        for (result_pos = 0; result_pos < slice_length; ++result_pos) {
+            SbObject *o = SbList_GetItemUnsafe(self, my_pos);
+
+            Sb_INCREF(o);
+            SbList_SetItemUnsafe(result, result_pos, o);
+            my_pos += step;
+        }
+
+        return result;
+    }
+    if (SbInt_Check(index)) {
+        SbInt_Native_t pos;
+
+        pos = SbInt_AsNative(index);
+        if (pos == -1 && SbErr_Occurred()) {
+            return NULL;
+        }
+        result = SbList_GetItem(self, pos);
+        if (result) {
+            Sb_INCREF(result);
+        }
+        return result;
+    }
+    return _SbErr_IncorrectSubscriptType(index);
+}
+
+static SbObject *
+list_setitem(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:index,O:value");
+    SbObject *index;
+    SbObject *value;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &index, &value) < 0) {
+        return NULL;
+    }
+    if (SbSlice_Check(index)) {
+        SbInt_Native_t start, end, step, slice_length;
+        SbInt_Native_t my_pos;
+        SbObject **items;
+        SbObject **recycle;
+        SbObject *holder;
+        Sb_ssize_t count;
+        Sb_ssize_t pos;
+
+        /* Collecting the items may run Python code that resizes the list,
+           so the slice is resolved against the size it has afterwards. */
+        if (list_seq_items((SbListObject *)self, value, &items, &count, &holder) < 0) {
+            return NULL;
+        }
+        if (SbSlice_GetIndices(index, SbList_GetSizeUnsafe(self), &start, &end, &step, &slice_length) < 0) {
+            goto setslice_fail;
+        }
+
+        if (step == 1) {
+            if (list_ass_slice((SbListObject *)self, start, end < start ? start : end, items, count) < 0) {
+                goto setslice_fail;
+            }
+            Sb_DECREF(holder);
+            Sb_RETURN_NONE;
+        }
+
+        if (count != slice_length) {
+            SbErr_RaiseWithFormat(SbExc_ValueError, "attempt to assign sequence of size %d to extended slice of size %d",
+                (int)count, (int)slice_length);
+            goto setslice_fail;
+        }
+        if (slice_length == 0) {
+            Sb_DECREF(holder);
+            Sb_RETURN_NONE;
+        }
+        recycle = (SbObject **)SbObject_Malloc(slice_length * sizeof(SbObject *));
+        if (!recycle) {
+            SbErr_NoMemory();
+            goto setslice_fail;
+        }
+        my_pos = start;
+        for (pos = 0; pos < slice_length; ++pos) {
+            recycle[pos] = SbList_GetItemUnsafe(self, my_pos);
+            Sb_INCREF(items[pos]);
+            SbList_SetItemUnsafe(self, my_pos, items[pos]);
+            my_pos += step;
+        }
+        for (pos = 0; pos < slice_length; ++pos) {
+            Sb_XDECREF(recycle[pos]);
+        }
+        SbObject_Free(recycle);
+        Sb_DECREF(holder);
+        Sb_RETURN_NONE;
+
+setslice_fail:
+        Sb_DECREF(holder);
+        return NULL;
+    }
+    if (SbInt_Check(index)) {
+        SbInt_Native_t pos;
+        int result;
+
+        pos = SbInt_AsNative(index);
+        if (pos == -1 && SbErr_Occurred()) {
+            return NULL;
+        }
+        Sb_INCREF(value);
+        result = SbList_SetItem(self, pos, value);
+        if (result < 0) {
+            return NULL;
+        }
+        Sb_RETURN_NONE;
+    }
+    return _SbErr_IncorrectSubscriptType(index);
+}
+
+static SbObject *
+list_delitem(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:index");
+    SbObject *index;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &index) < 0) {
+        return NULL;
+    }
+    if (SbSlice_Check(index)) {
+        SbInt_Native_t start, end, step, slice_length;
+        int result;
+
+        if (SbSlice_GetIndices(index, SbList_GetSizeUnsafe(self), &start, &end, &step, &slice_length) < 0) {
+            return NULL;
+        }
+        if (slice_length == 0) {
+            Sb_RETURN_NONE;
+        }
+        if (step < 0) {
+            /* Walk the same items upwards. */
+            start += step * (slice_length - 1);
+            step = -step;
+        }
+        if (step == 1 || slice_length == 1) {
+            result = list_ass_slice((SbListObject *)self, start, start + slice_length, NULL, 0);
+        }
+        else {
+            result = list_del_extended((SbListObject *)self, start, step, slice_length);
+        }
+        if (result < 0) {
+            return NULL;
+        }
+        Sb_RETURN_NONE;
+    }
+    if (SbInt_Check(index)) {
+        SbInt_Native_t my_pos;
+
+        my_pos = SbInt_AsNative(index);
+        if (my_pos == -1 && SbErr_Occurred()) {
+            return NULL;
+        }
+        if (list_check_type_pos(self, my_pos) < 0) {
+            return NULL;
+        }
+        if (list_ass_slice((SbListObject *)self, my_pos, my_pos + 1, NULL, 0) < 0) {
+            return NULL;
+        }
+        Sb_RETURN_NONE;
+    }
+    return _SbErr_IncorrectSubscriptType(index);
+}
+
+static SbObject *
+list_iter(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    return SbListIter_New(self);
+}
+
+
+static SbObject *
+list_append(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:o");
+    SbObject *o;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o) < 0) {
+        return NULL;
     }
 
     if (SbList_Append(self, o) < 0) {
@@ -392,6 +1722,116 @@ list_append(SbObject *self, SbObject *args, SbObject *kwargs)
     Sb_RETURN_NONE;
 }
 
+static SbObject *
+list_insert(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("i:index,O:o");
+    SbInt_Native_t pos;
+    SbObject *o;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &pos, &o) < 0) {
+        return NULL;
+    }
+
+    if (SbList_Insert(self, pos, o) < 0) {
+        return NULL;
+    }
+    Sb_RETURN_NONE;
+}
+
+static SbObject *
+list_extend(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:iterable");
+    SbObject *iterable;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &iterable) < 0) {
+        return NULL;
+    }
+
+    if (SbList_Extend(self, iterable) < 0) {
+        return NULL;
+    }
+    Sb_RETURN_NONE;
+}
+
+static SbObject *
+list_pop(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("|i:index");
+    SbListObject *myself = (SbListObject *)self;
+    SbInt_Native_t pos = -1;
+    SbObject *result;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &pos) < 0) {
+        return NULL;
+    }
+
+    if (myself->count == 0) {
+        SbErr_RaiseWithString(SbExc_IndexError, "pop from empty list");
+        return NULL;
+    }
+    if (pos < 0) {
+        pos += myself->count;
+    }
+    if ((Sb_size_t)pos >= (Sb_size_t)myself->count) {
+        SbErr_RaiseWithString(SbExc_IndexError, "pop index out of range");
+        return NULL;
+    }
+
+    /* The reference moves from the list to the caller. */
+    result = myself->items[pos];
+    SbRT_MemMove(myself->items + pos, myself->items + pos + 1, (myself->count - pos - 1) * sizeof(SbObject *));
+    list_resize(myself, myself->count - 1);
+    return result;
+}
+
+static SbObject *
+list_reverse(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    SbListObject *myself = (SbListObject *)self;
+    SbObject **lo, **hi;
+
+    if (myself->count > 1) {
+        lo = myself->items;
+        hi = myself->items + myself->count - 1;
+        while (lo < hi) {
+            SbObject *tmp = *lo;
+
+            *lo++ = *hi;
+            *hi-- = tmp;
+        }
+    }
+    Sb_RETURN_NONE;
+}
+
+static SbObject *
+list_sort(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("|O:key,O:reverse");
+    SbObject *key = NULL;
+    SbObject *reverse = NULL;
+    int reverse_flag = 0;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &key, &reverse) < 0) {
+        return NULL;
+    }
+    if (key == Sb_None) {
+        key = NULL;
+    }
+    if (reverse) {
+        reverse_flag = SbObject_IsTrue(reverse);
+        if (reverse_flag < 0) {
+            return NULL;
+        }
+    }
+
+    if (SbList_Sort(self, key, reverse_flag) < 0) {
+        return NULL;
+    }
+    Sb_RETURN_NONE;
+}
+
 /* Type initializer */
 
 static const SbCMethodDef list_methods[] = {
@@ -402,6 +1842,11 @@ static const SbCMethodDef list_methods[] = {
     { "__iter__", list_iter },
 
     { "append", list_append },
+    { "extend", list_extend },
+    { "insert", list_insert },
+    { "pop", list_pop },
+    { "reverse", list_reverse },
+    { "sort", list_sort },
     /* Sentinel */
     { NULL, NULL },
 };
@@ -417,6 +1862,7 @@ _Sb_TypeInit_List()
     }
 
     tp->tp_destroy = (SbDestroyFunc)list_destroy;
+    _SbType_EnableGC(tp, (SbTraverseFunc)list_traverse, (SbClearFunc)list_clear);
 
     SbList_Type = tp;
     return 0;
@@ -39,6 +39,39 @@ method_destroy(SbMethodObject *self)
     SbObject_DefaultDestroy((SbObject *)self);
 }
 
+static int
+method_traverse(SbMethodObject *self, SbVisitFunc visit, void *arg)
+{
+    Sb_VISIT(self->type);
+    Sb_VISIT(self->func);
+    Sb_VISIT(self->self);
+    return 0;
+}
+
+static int
+method_clear(SbMethodObject *self)
+{
+    Sb_CLEAR(self->func);
+    Sb_CLEAR(self->self);
+    return 0;
+}
+
+#if SUPPORTS(OBJECT_FREELISTS)
+static SbFreeList method_freelist = SbFreeList_INIT(64);
+
+static SbObject *
+method_alloc(SbTypeObject *type, Sb_ssize_t nitems)
+{
+    return _SbFreeList_Alloc(&method_freelist, type, type->tp_basicsize);
+}
+
+static void
+method_free(void *p)
+{
+    _SbFreeList_Free(&method_freelist, p);
+}
+#endif
+
 SbObject *
 SbMethod_Call(SbObject *p, SbObject *args, SbObject *kwargs)
 {
@@ -108,10 +141,11 @@ SbMethod_Call(SbObject *p, SbObject *args, SbObject *kwargs)
 static SbObject *
 method_getattr(SbMethodObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("s:name");
     const char *attr_name;
     SbObject *value;
 
-    if (SbArgs_Parse("s:name", args, kwargs, &attr_name) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &attr_name) < 0) {
         return NULL;
     }
     if (!SbRT_StrCmp(attr_name, "__name__")) {
@@ -153,6 +187,11 @@ _SbMethod_BuiltinInit()
     }
 
     tp->tp_destroy = (SbDestroyFunc)method_destroy;
+    _SbType_EnableGC(tp, (SbTraverseFunc)method_traverse, (SbClearFunc)method_clear);
+#if SUPPORTS(OBJECT_FREELISTS)
+    tp->tp_alloc = method_alloc;
+    tp->tp_free = method_free;
+#endif
 
     SbMethod_Type = tp;
     return 0;
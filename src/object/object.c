@@ -10,6 +10,8 @@
 /* Keep the type object here. */
 SbTypeObject *SbObject_Type = NULL;
 
+static SbDictKey key_del = SbDictKey_INIT("__del__");
+
 #if SUPPORTS(ALLOC_STATISTICS)
 unsigned long SbObject_AliveCount = 0;
 #endif
@@ -18,9 +20,6 @@ void _SbObject_DecRef(SbObject *op)
 {
     Sb_ssize_t new_refcount;
     SbTypeObject *tp;
-    SbTypeObject *exc_type;
-    SbObject *exc_value;
-    SbObject *exc_tb;
 
     new_refcount = op->ob_refcount - 1;
     if (new_refcount > 0) {
@@ -28,28 +27,40 @@ void _SbObject_DecRef(SbObject *op)
         return;
     }
     if (new_refcount < 0) {
-        __asm int 3;
+        Sb_DebugBreak();
     }
 
-    /* NOTE: To avoid mayhem, we store the current exception before actually destroying the object. */
-    SbErr_Fetch(&exc_type, &exc_value, &exc_tb);
     tp = Sb_TYPE(op);
-    /* NOTE: Here, we might check for __del__ when initialising.
-       Work around by checking the type's dict directly. */
-    if (SbDict_GetItemString(SbObject_DICT(tp), "__del__")) {
-        if (!SbObject_CallMethod(op, "__del__", NULL, NULL)) {
+    if (tp->tp_flags & SbType_FLAGS_HAS_FINALIZER) {
+        SbTypeObject *exc_type;
+        SbObject *exc_value;
+        SbObject *exc_tb;
+        SbObject *result;
+
+        /* NOTE: To avoid mayhem, we store the current exception before running Python code. */
+        SbErr_Fetch(&exc_type, &exc_value, &exc_tb);
+        result = _SbObject_CallMethodKey(op, &key_del, NULL, NULL);
+        if (!result) {
             SbErr_Clear();
             /* TODO: print warning maybe? */
         }
-        if (op->ob_refcount > 0) {
-            SbErr_Restore(exc_type, exc_value, exc_tb);
+        Sb_XDECREF(result);
+        SbErr_Restore(exc_type, exc_value, exc_tb);
+        /* The object kept its last reference during the call;
+           if anything else still holds it, it has been resurrected. */
+        if (--op->ob_refcount > 0) {
             return;
         }
     }
     op->ob_refcount = 0;
+#if SUPPORTS(CYCLE_GC)
+    /* The collector must not see the object half torn down. */
+    if (tp->tp_flags & SbType_FLAGS_HAVE_GC) {
+        _SbGC_Untrack(op);
+    }
+#endif
     tp->tp_destroy(op);
     op = NULL;
-    SbErr_Restore(exc_type, exc_value, exc_tb);
     Sb_DECREF(tp);
 
 #if SUPPORTS(ALLOC_STATISTICS)
@@ -64,7 +75,7 @@ SbObject_New(SbTypeObject *type)
     p = (SbObject *)type->tp_alloc(type, 0);
     SbObject_INIT(p, type);
     if (type->tp_flags & SbType_FLAGS_HAS_DICT) {
-        SbObject_DICT(p) = SbDict_New();
+        SbObject_DICT(p) = type->tp_dict_keys ? _SbDict_NewSplit(type->tp_dict_keys) : SbDict_New();
     }
 #if __TRACE_ALLOCS
     printf("Object at %p (type %s) allocated.\n", p, type->tp_name);
@@ -82,7 +93,7 @@ SbObject_NewVar(SbTypeObject *type, Sb_ssize_t count)
     p = (SbVarObject *)type->tp_alloc(type, count);
     SbObject_INIT_VAR(p, type, count);
     if (type->tp_flags & SbType_FLAGS_HAS_DICT) {
-        SbObject_DICT(p) = SbDict_New();
+        SbObject_DICT(p) = type->tp_dict_keys ? _SbDict_NewSplit(type->tp_dict_keys) : SbDict_New();
     }
 #if __TRACE_ALLOCS
     printf("Object at %p (type %s) allocated.\n", p, type->tp_name);
@@ -117,11 +128,12 @@ SbObject_DefaultHash(SbObject *self, SbObject *args, SbObject *kwargs)
 SbObject *
 SbObject_DefaultGetAttr(SbObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("S:name");
     SbObject *o_name;
     SbObject *result;
     const char *attr_name;
 
-    if (SbArgs_Parse("S:name", args, kwargs, &o_name) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_name) < 0) {
         return NULL;
     }
 
@@ -140,7 +152,7 @@ SbObject_DefaultGetAttr(SbObject *self, SbObject *args, SbObject *kwargs)
 
     /* If the object has a dict, check it. */
     if (Sb_TYPE(self)->tp_flags & SbType_FLAGS_HAS_DICT) {
-        result = SbDict_GetItemString(SbObject_DICT(self), attr_name);
+        result = _SbDict_GetItemStr(SbObject_DICT(self), o_name);
         if (result) {
             goto return_result;
         }
@@ -157,18 +169,22 @@ return_result:
 SbObject *
 SbObject_DefaultSetAttr(SbObject *self, SbObject *args, SbObject *kwargs)
 {
-    const char *attr_name;
+    static SbArgsSpec args_spec = SbArgs_SPEC("S:name,O:value");
+    SbObject *o_name;
     SbObject *value;
 
-    if (SbArgs_Parse("s:name,O:value", args, kwargs, &attr_name, &value) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_name, &value) < 0) {
         return NULL;
     }
 
     /* If the object has a dict, modify it. */
     if (Sb_TYPE(self)->tp_flags & SbType_FLAGS_HAS_DICT) {
-        if (SbDict_SetItemString(SbObject_DICT(self), attr_name, value) < 0) {
+        if (_SbDict_SetItemStr(SbObject_DICT(self), o_name, value) < 0) {
             return NULL;
         }
+        if (SbType_Check(self)) {
+            _SbType_UpdateFlags((SbTypeObject *)self);
+        }
         Sb_RETURN_NONE;
     }
     return NULL;
@@ -177,17 +193,21 @@ SbObject_DefaultSetAttr(SbObject *self, SbObject *args, SbObject *kwargs)
 SbObject *
 SbObject_DefaultDelAttr(SbObject *self, SbObject *args, SbObject *kwargs)
 {
-    const char *attr_name;
+    static SbArgsSpec args_spec = SbArgs_SPEC("S:name");
+    SbObject *o_name;
 
-    if (SbArgs_Parse("s:name", args, kwargs, &attr_name) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_name) < 0) {
         return NULL;
     }
 
     /* If the object has a dict, modify it. */
     if (Sb_TYPE(self)->tp_flags & SbType_FLAGS_HAS_DICT) {
-        if (SbDict_DelItemString(SbObject_DICT(self), attr_name) < 0) {
+        if (_SbDict_DelItemStr(SbObject_DICT(self), o_name) < 0) {
             return NULL;
         }
+        if (SbType_Check(self)) {
+            _SbType_UpdateFlags((SbTypeObject *)self);
+        }
         Sb_RETURN_NONE;
     }
     return NULL;
@@ -205,11 +225,12 @@ SbObject_DefaultStr(SbObject *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 object_format(SbObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:spec");
     SbObject *str;
     SbObject *formatted;
     SbObject *spec;
 
-    if (SbArgs_Parse("O:spec", args, kwargs, &spec) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &spec) < 0) {
         return NULL;
     }
 
@@ -243,6 +264,20 @@ static const SbCMethodDef object_methods[] = {
     { NULL, NULL },
 };
 
+static int
+object_traverse(SbObject *self, SbVisitFunc visit, void *arg)
+{
+    Sb_VISIT(SbObject_DICT(self));
+    return 0;
+}
+
+static int
+object_clear(SbObject *self)
+{
+    Sb_CLEAR(SbObject_DICT(self));
+    return 0;
+}
+
 int
 _SbObject_TypeInit()
 {
@@ -254,6 +289,7 @@ _SbObject_TypeInit()
     }
     tp->tp_flags = SbType_FLAGS_HAS_DICT;
     tp->tp_dictoffset = Sb_OffsetOf(SbObject, dict);
+    _SbType_EnableGC(tp, object_traverse, object_clear);
     SbObject_Type = tp;
     return 0;
 }
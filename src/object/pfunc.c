@@ -41,6 +41,23 @@ pfunction_destroy(SbPFunctionObject *self)
     SbObject_DefaultDestroy((SbObject *)self);
 }
 
+static int
+pfunction_traverse(SbPFunctionObject *self, SbVisitFunc visit, void *arg)
+{
+    Sb_VISIT(self->code);
+    Sb_VISIT(self->globals);
+    Sb_VISIT(self->defaults);
+    return 0;
+}
+
+static int
+pfunction_clear(SbPFunctionObject *self)
+{
+    Sb_CLEAR(self->defaults);
+    Sb_CLEAR(self->globals);
+    return 0;
+}
+
 SbObject *
 SbPFunction_Call(SbObject *p, SbObject *args, SbObject *kwargs)
 {
@@ -57,7 +74,9 @@ SbPFunction_Call(SbObject *p, SbObject *args, SbObject *kwargs)
 #endif
 
     if (op->code->flags & SbCode_NEWLOCALS) {
-        locals = SbDict_New();
+        /* Functions bind their varnames; class bodies bind some of their names. */
+        locals = SbDict_NewPresized(SbTuple_GetSizeUnsafe(
+            (op->code->flags & SbCode_OPTIMIZED) ? op->code->varnames : op->code->names));
     }
 
     frame = SbFrame_New(op->code, op->globals, locals);
@@ -101,6 +120,7 @@ _SbPFunction_TypeInit()
     }
 
     tp->tp_destroy = (SbDestroyFunc)pfunction_destroy;
+    _SbType_EnableGC(tp, (SbTraverseFunc)pfunction_traverse, (SbClearFunc)pfunction_clear);
 
     SbPFunction_Type = tp;
     return 0;
@@ -39,11 +39,112 @@ slice_destroy(SbSliceObject *myself)
     SbObject_DefaultDestroy((SbObject *)myself);
 }
 
+/* Convert a slice bound to a native value; huge values saturate, which
+   clamps the same way as any out of range index does.
+   Returns: 1 if a value was stored, 0 if `o` is None, -1 on error. */
+static int
+slice_get_bound(SbObject *o, SbInt_Native_t *value)
+{
+    int overflow;
+
+    if (!o || o == Sb_None) {
+        return 0;
+    }
+    if (!SbInt_Check(o)) {
+        SbErr_RaiseWithString(SbExc_TypeError, "slice indices must be integers or None");
+        return -1;
+    }
+    *value = SbInt_AsNativeOverflow(o, &overflow);
+    if (overflow) {
+        SbObject *zero;
+        int negative;
+
+        zero = SbInt_FromNative(0);
+        if (!zero) {
+            return -1;
+        }
+        negative = SbObject_CompareBool(o, zero, Sb_LT);
+        Sb_DECREF(zero);
+        if (negative < 0) {
+            return -1;
+        }
+        *value = negative ? SbInt_NATIVE_MIN : SbInt_NATIVE_MAX;
+    }
+    return 1;
+}
+
 int
 SbSlice_GetIndices(SbObject *self, SbInt_Native_t seq_length, 
     SbInt_Native_t *start, SbInt_Native_t *end, SbInt_Native_t *step, SbInt_Native_t *slice_length)
 {
-    return -1;
+    SbSliceObject *myself = (SbSliceObject *)self;
+    SbInt_Native_t my_start, my_end, my_step;
+    int rv;
+
+    rv = slice_get_bound(myself->step, &my_step);
+    if (rv < 0) {
+        return -1;
+    }
+    if (rv == 0) {
+        my_step = 1;
+    }
+    else if (my_step == 0) {
+        SbErr_RaiseWithString(SbExc_ValueError, "slice step cannot be zero");
+        return -1;
+    }
+    else if (my_step < -SbInt_NATIVE_MAX) {
+        /* Keep -step representable. */
+        my_step = -SbInt_NATIVE_MAX;
+    }
+
+    rv = slice_get_bound(myself->start, &my_start);
+    if (rv < 0) {
+        return -1;
+    }
+    if (rv == 0) {
+        my_start = my_step < 0 ? seq_length - 1 : 0;
+    }
+    else {
+        if (my_start < 0) {
+            my_start += seq_length;
+            if (my_start < 0) {
+                my_start = my_step < 0 ? -1 : 0;
+            }
+        }
+        else if (my_start >= seq_length) {
+            my_start = my_step < 0 ? seq_length - 1 : seq_length;
+        }
+    }
+
+    rv = slice_get_bound(myself->end, &my_end);
+    if (rv < 0) {
+        return -1;
+    }
+    if (rv == 0) {
+        my_end = my_step < 0 ? -1 : seq_length;
+    }
+    else {
+        if (my_end < 0) {
+            my_end += seq_length;
+            if (my_end < 0) {
+                my_end = my_step < 0 ? -1 : 0;
+            }
+        }
+        else if (my_end >= seq_length) {
+            my_end = my_step < 0 ? seq_length - 1 : seq_length;
+        }
+    }
+
+    *start = my_start;
+    *end = my_end;
+    *step = my_step;
+    if (my_step < 0) {
+        *slice_length = my_end < my_start ? (my_start - my_end - 1) / -my_step + 1 : 0;
+    }
+    else {
+        *slice_length = my_start < my_end ? (my_end - my_start - 1) / my_step + 1 : 0;
+    }
+    return 0;
 }
 
 
@@ -33,134 +33,106 @@ SbStr_FromStringAndSize(const void *v, Sb_ssize_t len)
     return (SbObject *)op;
 }
 
-Sb_ssize_t
-str_format_internal_va(char *buffer, const char *format, va_list va)
+static int
+str_format_internal_va(SbStrBuilder *sb, const char *format, va_list va)
 {
     const char *p;
-    int got_format;
-    char *cursor;
-    char temp_buf[32];
+    const char *s;
+    char temp_buf[2];
 
-    got_format = 0;
-    cursor = buffer;
     for (p = format; *p; ++p) {
-        if (got_format) {
-            const char *s;
-
-            got_format = 0;
-            switch (*p) {
-            case '%':
-                s = "%";
-                break;
-
-            case 'c':
-                temp_buf[0] = (char)va_arg(va, int);
-                temp_buf[1] = '\0';
-                s = temp_buf;
-                break;
-
-            case 's':
-                s = va_arg(va, const char *);
-                break;
-
-            case 'd':
-            case 'i':
-                s = Sb_LtoA(va_arg(va, int), 10);
-                break;
-
-            case 'u':
-                s = Sb_ULtoA(va_arg(va, unsigned int), 10);
-                break;
-
-            case 'p':
-                {
-                    Sb_size_t len;
-
-                    /* This is the only one that needs alignment... */
-                    s = Sb_ULtoA((unsigned long)va_arg(va, void *), 16);
-                    if (buffer) {
-                        cursor[0] = '0';
-                        cursor[1] = 'x';
-                    }
-                    cursor += 2;
-                    len = SbRT_StrLen(s);
-                    if (buffer) {
-                        while (len < 8) {
-                            *cursor++ = '0';
-                            ++len;
-                        }
-                    }
-                    else {
-                        if (len < 8) {
-                            cursor += 8 - len;
-                        }
-                    }
-                }
-                break;
+        if (*p != '%') {
+            const char *literal;
 
-            case 'x':
-                s = Sb_ULtoA(va_arg(va, unsigned int), 16);
-                break;
-
-            case 'l':
-            case 'z':
-            default:
-                /* Invalid format specifier */
-                /* NOTE: This differs from CPython. */
-                continue;
+            /* Copy the literal run in one go. */
+            literal = p;
+            while (p[1] && p[1] != '%') {
+                ++p;
             }
+            if (SbStrBuilder_Append(sb, literal, p - literal + 1) < 0) {
+                return -1;
+            }
+            continue;
+        }
 
-            if (buffer) {
-                while (*cursor = *s++) {
-                    ++cursor;
+        ++p;
+        switch (*p) {
+        case '%':
+            s = "%";
+            break;
+
+        case 'c':
+            temp_buf[0] = (char)va_arg(va, int);
+            temp_buf[1] = '\0';
+            s = temp_buf;
+            break;
+
+        case 's':
+            s = va_arg(va, const char *);
+            break;
+
+        case 'd':
+        case 'i':
+            s = Sb_LtoA(va_arg(va, int), 10);
+            break;
+
+        case 'u':
+            s = Sb_ULtoA(va_arg(va, unsigned int), 10);
+            break;
+
+        case 'p':
+            {
+                Sb_ssize_t len;
+
+                /* This is the only one that needs alignment... */
+                s = Sb_ULtoA((unsigned long)va_arg(va, void *), 16);
+                len = SbRT_StrLen(s);
+                if (SbStrBuilder_Append(sb, "0x", 2) < 0) {
+                    return -1;
                 }
-            }
-            else {
-                while (*s++) {
-                    ++cursor;
+                if (len < 8 && SbStrBuilder_AppendFill(sb, '0', 8 - len) < 0) {
+                    return -1;
                 }
             }
-            continue;
-        }
+            break;
+
+        case 'x':
+            s = Sb_ULtoA(va_arg(va, unsigned int), 16);
+            break;
 
-        if (*p == '%') {
-            got_format = 1;
+        case '\0':
+            /* A lone '%' at the very end. */
+            return 0;
+
+        case 'l':
+        case 'z':
+        default:
+            /* Invalid format specifier */
+            /* NOTE: This differs from CPython. */
             continue;
         }
 
-        if (buffer) {
-            *cursor = *p;
+        if (SbStrBuilder_Append(sb, s, SbRT_StrLen(s)) < 0) {
+            return -1;
         }
-        cursor++;
-    }
-    if (buffer) {
-        *cursor = '\0';
     }
-    cursor++;
 
-    return cursor - buffer;
+    return 0;
 }
+
 SbObject *
 SbStr_FromFormatVa(const char *format, va_list va)
 {
-    Sb_ssize_t max_length;
-    SbObject *result;
-    char *buffer;
-
-    /* Determine maximum required size */
-    max_length = str_format_internal_va(NULL, format, va);
+    SbStrBuilder sb;
 
-    /* Allocate */
-    result = SbStr_FromStringAndSize(NULL, max_length);
-    if (!result) {
-        return result;
+    if (SbStrBuilder_Init(&sb, SbRT_StrLen(format) + 16) < 0) {
+        return NULL;
     }
-    buffer = SbStr_AsStringUnsafe(result);
-
-    /* Write out */
-    str_format_internal_va(buffer, format, va);
-
-    return result;
+    if (str_format_internal_va(&sb, format, va) < 0) {
+        SbStrBuilder_Clear(&sb);
+        return NULL;
+    }
+    return SbStrBuilder_Finish(&sb);
 }
 
 SbObject *
@@ -219,70 +191,92 @@ SbStr_StartsWithString(SbObject *p1, const char *p2)
 SbObject *
 SbStr_Join(SbObject *glue, SbObject *iterable)
 {
-    SbObject *it;
-    SbObject *o;
+    SbObject *seq;
+    SbObject **items;
     SbObject *result;
+    Sb_ssize_t count;
+    Sb_ssize_t glue_size;
     Sb_ssize_t length;
+    Sb_ssize_t pos;
     char *cursor;
-    const char *source;
 
-    it = SbObject_GetIter(iterable);
-    if (!it) {
-        return NULL;
+    /* Lists and tuples are joined straight off their item arrays;
+       anything else is collected into a list first. */
+    if (SbTuple_CheckExact(iterable)) {
+        seq = iterable;
+        Sb_INCREF(seq);
+        items = ((SbTupleObject *)seq)->items;
+        count = SbTuple_GetSizeUnsafe(seq);
     }
-
-    length = -SbStr_GetSizeUnsafe(glue);
-    for (o = SbIter_Next(it); o; o = SbIter_Next(it)) {
-        if (!SbStr_CheckExact(o)) {
-            Sb_DECREF(o);
-            Sb_DECREF(it);
-            SbErr_RaiseWithFormat(SbExc_TypeError, "invalid type: expected str, found %s", Sb_TYPE(o)->tp_name);
-            return NULL;
+    else {
+        if (SbList_CheckExact(iterable)) {
+            seq = iterable;
+            Sb_INCREF(seq);
         }
-        length += SbStr_GetSizeUnsafe(o) + SbStr_GetSizeUnsafe(glue);
-        Sb_DECREF(o);
+        else {
+            seq = SbList_New(0);
+            if (!seq) {
+                return NULL;
+            }
+            if (SbList_Extend(seq, iterable) < 0) {
+                goto fail;
+            }
+        }
+        items = ((SbListObject *)seq)->items;
+        count = SbList_GetSizeUnsafe(seq);
     }
-    Sb_DECREF(it);
 
-    if (length <= 0) {
-        return SbStr_FromString("");
+    if (count == 1 && SbStr_CheckExact(items[0])) {
+        result = items[0];
+        Sb_INCREF(result);
+        Sb_DECREF(seq);
+        return result;
     }
 
-    /* FIXME: guard against overflows */
-    result = SbStr_FromStringAndSize(NULL, length);
-    if (!result) {
-        return NULL;
-    }
+    /* Nothing below calls back into Python, so the items stay put. */
+    glue_size = SbStr_GetSizeUnsafe(glue);
+    length = 0;
+    for (pos = 0; pos < count; ++pos) {
+        Sb_ssize_t size;
 
-    it = SbObject_GetIter(iterable);
-    if (!it) {
-        Sb_DECREF(result);
-        return NULL;
+        if (!SbStr_CheckExact(items[pos])) {
+            SbErr_RaiseWithFormat(SbExc_TypeError, "invalid type: expected str, found %s", Sb_TYPE(items[pos])->tp_name);
+            goto fail;
+        }
+        size = SbStr_GetSizeUnsafe(items[pos]);
+        if (pos > 0) {
+            size += glue_size;
+        }
+        if (size > Sb_SSIZE_MAX - length) {
+            SbErr_RaiseWithString(SbExc_OverflowError, "join() result is too long");
+            goto fail;
+        }
+        length += size;
     }
 
+    result = SbStr_FromStringAndSize(NULL, length);
+    if (!result) {
+        goto fail;
+    }
     cursor = SbStr_AsStringUnsafe(result);
+    for (pos = 0; pos < count; ++pos) {
+        Sb_ssize_t size;
 
-    o = SbIter_Next(it);
-    goto midloop;
-
-    while (o) {
-        length = SbStr_GetSizeUnsafe(glue);
-        source = SbStr_AsStringUnsafe(glue);
-        while (length-- > 0) {
-            *cursor++ = *source++;
-        }
-midloop:
-        length = SbStr_GetSizeUnsafe(o);
-        source = SbStr_AsStringUnsafe(o);
-        while (length-- > 0) {
-            *cursor++ = *source++;
+        if (pos > 0 && glue_size) {
+            SbRT_MemCpy(cursor, SbStr_AsStringUnsafe(glue), glue_size);
+            cursor += glue_size;
         }
-        Sb_DECREF(o);
-        o = SbIter_Next(it);
+        size = SbStr_GetSizeUnsafe(items[pos]);
+        SbRT_MemCpy(cursor, SbStr_AsStringUnsafe(items[pos]), size);
+        cursor += size;
     }
-    Sb_DECREF(it);
 
+    Sb_DECREF(seq);
     return result;
+
+fail:
+    Sb_DECREF(seq);
+    return NULL;
 }
 
 SbObject *
@@ -330,6 +324,141 @@ SbStr_Truncate(SbObject *p, Sb_ssize_t new_length)
     return 0;
 }
 
+int
+_SbStr_Resize(SbObject **pp, Sb_ssize_t new_length)
+{
+    SbStrObject *op;
+    SbTypeObject *tp;
+
+    tp = Sb_TYPE(*pp);
+    op = (SbStrObject *)SbObject_Realloc(*pp, tp->tp_basicsize + new_length * tp->tp_itemsize);
+    if (!op) {
+        Sb_CLEAR(*pp);
+        SbErr_NoMemory();
+        return -1;
+    }
+
+    op->ob_itemcount = new_length;
+    op->stored_hash = -1;
+    op->items[new_length] = '\0';
+    *pp = (SbObject *)op;
+    return 0;
+}
+
+int
+_SbStr_ConcatInPlace(SbObject **pp, SbObject *rhs)
+{
+    Sb_ssize_t lhs_size;
+    Sb_ssize_t rhs_size;
+
+    lhs_size = SbStr_GetSizeUnsafe(*pp);
+    rhs_size = SbStr_GetSizeUnsafe(rhs);
+    if (_SbStr_Resize(pp, lhs_size + rhs_size) < 0) {
+        return -1;
+    }
+    SbRT_MemCpy(SbStr_AsStringUnsafe(*pp) + lhs_size, SbStr_AsStringUnsafe(rhs), rhs_size);
+    return 0;
+}
+
+/* StrBuilder implementation */
+
+#define STR_BUILDER_MIN_SIZE 16
+
+int
+SbStrBuilder_Init(SbStrBuilder *sb, Sb_ssize_t size_hint)
+{
+    if (size_hint < STR_BUILDER_MIN_SIZE) {
+        size_hint = STR_BUILDER_MIN_SIZE;
+    }
+    sb->length = 0;
+    sb->str = SbStr_FromStringAndSize(NULL, size_hint);
+    return sb->str ? 0 : -1;
+}
+
+int
+SbStrBuilder_Reserve(SbStrBuilder *sb, Sb_ssize_t extra)
+{
+    Sb_ssize_t needed;
+    Sb_ssize_t capacity;
+
+    needed = sb->length + extra;
+    capacity = SbStr_GetSizeUnsafe(sb->str);
+    if (needed <= capacity) {
+        return 0;
+    }
+
+    /* Grow by half, so a long run of small appends costs linear time. */
+    capacity += capacity >> 1;
+    if (capacity < needed) {
+        capacity = needed;
+    }
+    return _SbStr_Resize(&sb->str, capacity);
+}
+
+int
+SbStrBuilder_Append(SbStrBuilder *sb, const void *v, Sb_ssize_t len)
+{
+    if (SbStrBuilder_Reserve(sb, len) < 0) {
+        return -1;
+    }
+    SbRT_MemCpy(SbStr_AsStringUnsafe(sb->str) + sb->length, v, len);
+    sb->length += len;
+    return 0;
+}
+
+int
+SbStrBuilder_AppendStr(SbStrBuilder *sb, SbObject *p)
+{
+    return SbStrBuilder_Append(sb, SbStr_AsStringUnsafe(p), SbStr_GetSizeUnsafe(p));
+}
+
+int
+SbStrBuilder_AppendChar(SbStrBuilder *sb, char c)
+{
+    if (SbStrBuilder_Reserve(sb, 1) < 0) {
+        return -1;
+    }
+    SbStr_AsStringUnsafe(sb->str)[sb->length++] = c;
+    return 0;
+}
+
+int
+SbStrBuilder_AppendFill(SbStrBuilder *sb, char c, Sb_ssize_t count)
+{
+    if (count <= 0) {
+        return 0;
+    }
+    if (SbStrBuilder_Reserve(sb, count) < 0) {
+        return -1;
+    }
+    SbRT_MemSet(SbStr_AsStringUnsafe(sb->str) + sb->length, c, count);
+    sb->length += count;
+    return 0;
+}
+
+SbObject *
+SbStrBuilder_Finish(SbStrBuilder *sb)
+{
+    SbObject *result;
+
+    if (SbStr_GetSizeUnsafe(sb->str) != sb->length) {
+        if (_SbStr_Resize(&sb->str, sb->length) < 0) {
+            return NULL;
+        }
+    }
+    result = sb->str;
+    sb->str = NULL;
+    sb->length = 0;
+    return result;
+}
+
+void
+SbStrBuilder_Clear(SbStrBuilder *sb)
+{
+    Sb_CLEAR(sb->str);
+    sb->length = 0;
+}
+
 
 long
 _SbStr_Hash(SbObject *p)
@@ -348,15 +477,12 @@ _SbStr_Hash(SbObject *p)
 long
 _SbStr_HashString(const Sb_byte_t *p, Sb_ssize_t len)
 {
-    Sb_ssize_t count = len;
+    Sb_ulong64_t h;
     long x;
 
-    x = *p << 7;
-    while (count-- > 0) {
-        x = (1000003 * x) ^ *p;
-        p++;
-    }
-    x ^= len;
+    h = SbRT_HashBytes(p, len);
+    /* Fold the high half in where long is narrower */
+    x = (long)(sizeof(long) < sizeof(h) ? h ^ (h >> 32) : h);
     if (x == -1) {
         x = -2;
     }
@@ -378,6 +504,21 @@ _SbStr_Eq(SbObject *p1, SbObject *p2)
     return SbRT_MemCmp(SbStr_AsString(p1), SbStr_AsString(p2), length) == 0;
 }
 
+int
+_SbStr_Compare(SbObject *p1, SbObject *p2)
+{
+    Sb_ssize_t length1, length2;
+    int result;
+
+    length1 = SbStr_GetSizeUnsafe(p1);
+    length2 = SbStr_GetSizeUnsafe(p2);
+    result = SbRT_MemCmp(SbStr_AsStringUnsafe(p1), SbStr_AsStringUnsafe(p2), length1 < length2 ? length1 : length2);
+    if (result) {
+        return result;
+    }
+    return length1 < length2 ? -1 : length1 > length2;
+}
+
 int
 _SbStr_EqString(SbObject *p1, const char *p2)
 {
@@ -399,9 +540,10 @@ _SbStr_EqString(SbObject *p1, const char *p2)
 static SbObject *
 str_new(SbObject *dummy, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:cls|O:o");
     SbObject *o;
 
-    if (SbArgs_Parse("O:cls|O:o", args, kwargs, &dummy, &o) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &dummy, &o) < 0) {
         return NULL;
     }
 
@@ -456,14 +598,66 @@ str_ne(SbObject *self, SbObject *args, SbObject *kwargs)
     return NULL;
 }
 
+static SbObject *
+str_compare_wrap(SbObject *self, SbObject *args, SbObjectCompareOp op)
+{
+    SbObject *other;
+    int result;
+
+    other = SbTuple_GetItem(args, 0);
+    if (!other) {
+        return NULL;
+    }
+    if (!SbStr_CheckExact(other)) {
+        Sb_INCREF(Sb_NotImplemented);
+        return Sb_NotImplemented;
+    }
+    result = _SbStr_Compare(self, other);
+    switch (op) {
+    case Sb_LT:
+        return SbBool_FromLong(result < 0);
+    case Sb_LE:
+        return SbBool_FromLong(result <= 0);
+    case Sb_GT:
+        return SbBool_FromLong(result > 0);
+    default:
+        return SbBool_FromLong(result >= 0);
+    }
+}
+
+static SbObject *
+str_lt(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    return str_compare_wrap(self, args, Sb_LT);
+}
+
+static SbObject *
+str_le(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    return str_compare_wrap(self, args, Sb_LE);
+}
+
+static SbObject *
+str_gt(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    return str_compare_wrap(self, args, Sb_GT);
+}
+
+static SbObject *
+str_ge(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    return str_compare_wrap(self, args, Sb_GE);
+}
+
 static SbObject *
 str_getitem(SbObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:index");
     SbObject *index;
     SbObject *result;
     SbInt_Native_t pos;
 
-    if (SbArgs_Parse("O:index", args, kwargs, &index) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &index) < 0) {
         return NULL;
     }
     if (SbSlice_Check(index)) {
@@ -471,16 +665,18 @@ str_getitem(SbObject *self, SbObject *args, SbObject *kwargs)
         char *src_buffer;
         char *dst_buffer;
 
-        if (SbSlice_GetIndices(index, SbList_GetSizeUnsafe(self), &start, &end, &step, &slice_length) < 0) {
+        if (SbSlice_GetIndices(index, SbStr_GetSizeUnsafe(self), &start, &end, &step, &slice_length) < 0) {
             return NULL;
         }
 
         src_buffer = (char *)SbStr_AsStringUnsafe(self);
         result = SbStr_FromStringAndSize(NULL, slice_length);
+        if (!result) {
+            return NULL;
+        }
         dst_buffer = (char *)SbStr_AsStringUnsafe(result);
-        pos = 0;
-        for ( ; start < end; start += step) {
-            dst_buffer[pos++] = src_buffer[start];
+        for (pos = 0; pos < slice_length; ++pos, start += step) {
+            dst_buffer[pos] = src_buffer[start];
         }
         /* SAFE: we overallocate by 1 */
         dst_buffer[pos] = '\0';
@@ -509,9 +705,10 @@ str_getitem(SbObject *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 str_join(SbObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:iterable");
     SbObject *iterable;
 
-    if (SbArgs_Parse("O:iterable", args, kwargs, &iterable) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &iterable) < 0) {
         return NULL;
     }
     return SbStr_Join(self, iterable);
@@ -564,10 +761,11 @@ str_justify_internal(SbObject *str, Sb_ssize_t width, char filler, void (*proc)(
 static SbObject *
 str_justify_generic(SbObject *self, SbObject *args, SbObject *kwargs, void (*proc)(char *, Sb_ssize_t, const char *, Sb_ssize_t, char))
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("i:width|c:fillchar");
     char fillchar = ' ';
     Sb_ssize_t width;
 
-    if (SbArgs_Parse("i:width|c:fillchar", args, kwargs, &width, &fillchar) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &width, &fillchar) < 0) {
         return NULL;
     }
 
@@ -610,37 +808,27 @@ SbStr_JustifyRight(SbObject *str, Sb_ssize_t width, char filler)
     return str_justify_internal(str, width, filler, fill_rjust);
 }
 
-static int
-str_normalize_indices(Sb_ssize_t *p_start, Sb_ssize_t *p_end, Sb_ssize_t len)
+/* Adjust start/end the way slice indices are: negative ones count from the end,
+   and both are clamped to the string. A start past the end is left as is,
+   so end - start goes negative and nothing matches. */
+static void
+str_adjust_indices(Sb_ssize_t *p_start, Sb_ssize_t *p_end, Sb_ssize_t len)
 {
-    Sb_ssize_t index;
-
-    index = *p_start;
-    if (index < 0) {
-        index += len;
-        if (index < 0) {
-            goto index_oob;
-        }
+    if (*p_end > len) {
+        *p_end = len;
     }
-    *p_start = index;
-
-    index = *p_end;
-    if (index < 0) {
-        index += len;
-        if (index < 0) {
-            goto index_oob;
+    else if (*p_end < 0) {
+        *p_end += len;
+        if (*p_end < 0) {
+            *p_end = 0;
         }
     }
-    if (index > len) {
-        index = len;
+    if (*p_start < 0) {
+        *p_start += len;
+        if (*p_start < 0) {
+            *p_start = 0;
+        }
     }
-    *p_end = index;
-
-    return 0;
-
-index_oob:
-    SbErr_RaiseWithString(SbExc_IndexError, "index out of range");
-    return -1;
 }
 
 typedef Sb_ssize_t (*str_searcher_t)(const char *, Sb_ssize_t, const char *, Sb_ssize_t);
@@ -648,6 +836,7 @@ typedef Sb_ssize_t (*str_searcher_t)(const char *, Sb_ssize_t, const char *, Sb_
 static Sb_ssize_t
 str_find_internal(SbObject *self, SbObject *args, SbObject *kwargs, str_searcher_t finder)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("S:pattern|i:start,i:end");
     SbObject *o_pattern;
     Sb_ssize_t start;
     Sb_ssize_t end;
@@ -657,16 +846,15 @@ str_find_internal(SbObject *self, SbObject *args, SbObject *kwargs, str_searcher
     start = 0;
     end = SbStr_GetSizeUnsafe(self);
 
-    if (SbArgs_Parse("S:pattern|i:start,i:end", args, kwargs, &o_pattern, &start, &end) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_pattern, &start, &end) < 0) {
         return -2;
     }
 
     str_len = SbStr_GetSizeUnsafe(self);
-    if (str_normalize_indices(&start, &end, str_len) < 0) {
-        return -2;
-    }
+    str_adjust_indices(&start, &end, str_len);
 
-    if (start <= str_len) {
+    /* A start past the end, or after an end, leaves nothing to search. */
+    if (start <= str_len && start <= end) {
         pos = finder(SbStr_AsStringUnsafe(self) + start, end - start,
             SbStr_AsStringUnsafe(o_pattern), SbStr_GetSizeUnsafe(o_pattern));
         if (pos >= 0) {
@@ -729,71 +917,514 @@ str_rindex(SbObject *self, SbObject *args, SbObject *kwargs)
 }
 
 
-static SbObject *
-str_startswith(SbObject *self, SbObject *args, SbObject *kwargs)
+/* Check whether `sub` occurs at the start (or the end) of self[start:end].
+   Returns: 1 if yes, 0 if no. */
+static int
+str_tailmatch(SbObject *self, SbObject *sub, Sb_ssize_t start, Sb_ssize_t end, int at_end)
 {
-    const char *prefix;
+    Sb_ssize_t sub_len;
 
-    /* NOTE: tuple prefix not implemented; start/end indices not implemented. */
-    if (SbArgs_Parse("s:prefix", args, kwargs, &prefix) < 0) {
-        return NULL;
+    sub_len = SbStr_GetSizeUnsafe(sub);
+    if (end - start < sub_len) {
+        return 0;
     }
-    switch (SbStr_StartsWithString(self, prefix)) {
-    case 0:
-        Sb_RETURN_FALSE;
-    case 1:
-        Sb_RETURN_TRUE;
-    default:
-        return NULL;
+    if (at_end) {
+        start = end - sub_len;
     }
+    return SbRT_MemCmp(SbStr_AsStringUnsafe(self) + start, SbStr_AsStringUnsafe(sub), sub_len) == 0;
 }
 
 static SbObject *
-str_concat(SbObject *self, SbObject *args, SbObject *kwargs)
+str_xwith(SbObject *self, SbObject *o_sub, Sb_ssize_t start, Sb_ssize_t end, int at_end)
 {
-    SbObject *o_rhs;
+    Sb_ssize_t pos;
 
-    if (SbArgs_Parse("O:rhs", args, kwargs, &o_rhs) < 0) {
-        return NULL;
+    str_adjust_indices(&start, &end, SbStr_GetSizeUnsafe(self));
+    if (SbStr_CheckExact(o_sub)) {
+        return SbBool_FromLong(str_tailmatch(self, o_sub, start, end, at_end));
     }
-    if (!SbStr_CheckExact(o_rhs)) {
-        Sb_INCREF(Sb_NotImplemented);
-        return Sb_NotImplemented;
+    if (!SbTuple_CheckExact(o_sub)) {
+        goto type_error;
     }
-    return SbStr_Concat(self, o_rhs);
-}
+    for (pos = 0; pos < SbTuple_GetSizeUnsafe(o_sub); ++pos) {
+        SbObject *o_item = SbTuple_GetItemUnsafe(o_sub, pos);
 
-#if SUPPORTS(STR_FORMAT)
+        if (!SbStr_CheckExact(o_item)) {
+            goto type_error;
+        }
+        if (str_tailmatch(self, o_item, start, end, at_end)) {
+            Sb_RETURN_TRUE;
+        }
+    }
+    Sb_RETURN_FALSE;
+
+type_error:
+    SbErr_RaiseWithFormat(SbExc_TypeError, "%s first arg must be str or a tuple of str, not %s",
+        at_end ? "endswith" : "startswith", Sb_TYPE(o_sub)->tp_name);
+    return NULL;
+}
 
 static SbObject *
-str_format(SbObject *self, SbObject *args, SbObject *kwargs)
+str_startswith(SbObject *self, SbObject *args, SbObject *kwargs)
 {
-    const char *spec_string;
-    SbString_FormatSpecifier spec;
-    SbObject *o_result;
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:prefix|i:start,i:end");
+    SbObject *o_prefix;
+    Sb_ssize_t start;
+    Sb_ssize_t end;
 
-    if (SbArgs_Parse("z:spec", args, kwargs, &spec_string) < 0) {
+    start = 0;
+    end = SbStr_GetSizeUnsafe(self);
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_prefix, &start, &end) < 0) {
         return NULL;
     }
-    if (SbString_ParseFormatSpec(spec_string ? spec_string : "", &spec) < 0) {
+    return str_xwith(self, o_prefix, start, end, 0);
+}
+
+static SbObject *
+str_endswith(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:suffix|i:start,i:end");
+    SbObject *o_suffix;
+    Sb_ssize_t start;
+    Sb_ssize_t end;
+
+    start = 0;
+    end = SbStr_GetSizeUnsafe(self);
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_suffix, &start, &end) < 0) {
         return NULL;
     }
+    return str_xwith(self, o_suffix, start, end, 1);
+}
 
-    if (spec.precision >= 0 && (unsigned long)SbStr_GetSizeUnsafe(self) > spec.precision) {
-        self = SbStr_FromStringAndSize(SbStr_AsStringUnsafe(self), spec.precision);
+/* Count non-overlapping occurrences of a pattern, stopping at `maxcount`.
+   An empty pattern matches at every position, the end included. */
+static Sb_ssize_t
+str_count_matches(const char *str, Sb_ssize_t str_len, const char *pat, Sb_ssize_t pat_len, Sb_ssize_t maxcount)
+{
+    Sb_ssize_t count;
+    Sb_ssize_t pos;
+    Sb_ssize_t found;
+
+    if (str_len < pat_len) {
+        return 0;
     }
-    else {
-        Sb_INCREF(self);
+    if (pat_len == 0) {
+        return str_len < maxcount ? str_len + 1 : maxcount;
     }
 
-    if (spec.align_flag == '>') {
-        o_result = SbStr_JustifyRight(self, spec.min_width, spec.filler);
-    }
-    else if (spec.align_flag == '^') {
-        o_result = SbStr_JustifyCenter(self, spec.min_width, spec.filler);
+    count = 0;
+    pos = 0;
+    while (count < maxcount) {
+        found = SbRT_MemMem(str + pos, str_len - pos, pat, pat_len);
+        if (found < 0) {
+            break;
+        }
+        pos += found + pat_len;
+        ++count;
     }
-    else {
-        o_result = SbStr_JustifyLeft(self, spec.min_width, spec.filler);
+    return count;
+}
+
+static SbObject *
+str_count(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("S:sub|i:start,i:end");
+    SbObject *o_sub;
+    Sb_ssize_t start;
+    Sb_ssize_t end;
+
+    start = 0;
+    end = SbStr_GetSizeUnsafe(self);
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_sub, &start, &end) < 0) {
+        return NULL;
+    }
+    str_adjust_indices(&start, &end, SbStr_GetSizeUnsafe(self));
+    return SbInt_FromNative(str_count_matches(SbStr_AsStringUnsafe(self) + start, end - start,
+        SbStr_AsStringUnsafe(o_sub), SbStr_GetSizeUnsafe(o_sub), Sb_SSIZE_MAX));
+}
+
+/* Match positions up to this many are kept on the stack. */
+#define STR_REPLACE_ON_STACK 64
+
+/* Insert `o_new` before each of the first `count` chars, and after the last one
+   if `count` goes that far. */
+static SbObject *
+str_replace_empty(SbObject *self, SbObject *o_new, Sb_ssize_t count)
+{
+    const char *src;
+    Sb_ssize_t str_len;
+    Sb_ssize_t new_len;
+    Sb_ssize_t pos;
+    SbObject *o_result;
+    char *cursor;
+
+    src = SbStr_AsStringUnsafe(self);
+    str_len = SbStr_GetSizeUnsafe(self);
+    new_len = SbStr_GetSizeUnsafe(o_new);
+    if (new_len && count > (Sb_SSIZE_MAX - str_len) / new_len) {
+        SbErr_RaiseWithString(SbExc_OverflowError, "replace() result is too long");
+        return NULL;
+    }
+    o_result = SbStr_FromStringAndSize(NULL, str_len + count * new_len);
+    if (!o_result) {
+        return NULL;
+    }
+
+    cursor = SbStr_AsStringUnsafe(o_result);
+    for (pos = 0; pos < count; ++pos) {
+        SbRT_MemCpy(cursor, SbStr_AsStringUnsafe(o_new), new_len);
+        cursor += new_len;
+        if (pos < str_len) {
+            *cursor++ = src[pos];
+        }
+    }
+    if (pos < str_len) {
+        SbRT_MemCpy(cursor, src + pos, str_len - pos);
+    }
+    return o_result;
+}
+
+static SbObject *
+str_replace(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("S:old,S:new|i:count");
+    SbObject *o_old;
+    SbObject *o_new;
+    Sb_ssize_t maxcount;
+    Sb_ssize_t stack_positions[STR_REPLACE_ON_STACK];
+    Sb_ssize_t *positions;
+    Sb_ssize_t allocated;
+    Sb_ssize_t count;
+    Sb_ssize_t str_len, old_len, new_len;
+    Sb_ssize_t pos, found, index;
+    const char *src;
+    SbObject *o_result;
+    char *cursor;
+
+    maxcount = -1;
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_old, &o_new, &maxcount) < 0) {
+        return NULL;
+    }
+    if (maxcount < 0) {
+        maxcount = Sb_SSIZE_MAX;
+    }
+
+    src = SbStr_AsStringUnsafe(self);
+    str_len = SbStr_GetSizeUnsafe(self);
+    old_len = SbStr_GetSizeUnsafe(o_old);
+    new_len = SbStr_GetSizeUnsafe(o_new);
+
+    if (old_len == 0) {
+        count = str_count_matches(src, str_len, "", 0, maxcount);
+        if (count == 0) {
+            goto unchanged;
+        }
+        return str_replace_empty(self, o_new, count);
+    }
+
+    /* Find all matches in one pass, remembering where they are */
+    positions = stack_positions;
+    allocated = STR_REPLACE_ON_STACK;
+    count = 0;
+    pos = 0;
+    while (count < maxcount) {
+        found = SbRT_MemMem(src + pos, str_len - pos, SbStr_AsStringUnsafe(o_old), old_len);
+        if (found < 0) {
+            break;
+        }
+        if (count == allocated) {
+            Sb_ssize_t *new_positions;
+
+            new_positions = (Sb_ssize_t *)SbObject_Malloc(2 * allocated * sizeof(Sb_ssize_t));
+            if (!new_positions) {
+                SbErr_NoMemory();
+                goto fail;
+            }
+            SbRT_MemCpy(new_positions, positions, count * sizeof(Sb_ssize_t));
+            if (positions != stack_positions) {
+                SbObject_Free(positions);
+            }
+            positions = new_positions;
+            allocated *= 2;
+        }
+        positions[count++] = pos + found;
+        pos += found + old_len;
+    }
+    if (count == 0) {
+        goto unchanged;
+    }
+
+    /* Then build the result in one allocation */
+    if (new_len > old_len && count > (Sb_SSIZE_MAX - str_len) / (new_len - old_len)) {
+        SbErr_RaiseWithString(SbExc_OverflowError, "replace() result is too long");
+        goto fail;
+    }
+    o_result = SbStr_FromStringAndSize(NULL, str_len + count * (new_len - old_len));
+    if (!o_result) {
+        goto fail;
+    }
+    cursor = SbStr_AsStringUnsafe(o_result);
+    pos = 0;
+    for (index = 0; index < count; ++index) {
+        SbRT_MemCpy(cursor, src + pos, positions[index] - pos);
+        cursor += positions[index] - pos;
+        SbRT_MemCpy(cursor, SbStr_AsStringUnsafe(o_new), new_len);
+        cursor += new_len;
+        pos = positions[index] + old_len;
+    }
+    SbRT_MemCpy(cursor, src + pos, str_len - pos);
+
+    if (positions != stack_positions) {
+        SbObject_Free(positions);
+    }
+    return o_result;
+
+unchanged:
+    Sb_INCREF(self);
+    return self;
+
+fail:
+    if (positions != stack_positions) {
+        SbObject_Free(positions);
+    }
+    return NULL;
+}
+
+/* Matches the C library's isspace() in the C locale. */
+#define STR_IS_SPACE(c) ((c) == ' ' || ((c) >= '\t' && (c) <= '\r'))
+
+/* Result lists start with room for this many items. */
+#define STR_SPLIT_PREALLOC 12
+
+static int
+str_split_append(SbObject *list, SbObject *self, Sb_ssize_t start, Sb_ssize_t end)
+{
+    SbObject *o_item;
+    int result;
+
+    if (start == 0 && end == SbStr_GetSizeUnsafe(self)) {
+        return SbList_Append(list, self);
+    }
+    o_item = SbStr_FromStringAndSize(SbStr_AsStringUnsafe(self) + start, end - start);
+    if (!o_item) {
+        return -1;
+    }
+    result = SbList_Append(list, o_item);
+    Sb_DECREF(o_item);
+    return result;
+}
+
+static SbObject *
+str_split(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("|O:sep,i:maxsplit");
+    SbObject *o_sep;
+    Sb_ssize_t maxsplit;
+    SbObject *o_result;
+    const char *src;
+    Sb_ssize_t str_len;
+    Sb_ssize_t start, pos, found;
+
+    o_sep = Sb_None;
+    maxsplit = -1;
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_sep, &maxsplit) < 0) {
+        return NULL;
+    }
+    if (maxsplit < 0) {
+        maxsplit = Sb_SSIZE_MAX;
+    }
+    if (o_sep != Sb_None) {
+        if (!SbStr_CheckExact(o_sep)) {
+            SbErr_RaiseWithFormat(SbExc_TypeError, "expected arg 'sep' to be str, got %s", Sb_TYPE(o_sep)->tp_name);
+            return NULL;
+        }
+        if (SbStr_GetSizeUnsafe(o_sep) == 0) {
+            SbErr_RaiseWithString(SbExc_ValueError, "empty separator");
+            return NULL;
+        }
+    }
+
+    o_result = SbList_New(0);
+    if (!o_result) {
+        return NULL;
+    }
+    if (SbList_Reserve(o_result, STR_SPLIT_PREALLOC) < 0) {
+        goto fail;
+    }
+
+    src = SbStr_AsStringUnsafe(self);
+    str_len = SbStr_GetSizeUnsafe(self);
+    if (o_sep == Sb_None) {
+        /* Runs of whitespace separate; leading and trailing ones are dropped */
+        pos = 0;
+        while (maxsplit-- > 0) {
+            while (pos < str_len && STR_IS_SPACE(src[pos])) {
+                ++pos;
+            }
+            if (pos == str_len) {
+                break;
+            }
+            start = pos;
+            while (pos < str_len && !STR_IS_SPACE(src[pos])) {
+                ++pos;
+            }
+            if (str_split_append(o_result, self, start, pos) < 0) {
+                goto fail;
+            }
+        }
+        while (pos < str_len && STR_IS_SPACE(src[pos])) {
+            ++pos;
+        }
+        if (pos < str_len && str_split_append(o_result, self, pos, str_len) < 0) {
+            goto fail;
+        }
+    }
+    else {
+        const char *sep = SbStr_AsStringUnsafe(o_sep);
+        Sb_ssize_t sep_len = SbStr_GetSizeUnsafe(o_sep);
+
+        start = 0;
+        while (maxsplit-- > 0) {
+            found = SbRT_MemMem(src + start, str_len - start, sep, sep_len);
+            if (found < 0) {
+                break;
+            }
+            if (str_split_append(o_result, self, start, start + found) < 0) {
+                goto fail;
+            }
+            start += found + sep_len;
+        }
+        if (str_split_append(o_result, self, start, str_len) < 0) {
+            goto fail;
+        }
+    }
+    return o_result;
+
+fail:
+    Sb_DECREF(o_result);
+    return NULL;
+}
+
+#define STR_STRIP_LEFT 1
+#define STR_STRIP_RIGHT 2
+
+static SbObject *
+str_strip_generic(SbObject *self, SbObject *args, SbObject *kwargs, int which)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("|O:chars");
+    SbObject *o_chars;
+    Sb_byte_t strip_set[256];
+    const Sb_byte_t *src;
+    Sb_ssize_t start, end, pos;
+
+    o_chars = Sb_None;
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_chars) < 0) {
+        return NULL;
+    }
+
+    SbRT_BZero(strip_set, sizeof(strip_set));
+    if (o_chars == Sb_None) {
+        strip_set[' '] = 1;
+        SbRT_MemSet(strip_set + '\t', 1, '\r' - '\t' + 1);
+    }
+    else if (SbStr_CheckExact(o_chars)) {
+        src = (const Sb_byte_t *)SbStr_AsStringUnsafe(o_chars);
+        for (pos = 0; pos < SbStr_GetSizeUnsafe(o_chars); ++pos) {
+            strip_set[src[pos]] = 1;
+        }
+    }
+    else {
+        SbErr_RaiseWithFormat(SbExc_TypeError, "expected arg 'chars' to be str, got %s", Sb_TYPE(o_chars)->tp_name);
+        return NULL;
+    }
+
+    src = (const Sb_byte_t *)SbStr_AsStringUnsafe(self);
+    start = 0;
+    end = SbStr_GetSizeUnsafe(self);
+    if (which & STR_STRIP_LEFT) {
+        while (start < end && strip_set[src[start]]) {
+            ++start;
+        }
+    }
+    if (which & STR_STRIP_RIGHT) {
+        while (end > start && strip_set[src[end - 1]]) {
+            --end;
+        }
+    }
+
+    if (start == 0 && end == SbStr_GetSizeUnsafe(self)) {
+        Sb_INCREF(self);
+        return self;
+    }
+    return SbStr_FromStringAndSize(src + start, end - start);
+}
+
+static SbObject *
+str_strip(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    return str_strip_generic(self, args, kwargs, STR_STRIP_LEFT | STR_STRIP_RIGHT);
+}
+
+static SbObject *
+str_lstrip(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    return str_strip_generic(self, args, kwargs, STR_STRIP_LEFT);
+}
+
+static SbObject *
+str_rstrip(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    return str_strip_generic(self, args, kwargs, STR_STRIP_RIGHT);
+}
+
+static SbObject *
+str_concat(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:rhs");
+    SbObject *o_rhs;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &o_rhs) < 0) {
+        return NULL;
+    }
+    if (!SbStr_CheckExact(o_rhs)) {
+        Sb_INCREF(Sb_NotImplemented);
+        return Sb_NotImplemented;
+    }
+    return SbStr_Concat(self, o_rhs);
+}
+
+#if SUPPORTS(STR_FORMAT)
+
+static SbObject *
+str_format(SbObject *self, SbObject *args, SbObject *kwargs)
+{
+    static SbArgsSpec args_spec = SbArgs_SPEC("z:spec");
+    const char *spec_string;
+    SbString_FormatSpecifier spec;
+    SbObject *o_result;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &spec_string) < 0) {
+        return NULL;
+    }
+    if (SbString_ParseFormatSpec(spec_string ? spec_string : "", &spec) < 0) {
+        return NULL;
+    }
+
+    if (spec.precision >= 0 && (unsigned long)SbStr_GetSizeUnsafe(self) > spec.precision) {
+        self = SbStr_FromStringAndSize(SbStr_AsStringUnsafe(self), spec.precision);
+    }
+    else {
+        Sb_INCREF(self);
+    }
+
+    if (spec.align_flag == '>') {
+        o_result = SbStr_JustifyRight(self, spec.min_width, spec.filler);
+    }
+    else if (spec.align_flag == '^') {
+        o_result = SbStr_JustifyCenter(self, spec.min_width, spec.filler);
+    }
+    else {
+        o_result = SbStr_JustifyLeft(self, spec.min_width, spec.filler);
     }
     Sb_DECREF(self);
 
@@ -806,10 +1437,403 @@ str_format(SbObject *self, SbObject *args, SbObject *kwargs)
 
 /* Ref: https://docs.python.org/2/library/stdtypes.html#string-formatting */
 
+typedef struct _str_interp_spec {
+    char left_align;
+    char zero_pad;
+    char sign;
+    char alt_form;
+    Sb_ssize_t width;
+    Sb_ssize_t precision;
+} str_interp_spec;
+
+static int
+str_interp_string(SbStrBuilder *sb, const str_interp_spec *spec, SbObject *s)
+{
+    Sb_ssize_t length;
+    Sb_ssize_t fill;
+
+    length = SbStr_GetSizeUnsafe(s);
+    if (spec->precision >= 0 && spec->precision < length) {
+        length = spec->precision;
+    }
+    fill = spec->width - length;
+
+    if (!spec->left_align && SbStrBuilder_AppendFill(sb, ' ', fill) < 0) {
+        return -1;
+    }
+    if (SbStrBuilder_Append(sb, SbStr_AsStringUnsafe(s), length) < 0) {
+        return -1;
+    }
+    if (spec->left_align && SbStrBuilder_AppendFill(sb, ' ', fill) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static int
+str_interp_int(SbStrBuilder *sb, const str_interp_spec *spec, SbObject *o, char conv)
+{
+    SbObject *o_digits;
+    const char *digits;
+    Sb_ssize_t digits_size;
+    char prefix[4];
+    Sb_ssize_t prefix_size;
+    Sb_ssize_t zeros;
+    Sb_ssize_t fill;
+    Sb_ssize_t start;
+    unsigned radix;
+
+    radix = conv == 'o' ? 8 : (conv == 'x' || conv == 'X') ? 16 : 10;
+    o_digits = SbInt_ToString(o, radix);
+    if (!o_digits) {
+        return -1;
+    }
+    digits = (const char *)SbStr_AsStringUnsafe(o_digits);
+    digits_size = SbStr_GetSizeUnsafe(o_digits);
+
+    prefix_size = 0;
+    if (*digits == '-') {
+        prefix[prefix_size++] = '-';
+        ++digits;
+        --digits_size;
+    }
+    else if (spec->sign) {
+        prefix[prefix_size++] = spec->sign;
+    }
+    if (spec->alt_form && radix != 10) {
+        prefix[prefix_size++] = '0';
+        if (radix == 16) {
+            prefix[prefix_size++] = conv;
+        }
+    }
+
+    zeros = spec->precision - digits_size;
+    if (zeros < 0) {
+        zeros = 0;
+    }
+    fill = spec->width - (prefix_size + zeros + digits_size);
+
+    if (!spec->left_align && !spec->zero_pad && SbStrBuilder_AppendFill(sb, ' ', fill) < 0) {
+        goto fail;
+    }
+    if (SbStrBuilder_Append(sb, prefix, prefix_size) < 0) {
+        goto fail;
+    }
+    if (!spec->left_align && spec->zero_pad && SbStrBuilder_AppendFill(sb, '0', fill) < 0) {
+        goto fail;
+    }
+    if (SbStrBuilder_AppendFill(sb, '0', zeros) < 0) {
+        goto fail;
+    }
+    start = sb->length;
+    if (SbStrBuilder_Append(sb, digits, digits_size) < 0) {
+        goto fail;
+    }
+    if (conv == 'X') {
+        char *cursor;
+
+        for (cursor = SbStr_AsStringUnsafe(sb->str) + start; start < sb->length; ++start, ++cursor) {
+            if (*cursor >= 'a' && *cursor <= 'f') {
+                *cursor -= 'a' - 'A';
+            }
+        }
+    }
+    if (spec->left_align && SbStrBuilder_AppendFill(sb, ' ', fill) < 0) {
+        goto fail;
+    }
+    Sb_DECREF(o_digits);
+    return 0;
+
+fail:
+    Sb_DECREF(o_digits);
+    return -1;
+}
+
+static int
+str_interp_convert(SbStrBuilder *sb, const str_interp_spec *spec, SbObject *o, char conv)
+{
+    SbObject *s;
+    int rv;
+
+    switch (conv) {
+    case 's':
+    case 'r':
+        s = conv == 's' ? SbObject_Str(o) : SbObject_Repr(o);
+        if (!s) {
+            return -1;
+        }
+        rv = str_interp_string(sb, spec, s);
+        Sb_DECREF(s);
+        return rv;
+
+    case 'c':
+        if (SbStr_CheckExact(o) && SbStr_GetSizeUnsafe(o) == 1) {
+            return str_interp_string(sb, spec, o);
+        }
+        if (SbInt_Check(o)) {
+            SbInt_Native_t value;
+            char c;
+
+            value = SbInt_AsNative(o);
+            if (value == -1 && SbErr_Occurred()) {
+                return -1;
+            }
+            if (value < 0 || value > 0xFF) {
+                SbErr_RaiseWithString(SbExc_OverflowError, "%c arg not in range(256)");
+                return -1;
+            }
+            c = (char)value;
+            s = SbStr_FromStringAndSize(&c, 1);
+            if (!s) {
+                return -1;
+            }
+            rv = str_interp_string(sb, spec, s);
+            Sb_DECREF(s);
+            return rv;
+        }
+        SbErr_RaiseWithString(SbExc_TypeError, "%c requires int or char");
+        return -1;
+
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+        if (!SbInt_Check(o)) {
+            SbErr_RaiseWithFormat(SbExc_TypeError, "%%%c format: a number is required, not %s", conv, Sb_TYPE(o)->tp_name);
+            return -1;
+        }
+        return str_interp_int(sb, spec, o, conv);
+
+    default:
+        /* No floats to speak of. */
+        return 0;
+    }
+}
+
+static int
+str_interp_star(SbObject *values, Sb_ssize_t count, Sb_ssize_t *p_next, Sb_ssize_t *p_result)
+{
+    SbObject *o;
+
+    if (*p_next >= count) {
+        SbErr_RaiseWithString(SbExc_TypeError, "not enough arguments for format string");
+        return -1;
+    }
+    o = SbTuple_CheckExact(values) ? SbTuple_GetItemUnsafe(values, *p_next) : values;
+    ++*p_next;
+    if (!SbInt_Check(o)) {
+        SbErr_RaiseWithString(SbExc_TypeError, "* wants int");
+        return -1;
+    }
+    *p_result = SbInt_AsNative(o);
+    if (*p_result == -1 && SbErr_Occurred()) {
+        return -1;
+    }
+    return 0;
+}
+
 static SbObject *
 str_interpolate(SbObject *self, SbObject *args, SbObject *kwargs)
 {
-    SbErr_RaiseWithString(SbExc_SystemError, "not implemented");
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:values");
+    SbObject *values;
+    SbObject *mapping;
+    SbObject *o;
+    SbStrBuilder sb;
+    const char *format;
+    const char *cursor;
+    const char *end;
+    Sb_ssize_t count;
+    Sb_ssize_t next;
+
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &values) < 0) {
+        return NULL;
+    }
+
+    if (SbTuple_CheckExact(values)) {
+        count = SbTuple_GetSizeUnsafe(values);
+    }
+    else {
+        count = 1;
+    }
+    mapping = SbDict_CheckExact(values) ? values : NULL;
+    next = 0;
+
+    format = SbStr_AsStringUnsafe(self);
+    end = format + SbStr_GetSizeUnsafe(self);
+    if (SbStrBuilder_Init(&sb, end - format + 16) < 0) {
+        return NULL;
+    }
+
+    cursor = format;
+    while (cursor < end) {
+        const char *literal;
+        str_interp_spec spec;
+        char conv;
+        int rv;
+
+        literal = cursor;
+        while (cursor < end && *cursor != '%') {
+            ++cursor;
+        }
+        if (SbStrBuilder_Append(&sb, literal, cursor - literal) < 0) {
+            goto fail;
+        }
+        if (cursor >= end) {
+            break;
+        }
+        ++cursor;
+
+        o = NULL;
+        if (cursor < end && *cursor == '(') {
+            SbObject *key;
+            const char *key_start;
+            int depth;
+
+            if (!mapping) {
+                SbErr_RaiseWithString(SbExc_TypeError, "format requires a mapping");
+                goto fail;
+            }
+            key_start = ++cursor;
+            for (depth = 1; cursor < end; ++cursor) {
+                if (*cursor == '(') {
+                    ++depth;
+                }
+                else if (*cursor == ')' && --depth == 0) {
+                    break;
+                }
+            }
+            if (cursor >= end) {
+                SbErr_RaiseWithString(SbExc_ValueError, "incomplete format key");
+                goto fail;
+            }
+            key = SbStr_FromStringAndSize(key_start, cursor - key_start);
+            if (!key) {
+                goto fail;
+            }
+            ++cursor;
+            o = SbDict_GetItem(mapping, key);
+            if (!o) {
+                if (!SbErr_Occurred()) {
+                    SbErr_RaiseWithObject(SbExc_KeyError, key);
+                }
+                Sb_DECREF(key);
+                goto fail;
+            }
+            Sb_DECREF(key);
+            Sb_INCREF(o);
+        }
+
+        spec.left_align = 0;
+        spec.zero_pad = 0;
+        spec.sign = 0;
+        spec.alt_form = 0;
+        spec.width = 0;
+        spec.precision = -1;
+        for (; cursor < end; ++cursor) {
+            if (*cursor == '-') {
+                spec.left_align = 1;
+            }
+            else if (*cursor == '0') {
+                spec.zero_pad = 1;
+            }
+            else if (*cursor == '+') {
+                spec.sign = '+';
+            }
+            else if (*cursor == ' ') {
+                if (!spec.sign) {
+                    spec.sign = ' ';
+                }
+            }
+            else if (*cursor == '#') {
+                spec.alt_form = 1;
+            }
+            else {
+                break;
+            }
+        }
+        if (cursor < end && *cursor == '*') {
+            if (str_interp_star(values, count, &next, &spec.width) < 0) {
+                goto fail_o;
+            }
+            if (spec.width < 0) {
+                spec.left_align = 1;
+                spec.width = -spec.width;
+            }
+            ++cursor;
+        }
+        else {
+            while (cursor < end && Sb_IsDigit(*cursor)) {
+                spec.width = spec.width * 10 + (*cursor++ - '0');
+            }
+        }
+        if (cursor < end && *cursor == '.') {
+            ++cursor;
+            spec.precision = 0;
+            if (cursor < end && *cursor == '*') {
+                if (str_interp_star(values, count, &next, &spec.precision) < 0) {
+                    goto fail_o;
+                }
+                ++cursor;
+            }
+            else {
+                while (cursor < end && Sb_IsDigit(*cursor)) {
+                    spec.precision = spec.precision * 10 + (*cursor++ - '0');
+                }
+            }
+        }
+        /* Length modifiers mean nothing here. */
+        while (cursor < end && (*cursor == 'h' || *cursor == 'l' || *cursor == 'L')) {
+            ++cursor;
+        }
+        if (cursor >= end) {
+            SbErr_RaiseWithString(SbExc_ValueError, "incomplete format");
+            goto fail_o;
+        }
+
+        conv = *cursor++;
+        if (conv == '%') {
+            Sb_XDECREF(o);
+            if (SbStrBuilder_AppendChar(&sb, '%') < 0) {
+                goto fail;
+            }
+            continue;
+        }
+        if (!SbRT_MemChr("srcdiuoxX", conv, 9)) {
+            SbErr_RaiseWithFormat(SbExc_ValueError, "unsupported format character '%c' (0x%x) at index %d",
+                conv, (unsigned)(Sb_byte_t)conv, (int)(cursor - format - 1));
+            goto fail_o;
+        }
+
+        if (!o) {
+            if (next >= count) {
+                SbErr_RaiseWithString(SbExc_TypeError, "not enough arguments for format string");
+                goto fail;
+            }
+            o = SbTuple_CheckExact(values) ? SbTuple_GetItemUnsafe(values, next) : values;
+            Sb_INCREF(o);
+            ++next;
+        }
+        rv = str_interp_convert(&sb, &spec, o, conv);
+        Sb_DECREF(o);
+        if (rv < 0) {
+            goto fail;
+        }
+    }
+
+    if (next < count && !mapping) {
+        SbErr_RaiseWithString(SbExc_TypeError, "not all arguments converted during string formatting");
+        goto fail;
+    }
+
+    return SbStrBuilder_Finish(&sb);
+
+fail_o:
+    Sb_XDECREF(o);
+fail:
+    SbStrBuilder_Clear(&sb);
     return NULL;
 }
 
@@ -827,6 +1851,10 @@ static const SbCMethodDef str_methods[] = {
     { "__len__", str_len },
     { "__eq__", str_eq },
     { "__ne__", str_ne },
+    { "__lt__", str_lt },
+    { "__le__", str_le },
+    { "__gt__", str_gt },
+    { "__ge__", str_ge },
     { "__getitem__", str_getitem },
     { "__add__", str_concat },
 
@@ -841,7 +1869,16 @@ static const SbCMethodDef str_methods[] = {
     { "rfind", str_rfind },
     { "rindex", str_rindex },
 
+    { "count", str_count },
+
     { "startswith", str_startswith },
+    { "endswith", str_endswith },
+
+    { "replace", str_replace },
+    { "split", str_split },
+    { "strip", str_strip },
+    { "lstrip", str_lstrip },
+    { "rstrip", str_rstrip },
 
 #if SUPPORTS(STRING_INTERPOLATION)
     { "__mod__", str_interpolate },
@@ -863,6 +1900,7 @@ _SbStr_BuiltinInit()
     if (!tp) {
         return -1;
     }
+    Sb_SET_IMMORTAL(tp);
 
     /* This overallocates by 1 char -- is used for NUL terminator. */
     tp->tp_basicsize = sizeof(SbStrObject);
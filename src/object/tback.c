@@ -65,6 +65,22 @@ traceback_destroy(SbTraceBackObject *self)
     SbObject_DefaultDestroy((SbObject *)self);
 }
 
+static int
+traceback_traverse(SbTraceBackObject *self, SbVisitFunc visit, void *arg)
+{
+    Sb_VISIT(self->next);
+    Sb_VISIT(self->frame);
+    return 0;
+}
+
+static int
+traceback_clear(SbTraceBackObject *self)
+{
+    Sb_CLEAR(self->next);
+    Sb_CLEAR(self->frame);
+    return 0;
+}
+
 
 int
 _Sb_TypeInit_TraceBack()
@@ -77,6 +93,7 @@ _Sb_TypeInit_TraceBack()
     }
 
     tp->tp_destroy = (SbDestroyFunc)traceback_destroy;
+    _SbType_EnableGC(tp, (SbTraverseFunc)traceback_traverse, (SbClearFunc)traceback_clear);
 
     SbTraceBack_Type = tp;
     return 0;
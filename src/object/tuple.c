@@ -4,6 +4,9 @@
 /* Keep the type object here. */
 SbTypeObject *SbTuple_Type = NULL;
 
+/* All empty tuples are this one. */
+static SbObject *tuple_empty = NULL;
+
 /*
  * Internals
  */
@@ -37,6 +40,60 @@ tuple_destroy(SbTupleObject *self)
     SbObject_DefaultDestroy((SbObject *)self);
 }
 
+static int
+tuple_traverse(SbTupleObject *self, SbVisitFunc visit, void *arg)
+{
+    Sb_ssize_t pos;
+    Sb_ssize_t size = SbTuple_GetSizeUnsafe((SbObject *)self);
+
+    for (pos = 0; pos < size; ++pos) {
+        Sb_VISIT(self->items[pos]);
+    }
+    return 0;
+}
+
+static int
+tuple_clear(SbTupleObject *self)
+{
+    Sb_ssize_t pos;
+    Sb_ssize_t size = SbTuple_GetSizeUnsafe((SbObject *)self);
+
+    for (pos = 0; pos < size; ++pos) {
+        Sb_CLEAR(self->items[pos]);
+    }
+    return 0;
+}
+
+#if SUPPORTS(OBJECT_FREELISTS)
+/* Short tuples, mostly argument tuples, are recycled with a freelist per length.
+   Empty tuples are never allocated past the shared one. */
+#define TUPLE_FREELIST_MAX_LENGTH 20
+#define TUPLE_FREELIST_LIMIT 32
+
+static SbFreeList tuple_freelists[TUPLE_FREELIST_MAX_LENGTH + 1];
+/* Longer tuples are never kept; this one only saves on special-casing them. */
+static SbFreeList tuple_oversized = SbFreeList_INIT(0);
+
+static SbObject *
+tuple_alloc(SbTypeObject *type, Sb_ssize_t nitems)
+{
+    SbFreeList *fl;
+
+    fl = nitems <= TUPLE_FREELIST_MAX_LENGTH ? &tuple_freelists[nitems] : &tuple_oversized;
+    return _SbFreeList_Alloc(fl, type, type->tp_basicsize + nitems * type->tp_itemsize);
+}
+
+static void
+tuple_free(void *p)
+{
+    Sb_ssize_t length;
+
+    /* The item count is left intact by the destructor. */
+    length = Sb_COUNT(p);
+    _SbFreeList_Free(length <= TUPLE_FREELIST_MAX_LENGTH ? &tuple_freelists[length] : &tuple_oversized, p);
+}
+#endif
+
 /*
  * C interface implementations
  */
@@ -51,6 +108,11 @@ SbTuple_New(Sb_ssize_t length)
         return NULL;
     }
 
+    if (length == 0 && tuple_empty) {
+        Sb_INCREF(tuple_empty);
+        return tuple_empty;
+    }
+
     /* Allocator returns the memory wiped with zeros, so no need to do that again. */
     op = (SbTupleObject *)SbObject_NewVar(SbTuple_Type, length);
     return (SbObject *)op;
@@ -170,17 +232,18 @@ tuple_len(SbObject *self, SbObject *args, SbObject *kwargs)
 static SbObject *
 tuple_getitem(SbObject *self, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:index");
     SbObject *index;
     SbObject *result;
 
-    if (SbArgs_Parse("O:index", args, kwargs, &index) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &index) < 0) {
         return NULL;
     }
     if (SbSlice_Check(index)) {
         SbInt_Native_t start, end, step, slice_length;
         SbInt_Native_t my_pos, result_pos;
 
-        if (SbSlice_GetIndices(index, SbList_GetSizeUnsafe(self), &start, &end, &step, &slice_length) < 0) {
+        if (SbSlice_GetIndices(index, SbTuple_GetSizeUnsafe(self), &start, &end, &step, &slice_length) < 0) {
             return NULL;
         }
 
@@ -189,11 +252,12 @@ tuple_getitem(SbObject *self, SbObject *args, SbObject *kwargs)
             return NULL;
         }
 
-        result_pos = 0;
         my_pos = start;
-        while (my_pos < end) {
-            SbTuple_SetItemUnsafe(result, result_pos, SbList_GetItemUnsafe(self, my_pos));
-            result_pos += 1;
+        for (result_pos = 0; result_pos < slice_length; ++result_pos) {
+            SbObject *o = SbTuple_GetItemUnsafe(self, my_pos);
+
+            Sb_INCREF(o);
+            SbTuple_SetItemUnsafe(result, result_pos, o);
             my_pos += step;
         }
 
@@ -221,7 +285,7 @@ tuple_iter(SbObject *self, SbObject *args, SbObject *kwargs)
     SbObject **base;
 
     base = ((SbTupleObject *)self)->items;
-    return SbArrayIter_New(base, base + SbTuple_GetSizeUnsafe(self));
+    return SbArrayIter_New(self, base, base + SbTuple_GetSizeUnsafe(self));
 }
 
 /* Type initializer */
@@ -238,6 +302,9 @@ int
 _Sb_TypeInit_Tuple()
 {
     SbTypeObject *tp;
+#if SUPPORTS(OBJECT_FREELISTS)
+    Sb_ssize_t length;
+#endif
 
     tp = _SbType_FromCDefs("tuple", NULL, tuple_methods, sizeof(SbTupleObject));
     if (!tp) {
@@ -246,7 +313,25 @@ _Sb_TypeInit_Tuple()
 
     tp->tp_itemsize = sizeof(SbObject *);
     tp->tp_destroy = (SbDestroyFunc)tuple_destroy;
+    _SbType_EnableGC(tp, (SbTraverseFunc)tuple_traverse, (SbClearFunc)tuple_clear);
+#if SUPPORTS(OBJECT_FREELISTS)
+    for (length = 1; length <= TUPLE_FREELIST_MAX_LENGTH; ++length) {
+        tuple_freelists[length].limit = TUPLE_FREELIST_LIMIT;
+    }
+    tp->tp_alloc = tuple_alloc;
+    tp->tp_free = tuple_free;
+#endif
 
     SbTuple_Type = tp;
+
+    tuple_empty = SbTuple_New(0);
+    if (!tuple_empty) {
+        return -1;
+    }
+    Sb_SET_IMMORTAL(tuple_empty);
+#if SUPPORTS(CYCLE_GC)
+    /* Holds nothing, so there is nothing to collect. */
+    _SbGC_Untrack(tuple_empty);
+#endif
     return 0;
 }
@@ -4,6 +4,10 @@
 /* Keep the type object here. */
 SbTypeObject *SbType_Type = NULL;
 
+static SbDictKey key_del = SbDictKey_INIT("__del__");
+static SbDictKey key_new = SbDictKey_INIT("__new__");
+static SbDictKey key_init = SbDictKey_INIT("__init__");
+
 SbObject *
 SbType_GenericAlloc(SbTypeObject *type, Sb_ssize_t nitems)
 {
@@ -71,10 +75,16 @@ SbType_New(const char *name, SbTypeObject *base_type, SbObject *dict)
         tp->tp_flags = base_type->tp_flags;
         tp->tp_dictoffset = base_type->tp_dictoffset;
         tp->tp_destroy = base_type->tp_destroy;
+#if SUPPORTS(CYCLE_GC)
+        if (tp->tp_flags & SbType_FLAGS_HAVE_GC) {
+            _SbType_EnableGC(tp, base_type->tp_traverse, base_type->tp_clear);
+        }
+#endif
         if (SbDict_Merge(tp->tp_dict, base_type->tp_dict, 0) < 0) {
             goto fail1;
         }
     }
+    _SbType_UpdateFlags(tp);
 
     return tp;
 
@@ -90,9 +100,24 @@ type_destroy(SbTypeObject *tp)
 {
     Sb_XDECREF(tp->tp_base);
     Sb_CLEAR(tp->tp_dict);
+    if (tp->tp_dict_keys) {
+        _SbDictSharedKeys_Release(tp->tp_dict_keys);
+        tp->tp_dict_keys = NULL;
+    }
     SbObject_DefaultDestroy((SbObject *)tp);
 }
 
+void
+_SbType_UpdateFlags(SbTypeObject *tp)
+{
+    if (tp->tp_dict && SbDict_GetItemKey(tp->tp_dict, &key_del)) {
+        tp->tp_flags |= SbType_FLAGS_HAS_FINALIZER;
+    }
+    else {
+        tp->tp_flags &= ~SbType_FLAGS_HAS_FINALIZER;
+    }
+}
+
 int
 SbType_IsSubtype(SbTypeObject *a, SbTypeObject *b)
 {
@@ -108,6 +133,51 @@ SbType_IsSubtype(SbTypeObject *a, SbTypeObject *b)
 
 /* Python accessible methods */
 
+#if SUPPORTS(CYCLE_GC)
+/* Instances of Python-created types that added a dict on top of a native base. */
+
+static SbTypeObject *
+subtype_native_base(SbObject *self, SbTraverseFunc traverse)
+{
+    SbTypeObject *base;
+
+    base = Sb_TYPE(self);
+    while (base->tp_traverse == traverse) {
+        base = base->tp_base;
+    }
+    return base;
+}
+
+static int
+subtype_traverse(SbObject *self, SbVisitFunc visit, void *arg)
+{
+    SbTypeObject *base;
+
+    base = subtype_native_base(self, subtype_traverse);
+    if (base->tp_traverse) {
+        int rv = base->tp_traverse(self, visit, arg);
+        if (rv) {
+            return rv;
+        }
+    }
+    Sb_VISIT(SbObject_DICT(self));
+    return 0;
+}
+
+static int
+subtype_clear(SbObject *self)
+{
+    SbTypeObject *base;
+
+    base = subtype_native_base(self, subtype_traverse);
+    if (base->tp_clear) {
+        base->tp_clear(self);
+    }
+    Sb_CLEAR(SbObject_DICT(self));
+    return 0;
+}
+#endif
+
 SbObject *
 _SbType_New(SbObject *name, SbObject *bases, SbObject *dict)
 {
@@ -154,6 +224,15 @@ _SbType_New(SbObject *name, SbObject *bases, SbObject *dict)
         result->tp_dictoffset = size;
         result->tp_basicsize = size + sizeof(SbObject *);
         result->tp_flags |= SbType_FLAGS_HAS_DICT;
+        /* The instance dict can take part in reference cycles. */
+        _SbType_EnableGC(result, subtype_traverse, subtype_clear);
+    }
+
+    /* Instances of one class mostly have the same attributes. */
+    result->tp_dict_keys = _SbDictSharedKeys_New();
+    if (!result->tp_dict_keys) {
+        Sb_DECREF(result);
+        return NULL;
     }
 
     return (SbObject *)result;
@@ -162,9 +241,10 @@ _SbType_New(SbObject *name, SbObject *bases, SbObject *dict)
 static SbObject *
 type_new(SbObject *cls, SbObject *args, SbObject *kwargs)
 {
+    static SbArgsSpec args_spec = SbArgs_SPEC("O:cls|S:name,T:base,D:dict");
     SbObject *name = NULL, *base = NULL, *dict = NULL;
 
-    if (SbArgs_Parse("O:cls|S:name,T:base,D:dict", args, kwargs, &cls, &name, &base, &dict) < 0) {
+    if (SbArgs_ParseSpec(&args_spec, args, kwargs, &cls, &name, &base, &dict) < 0) {
         return NULL;
     }
     return _SbType_New(name, base, dict);
@@ -189,7 +269,7 @@ type_instantiate(SbTypeObject *type, SbObject *args, SbObject *kwargs)
         return NULL;
     }
 
-    m = SbDict_GetItemString(SbObject_DICT(type), "__new__");
+    m = SbDict_GetItemKey(SbObject_DICT(type), &key_new);
     if (m) {
         o = SbObject_Call(m, new_args, kwargs);
     }
@@ -205,11 +285,11 @@ type_instantiate(SbTypeObject *type, SbObject *args, SbObject *kwargs)
      * then the new instance's `__init__()` method will not be invoked. */
     if (SbType_IsSubtype(Sb_TYPE(o), type)) {
         /* Just don't call `__init__` if it's not there. */
-        m = SbDict_GetItemString(SbObject_DICT(type), "__init__");
+        m = SbDict_GetItemKey(SbObject_DICT(type), &key_init);
         if (m) {
             SbObject *none;
 
-            none = SbObject_CallMethod(o, "__init__", args, kwargs);
+            none = _SbObject_CallMethodKey(o, &key_init, args, kwargs);
             Sb_XDECREF(none);
             if (none == NULL) {
                 Sb_DECREF(o);
@@ -270,6 +350,7 @@ _SbType_BuiltinInit()
 
     SbRT_BZero(tp, size);
     SbObject_INIT(tp, tp);
+    Sb_SET_IMMORTAL(tp);
 
     tp->tp_name = "type";
     tp->tp_basicsize = size;
@@ -22,7 +22,7 @@ typedef enum _SbOpcode {
     UnaryConvert            = 13,
 /**/UnaryInvert             = 15,
 
-    BinaryPower             = 19,
+/**/BinaryPower             = 19,
 /**/BinaryMultiply          = 20,
 /**/BinaryDivide            = 21,
 /**/BinaryModulo            = 22,
@@ -57,7 +57,7 @@ typedef enum _SbOpcode {
 /**/BinaryAnd               = 64,
 /**/BinaryXor               = 65,
 /**/BinaryOr                = 66,
-    InPlacePower            = 67,
+/**/InPlacePower            = 67,
 /**/GetIter                 = 68,
 
     /* Support not planned */
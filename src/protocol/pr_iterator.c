@@ -1,9 +1,12 @@
 #include "snakebed.h"
 
+static SbDictKey key_iter = SbDictKey_INIT("__iter__");
+static SbDictKey key_next = SbDictKey_INIT("next");
+
 SbObject *
 SbObject_GetIter(SbObject *o)
 {
-    return SbObject_CallMethod(o, "__iter__", NULL, NULL);
+    return _SbObject_CallMethodKey(o, &key_iter, NULL, NULL);
 }
 
 SbObject *
@@ -11,7 +14,7 @@ SbIter_Next(SbObject *o)
 {
     SbObject *r;
 
-    r = SbObject_CallMethod(o, "next", NULL, NULL);
+    r = _SbObject_CallMethodKey(o, &key_next, NULL, NULL);
     if (!r && SbExc_ExceptionTypeMatches(SbErr_Occurred(), (SbObject *)SbExc_StopIteration)) {
         SbErr_Clear();
     }
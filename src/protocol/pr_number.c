@@ -86,6 +86,37 @@ SbNumber_Remainder(SbObject * lhs, SbObject *rhs)
     return numeric_try_methods2(lhs, rhs, "__mod__", "__rmod__");
 }
 
+SbObject *
+SbNumber_DivMod(SbObject * lhs, SbObject *rhs)
+{
+    return numeric_try_methods2(lhs, rhs, "__divmod__", "__rdivmod__");
+}
+
+SbObject *
+SbNumber_Power(SbObject * base, SbObject *exp, SbObject *mod)
+{
+    SbObject *result;
+    SbObject *tmp;
+
+    if (!mod || mod == Sb_None) {
+        return numeric_try_methods2(base, exp, "__pow__", "__rpow__");
+    }
+
+    /* The three-argument form is not reflected. */
+    tmp = SbTuple_Pack(2, exp, mod);
+    if (!tmp) {
+        return NULL;
+    }
+    result = SbObject_CallMethod(base, "__pow__", tmp, NULL);
+    Sb_DECREF(tmp);
+    if (result == Sb_NotImplemented) {
+        Sb_DECREF(result);
+        SbErr_RaiseWithString(SbExc_TypeError, "unsupported operand type");
+        return NULL;
+    }
+    return result;
+}
+
 SbObject *
 SbNumber_And(SbObject * lhs, SbObject *rhs)
 {
@@ -1,12 +1,24 @@
 #include "snakebed.h"
 
+/* Names looked up on every call are hashed once. */
+static SbDictKey key_hash = SbDictKey_INIT("__hash__");
+static SbDictKey key_nonzero = SbDictKey_INIT("__nonzero__");
+static SbDictKey key_len = SbDictKey_INIT("__len__");
+static SbDictKey key_str = SbDictKey_INIT("__str__");
+static SbDictKey key_repr = SbDictKey_INIT("__repr__");
+static SbDictKey key_getattribute = SbDictKey_INIT("__getattribute__");
+static SbDictKey key_getattr = SbDictKey_INIT("__getattr__");
+static SbDictKey key_setattr = SbDictKey_INIT("__setattr__");
+static SbDictKey key_delattr = SbDictKey_INIT("__delattr__");
+static SbDictKey key_call = SbDictKey_INIT("__call__");
+
 SbInt_Native_t
 SbObject_Hash(SbObject *p)
 {
     SbObject *result;
     SbInt_Native_t hash;
 
-    result = SbObject_CallMethod(p, "__hash__", NULL, NULL);
+    result = _SbObject_CallMethodKey(p, &key_hash, NULL, NULL);
     if (result) {
         hash = SbInt_AsNative(result);
         Sb_DECREF(result);
@@ -30,10 +42,10 @@ SbObject_IsTrue(SbObject *p)
         return 1;
     }
 
-    result = SbObject_CallMethod(p, "__nonzero__", NULL, NULL);
+    result = _SbObject_CallMethodKey(p, &key_nonzero, NULL, NULL);
     if (!result && SbExc_ExceptionTypeMatches(SbErr_Occurred(), (SbObject *)SbExc_AttributeError)) {
         SbErr_Clear();
-        result = SbObject_CallMethod(p, "__len__", NULL, NULL);
+        result = _SbObject_CallMethodKey(p, &key_len, NULL, NULL);
         if (!result && SbExc_ExceptionTypeMatches(SbErr_Occurred(), (SbObject *)SbExc_AttributeError)) {
             SbErr_Clear();
             return 1;
@@ -81,7 +93,7 @@ SbObject_Str(SbObject *p)
 {
     SbObject *result;
 
-    result = SbObject_CallMethod(p, "__str__", NULL, NULL);
+    result = _SbObject_CallMethodKey(p, &key_str, NULL, NULL);
     if (!result && SbExc_ExceptionTypeMatches(SbErr_Occurred(), (SbObject *)SbExc_AttributeError)) {
         SbErr_Clear();
         result = SbObject_Repr(p);
@@ -95,7 +107,7 @@ SbObject_Repr(SbObject *p)
 {
     SbObject *result;
 
-    result = SbObject_CallMethod(p, "__repr__", NULL, NULL);
+    result = _SbObject_CallMethodKey(p, &key_repr, NULL, NULL);
     if (!result && SbExc_ExceptionTypeMatches(SbErr_Occurred(), (SbObject *)SbExc_AttributeError)) {
         SbErr_Clear();
         result = SbObject_DefaultStr(p, NULL, NULL);
@@ -164,13 +176,13 @@ SbObject_CompareBool(SbObject *p1, SbObject *p2, SbObjectCompareOp op)
 /* Lookup a method within the type dictionary.
    Returns: New reference. */
 static SbObject *
-type_method_check(SbObject *p, const char *method_name)
+type_method_check(SbObject *p, SbDictKey *method_key)
 {
     SbObject *attr;
     SbTypeObject *tp;
 
     tp = Sb_TYPE(p);
-    attr = SbDict_GetItemString(tp->tp_dict, method_name);
+    attr = SbDict_GetItemKey(tp->tp_dict, method_key);
     if (attr) {
         if (SbCFunction_Check(attr) || SbPFunction_Check(attr)) {
             return SbMethod_New(tp, attr, p);
@@ -179,17 +191,27 @@ type_method_check(SbObject *p, const char *method_name)
     return NULL;
 }
 
+/* Call a bound attribute hook with the attribute name (and optionally a value) */
+static SbObject *
+call_attr_hook(SbObject *hook, SbObject *name, SbObject *v)
+{
+    if (v) {
+        return SbObject_CallObjArgs(hook, 2, name, v);
+    }
+    return SbObject_CallObjArgs(hook, 1, name);
+}
+
 SbObject *
-SbObject_GetAttrString(SbObject *p, const char *attr_name)
+_SbObject_GetAttr(SbObject *p, SbObject *name)
 {
     SbObject *getattribute;
     SbObject *getattr;
     SbObject *attr;
 
     /* https://docs.python.org/2/reference/datamodel.html#more-attribute-access-for-new-style-classes */
-    getattribute = type_method_check(p, "__getattribute__");
+    getattribute = type_method_check(p, &key_getattribute);
     if (getattribute) {
-        attr = SbObject_CallObjArgs(getattribute, 1, SbStr_FromString(attr_name));
+        attr = call_attr_hook(getattribute, name, NULL);
         Sb_DECREF(getattribute);
         /* Silence AttributeError, if any */
         if (!attr && SbExc_ExceptionTypeMatches(SbErr_Occurred(), (SbObject *)SbExc_AttributeError)) {
@@ -200,7 +222,7 @@ SbObject_GetAttrString(SbObject *p, const char *attr_name)
 
     /* For class object lookups, produce an unbound method object */
     if (Sb_TYPE(p) == SbType_Type) {
-        attr = SbDict_GetItemString(SbObject_DICT(p), attr_name);
+        attr = _SbDict_GetItemStr(SbObject_DICT(p), name);
         if (attr) {
             if (SbCFunction_Check(attr) || SbPFunction_Check(attr)) {
                 attr = SbMethod_New((SbTypeObject *)p, attr, NULL);
@@ -210,7 +232,7 @@ SbObject_GetAttrString(SbObject *p, const char *attr_name)
     }
 
     /* Note: inlined type_method_check to avoid double lookup */
-    attr = SbDict_GetItemString(Sb_TYPE(p)->tp_dict, attr_name);
+    attr = _SbDict_GetItemStr(Sb_TYPE(p)->tp_dict, name);
     if (attr) {
         if (SbCFunction_Check(attr) || SbPFunction_Check(attr)) {
             attr = SbMethod_New(Sb_TYPE(p), attr, p);
@@ -224,9 +246,9 @@ SbObject_GetAttrString(SbObject *p, const char *attr_name)
     /* https://docs.python.org/2/reference/datamodel.html#customizing-attribute-access */
     /* Note that if the attribute is found through the normal mechanism, 
        __getattr__() is not called. */
-    getattr = type_method_check(p, "__getattr__");
+    getattr = type_method_check(p, &key_getattr);
     if (getattr) {
-        attr = SbObject_CallObjArgs(getattr, 1, SbStr_FromString(attr_name));
+        attr = call_attr_hook(getattr, name, NULL);
         Sb_DECREF(getattr);
         /* Silence AttributeError, if any */
         if (!attr && SbExc_ExceptionTypeMatches(SbErr_Occurred(), (SbObject *)SbExc_AttributeError)) {
@@ -239,45 +261,91 @@ SbObject_GetAttrString(SbObject *p, const char *attr_name)
     return NULL;
 }
 
+SbObject *
+SbObject_GetAttrString(SbObject *p, const char *attr_name)
+{
+    SbObject *name;
+    SbObject *attr;
+
+    name = SbStr_FromString(attr_name);
+    if (!name) {
+        return NULL;
+    }
+    attr = _SbObject_GetAttr(p, name);
+    Sb_DECREF(name);
+    return attr;
+}
+
 int
-SbObject_SetAttrString(SbObject *p, const char *attr_name, SbObject *v)
+_SbObject_SetAttr(SbObject *p, SbObject *name, SbObject *v)
 {
     SbObject *setattr;
 
     /* Look for a descriptor in type hierarchy first? */
-    setattr = type_method_check(p, "__setattr__");
+    setattr = type_method_check(p, &key_setattr);
     if (setattr) {
         SbObject *result;
 
-        Sb_INCREF(v);
-        result = SbObject_CallObjArgs(setattr, 2, SbStr_FromString(attr_name), v);
+        result = call_attr_hook(setattr, name, v);
+        Sb_DECREF(setattr);
         Sb_XDECREF(result);
         return result ? 0 : -1;
     }
 
-    SbErr_RaiseWithString(SbExc_AttributeError, attr_name);
+    SbErr_RaiseWithObject(SbExc_AttributeError, name);
     return -1;
 }
 
 int
-SbObject_DelAttrString(SbObject *p, const char *attr_name)
+SbObject_SetAttrString(SbObject *p, const char *attr_name, SbObject *v)
+{
+    SbObject *name;
+    int result;
+
+    name = SbStr_FromString(attr_name);
+    if (!name) {
+        return -1;
+    }
+    result = _SbObject_SetAttr(p, name, v);
+    Sb_DECREF(name);
+    return result;
+}
+
+int
+_SbObject_DelAttr(SbObject *p, SbObject *name)
 {
     SbObject *delattr;
 
     /* Look for a descriptor in type hierarchy first? */
-    delattr = type_method_check(p, "__delattr__");
+    delattr = type_method_check(p, &key_delattr);
     if (delattr) {
         SbObject *result;
 
-        result = SbObject_CallObjArgs(delattr, 1, SbStr_FromString(attr_name));
+        result = call_attr_hook(delattr, name, NULL);
+        Sb_DECREF(delattr);
         Sb_XDECREF(result);
         return result ? 0 : -1;
     }
 
-    SbErr_RaiseWithString(SbExc_AttributeError, attr_name);
+    SbErr_RaiseWithObject(SbExc_AttributeError, name);
     return -1;
 }
 
+int
+SbObject_DelAttrString(SbObject *p, const char *attr_name)
+{
+    SbObject *name;
+    int result;
+
+    name = SbStr_FromString(attr_name);
+    if (!name) {
+        return -1;
+    }
+    result = _SbObject_DelAttr(p, name);
+    Sb_DECREF(name);
+    return result;
+}
+
 /* Callable interface */
 
 SbObject *
@@ -295,7 +363,7 @@ SbObject_Call(SbObject *callable, SbObject *args, SbObject *kwargs)
     if (SbMethod_Check(callable)) {
         return SbMethod_Call(callable, args, kwargs);
     }
-    m_call = type_method_check(callable, "__call__");
+    m_call = type_method_check(callable, &key_call);
     if (m_call) {
         SbObject *result;
         result = SbObject_Call(m_call, args, kwargs);
@@ -328,15 +396,14 @@ SbObject_CallObjArgs(SbObject *callable, Sb_ssize_t count, ...)
 }
 
 SbObject *
-SbObject_CallMethod(SbObject *o, const char *method, SbObject *args, SbObject *kwargs)
+_SbObject_CallMethodKey(SbObject *o, SbDictKey *method_key, SbObject *args, SbObject *kwargs)
 {
     SbObject *m;
     SbObject *result;
 
-    /* m = SbObject_GetAttrString(o, method); */
-    m = type_method_check(o, method);
+    m = type_method_check(o, method_key);
     if (!m) {
-        SbErr_RaiseWithString(SbExc_AttributeError, method);
+        SbErr_RaiseWithString(SbExc_AttributeError, method_key->text);
         return NULL;
     }
 
@@ -345,6 +412,17 @@ SbObject_CallMethod(SbObject *o, const char *method, SbObject *args, SbObject *k
     return result;
 }
 
+SbObject *
+SbObject_CallMethod(SbObject *o, const char *method, SbObject *args, SbObject *kwargs)
+{
+    SbDictKey method_key;
+
+    method_key.text = method;
+    method_key.length = SbRT_StrLen(method);
+    method_key.hash = -1;
+    return _SbObject_CallMethodKey(o, &method_key, args, kwargs);
+}
+
 SbObject *
 SbObject_CallMethodObjArgs(SbObject *o, const char *method, Sb_ssize_t count, ...)
 {
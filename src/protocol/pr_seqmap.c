@@ -1,11 +1,13 @@
 #include "snakebed.h"
 
+static SbDictKey key_len = SbDictKey_INIT("__len__");
+
 Sb_ssize_t
 SbObject_GetSize(SbObject *o)
 {
     SbObject *result;
 
-    result = SbObject_CallMethod(o, "__len__", NULL, NULL);
+    result = _SbObject_CallMethodKey(o, &key_len, NULL, NULL);
     if (result && SbInt_CheckExact(result)) {
         return SbInt_AsNative(result);
     }
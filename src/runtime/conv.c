@@ -3,6 +3,47 @@
 /* Space for converting a 64-bit with radix 2 */
 static char xtoa_buffer[68];
 
+/* Two decimal digits per entry; halves the divisions in decimal conversion. */
+static const char decimal_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+char *
+Sb_FormatDecimal(char *end, Sb_size_t x, int min_digits)
+{
+    char *q;
+
+    q = end;
+    while (x >= 100) {
+        unsigned pair;
+
+        pair = (unsigned)(x % 100) * 2;
+        x /= 100;
+        *--q = decimal_pairs[pair + 1];
+        *--q = decimal_pairs[pair];
+    }
+    if (x >= 10) {
+        *--q = decimal_pairs[x * 2 + 1];
+        *--q = decimal_pairs[x * 2];
+    }
+    else if (x || q == end) {
+        *--q = (char)('0' + x);
+    }
+    while (end - q < min_digits) {
+        *--q = '0';
+    }
+
+    return q;
+}
+
 char *
 Sb_ULtoA(unsigned long x, unsigned radix)
 {
@@ -11,7 +52,10 @@ Sb_ULtoA(unsigned long x, unsigned radix)
     /* NOTE: the implementation is not thread safe, but who cares. */
 
     q = &xtoa_buffer[sizeof(xtoa_buffer) - 1];
-    while (x) {
+    if (radix == 10) {
+        return Sb_FormatDecimal(q, x, 1);
+    }
+    do {
         unsigned long quot, rem;
 
         quot = x / radix;
@@ -19,7 +63,7 @@ Sb_ULtoA(unsigned long x, unsigned radix)
         x = quot;
 
         *--q = (char)(rem > 9 ? ('a' + rem - 10) : ('0' + rem));
-    }
+    } while (x);
 
     return q;
 }
@@ -29,11 +73,11 @@ Sb_LtoA(long x, int radix)
 {
     char *q;
 
-    /* NOTE: the implementation has issues with converting 0x80000000 */
     /* NOTE: the implementation is not thread safe, but who cares. */
 
     if (x < 0) {
-        q = Sb_ULtoA(-x, radix);
+        /* Negate as unsigned: the most negative value has no positive counterpart. */
+        q = Sb_ULtoA(0UL - (unsigned long)x, radix);
         *--q = '-';
         return q;
     }
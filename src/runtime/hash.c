@@ -0,0 +1,144 @@
+#include "runtime.h"
+
+/* SipHash-1-3 (Aumasson & Bernstein): one compression round per 8-byte
+   word and three finalization rounds, under a 128-bit key. Without the key,
+   nobody can pick strings that collide, which keeps dicts with untrusted
+   keys from degrading into linear scans. */
+
+#if defined(__GNUC__)
+#define HASH_LOAD64(p, w) __builtin_memcpy(&(w), (p), 8)
+#else
+/* Both x86 flavours read unaligned words. */
+#define HASH_LOAD64(p, w) ((w) = *(const Sb_ulong64_t *)(p))
+#endif
+
+#define HASH_ROTL(x, b) (((x) << (b)) | ((x) >> (64 - (b))))
+
+#define SIPROUND \
+    do { \
+        v0 += v1; v1 = HASH_ROTL(v1, 13); v1 ^= v0; v0 = HASH_ROTL(v0, 32); \
+        v2 += v3; v3 = HASH_ROTL(v3, 16); v3 ^= v2; \
+        v0 += v3; v3 = HASH_ROTL(v3, 21); v3 ^= v0; \
+        v2 += v1; v1 = HASH_ROTL(v1, 17); v1 ^= v2; v2 = HASH_ROTL(v2, 32); \
+    } while (0)
+
+/* The process-wide key; until SbRT_InitHashKey() runs, it is all zeros. */
+static Sb_ulong64_t hash_key[2];
+/* -1 until the key is picked, then what SbRT_InitHashKey() returned. */
+static int hash_key_source = -1;
+
+Sb_ulong64_t
+SbRT_SipHash13(Sb_ulong64_t k0, Sb_ulong64_t k1, const void *p, Sb_size_t len)
+{
+    const Sb_byte_t *s = (const Sb_byte_t *)p;
+    const Sb_byte_t *end;
+    Sb_ulong64_t v0, v1, v2, v3;
+    Sb_ulong64_t m, b;
+
+    v0 = k0 ^ 0x736f6d6570736575ULL;
+    v1 = k1 ^ 0x646f72616e646f6dULL;
+    v2 = k0 ^ 0x6c7967656e657261ULL;
+    v3 = k1 ^ 0x7465646279746573ULL;
+
+    end = s + (len & ~(Sb_size_t)7);
+    while (s != end) {
+        HASH_LOAD64(s, m);
+        v3 ^= m;
+        SIPROUND;
+        v0 ^= m;
+        s += 8;
+    }
+
+    /* The last 0 to 7 bytes, with the length in the top byte */
+    b = (Sb_ulong64_t)len << 56;
+    switch (len & 7) {
+    case 7: b |= (Sb_ulong64_t)s[6] << 48;
+    case 6: b |= (Sb_ulong64_t)s[5] << 40;
+    case 5: b |= (Sb_ulong64_t)s[4] << 32;
+    case 4: b |= (Sb_ulong64_t)s[3] << 24;
+    case 3: b |= (Sb_ulong64_t)s[2] << 16;
+    case 2: b |= (Sb_ulong64_t)s[1] << 8;
+    case 1: b |= (Sb_ulong64_t)s[0];
+    case 0: break;
+    }
+    v3 ^= b;
+    SIPROUND;
+    v0 ^= b;
+
+    v2 ^= 0xFF;
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+Sb_ulong64_t
+SbRT_HashBytes(const void *p, Sb_size_t len)
+{
+    return SbRT_SipHash13(hash_key[0], hash_key[1], p, len);
+}
+
+/* SplitMix64: spreads a small seed over a full 64-bit word. */
+static Sb_ulong64_t
+hash_mix_seed(Sb_ulong64_t *state)
+{
+    Sb_ulong64_t z;
+
+    z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* Parse a decimal seed that fits in 64 bits; anything else is not one.
+   Returns: 0 if OK, -1 otherwise. */
+static int
+hash_parse_seed(const char *text, Sb_ulong64_t *seed)
+{
+    Sb_ulong64_t value = 0;
+
+    if (!*text) {
+        return -1;
+    }
+    for (; *text; ++text) {
+        if (*text < '0' || *text > '9' || value > (~(Sb_ulong64_t)0 - 9) / 10) {
+            return -1;
+        }
+        value = value * 10 + (*text - '0');
+    }
+    *seed = value;
+    return 0;
+}
+
+int
+SbRT_InitHashKey(void)
+{
+    const char *text;
+    Sb_ulong64_t state;
+
+    /* Hashes cached in static keys must stay valid across reinitialization. */
+    if (hash_key_source >= 0) {
+        return hash_key_source;
+    }
+
+    text = Sb_GetEnv(SbRT_HASHSEED_ENV);
+    if (text && *text) {
+        /* The seed is there for reproducible runs; a typo must not quietly pick a random key. */
+        if (hash_parse_seed(text, &state) < 0) {
+            return -1;
+        }
+        hash_key[0] = hash_mix_seed(&state);
+        hash_key[1] = hash_mix_seed(&state);
+        hash_key_source = 1;
+        return 1;
+    }
+
+    if (Sb_GetRandomBytes(hash_key, sizeof(hash_key)) < 0) {
+        /* No entropy source: still better than a fixed key. */
+        state = Sb_GetTimeMicroseconds() ^ (Sb_ulong64_t)(Sb_size_t)&state;
+        hash_key[0] = hash_mix_seed(&state);
+        hash_key[1] = hash_mix_seed(&state);
+    }
+    hash_key_source = 0;
+    return 0;
+}
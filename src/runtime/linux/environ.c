@@ -0,0 +1,30 @@
+#include "runtime.h"
+#include <stdlib.h>
+#include <errno.h>
+#include <sys/random.h>
+
+const char *
+Sb_GetEnv(const char *name)
+{
+    return getenv(name);
+}
+
+int
+Sb_GetRandomBytes(void *buffer, Sb_size_t count)
+{
+    Sb_byte_t *p = (Sb_byte_t *)buffer;
+    ssize_t result;
+
+    while (count > 0) {
+        result = getrandom(p, count, 0);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        p += result;
+        count -= result;
+    }
+    return 0;
+}
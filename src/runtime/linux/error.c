@@ -0,0 +1,8 @@
+#include "runtime.h"
+#include <string.h>
+
+const char *
+Sb_StrError(OSError_t error_code)
+{
+    return strerror((int)error_code);
+}
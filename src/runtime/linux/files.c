@@ -0,0 +1,148 @@
+#include "runtime.h"
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <errno.h>
+
+/* Handles carry the descriptor; offset by one so that fd 0 is not NULL. */
+#define FD_TO_HANDLE(fd) ((OSFileHandle_t)(intptr_t)((fd) + 1))
+#define HANDLE_TO_FD(h) ((int)(intptr_t)(h) - 1)
+
+OSError_t
+Sb_FileOpen(const char *path, const char *mode, OSFileHandle_t *handle)
+{
+    int flags = O_RDONLY;
+    int fd;
+
+    if (mode[0] == 'w') {
+        flags = O_RDWR | O_CREAT;
+    }
+
+    fd = open(path, flags, 0666);
+    if (fd < 0) {
+        return (OSError_t)errno;
+    }
+
+    *handle = FD_TO_HANDLE(fd);
+    return OS_NO_ERROR;
+}
+
+OSError_t
+Sb_FileRead(OSFileHandle_t handle, void *buffer, Sb_ssize_t count, Sb_ssize_t *read_count)
+{
+    ssize_t transferred;
+
+    do {
+        transferred = read(HANDLE_TO_FD(handle), buffer, count);
+    } while (transferred < 0 && errno == EINTR);
+    if (transferred < 0) {
+        return (OSError_t)errno;
+    }
+    if (read_count) {
+        *read_count = transferred;
+    }
+    return OS_NO_ERROR;
+}
+
+OSError_t
+Sb_FileWrite(OSFileHandle_t handle, const void *buffer, Sb_ssize_t count, Sb_ssize_t *written)
+{
+    ssize_t transferred;
+
+    do {
+        transferred = write(HANDLE_TO_FD(handle), buffer, count);
+    } while (transferred < 0 && errno == EINTR);
+    if (transferred < 0) {
+        return (OSError_t)errno;
+    }
+    if (written) {
+        *written = transferred;
+    }
+    return OS_NO_ERROR;
+}
+
+OSError_t
+Sb_FileTell(OSFileHandle_t handle, Sb_ssize_t *offset)
+{
+    return Sb_FileSeek(handle, 0, SEEK_CUR, offset);
+}
+
+OSError_t
+Sb_FileSeek(OSFileHandle_t handle, Sb_ssize_t offset, int whence, Sb_ssize_t *new_pos)
+{
+    off_t pos;
+
+    pos = lseek(HANDLE_TO_FD(handle), (off_t)offset, whence);
+    if (pos < 0) {
+        return (OSError_t)errno;
+    }
+
+    if (new_pos) {
+        *new_pos = (Sb_ssize_t)pos;
+    }
+    return OS_NO_ERROR;
+}
+
+void
+Sb_FileClose(OSFileHandle_t handle)
+{
+    close(HANDLE_TO_FD(handle));
+}
+
+OSError_t
+Sb_DirOpen(const char *path, OSDirHandle_t *handle)
+{
+    DIR *dir;
+
+    dir = opendir(path[0] ? path : ".");
+    if (!dir) {
+        return (OSError_t)errno;
+    }
+
+    *handle = (OSDirHandle_t)dir;
+    return OS_NO_ERROR;
+}
+
+OSError_t
+Sb_DirRead(OSDirHandle_t handle, const char **name)
+{
+    struct dirent *entry;
+
+    errno = 0;
+    entry = readdir((DIR *)handle);
+    if (!entry) {
+        if (errno) {
+            return (OSError_t)errno;
+        }
+        *name = NULL;
+        return OS_NO_ERROR;
+    }
+
+    *name = entry->d_name;
+    return OS_NO_ERROR;
+}
+
+void
+Sb_DirClose(OSDirHandle_t handle)
+{
+    closedir((DIR *)handle);
+}
+
+OSFileHandle_t
+Sb_GetStdInHandle(void)
+{
+    return FD_TO_HANDLE(dup(STDIN_FILENO));
+}
+
+OSFileHandle_t
+Sb_GetStdOutHandle(void)
+{
+    return FD_TO_HANDLE(dup(STDOUT_FILENO));
+}
+
+OSFileHandle_t
+Sb_GetStdErrHandle(void)
+{
+    return FD_TO_HANDLE(dup(STDERR_FILENO));
+}
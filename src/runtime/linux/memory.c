@@ -0,0 +1,27 @@
+#include "runtime.h"
+#include <sys/mman.h>
+
+void *
+Sb_AllocArena(Sb_size_t size)
+{
+    char *base;
+    char *aligned;
+
+    /* mmap() only guarantees page alignment: over-reserve and trim both ends. */
+    base = (char *)mmap(NULL, size * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == (char *)MAP_FAILED) {
+        return NULL;
+    }
+    aligned = (char *)(((Sb_size_t)base + size - 1) & ~(size - 1));
+    if (aligned > base) {
+        munmap(base, aligned - base);
+    }
+    munmap(aligned + size, base + size - aligned);
+    return aligned;
+}
+
+void
+Sb_FreeArena(void *ptr, Sb_size_t size)
+{
+    munmap(ptr, size);
+}
@@ -0,0 +1,11 @@
+#include "runtime.h"
+#include <time.h>
+
+Sb_ulong64_t
+Sb_GetTimeMicroseconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (Sb_ulong64_t)ts.tv_sec * 1000000 + (Sb_ulong64_t)ts.tv_nsec / 1000;
+}
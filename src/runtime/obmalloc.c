@@ -0,0 +1,468 @@
+#include "supports.h"
+#include "runtime.h"
+
+#if SUPPORTS(SMALL_OBJECT_ALLOCATOR)
+
+/*
+ * A size-class allocator for small objects.
+ *
+ * Requests up to SMALL_REQUEST_THRESHOLD bytes are rounded up to a multiple
+ * of ALIGNMENT and served from pools; each pool is a POOL_SIZE page carved
+ * into blocks of one size class. Pools come from arenas, which are obtained
+ * from the OS aligned on ARENA_SIZE, so the arena owning a block is found
+ * by masking the block address. Arenas with no used pools are given back.
+ *
+ * Larger requests, and blocks not owned by any arena, go to Sb_Malloc/Sb_Free.
+ */
+
+#define ALIGNMENT               8
+#define ALIGNMENT_SHIFT         3
+#define SMALL_REQUEST_THRESHOLD 256
+#define NB_SIZE_CLASSES         (SMALL_REQUEST_THRESHOLD / ALIGNMENT)
+
+#define INDEX2SIZE(i)   (((Sb_size_t)(i) + 1) << ALIGNMENT_SHIFT)
+#define SIZE2INDEX(n)   (((n) - 1) >> ALIGNMENT_SHIFT)
+
+#define POOL_SIZE       4096
+#define POOL_MASK       ((Sb_size_t)POOL_SIZE - 1)
+
+#define ARENA_SHIFT     16
+#define ARENA_SIZE      ((Sb_size_t)1 << ARENA_SHIFT)
+#define ARENA_MASK      (ARENA_SIZE - 1)
+#define POOLS_PER_ARENA (ARENA_SIZE / POOL_SIZE)
+
+struct _arena_object;
+
+typedef struct _pool_header {
+    /* Blocks handed out from this pool */
+    unsigned ref_count;
+    /* Size class index */
+    unsigned size_index;
+    /* Offset of the first never used block */
+    unsigned next_offset;
+    /* Offset past which no block fits */
+    unsigned max_next_offset;
+    /* Chain of freed blocks */
+    Sb_byte_t *freeblock;
+    /* Links in the used pools list, or the arena free pools list */
+    struct _pool_header *nextpool;
+    struct _pool_header *prevpool;
+    struct _arena_object *arena;
+} pool_header;
+
+#define POOL_OVERHEAD \
+    ((unsigned)((sizeof(pool_header) + ALIGNMENT - 1) & ~(Sb_size_t)(ALIGNMENT - 1)))
+
+#define POOL_ADDR(p) \
+    ((pool_header *)((Sb_size_t)(p) & ~POOL_MASK))
+
+#define POOL_IS_FULL(pool) \
+    (!(pool)->freeblock && (pool)->next_offset > (pool)->max_next_offset)
+
+typedef struct _arena_object {
+    Sb_byte_t *address;
+    /* Pools not holding any blocks */
+    pool_header *freepools;
+    unsigned nfreepools;
+    /* Links in the usable arenas list */
+    struct _arena_object *nextarena;
+    struct _arena_object *prevarena;
+} arena_object;
+
+/* Pools with at least one free block, per size class */
+static pool_header *usedpools[NB_SIZE_CLASSES];
+
+/* Arenas with at least one free pool, other than the spare one */
+static arena_object *usable_arenas;
+/* One emptied arena is kept back to avoid thrashing the OS */
+static arena_object *spare_arena;
+
+/* Open addressing map from arena addresses to arena objects */
+static arena_object **arena_map;
+static Sb_size_t arena_map_size;
+static Sb_size_t arena_map_fill;
+
+/* Marks a deleted map slot */
+#define ARENA_DUMMY ((arena_object *)1)
+
+static SbRT_ObjAllocStats stats;
+
+static Sb_size_t
+arena_map_slot(arena_object **map, Sb_size_t size, Sb_byte_t *address)
+{
+    Sb_size_t key = (Sb_size_t)address >> ARENA_SHIFT;
+    Sb_size_t mask = size - 1;
+    Sb_size_t i;
+
+    i = (key * 2654435761U) & mask;
+    for (;;) {
+        arena_object *ao = map[i];
+        if (!ao || (ao != ARENA_DUMMY && ao->address == address)) {
+            return i;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+static arena_object *
+arena_map_lookup(const void *p)
+{
+    Sb_byte_t *address;
+    Sb_size_t key;
+    Sb_size_t mask;
+    Sb_size_t i;
+
+    if (!arena_map) {
+        return NULL;
+    }
+    address = (Sb_byte_t *)((Sb_size_t)p & ~ARENA_MASK);
+    key = (Sb_size_t)address >> ARENA_SHIFT;
+    mask = arena_map_size - 1;
+    i = (key * 2654435761U) & mask;
+    for (;;) {
+        arena_object *ao = arena_map[i];
+        if (!ao) {
+            return NULL;
+        }
+        if (ao != ARENA_DUMMY && ao->address == address) {
+            return ao;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+static int
+arena_map_insert(arena_object *arena)
+{
+    Sb_size_t i;
+
+    /* Keep at least half of the slots empty, rebuilding on the way. */
+    if ((arena_map_fill + 1) * 2 > arena_map_size) {
+        arena_object **new_map;
+        Sb_size_t new_size;
+
+        new_size = arena_map_size ? arena_map_size : 16;
+        while ((stats.arenas + 1) * 4 > new_size) {
+            new_size <<= 1;
+        }
+        new_map = (arena_object **)Sb_Calloc(new_size, sizeof(arena_object *));
+        if (!new_map) {
+            return -1;
+        }
+        arena_map_fill = 0;
+        for (i = 0; i < arena_map_size; ++i) {
+            arena_object *ao = arena_map[i];
+            if (ao && ao != ARENA_DUMMY) {
+                new_map[arena_map_slot(new_map, new_size, ao->address)] = ao;
+                ++arena_map_fill;
+            }
+        }
+        Sb_Free(arena_map);
+        arena_map = new_map;
+        arena_map_size = new_size;
+    }
+
+    i = arena_map_slot(arena_map, arena_map_size, arena->address);
+    arena_map[i] = arena;
+    ++arena_map_fill;
+    return 0;
+}
+
+static void
+arena_map_remove(arena_object *arena)
+{
+    Sb_size_t i;
+
+    i = arena_map_slot(arena_map, arena_map_size, arena->address);
+    /* The slot is still counted as filled until the next rebuild. */
+    arena_map[i] = ARENA_DUMMY;
+}
+
+static void
+arena_link(arena_object *arena)
+{
+    arena->prevarena = NULL;
+    arena->nextarena = usable_arenas;
+    if (usable_arenas) {
+        usable_arenas->prevarena = arena;
+    }
+    usable_arenas = arena;
+}
+
+static arena_object *
+arena_new(void)
+{
+    arena_object *arena;
+    Sb_byte_t *p;
+    unsigned i;
+
+    arena = (arena_object *)Sb_Malloc(sizeof(arena_object));
+    if (!arena) {
+        goto fail0;
+    }
+    arena->address = (Sb_byte_t *)Sb_AllocArena(ARENA_SIZE);
+    if (!arena->address) {
+        goto fail1;
+    }
+    if (arena_map_insert(arena) < 0) {
+        goto fail2;
+    }
+
+    /* Chain all the pools; pool headers are only written when pools get used. */
+    arena->freepools = NULL;
+    p = arena->address + ARENA_SIZE;
+    for (i = 0; i < POOLS_PER_ARENA; ++i) {
+        pool_header *pool;
+
+        p -= POOL_SIZE;
+        pool = (pool_header *)p;
+        pool->nextpool = arena->freepools;
+        pool->arena = arena;
+        arena->freepools = pool;
+    }
+    arena->nfreepools = POOLS_PER_ARENA;
+    arena_link(arena);
+
+    ++stats.arenas;
+    ++stats.arenas_allocated;
+    return arena;
+
+fail2:
+    Sb_FreeArena(arena->address, ARENA_SIZE);
+fail1:
+    Sb_Free(arena);
+fail0:
+    return NULL;
+}
+
+static void
+arena_unlink(arena_object *arena)
+{
+    if (arena->prevarena) {
+        arena->prevarena->nextarena = arena->nextarena;
+    }
+    else {
+        usable_arenas = arena->nextarena;
+    }
+    if (arena->nextarena) {
+        arena->nextarena->prevarena = arena->prevarena;
+    }
+}
+
+static void
+arena_release(arena_object *arena)
+{
+    arena_map_remove(arena);
+    Sb_FreeArena(arena->address, ARENA_SIZE);
+    Sb_Free(arena);
+
+    --stats.arenas;
+    ++stats.arenas_released;
+}
+
+static pool_header *
+pool_new(unsigned size_index)
+{
+    arena_object *arena;
+    pool_header *pool;
+
+    arena = usable_arenas;
+    if (!arena) {
+        arena = spare_arena;
+        if (arena) {
+            spare_arena = NULL;
+            arena_link(arena);
+        }
+        else {
+            arena = arena_new();
+            if (!arena) {
+                return NULL;
+            }
+        }
+    }
+
+    pool = arena->freepools;
+    arena->freepools = pool->nextpool;
+    if (--arena->nfreepools == 0) {
+        arena_unlink(arena);
+    }
+
+    pool->ref_count = 0;
+    pool->size_index = size_index;
+    pool->next_offset = POOL_OVERHEAD;
+    pool->max_next_offset = POOL_SIZE - (unsigned)INDEX2SIZE(size_index);
+    pool->freeblock = NULL;
+
+    pool->prevpool = NULL;
+    pool->nextpool = NULL;
+    usedpools[size_index] = pool;
+
+    ++stats.pools;
+    return pool;
+}
+
+static void
+pool_unlink(pool_header *pool)
+{
+    if (pool->prevpool) {
+        pool->prevpool->nextpool = pool->nextpool;
+    }
+    else {
+        usedpools[pool->size_index] = pool->nextpool;
+    }
+    if (pool->nextpool) {
+        pool->nextpool->prevpool = pool->prevpool;
+    }
+}
+
+static void
+pool_link(pool_header *pool)
+{
+    pool_header *head;
+
+    head = usedpools[pool->size_index];
+    pool->prevpool = NULL;
+    pool->nextpool = head;
+    if (head) {
+        head->prevpool = pool;
+    }
+    usedpools[pool->size_index] = pool;
+}
+
+static void
+pool_release(pool_header *pool)
+{
+    arena_object *arena;
+
+    arena = pool->arena;
+    pool->nextpool = arena->freepools;
+    arena->freepools = pool;
+    ++arena->nfreepools;
+    --stats.pools;
+
+    if (arena->nfreepools == 1) {
+        /* Was full, became usable again */
+        arena_link(arena);
+    }
+    if (arena->nfreepools == POOLS_PER_ARENA) {
+        arena_unlink(arena);
+        if (spare_arena) {
+            arena_release(spare_arena);
+        }
+        spare_arena = arena;
+    }
+}
+
+void *
+SbRT_ObjMalloc(Sb_size_t size)
+{
+    unsigned size_index;
+    pool_header *pool;
+    Sb_byte_t *block;
+
+    if (size - 1 >= SMALL_REQUEST_THRESHOLD) {
+        /* Handles zero-sized requests as well */
+        return Sb_Malloc(size ? size : 1);
+    }
+
+    size_index = (unsigned)SIZE2INDEX(size);
+    pool = usedpools[size_index];
+    if (!pool) {
+        pool = pool_new(size_index);
+        if (!pool) {
+            return NULL;
+        }
+    }
+
+    block = pool->freeblock;
+    if (block) {
+        pool->freeblock = *(Sb_byte_t **)block;
+    }
+    else {
+        block = (Sb_byte_t *)pool + pool->next_offset;
+        pool->next_offset += (unsigned)INDEX2SIZE(size_index);
+    }
+    ++pool->ref_count;
+    if (POOL_IS_FULL(pool)) {
+        pool_unlink(pool);
+    }
+
+#if SUPPORTS(ALLOC_STATISTICS)
+    ++stats.blocks;
+    stats.block_bytes += INDEX2SIZE(size_index);
+#endif
+    return block;
+}
+
+void
+SbRT_ObjFree(void *p)
+{
+    pool_header *pool;
+    int was_full;
+
+    if (!p) {
+        return;
+    }
+    if (!arena_map_lookup(p)) {
+        Sb_Free(p);
+        return;
+    }
+
+    pool = POOL_ADDR(p);
+    was_full = POOL_IS_FULL(pool);
+    *(Sb_byte_t **)p = pool->freeblock;
+    pool->freeblock = (Sb_byte_t *)p;
+#if SUPPORTS(ALLOC_STATISTICS)
+    --stats.blocks;
+    stats.block_bytes -= INDEX2SIZE(pool->size_index);
+#endif
+
+    if (--pool->ref_count == 0) {
+        if (!was_full) {
+            pool_unlink(pool);
+        }
+        pool_release(pool);
+    }
+    else if (was_full) {
+        pool_link(pool);
+    }
+}
+
+void *
+SbRT_ObjRealloc(void *p, Sb_size_t new_size)
+{
+    Sb_size_t old_size;
+    void *q;
+
+    if (!p) {
+        return SbRT_ObjMalloc(new_size);
+    }
+    if (!arena_map_lookup(p)) {
+        if (new_size == 0) {
+            new_size = 1;
+        }
+        return Sb_Realloc(p, new_size);
+    }
+
+    old_size = INDEX2SIZE(POOL_ADDR(p)->size_index);
+    /* Stay in place when shrinking by no more than a quarter. */
+    if (new_size <= old_size && new_size * 4 > old_size * 3) {
+        return p;
+    }
+    q = SbRT_ObjMalloc(new_size);
+    if (!q) {
+        return NULL;
+    }
+    SbRT_MemCpy(q, p, new_size < old_size ? new_size : old_size);
+    SbRT_ObjFree(p);
+    return q;
+}
+
+void
+SbRT_ObjAllocGetStats(SbRT_ObjAllocStats *out)
+{
+    *out = stats;
+    out->pool_bytes = stats.pools * POOL_SIZE;
+}
+
+#endif /* SUPPORTS(SMALL_OBJECT_ALLOCATOR) */
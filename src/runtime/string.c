@@ -1,77 +1,140 @@
 #include "runtime.h"
 
-void
-SbRT_BZero(void *ptr, Sb_size_t size)
+/* Buffer routines work a machine word at a time; where the CPU has vector
+   units, SbRT_SelectStringRoutines() swaps in versions that use them. */
+
+typedef Sb_size_t rt_word_t;
+
+#define RT_WORD_SIZE sizeof(rt_word_t)
+#define RT_WORD_MASK (RT_WORD_SIZE - 1)
+/* 0x0101...01 and 0x8080...80 */
+#define RT_ONES ((rt_word_t)-1 / 0xFF)
+#define RT_HIGHS (RT_ONES << 7)
+/* Nonzero if and only if some byte of `w` is zero. */
+#define RT_HAS_ZERO(w) (((w) - RT_ONES) & ~(w) & RT_HIGHS)
+
+/* Patterns up to this long are found by the per-level search routine;
+   longer ones go to Two-Way, which never needs more than 2N comparisons. */
+#define RT_SHORT_PATTERN 32
+
+#if defined(__GNUC__)
+/* These compile to single moves, but stay defined for unaligned or type-punned accesses. */
+#define RT_LOAD(w, p) __builtin_memcpy(&(w), (p), RT_WORD_SIZE)
+#define RT_STORE(p, w) __builtin_memcpy((p), &(w), RT_WORD_SIZE)
+/* Word reads may run past the terminator, though never across a page. */
+#define RT_NO_SANITIZE __attribute__((no_sanitize_address))
+#else
+#define RT_LOAD(w, p) ((w) = *(const rt_word_t *)(p))
+#define RT_STORE(p, w) (*(rt_word_t *)(p) = (w))
+#define RT_NO_SANITIZE
+#endif
+
+static void
+rt_copy_word(void *dst, const void *src, Sb_size_t count)
 {
-    char *p = (char *)ptr;
-    while (size--) {
-        *p++ = 0;
+    Sb_byte_t *d = (Sb_byte_t *)dst;
+    const Sb_byte_t *s = (const Sb_byte_t *)src;
+    rt_word_t w;
+
+    if (count >= 2 * RT_WORD_SIZE) {
+        /* Align the destination; the source is read unaligned if need be. */
+        while ((Sb_size_t)d & RT_WORD_MASK) {
+            *d++ = *s++;
+            --count;
+        }
+        while (count >= RT_WORD_SIZE) {
+            RT_LOAD(w, s);
+            RT_STORE(d, w);
+            d += RT_WORD_SIZE;
+            s += RT_WORD_SIZE;
+            count -= RT_WORD_SIZE;
+        }
+    }
+    while (count--) {
+        *d++ = *s++;
     }
 }
 
-Sb_size_t
-SbRT_StrLen(const char *s)
-{
-    const char *p;
-
-    for (p = s; *p; ++p);
-    return p - s;
-}
-
-void
-SbRT_StrCpy(char *dst, const char *src)
-{
-    while (*dst++ = *src++);
-}
-
-int
-SbRT_StrCmp(const char *s1, const char *s2)
+static void
+rt_fill_word(void *ptr, int ch, Sb_size_t count)
 {
-    int d;
-
-    for (;; ++s1, ++s2) {
-        d = s1[0] - s2[0];
-        if (d || !s1[0]) {
-            return d;
+    Sb_byte_t *p = (Sb_byte_t *)ptr;
+    Sb_byte_t c = (Sb_byte_t)ch;
+    rt_word_t w;
+
+    if (count >= 2 * RT_WORD_SIZE) {
+        w = RT_ONES * c;
+        while ((Sb_size_t)p & RT_WORD_MASK) {
+            *p++ = c;
+            --count;
+        }
+        while (count >= RT_WORD_SIZE) {
+            RT_STORE(p, w);
+            p += RT_WORD_SIZE;
+            count -= RT_WORD_SIZE;
         }
     }
-}
-
-void
-SbRT_MemCpy(void *dst, const void *src, Sb_size_t count)
-{
-    char *d = (char *)dst;
-    const char *s = (const char *)src;
-
     while (count--) {
-        *d++ = *s++;
+        *p++ = c;
     }
 }
 
-int
-SbRT_MemCmp(const void *p1, const void *p2, Sb_size_t count)
+static int
+rt_compare_word(const void *p1, const void *p2, Sb_size_t count)
 {
-    const char *s1 = (const char *)p1;
-    const char *s2 = (const char *)p2;
-    int d = 0;
-
-    while (count--) {
-        d = s1[0] - s2[0];
-        if (d) {
+    const Sb_byte_t *s1 = (const Sb_byte_t *)p1;
+    const Sb_byte_t *s2 = (const Sb_byte_t *)p2;
+    rt_word_t w1, w2;
+
+    /* Skip equal words; the byte loop then pins down the difference. */
+    while (count >= RT_WORD_SIZE) {
+        RT_LOAD(w1, s1);
+        RT_LOAD(w2, s2);
+        if (w1 != w2) {
             break;
         }
+        s1 += RT_WORD_SIZE;
+        s2 += RT_WORD_SIZE;
+        count -= RT_WORD_SIZE;
+    }
+    while (count--) {
+        if (*s1 != *s2) {
+            return *s1 - *s2;
+        }
         ++s1;
         ++s2;
     }
-    return d;
+    return 0;
 }
 
-const void *
-SbRT_MemChr(const void *p, int value, Sb_size_t count)
+static const void *
+rt_find_word(const void *p, int value, Sb_size_t count)
 {
-    const char *s = (const char *)p;
+    const Sb_byte_t *s = (const Sb_byte_t *)p;
+    Sb_byte_t c = (Sb_byte_t)value;
+    rt_word_t pattern, w;
+
+    if (count >= 2 * RT_WORD_SIZE) {
+        pattern = RT_ONES * c;
+        while ((Sb_size_t)s & RT_WORD_MASK) {
+            if (*s == c) {
+                return s;
+            }
+            ++s;
+            --count;
+        }
+        while (count >= RT_WORD_SIZE) {
+            RT_LOAD(w, s);
+            w ^= pattern;
+            if (RT_HAS_ZERO(w)) {
+                break;
+            }
+            s += RT_WORD_SIZE;
+            count -= RT_WORD_SIZE;
+        }
+    }
     while (count--) {
-        if (*s == value) {
+        if (*s == c) {
             return s;
         }
         ++s;
@@ -79,29 +142,32 @@ SbRT_MemChr(const void *p, int value, Sb_size_t count)
     return NULL;
 }
 
-const void *
-SbRT_MemRChr(const void *p, int value, Sb_size_t count)
+static RT_NO_SANITIZE Sb_size_t
+rt_length_word(const char *str)
 {
-    const char *s = (const char *)p + count;
-    while (count--) {
-        --s;
-        if (*s == value) {
-            return s;
+    const char *s = str;
+    rt_word_t w;
+
+    while ((Sb_size_t)s & RT_WORD_MASK) {
+        if (!*s) {
+            return s - str;
         }
+        ++s;
     }
-    return NULL;
-}
-
-void
-SbRT_MemSet(void *ptr, int ch, Sb_size_t count)
-{
-    char *p = (char *)ptr;
-    while (count--) {
-        *p++ = (char)ch;
+    for (;;) {
+        RT_LOAD(w, s);
+        if (RT_HAS_ZERO(w)) {
+            break;
+        }
+        s += RT_WORD_SIZE;
+    }
+    while (*s) {
+        ++s;
     }
+    return s - str;
 }
 
-/* The following routines are adapted from http://effbot.org/zone/stringlib.htm */
+/* The substring searches below are adapted from http://effbot.org/zone/stringlib.htm */
 
 typedef unsigned long Sb_BloomMask_t;
 
@@ -112,34 +178,15 @@ typedef unsigned long Sb_BloomMask_t;
 #define STRINGLIB_BLOOM_TEST(mask, ch) \
     ((mask) &  STRINGLIB_BLOOM_KEY(ch))
 
-Sb_ssize_t
-SbRT_MemMem(const char *str, Sb_ssize_t str_len, const char *pat, Sb_ssize_t pat_len)
+/* Search for a pattern of 2 to RT_SHORT_PATTERN bytes, no longer than the string. */
+static Sb_ssize_t
+rt_search_word(const char *str, Sb_ssize_t str_len, const char *pat, Sb_ssize_t pat_len)
 {
     Sb_BloomMask_t mask;
     Sb_ssize_t skip;
     Sb_ssize_t i, mlast, w;
     const char *ss, *pp;
 
-    if (str_len < pat_len) {
-        return -1;
-    }
-
-    /* Special case: 1-char pattern */
-    if (pat_len == 1) {
-        const char *p;
-
-        p = (const char *)SbRT_MemChr(str, pat[0], str_len);
-        if (p) {
-            return p - str;
-        }
-        return -1;
-    }
-
-    /* Special case: same length strings */
-    if (pat_len == str_len) {
-        return SbRT_MemCmp(str, pat, pat_len) ? -1 : 0;
-    }
-
     /* create compressed boyer-moore delta 1 table */
     mlast = pat_len - 1;
     skip = mlast - 1;
@@ -172,7 +219,7 @@ SbRT_MemMem(const char *str, Sb_ssize_t str_len, const char *pat, Sb_ssize_t pat
 
 miss:
             /* miss: check if next character is part of pattern */
-            if (!STRINGLIB_BLOOM_TEST(mask, ss[i+1])) {
+            if (i < w && !STRINGLIB_BLOOM_TEST(mask, ss[i+1])) {
                 i = i + pat_len;
             }
             else {
@@ -180,7 +227,7 @@ miss:
             }
         } else {
             /* skip: check if next character is part of pattern */
-            if (!STRINGLIB_BLOOM_TEST(mask, ss[i+1])) {
+            if (i < w && !STRINGLIB_BLOOM_TEST(mask, ss[i+1])) {
                 i = i + pat_len;
             }
         }
@@ -188,6 +235,385 @@ miss:
     return -1;
 }
 
+
+typedef struct _rt_string_routines {
+    void (*copy)(void *dst, const void *src, Sb_size_t count);
+    void (*fill)(void *ptr, int ch, Sb_size_t count);
+    int (*compare)(const void *p1, const void *p2, Sb_size_t count);
+    const void *(*find)(const void *p, int value, Sb_size_t count);
+    Sb_size_t (*length)(const char *s);
+    Sb_ssize_t (*search)(const char *str, Sb_ssize_t str_len, const char *pat, Sb_ssize_t pat_len);
+} rt_string_routines;
+
+static const rt_string_routines rt_routines_word = {
+    rt_copy_word,
+    rt_fill_word,
+    rt_compare_word,
+    rt_find_word,
+    rt_length_word,
+    rt_search_word,
+};
+
+#if SbRT_HAVE_X86_SIMD
+
+/* Implemented in string_x86.c */
+extern int
+_SbRT_X86Level(void);
+extern void
+_SbRT_MemCpy_SSE2(void *dst, const void *src, Sb_size_t count);
+extern void
+_SbRT_MemSet_SSE2(void *ptr, int ch, Sb_size_t count);
+extern int
+_SbRT_MemCmp_SSE2(const void *p1, const void *p2, Sb_size_t count);
+extern const void *
+_SbRT_MemChr_SSE2(const void *p, int value, Sb_size_t count);
+extern Sb_size_t
+_SbRT_StrLen_SSE2(const char *s);
+extern Sb_ssize_t
+_SbRT_MemMem_SSE2(const char *str, Sb_ssize_t str_len, const char *pat, Sb_ssize_t pat_len);
+extern void
+_SbRT_MemCpy_AVX2(void *dst, const void *src, Sb_size_t count);
+extern void
+_SbRT_MemSet_AVX2(void *ptr, int ch, Sb_size_t count);
+extern int
+_SbRT_MemCmp_AVX2(const void *p1, const void *p2, Sb_size_t count);
+extern const void *
+_SbRT_MemChr_AVX2(const void *p, int value, Sb_size_t count);
+extern Sb_size_t
+_SbRT_StrLen_AVX2(const char *s);
+extern Sb_ssize_t
+_SbRT_MemMem_AVX2(const char *str, Sb_ssize_t str_len, const char *pat, Sb_ssize_t pat_len);
+
+static const rt_string_routines rt_routines_sse2 = {
+    _SbRT_MemCpy_SSE2,
+    _SbRT_MemSet_SSE2,
+    _SbRT_MemCmp_SSE2,
+    _SbRT_MemChr_SSE2,
+    _SbRT_StrLen_SSE2,
+    _SbRT_MemMem_SSE2,
+};
+
+static const rt_string_routines rt_routines_avx2 = {
+    _SbRT_MemCpy_AVX2,
+    _SbRT_MemSet_AVX2,
+    _SbRT_MemCmp_AVX2,
+    _SbRT_MemChr_AVX2,
+    _SbRT_StrLen_AVX2,
+    _SbRT_MemMem_AVX2,
+};
+
+#endif /* SbRT_HAVE_X86_SIMD */
+
+static const rt_string_routines *rt_routines = &rt_routines_word;
+
+int
+SbRT_SelectStringRoutines(int max_level)
+{
+    int level;
+
+    level = SbRT_ISA_WORD;
+#if SbRT_HAVE_X86_SIMD
+    level = _SbRT_X86Level();
+    if (level > max_level) {
+        level = max_level;
+    }
+#endif
+
+    switch (level) {
+#if SbRT_HAVE_X86_SIMD
+    case SbRT_ISA_AVX2:
+        rt_routines = &rt_routines_avx2;
+        break;
+    case SbRT_ISA_SSE2:
+        rt_routines = &rt_routines_sse2;
+        break;
+#endif
+    default:
+        level = SbRT_ISA_WORD;
+        rt_routines = &rt_routines_word;
+        break;
+    }
+    return level;
+}
+
+void
+SbRT_BZero(void *ptr, Sb_size_t size)
+{
+    rt_routines->fill(ptr, 0, size);
+}
+
+Sb_size_t
+SbRT_StrLen(const char *s)
+{
+    return rt_routines->length(s);
+}
+
+void
+SbRT_StrCpy(char *dst, const char *src)
+{
+    while (*dst++ = *src++);
+}
+
+int
+SbRT_StrCmp(const char *s1, const char *s2)
+{
+    int d;
+
+    for (;; ++s1, ++s2) {
+        d = s1[0] - s2[0];
+        if (d || !s1[0]) {
+            return d;
+        }
+    }
+}
+
+void
+SbRT_MemCpy(void *dst, const void *src, Sb_size_t count)
+{
+    rt_routines->copy(dst, src, count);
+}
+
+void
+SbRT_MemMove(void *dst, const void *src, Sb_size_t count)
+{
+    Sb_byte_t *d = (Sb_byte_t *)dst;
+    const Sb_byte_t *s = (const Sb_byte_t *)src;
+    rt_word_t w;
+
+    if (d <= s || d >= s + count) {
+        /* Copying forward reads every word before it can be overwritten. */
+        rt_copy_word(dst, src, count);
+        return;
+    }
+
+    /* Overlapping with dst above src: copy backwards. */
+    d += count;
+    s += count;
+    if (count >= 2 * RT_WORD_SIZE) {
+        while ((Sb_size_t)d & RT_WORD_MASK) {
+            *--d = *--s;
+            --count;
+        }
+        while (count >= RT_WORD_SIZE) {
+            d -= RT_WORD_SIZE;
+            s -= RT_WORD_SIZE;
+            RT_LOAD(w, s);
+            RT_STORE(d, w);
+            count -= RT_WORD_SIZE;
+        }
+    }
+    while (count--) {
+        *--d = *--s;
+    }
+}
+
+int
+SbRT_MemCmp(const void *p1, const void *p2, Sb_size_t count)
+{
+    return rt_routines->compare(p1, p2, count);
+}
+
+const void *
+SbRT_MemChr(const void *p, int value, Sb_size_t count)
+{
+    return rt_routines->find(p, value, count);
+}
+
+const void *
+SbRT_MemRChr(const void *p, int value, Sb_size_t count)
+{
+    const Sb_byte_t *s = (const Sb_byte_t *)p + count;
+    Sb_byte_t c = (Sb_byte_t)value;
+    rt_word_t pattern, w;
+
+    if (count >= 2 * RT_WORD_SIZE) {
+        pattern = RT_ONES * c;
+        while ((Sb_size_t)s & RT_WORD_MASK) {
+            --s;
+            if (*s == c) {
+                return s;
+            }
+            --count;
+        }
+        while (count >= RT_WORD_SIZE) {
+            RT_LOAD(w, s - RT_WORD_SIZE);
+            w ^= pattern;
+            if (RT_HAS_ZERO(w)) {
+                break;
+            }
+            s -= RT_WORD_SIZE;
+            count -= RT_WORD_SIZE;
+        }
+    }
+    while (count--) {
+        --s;
+        if (*s == c) {
+            return s;
+        }
+    }
+    return NULL;
+}
+
+void
+SbRT_MemSet(void *ptr, int ch, Sb_size_t count)
+{
+    rt_routines->fill(ptr, ch, count);
+}
+
+/* Two-Way string matching (Crochemore & Perrin), with a Horspool shift
+   on the byte under the pattern's end to skip ahead quickly.
+   The pattern is split at a critical factorization into a left and a right part;
+   the right part is matched first, and what is known about the period of the
+   pattern keeps either part from being compared twice. */
+static Sb_ssize_t
+rt_search_twoway(const char *str, Sb_ssize_t str_len, const char *pat, Sb_ssize_t pat_len)
+{
+    const Sb_byte_t *h = (const Sb_byte_t *)str;
+    const Sb_byte_t *z = h + str_len;
+    const Sb_byte_t *n = (const Sb_byte_t *)pat;
+    Sb_size_t l = (Sb_size_t)pat_len;
+    Sb_size_t i, ip, jp, k, p, ms, p0, mem, mem0;
+    Sb_byte_t present[256];
+    Sb_size_t shift[256];
+
+    SbRT_BZero(present, sizeof(present));
+    for (i = 0; i < l; ++i) {
+        present[n[i]] = 1;
+        shift[n[i]] = i + 1;
+    }
+
+    /* Maximal suffix under the byte order; ip starts at -1 and wraps around. */
+    ip = (Sb_size_t)-1;
+    jp = 0;
+    k = p = 1;
+    while (jp + k < l) {
+        if (n[ip + k] == n[jp + k]) {
+            if (k == p) {
+                jp += p;
+                k = 1;
+            }
+            else {
+                ++k;
+            }
+        }
+        else if (n[ip + k] > n[jp + k]) {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        }
+        else {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+    ms = ip;
+    p0 = p;
+
+    /* Same under the reversed order; the later starting one is the critical factorization. */
+    ip = (Sb_size_t)-1;
+    jp = 0;
+    k = p = 1;
+    while (jp + k < l) {
+        if (n[ip + k] == n[jp + k]) {
+            if (k == p) {
+                jp += p;
+                k = 1;
+            }
+            else {
+                ++k;
+            }
+        }
+        else if (n[ip + k] < n[jp + k]) {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        }
+        else {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+    if (ip + 1 > ms + 1) {
+        ms = ip;
+    }
+    else {
+        p = p0;
+    }
+
+    /* A periodic pattern remembers how much of it matched across shifts by p. */
+    if (SbRT_MemCmp(n, n + p, ms + 1)) {
+        mem0 = 0;
+        p = (ms > l - ms - 1 ? ms : l - ms - 1) + 1;
+    }
+    else {
+        mem0 = l - p;
+    }
+    mem = 0;
+
+    for (;;) {
+        if ((Sb_size_t)(z - h) < l) {
+            return -1;
+        }
+
+        /* Check the last byte first */
+        if (present[h[l - 1]]) {
+            k = l - shift[h[l - 1]];
+            if (k) {
+                if (k < mem) {
+                    k = mem;
+                }
+                h += k;
+                mem = 0;
+                continue;
+            }
+        }
+        else {
+            h += l;
+            mem = 0;
+            continue;
+        }
+
+        /* Right part */
+        for (k = ms + 1 > mem ? ms + 1 : mem; k < l && n[k] == h[k]; ++k);
+        if (k < l) {
+            h += k - ms;
+            mem = 0;
+            continue;
+        }
+        /* Left part */
+        for (k = ms + 1; k > mem && n[k - 1] == h[k - 1]; --k);
+        if (k <= mem) {
+            return (const char *)h - str;
+        }
+        h += p;
+        mem = mem0;
+    }
+}
+
+Sb_ssize_t
+SbRT_MemMem(const char *str, Sb_ssize_t str_len, const char *pat, Sb_ssize_t pat_len)
+{
+    const char *p;
+
+    if (str_len < pat_len) {
+        return -1;
+    }
+    if (pat_len <= 1) {
+        if (pat_len == 0) {
+            return 0;
+        }
+        p = (const char *)SbRT_MemChr(str, pat[0], str_len);
+        return p ? p - str : -1;
+    }
+    if (pat_len == str_len) {
+        return SbRT_MemCmp(str, pat, pat_len) ? -1 : 0;
+    }
+    if (pat_len <= RT_SHORT_PATTERN) {
+        return rt_routines->search(str, str_len, pat, pat_len);
+    }
+    return rt_search_twoway(str, str_len, pat, pat_len);
+}
+
 Sb_ssize_t
 SbRT_MemRMem(const char *str, Sb_ssize_t str_len, const char *pat, Sb_ssize_t pat_len)
 {
@@ -198,6 +624,9 @@ SbRT_MemRMem(const char *str, Sb_ssize_t str_len, const char *pat, Sb_ssize_t pa
     if (str_len < pat_len) {
         return -1;
     }
+    if (pat_len == 0) {
+        return str_len;
+    }
 
     /* Special case: 1-char pattern */
     if (pat_len == 1) {
@@ -0,0 +1,500 @@
+#include "runtime.h"
+
+#if SbRT_HAVE_X86_SIMD
+
+/* SSE2 and AVX2 variants of the buffer routines.
+   SSE2 is part of x86-64; AVX2 code is only reached after _SbRT_X86Level() said so.
+   Blocks are loaded unaligned; the last partial block of a buffer is handled
+   by a full block ending flush with the buffer, overlapping what came before. */
+
+#include <cpuid.h>
+#include <emmintrin.h>
+#include <immintrin.h>
+
+#define RT_AVX2 __attribute__((target("avx2")))
+/* Aligned block reads may run past the terminator, though never across a page. */
+#define RT_NO_SANITIZE __attribute__((no_sanitize_address))
+
+typedef unsigned long long rt_u64;
+typedef unsigned int rt_u32;
+
+int
+_SbRT_X86Level(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    unsigned int xcr0_lo, xcr0_hi;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return SbRT_ISA_SSE2;
+    }
+    /* The OS must save the YMM registers on context switches. */
+    if (!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX)) {
+        return SbRT_ISA_SSE2;
+    }
+    __asm__ __volatile__ ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+    if ((xcr0_lo & 6) != 6) {
+        return SbRT_ISA_SSE2;
+    }
+    if (__get_cpuid_max(0, NULL) < 7) {
+        return SbRT_ISA_SSE2;
+    }
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    return (ebx & bit_AVX2) ? SbRT_ISA_AVX2 : SbRT_ISA_SSE2;
+}
+
+/* Copies up to 16 bytes with at most two possibly overlapping moves. */
+static void
+rt_copy_small(Sb_byte_t *d, const Sb_byte_t *s, Sb_size_t count)
+{
+    if (count >= 8) {
+        rt_u64 a, b;
+
+        __builtin_memcpy(&a, s, 8);
+        __builtin_memcpy(&b, s + count - 8, 8);
+        __builtin_memcpy(d, &a, 8);
+        __builtin_memcpy(d + count - 8, &b, 8);
+    }
+    else if (count >= 4) {
+        rt_u32 a, b;
+
+        __builtin_memcpy(&a, s, 4);
+        __builtin_memcpy(&b, s + count - 4, 4);
+        __builtin_memcpy(d, &a, 4);
+        __builtin_memcpy(d + count - 4, &b, 4);
+    }
+    else {
+        while (count--) {
+            *d++ = *s++;
+        }
+    }
+}
+
+static void
+rt_fill_small(Sb_byte_t *p, Sb_byte_t c, Sb_size_t count)
+{
+    if (count >= 8) {
+        rt_u64 w = 0x0101010101010101ULL * c;
+
+        __builtin_memcpy(p, &w, 8);
+        __builtin_memcpy(p + count - 8, &w, 8);
+    }
+    else {
+        while (count--) {
+            *p++ = c;
+        }
+    }
+}
+
+/*
+ * SSE2
+ */
+
+void
+_SbRT_MemCpy_SSE2(void *dst, const void *src, Sb_size_t count)
+{
+    Sb_byte_t *d = (Sb_byte_t *)dst;
+    const Sb_byte_t *s = (const Sb_byte_t *)src;
+    Sb_byte_t *last;
+    __m128i tail;
+
+    if (count <= 16) {
+        rt_copy_small(d, s, count);
+        return;
+    }
+
+    tail = _mm_loadu_si128((const __m128i *)(s + count - 16));
+    last = d + count - 16;
+    while (last - d >= 64) {
+        __m128i x0, x1, x2, x3;
+
+        x0 = _mm_loadu_si128((const __m128i *)(s + 0));
+        x1 = _mm_loadu_si128((const __m128i *)(s + 16));
+        x2 = _mm_loadu_si128((const __m128i *)(s + 32));
+        x3 = _mm_loadu_si128((const __m128i *)(s + 48));
+        _mm_storeu_si128((__m128i *)(d + 0), x0);
+        _mm_storeu_si128((__m128i *)(d + 16), x1);
+        _mm_storeu_si128((__m128i *)(d + 32), x2);
+        _mm_storeu_si128((__m128i *)(d + 48), x3);
+        d += 64;
+        s += 64;
+    }
+    while (d < last) {
+        _mm_storeu_si128((__m128i *)d, _mm_loadu_si128((const __m128i *)s));
+        d += 16;
+        s += 16;
+    }
+    _mm_storeu_si128((__m128i *)last, tail);
+}
+
+void
+_SbRT_MemSet_SSE2(void *ptr, int ch, Sb_size_t count)
+{
+    Sb_byte_t *p = (Sb_byte_t *)ptr;
+    Sb_byte_t *last;
+    __m128i v;
+
+    if (count < 16) {
+        rt_fill_small(p, (Sb_byte_t)ch, count);
+        return;
+    }
+
+    v = _mm_set1_epi8((char)ch);
+    last = p + count - 16;
+    while (p < last) {
+        _mm_storeu_si128((__m128i *)p, v);
+        p += 16;
+    }
+    _mm_storeu_si128((__m128i *)last, v);
+}
+
+int
+_SbRT_MemCmp_SSE2(const void *p1, const void *p2, Sb_size_t count)
+{
+    const Sb_byte_t *s1 = (const Sb_byte_t *)p1;
+    const Sb_byte_t *s2 = (const Sb_byte_t *)p2;
+    Sb_size_t pos;
+    unsigned int mask;
+
+    if (count < 16) {
+        for (pos = 0; pos < count; ++pos) {
+            if (s1[pos] != s2[pos]) {
+                return s1[pos] - s2[pos];
+            }
+        }
+        return 0;
+    }
+
+    pos = 0;
+    for (;;) {
+        if (pos > count - 16) {
+            /* Recheck a full block ending at the end; its head is known to match. */
+            pos = count - 16;
+        }
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi8(
+            _mm_loadu_si128((const __m128i *)(s1 + pos)),
+            _mm_loadu_si128((const __m128i *)(s2 + pos))));
+        if (mask != 0xFFFF) {
+            pos += __builtin_ctz(~mask);
+            return s1[pos] - s2[pos];
+        }
+        pos += 16;
+        if (pos >= count) {
+            return 0;
+        }
+    }
+}
+
+const void *
+_SbRT_MemChr_SSE2(const void *p, int value, Sb_size_t count)
+{
+    const Sb_byte_t *s = (const Sb_byte_t *)p;
+    Sb_size_t pos;
+    unsigned int mask;
+    __m128i v;
+
+    if (count < 16) {
+        for (pos = 0; pos < count; ++pos) {
+            if (s[pos] == (Sb_byte_t)value) {
+                return s + pos;
+            }
+        }
+        return NULL;
+    }
+
+    v = _mm_set1_epi8((char)value);
+    pos = 0;
+    for (;;) {
+        if (pos > count - 16) {
+            /* Bytes before `pos` had no match, so the first hit is genuine. */
+            pos = count - 16;
+        }
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(s + pos)), v));
+        if (mask) {
+            return s + pos + __builtin_ctz(mask);
+        }
+        pos += 16;
+        if (pos >= count) {
+            return NULL;
+        }
+    }
+}
+
+RT_NO_SANITIZE Sb_size_t
+_SbRT_StrLen_SSE2(const char *str)
+{
+    const char *s;
+    unsigned int mask;
+    __m128i zero;
+
+    zero = _mm_setzero_si128();
+    s = (const char *)((Sb_size_t)str & ~(Sb_size_t)15);
+    mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i *)s), zero));
+    mask >>= str - s;
+    if (mask) {
+        return __builtin_ctz(mask);
+    }
+    for (;;) {
+        s += 16;
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i *)s), zero));
+        if (mask) {
+            return s + __builtin_ctz(mask) - str;
+        }
+    }
+}
+
+/* Search too short a string for a block of candidates: test each start position. */
+static Sb_ssize_t
+rt_search_small(const Sb_byte_t *s, Sb_ssize_t str_len, const Sb_byte_t *p, Sb_ssize_t pat_len)
+{
+    Sb_ssize_t pos, last;
+
+    last = pat_len - 1;
+    for (pos = 0; pos <= str_len - pat_len; ++pos) {
+        if (s[pos] == p[0] && s[pos + last] == p[last]
+            && !_SbRT_MemCmp_SSE2(s + pos + 1, p + 1, last - 1)) {
+            return pos;
+        }
+    }
+    return -1;
+}
+
+/* Every start position in a block is tested at once against the first and
+   the last byte of the pattern; only positions passing both are compared. */
+Sb_ssize_t
+_SbRT_MemMem_SSE2(const char *str, Sb_ssize_t str_len, const char *pat, Sb_ssize_t pat_len)
+{
+    const Sb_byte_t *s = (const Sb_byte_t *)str;
+    const Sb_byte_t *p = (const Sb_byte_t *)pat;
+    Sb_size_t pos, last, w;
+    unsigned int mask;
+    __m128i first_v, last_v;
+
+    /* Last start position */
+    w = str_len - pat_len;
+    if (w < 16) {
+        return rt_search_small(s, str_len, p, pat_len);
+    }
+
+    last = pat_len - 1;
+    first_v = _mm_set1_epi8((char)p[0]);
+    last_v = _mm_set1_epi8((char)p[last]);
+    pos = 0;
+    for (;;) {
+        if (pos > w - 15) {
+            /* Positions before `pos` are known not to match. */
+            pos = w - 15;
+        }
+        mask = _mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(s + pos)), first_v),
+            _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(s + pos + last)), last_v)));
+        while (mask) {
+            Sb_size_t hit = pos + __builtin_ctz(mask);
+
+            if (!_SbRT_MemCmp_SSE2(s + hit + 1, p + 1, last - 1)) {
+                return hit;
+            }
+            mask &= mask - 1;
+        }
+        pos += 16;
+        if (pos > w) {
+            return -1;
+        }
+    }
+}
+
+/*
+ * AVX2
+ */
+
+RT_AVX2 void
+_SbRT_MemCpy_AVX2(void *dst, const void *src, Sb_size_t count)
+{
+    Sb_byte_t *d = (Sb_byte_t *)dst;
+    const Sb_byte_t *s = (const Sb_byte_t *)src;
+    Sb_byte_t *last;
+    __m256i tail;
+
+    if (count <= 32) {
+        if (count <= 16) {
+            rt_copy_small(d, s, count);
+        }
+        else {
+            __m128i head, tail16;
+
+            head = _mm_loadu_si128((const __m128i *)s);
+            tail16 = _mm_loadu_si128((const __m128i *)(s + count - 16));
+            _mm_storeu_si128((__m128i *)d, head);
+            _mm_storeu_si128((__m128i *)(d + count - 16), tail16);
+        }
+        return;
+    }
+
+    tail = _mm256_loadu_si256((const __m256i *)(s + count - 32));
+    last = d + count - 32;
+    while (last - d >= 128) {
+        __m256i y0, y1, y2, y3;
+
+        y0 = _mm256_loadu_si256((const __m256i *)(s + 0));
+        y1 = _mm256_loadu_si256((const __m256i *)(s + 32));
+        y2 = _mm256_loadu_si256((const __m256i *)(s + 64));
+        y3 = _mm256_loadu_si256((const __m256i *)(s + 96));
+        _mm256_storeu_si256((__m256i *)(d + 0), y0);
+        _mm256_storeu_si256((__m256i *)(d + 32), y1);
+        _mm256_storeu_si256((__m256i *)(d + 64), y2);
+        _mm256_storeu_si256((__m256i *)(d + 96), y3);
+        d += 128;
+        s += 128;
+    }
+    while (d < last) {
+        _mm256_storeu_si256((__m256i *)d, _mm256_loadu_si256((const __m256i *)s));
+        d += 32;
+        s += 32;
+    }
+    _mm256_storeu_si256((__m256i *)last, tail);
+}
+
+RT_AVX2 void
+_SbRT_MemSet_AVX2(void *ptr, int ch, Sb_size_t count)
+{
+    Sb_byte_t *p = (Sb_byte_t *)ptr;
+    Sb_byte_t *last;
+    __m256i v;
+
+    if (count < 32) {
+        _SbRT_MemSet_SSE2(ptr, ch, count);
+        return;
+    }
+
+    v = _mm256_set1_epi8((char)ch);
+    last = p + count - 32;
+    while (p < last) {
+        _mm256_storeu_si256((__m256i *)p, v);
+        p += 32;
+    }
+    _mm256_storeu_si256((__m256i *)last, v);
+}
+
+RT_AVX2 int
+_SbRT_MemCmp_AVX2(const void *p1, const void *p2, Sb_size_t count)
+{
+    const Sb_byte_t *s1 = (const Sb_byte_t *)p1;
+    const Sb_byte_t *s2 = (const Sb_byte_t *)p2;
+    Sb_size_t pos;
+    unsigned int mask;
+
+    if (count < 32) {
+        return _SbRT_MemCmp_SSE2(p1, p2, count);
+    }
+
+    pos = 0;
+    for (;;) {
+        if (pos > count - 32) {
+            pos = count - 32;
+        }
+        mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+            _mm256_loadu_si256((const __m256i *)(s1 + pos)),
+            _mm256_loadu_si256((const __m256i *)(s2 + pos))));
+        if (mask != 0xFFFFFFFFU) {
+            pos += __builtin_ctz(~mask);
+            return s1[pos] - s2[pos];
+        }
+        pos += 32;
+        if (pos >= count) {
+            return 0;
+        }
+    }
+}
+
+RT_AVX2 const void *
+_SbRT_MemChr_AVX2(const void *p, int value, Sb_size_t count)
+{
+    const Sb_byte_t *s = (const Sb_byte_t *)p;
+    Sb_size_t pos;
+    unsigned int mask;
+    __m256i v;
+
+    if (count < 32) {
+        return _SbRT_MemChr_SSE2(p, value, count);
+    }
+
+    v = _mm256_set1_epi8((char)value);
+    pos = 0;
+    for (;;) {
+        if (pos > count - 32) {
+            pos = count - 32;
+        }
+        mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + pos)), v));
+        if (mask) {
+            return s + pos + __builtin_ctz(mask);
+        }
+        pos += 32;
+        if (pos >= count) {
+            return NULL;
+        }
+    }
+}
+
+RT_AVX2 RT_NO_SANITIZE Sb_size_t
+_SbRT_StrLen_AVX2(const char *str)
+{
+    const char *s;
+    unsigned int mask;
+    __m256i zero;
+
+    zero = _mm256_setzero_si256();
+    s = (const char *)((Sb_size_t)str & ~(Sb_size_t)31);
+    mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i *)s), zero));
+    mask >>= str - s;
+    if (mask) {
+        return __builtin_ctz(mask);
+    }
+    for (;;) {
+        s += 32;
+        mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i *)s), zero));
+        if (mask) {
+            return s + __builtin_ctz(mask) - str;
+        }
+    }
+}
+
+RT_AVX2 Sb_ssize_t
+_SbRT_MemMem_AVX2(const char *str, Sb_ssize_t str_len, const char *pat, Sb_ssize_t pat_len)
+{
+    const Sb_byte_t *s = (const Sb_byte_t *)str;
+    const Sb_byte_t *p = (const Sb_byte_t *)pat;
+    Sb_size_t pos, last, w;
+    unsigned int mask;
+    __m256i first_v, last_v;
+
+    w = str_len - pat_len;
+    if (w < 32) {
+        return _SbRT_MemMem_SSE2(str, str_len, pat, pat_len);
+    }
+
+    last = pat_len - 1;
+    first_v = _mm256_set1_epi8((char)p[0]);
+    last_v = _mm256_set1_epi8((char)p[last]);
+    pos = 0;
+    for (;;) {
+        if (pos > w - 31) {
+            pos = w - 31;
+        }
+        mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + pos)), first_v),
+            _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + pos + last)), last_v)));
+        while (mask) {
+            Sb_size_t hit = pos + __builtin_ctz(mask);
+
+            if (!_SbRT_MemCmp_SSE2(s + hit + 1, p + 1, last - 1)) {
+                return hit;
+            }
+            mask &= mask - 1;
+        }
+        pos += 32;
+        if (pos > w) {
+            return -1;
+        }
+    }
+}
+
+#endif /* SbRT_HAVE_X86_SIMD */
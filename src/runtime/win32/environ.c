@@ -0,0 +1,37 @@
+#include "runtime.h"
+#include <windows.h>
+/* RtlGenRandom is exported from advapi32 as SystemFunction036. */
+#define SystemFunction036 NTAPI SystemFunction036
+#include <ntsecapi.h>
+#undef SystemFunction036
+
+static char env_buffer[1024];
+
+const char *
+Sb_GetEnv(const char *name)
+{
+    DWORD length;
+
+    length = GetEnvironmentVariableA(name, env_buffer, sizeof(env_buffer));
+    if (length == 0 || length >= sizeof(env_buffer)) {
+        return NULL;
+    }
+    return env_buffer;
+}
+
+int
+Sb_GetRandomBytes(void *buffer, Sb_size_t count)
+{
+    Sb_byte_t *p = (Sb_byte_t *)buffer;
+    ULONG chunk;
+
+    while (count > 0) {
+        chunk = count > 0x10000 ? 0x10000 : (ULONG)count;
+        if (!RtlGenRandom(p, chunk)) {
+            return -1;
+        }
+        p += chunk;
+        count -= chunk;
+    }
+    return 0;
+}
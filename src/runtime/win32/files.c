@@ -92,6 +92,81 @@ Sb_FileClose(OSFileHandle_t handle)
     CloseHandle((HANDLE)handle);
 }
 
+typedef struct {
+    HANDLE find_handle;
+    int first_pending;
+    WIN32_FIND_DATAA find_data;
+} OSDirState;
+
+OSError_t
+Sb_DirOpen(const char *path, OSDirHandle_t *handle)
+{
+    OSDirState *state;
+    char pattern[MAX_PATH];
+    Sb_size_t length;
+
+    length = SbRT_StrLen(path);
+    if (length == 0) {
+        path = ".";
+        length = 1;
+    }
+    if (length + 3 > sizeof(pattern)) {
+        return ERROR_FILENAME_EXCED_RANGE;
+    }
+    SbRT_StrCpy(pattern, path);
+    pattern[length] = '\\';
+    pattern[length + 1] = '*';
+    pattern[length + 2] = '\0';
+
+    state = (OSDirState *)Sb_Malloc(sizeof(*state));
+    if (!state) {
+        return ERROR_NOT_ENOUGH_MEMORY;
+    }
+
+    state->find_handle = FindFirstFileA(pattern, &state->find_data);
+    if (state->find_handle == INVALID_HANDLE_VALUE) {
+        DWORD error = GetLastError();
+
+        Sb_Free(state);
+        return (OSError_t)error;
+    }
+    state->first_pending = 1;
+
+    *handle = (OSDirHandle_t)state;
+    return OS_NO_ERROR;
+}
+
+OSError_t
+Sb_DirRead(OSDirHandle_t handle, const char **name)
+{
+    OSDirState *state = (OSDirState *)handle;
+
+    if (state->first_pending) {
+        state->first_pending = 0;
+    }
+    else if (!FindNextFileA(state->find_handle, &state->find_data)) {
+        DWORD error = GetLastError();
+
+        if (error != ERROR_NO_MORE_FILES) {
+            return (OSError_t)error;
+        }
+        *name = NULL;
+        return OS_NO_ERROR;
+    }
+
+    *name = state->find_data.cFileName;
+    return OS_NO_ERROR;
+}
+
+void
+Sb_DirClose(OSDirHandle_t handle)
+{
+    OSDirState *state = (OSDirState *)handle;
+
+    FindClose(state->find_handle);
+    Sb_Free(state);
+}
+
 OSFileHandle_t
 Sb_GetStdInHandle(void)
 {
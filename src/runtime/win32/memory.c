@@ -0,0 +1,15 @@
+#include "runtime.h"
+#include <windows.h>
+
+void *
+Sb_AllocArena(Sb_size_t size)
+{
+    /* VirtualAlloc() reservations start on the allocation granularity boundary. */
+    return VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+}
+
+void
+Sb_FreeArena(void *ptr, Sb_size_t size)
+{
+    VirtualFree(ptr, 0, MEM_RELEASE);
+}
@@ -0,0 +1,22 @@
+#include "runtime.h"
+#include <windows.h>
+
+static LARGE_INTEGER counter_frequency;
+
+Sb_ulong64_t
+Sb_GetTimeMicroseconds(void)
+{
+    LARGE_INTEGER counter;
+    Sb_ulong64_t seconds;
+    Sb_ulong64_t remainder;
+
+    if (!counter_frequency.QuadPart) {
+        QueryPerformanceFrequency(&counter_frequency);
+    }
+    QueryPerformanceCounter(&counter);
+
+    /* Split to avoid overflowing the multiplication on long uptimes. */
+    seconds = (Sb_ulong64_t)counter.QuadPart / (Sb_ulong64_t)counter_frequency.QuadPart;
+    remainder = (Sb_ulong64_t)counter.QuadPart % (Sb_ulong64_t)counter_frequency.QuadPart;
+    return seconds * 1000000 + remainder * 1000000 / (Sb_ulong64_t)counter_frequency.QuadPart;
+}
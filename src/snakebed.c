@@ -34,6 +34,8 @@ _Sb_TypeInit_Tuple();
 extern int
 _Sb_TypeInit_List();
 extern int
+_Sb_TypeInit_Slice();
+extern int
 _SbNone_BuiltinInit();
 extern int
 _SbNotImplemented_BuiltinInit();
@@ -62,6 +64,8 @@ extern int
 _Sb_ModuleInit_Sys();
 int
 _Sb_ModuleInit_Socket();
+extern int
+_Sb_ModuleInit_GC();
 
 typedef int (*typeinitfunc)();
 
@@ -87,6 +91,7 @@ static typeinitfunc stage3_inits[] = {
     /* Types */
     _Sb_TypeInit_Tuple,
     _Sb_TypeInit_List,
+    _Sb_TypeInit_Slice,
     _SbInt_BuiltinInit,
     _SbNone_BuiltinInit,
     _SbNotImplemented_BuiltinInit,
@@ -107,6 +112,9 @@ static typeinitfunc stage3_inits[] = {
     /* Modules */
     _Sb_ModuleInit_Sys,
     _Sb_ModuleInit_Builtin,
+#if SUPPORTS(CYCLE_GC)
+    _Sb_ModuleInit_GC,
+#endif
 #if SUPPORTS(MODULE_SOCKET)
     _Sb_ModuleInit_Socket,
 #endif
@@ -136,6 +144,16 @@ do_initfuncs(typeinitfunc *funcs)
 int
 Sb_Initialize(void)
 {
+    SbRT_SelectStringRoutines(SbRT_ISA_BEST);
+    if (SbRT_InitHashKey() < 0) {
+        /* Nothing is set up to raise with yet; tell the user directly. */
+        static const char message[] = SbRT_HASHSEED_ENV " must be a decimal number below 2**64\r\n";
+        Sb_ssize_t written;
+
+        Sb_FileWrite(Sb_GetStdErrHandle(), message, sizeof(message) - 1, &written);
+        return -1;
+    }
+
     /* Stage 1: build the most basic types */
 #if __TRACE_INITS
     printf("Starting init stage 1.\n");
@@ -168,10 +186,18 @@ extern void
 _Sb_ModuleFini_Sys();
 extern void
 _Sb_ModuleFini_Builtin();
+extern void
+_Sb_ModuleFini_GC();
+extern void
+_Sb_ImportFini(void);
 
 void
 Sb_Finalize(void)
 {
+    _Sb_ImportFini();
     _Sb_ModuleFini_Sys();
     _Sb_ModuleFini_Builtin();
+#if SUPPORTS(CYCLE_GC)
+    _Sb_ModuleFini_GC();
+#endif
 }
@@ -0,0 +1,25 @@
+# Verify the small object allocator gives memory back once objects go away.
+import sys
+
+def churn(n):
+    keep = []
+    i = 0
+    while i < n:
+        keep.append([i, i + 1, (i, i)])
+        i = i + 1
+    return len(keep)
+
+before = sys.getallocstats()
+churn(20000)
+after = sys.getallocstats()
+
+if after['arenas_allocated'] <= before['arenas_allocated']:
+    print('FAILED 1')
+elif after['arenas_released'] <= before['arenas_released']:
+    print('FAILED 2')
+elif after['block_bytes'] > after['pool_bytes']:
+    print('FAILED 3')
+elif after['arenas_allocated'] - after['arenas_released'] != after['arenas']:
+    print('FAILED 4')
+else:
+    print('PASSED')
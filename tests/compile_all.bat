@@ -1 +1,2 @@
 for %%F in (*.py) do python ../tools/sbcompile.py %%F
+for %%F in (import_005\*.py) do python ../tools/sbcompile.py %%F
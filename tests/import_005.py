@@ -0,0 +1,39 @@
+# Verify modules are searched along sys.path and misses stay misses.
+import sys
+
+def try_import():
+    try:
+        import import_005_mod
+        return import_005_mod.value
+    except ImportError:
+        return None
+
+try:
+    import IDontExistEither
+    print('FAILED 1')
+except ImportError:
+    try:
+        import IDontExistEither
+        print('FAILED 2')
+    except ImportError:
+        if type(sys.path) is list and sys.path[0] == '':
+            # The module lives in a subdirectory, so it is a miss until that is on the path.
+            if try_import() is not None:
+                print('FAILED 5')
+            sys.path.append('import_005')
+            if try_import() != 5:
+                print('FAILED 6')
+            # Take the directory away again: the module is a miss once more.
+            del sys.modules['import_005_mod']
+            sys.path = sys.path[:1]
+            if try_import() is not None:
+                print('FAILED 7')
+            sys.path = [sys.path[0], 'import_005']
+            if try_import() != 5:
+                print('FAILED 8')
+            else:
+                print('PASSED')
+        else:
+            print('FAILED 3')
+except:
+    print('FAILED 4')
@@ -0,0 +1,2 @@
+# Imported by import_005.py from a directory on sys.path.
+value = 5
@@ -7,6 +7,10 @@ int
 test_dicts_main(int which);
 int
 test_str_main(int which);
+int
+test_int_main(int which);
+int
+test_runtime_main(int which);
 
 typedef int (*testsuiteproc)(int which);
 
@@ -35,6 +39,8 @@ int main()
     do_tests(test_str_main);
     do_tests(test_lists_main);
     do_tests(test_dicts_main);
+    do_tests(test_int_main);
+    do_tests(test_runtime_main);
 
     return 0;
 }
@@ -65,12 +65,258 @@ test_dict_getsetstring(void)
     return 0;
 }
 
+/* Test: str objects and C strings hash alike, so either finds the other's entries. */
+static int
+test_dict_str_keys(void)
+{
+    static const char *keys[] = { "", "k", "seven77", "eight888", "a key longer than a couple of words" };
+    SbObject *dict;
+    SbObject *key;
+    Sb_ssize_t i;
+
+    dict = SbDict_New();
+    if (!dict) {
+        return -1;
+    }
+    for (i = 0; i < 5; ++i) {
+        key = SbStr_FromString(keys[i]);
+        if (!key) {
+            return -2;
+        }
+        if (_SbStr_Hash(key) != _SbStr_HashString((const Sb_byte_t *)keys[i], SbRT_StrLen(keys[i]))) {
+            return -3;
+        }
+        if (SbDict_SetItem(dict, key, key) < 0) {
+            return -4;
+        }
+        Sb_DECREF(key);
+    }
+    for (i = 0; i < 5; ++i) {
+        key = SbDict_GetItemString(dict, keys[i]);
+        if (!key || !_SbStr_EqString(key, keys[i])) {
+            return -5;
+        }
+    }
+
+    Sb_DECREF(dict);
+    return 0;
+}
+
+static int
+test_dict_key(void)
+{
+    static SbDictKey key_spam = SbDictKey_INIT("spam");
+    static SbDictKey key_eggs = SbDictKey_INIT("eggs");
+    SbObject *dict;
+    SbObject *key;
+    SbObject *value;
+
+    dict = SbDict_New();
+    if (!dict) {
+        return -1;
+    }
+    if (key_spam.length != 4 || key_spam.hash != -1) {
+        return -2;
+    }
+    if (SbDict_SetItemKey(dict, &key_spam, Sb_True) < 0) {
+        return -3;
+    }
+    /* The hash is cached and agrees with the str's own */
+    if (key_spam.hash != _SbStr_HashString((const Sb_byte_t *)"spam", 4)) {
+        return -4;
+    }
+    if (SbDict_GetItemString(dict, "spam") != Sb_True || SbDict_GetItemKey(dict, &key_spam) != Sb_True) {
+        return -5;
+    }
+    if (SbDict_GetItemKey(dict, &key_eggs) || SbErr_Occurred()) {
+        return -6;
+    }
+
+    key = SbStr_FromString("eggs");
+    if (!key) {
+        return -7;
+    }
+    if (_SbDict_SetItemStr(dict, key, Sb_False) < 0) {
+        return -8;
+    }
+    value = SbDict_GetItemKey(dict, &key_eggs);
+    if (value != Sb_False || SbDict_GetSize(dict) != 2) {
+        return -9;
+    }
+    if (SbDict_DelItemKey(dict, &key_spam) < 0 || _SbDict_GetItemStr(dict, key) != Sb_False) {
+        return -10;
+    }
+    if (_SbDict_DelItemStr(dict, key) < 0 || SbDict_GetSize(dict) != 0) {
+        return -11;
+    }
+    /* Deleting a missing key raises KeyError */
+    if (SbDict_DelItemKey(dict, &key_eggs) != -1 || !SbErr_Occurred()) {
+        return -12;
+    }
+    SbErr_Clear();
+    Sb_DECREF(key);
+
+    Sb_DECREF(dict);
+    return 0;
+}
+
+static int
+test_dict_grow(void)
+{
+    SbObject *dict;
+    SbObject *copy;
+    SbObject *key;
+    SbObject *value;
+    Sb_ssize_t state = 0;
+    Sb_ssize_t seen = 0;
+    long i;
+
+    dict = SbDict_NewPresized(3);
+    if (!dict) {
+        return -1;
+    }
+    /* Well past the initial table, so it has to grow a few times */
+    for (i = 0; i < 1000; ++i) {
+        key = SbInt_FromNative(i);
+        if (!key || SbDict_SetItem(dict, key, key) < 0) {
+            return -2;
+        }
+        Sb_DECREF(key);
+    }
+    for (i = 0; i < 1000; i += 2) {
+        key = SbInt_FromNative(i);
+        if (!key || SbDict_DelItem(dict, key) < 0) {
+            return -3;
+        }
+        Sb_DECREF(key);
+    }
+    if (SbDict_GetSize(dict) != 500) {
+        return -4;
+    }
+    while (SbDict_Next(dict, &state, &key, &value) > 0) {
+        if (key != value || !(SbInt_AsNative(key) & 1)) {
+            return -5;
+        }
+        ++seen;
+    }
+    if (seen != 500) {
+        return -6;
+    }
+
+    copy = SbDict_Copy(dict);
+    if (!copy || SbDict_GetSize(copy) != 500) {
+        return -7;
+    }
+    /* Merging over existing keys does not add entries */
+    if (SbDict_Merge(copy, dict, 0) < 0 || SbDict_GetSize(copy) != 500) {
+        return -8;
+    }
+    for (i = 0; i < 1000; ++i) {
+        key = SbInt_FromNative(i);
+        value = SbDict_GetItem(copy, key);
+        if ((value != NULL) != (i & 1)) {
+            return -9;
+        }
+        Sb_DECREF(key);
+    }
+    Sb_DECREF(copy);
+
+    SbDict_Clear(dict);
+    if (SbDict_GetSize(dict) != 0 || SbDict_SetItemString(dict, "x", Sb_None) < 0) {
+        return -10;
+    }
+    Sb_DECREF(dict);
+    return 0;
+}
+
+static int
+test_dict_split(void)
+{
+    static const char *names[] = { "a", "b", "c", "d", "e", "f", "g", "h", "i", "j" };
+    SbDictSharedKeys *keys;
+    SbObject *d1;
+    SbObject *d2;
+    SbObject *copy;
+    SbObject *key;
+    SbObject *value;
+    Sb_ssize_t state = 0;
+    Sb_ssize_t seen = 0;
+    Sb_ssize_t i;
+
+    keys = _SbDictSharedKeys_New();
+    if (!keys) {
+        return -1;
+    }
+    d1 = _SbDict_NewSplit(keys);
+    d2 = _SbDict_NewSplit(keys);
+    _SbDictSharedKeys_Release(keys);
+    if (!d1 || !d2) {
+        return -2;
+    }
+
+    /* Past the values that fit inline */
+    for (i = 0; i < 10; ++i) {
+        if (SbDict_SetItemString(d1, names[i], Sb_True) < 0) {
+            return -3;
+        }
+    }
+    if (SbDict_SetItemString(d2, "c", Sb_False) < 0) {
+        return -4;
+    }
+    if (SbDict_GetSize(d1) != 10 || SbDict_GetSize(d2) != 1) {
+        return -5;
+    }
+    if (SbDict_GetItemString(d2, "c") != Sb_False || SbDict_GetItemString(d2, "a") || SbDict_GetItemString(d1, "j") != Sb_True) {
+        return -6;
+    }
+    if (SbDict_DelItemString(d1, "b") < 0 || SbDict_GetItemString(d1, "b")) {
+        return -7;
+    }
+    if (SbDict_DelItemString(d2, "a") != -1) {
+        return -8;
+    }
+    SbErr_Clear();
+
+    while (SbDict_Next(d1, &state, &key, &value) > 0) {
+        if (value != Sb_True || SbDict_GetItem(d1, key) != value) {
+            return -9;
+        }
+        ++seen;
+    }
+    if (seen != 9) {
+        return -10;
+    }
+    copy = SbDict_Copy(d1);
+    if (!copy || SbDict_GetSize(copy) != 9 || SbDict_GetItemString(copy, "i") != Sb_True) {
+        return -11;
+    }
+    Sb_DECREF(copy);
+
+    /* A non-str key turns the dict into a plain one */
+    key = SbInt_FromNative(1);
+    if (!key || SbDict_SetItem(d2, key, key) < 0) {
+        return -12;
+    }
+    if (SbDict_GetSize(d2) != 2 || SbDict_GetItemString(d2, "c") != Sb_False || SbDict_GetItem(d2, key) != key) {
+        return -13;
+    }
+    Sb_DECREF(key);
+
+    Sb_DECREF(d1);
+    Sb_DECREF(d2);
+    return 0;
+}
+
 int
 test_dicts_main(int which)
 {
     switch (which) {
     case 0: return test_dict_new();
     case 1: return test_dict_getsetstring();
+    case 2: return test_dict_str_keys();
+    case 3: return test_dict_key();
+    case 4: return test_dict_grow();
+    case 5: return test_dict_split();
     default: return 1;
     }
 }
@@ -4,6 +4,9 @@ This is a test suite for exception objects and their handling.
 
 import unittest
 
+def remove(d, k):
+    del d[k]
+
 class Tests(unittest.TestCase):
     def test_properties(self):
         def f():
@@ -20,6 +23,20 @@ class Tests(unittest.TestCase):
         self.assertEqual(args[2], False)
         self.assertEqual(args[3], "irrelevant")
 
+    def test_raise_value(self):
+        "Verify raising with a value does not release the caller's reference"
+        msg = str(12345)
+        d = {}
+        i = 0
+        while i < 100:
+            try:
+                raise ValueError, msg
+            except ValueError:
+                pass
+            self.assertRaises(KeyError, remove, d, msg)
+            i += 1
+        self.assertEqual(msg, "12345")
+
 if __name__ == "__main__":
     r = Tests().run()
     print(str(r))
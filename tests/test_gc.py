@@ -0,0 +1,67 @@
+"""
+This is a test suite for the cycle collector.
+"""
+
+import unittest
+import gc
+
+class Node:
+    pass
+
+class Finalized:
+    def __del__(self):
+        pass
+
+class Tests(unittest.TestCase):
+    def test_list_cycle(self):
+        "Verify a list containing itself is collected"
+        gc.collect()
+        l = []
+        l.append(l)
+        del l
+        self.assertTrue(gc.collect() == 1)
+    def test_instance_cycle(self):
+        "Verify instances referring to each other are collected"
+        gc.collect()
+        a = Node()
+        b = Node()
+        a.other = b
+        b.other = a
+        del a
+        del b
+        # Two instances and their dicts
+        self.assertTrue(gc.collect() == 4)
+    def test_reachable_kept(self):
+        "Verify objects reachable from outside survive a collection"
+        a = Node()
+        a.me = a
+        gc.collect()
+        self.assertTrue(a.me is a)
+    def test_finalizer_garbage(self):
+        "Verify cycles with __del__ end up in gc.garbage"
+        gc.collect()
+        x = Finalized()
+        x.me = x
+        del x
+        gc.collect()
+        self.assertTrue(len(gc.garbage) == 1)
+        del gc.garbage[0]
+    def test_threshold(self):
+        "Verify thresholds can be changed"
+        old = gc.get_threshold()
+        gc.set_threshold(100, 5)
+        self.assertTrue(gc.get_threshold() == (100, 5, old[2]))
+        gc.set_threshold(old[0], old[1], old[2])
+        self.assertTrue(gc.get_threshold() == old)
+    def test_stats(self):
+        "Verify collections are counted"
+        before = gc.get_stats()[2]['collections']
+        gc.collect()
+        self.assertTrue(gc.get_stats()[2]['collections'] == before + 1)
+    pass
+#
+
+if __name__ == "__main__":
+    r = Tests().run()
+    print(str(r))
+    print()
@@ -0,0 +1,482 @@
+#include "snakebed.h"
+
+/* The chunk size is well below any subquadratic cutoff, so multiplying
+   by a chunk always takes the schoolbook path. */
+#define CHUNK_DIGITS 8
+#define MAX_DIGITS 320
+
+static unsigned int rng_state = 0x2545F491u;
+
+static unsigned int
+rng_next(void)
+{
+    /* xorshift32 */
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+/* Pick lengths around the interesting boundaries more often than not. */
+static Sb_ssize_t
+rng_length(void)
+{
+    static const Sb_ssize_t lengths[] = { 1, 2, 7, 39, 40, 41, 63, 64, 65, 81, 128, 157, 300 };
+
+    if (rng_next() & 1) {
+        return lengths[rng_next() % (sizeof(lengths) / sizeof(lengths[0]))];
+    }
+    return 1 + rng_next() % 300;
+}
+
+/* Build a random int of the given length; fill selects the digit pattern.
+   Returns: New reference. */
+static SbObject *
+make_int(Sb_ssize_t length, int fill)
+{
+    SbInt_Digit_t digits[MAX_DIGITS];
+    Sb_ssize_t i;
+
+    for (i = 0; i < length; ++i) {
+        switch (fill) {
+        case 1:
+            digits[i] = SbInt_DIGIT_MASK;
+            break;
+        case 2:
+            digits[i] = (rng_next() & 1) ? SbInt_DIGIT_MASK : 0;
+            break;
+        default:
+            digits[i] = rng_next();
+            break;
+        }
+    }
+    return SbInt_FromLengthAndDigits(length, digits);
+}
+
+/* Compute a * b by summing products of b with CHUNK_DIGITS slices of a.
+   Returns: New reference. */
+static SbObject *
+reference_mul(SbObject *a, SbObject *b)
+{
+    SbInt_Digit_t digits[CHUNK_DIGITS + 1];
+    SbIntObject *ia;
+    SbObject *result;
+    Sb_ssize_t pos;
+
+    ia = (SbIntObject *)a;
+    if (Sb_IS_TAGGED(a) || ia->v.length <= 0) {
+        return SbNumber_Multiply(a, b);
+    }
+
+    result = SbInt_FromNative(0);
+    for (pos = 0; pos < ia->v.length; pos += CHUNK_DIGITS) {
+        SbObject *chunk, *part, *shift, *tmp;
+        Sb_ssize_t count;
+
+        count = ia->v.length - pos;
+        if (count > CHUNK_DIGITS) {
+            /* Lower slices are unsigned: zero-extend them. */
+            count = CHUNK_DIGITS;
+            SbRT_MemCpy(digits, ia->v.u.digits + pos, count * sizeof(SbInt_Digit_t));
+            digits[count] = 0;
+            chunk = SbInt_FromLengthAndDigits(count + 1, digits);
+        }
+        else {
+            /* The top slice carries the sign. */
+            SbRT_MemCpy(digits, ia->v.u.digits + pos, count * sizeof(SbInt_Digit_t));
+            chunk = SbInt_FromLengthAndDigits(count, digits);
+        }
+        part = SbNumber_Multiply(chunk, b);
+        Sb_DECREF(chunk);
+        shift = SbInt_FromNative(pos * SbInt_DIGIT_BITS);
+        tmp = SbNumber_Lshift(part, shift);
+        Sb_DECREF(shift);
+        Sb_DECREF(part);
+        part = SbNumber_Add(result, tmp);
+        Sb_DECREF(tmp);
+        Sb_DECREF(result);
+        result = part;
+    }
+    return result;
+}
+
+static int
+check_mul(SbObject *a, SbObject *b)
+{
+    SbObject *expected, *actual;
+    int equal;
+
+    actual = SbNumber_Multiply(a, b);
+    if (!actual) {
+        return -1;
+    }
+    expected = reference_mul(a, b);
+    if (!expected) {
+        return -1;
+    }
+    equal = SbObject_CompareBool(actual, expected, Sb_EQ);
+    Sb_DECREF(actual);
+    Sb_DECREF(expected);
+    return equal == 1 ? 0 : -1;
+}
+
+/* Test: Verify products of random operands match the schoolbook reference. */
+static int
+test_int_mul_random(void)
+{
+    int iteration;
+
+    for (iteration = 0; iteration < 80; ++iteration) {
+        SbObject *a, *b;
+        int rv;
+
+        a = make_int(rng_length(), 0);
+        b = make_int(rng_length(), 0);
+        rv = check_mul(a, b);
+        Sb_DECREF(a);
+        Sb_DECREF(b);
+        if (rv < 0) {
+            return -1 - iteration;
+        }
+    }
+    return 0;
+}
+
+/* Test: Verify squares of random operands match the schoolbook reference. */
+static int
+test_int_sqr_random(void)
+{
+    int iteration;
+
+    for (iteration = 0; iteration < 40; ++iteration) {
+        SbObject *a;
+        int rv;
+
+        a = make_int(rng_length(), 0);
+        /* Same object on both sides takes the squaring path. */
+        rv = check_mul(a, a);
+        Sb_DECREF(a);
+        if (rv < 0) {
+            return -1 - iteration;
+        }
+    }
+    return 0;
+}
+
+/* Test: Verify carry-heavy digit patterns. */
+static int
+test_int_mul_patterns(void)
+{
+    int iteration;
+
+    for (iteration = 0; iteration < 40; ++iteration) {
+        SbObject *a, *b;
+        int rv;
+
+        a = make_int(rng_length(), 1 + (iteration & 1));
+        b = make_int(rng_length(), 1 + ((iteration >> 1) & 1));
+        rv = check_mul(a, b);
+        if (rv == 0) {
+            rv = check_mul(a, a);
+        }
+        Sb_DECREF(a);
+        Sb_DECREF(b);
+        if (rv < 0) {
+            return -1 - iteration;
+        }
+    }
+    return 0;
+}
+
+/* Verify a == q * b + r, with r between zero and b.
+   Returns: 0 if OK, -1 otherwise. */
+static int
+check_divmod(SbObject *a, SbObject *b)
+{
+    SbObject *q, *r, *zero, *tmp, *back;
+    int rv;
+
+    q = SbNumber_FloorDivide(a, b);
+    r = SbNumber_Remainder(a, b);
+    if (!q || !r) {
+        return -1;
+    }
+    tmp = SbNumber_Multiply(q, b);
+    back = SbNumber_Add(tmp, r);
+    Sb_DECREF(tmp);
+    rv = SbObject_CompareBool(back, a, Sb_EQ) == 1 ? 0 : -1;
+    Sb_DECREF(back);
+
+    zero = SbInt_FromNative(0);
+    if (SbObject_CompareBool(b, zero, Sb_GT) == 1) {
+        if (SbObject_CompareBool(r, zero, Sb_LT) == 1 || SbObject_CompareBool(r, b, Sb_GE) == 1) {
+            rv = -1;
+        }
+    }
+    else {
+        if (SbObject_CompareBool(r, zero, Sb_GT) == 1 || SbObject_CompareBool(r, b, Sb_LE) == 1) {
+            rv = -1;
+        }
+    }
+    Sb_DECREF(zero);
+    Sb_DECREF(q);
+    Sb_DECREF(r);
+    return rv;
+}
+
+/* Test: Verify floor division of random operands. */
+static int
+test_int_divmod_random(void)
+{
+    int iteration;
+
+    for (iteration = 0; iteration < 120; ++iteration) {
+        SbObject *a, *b;
+        Sb_ssize_t na, nb;
+        int rv;
+
+        na = rng_length();
+        nb = 1 + rng_next() % (iteration & 1 ? na : 4);
+        a = make_int(na, iteration % 5 == 4 ? 2 : 0);
+        b = make_int(nb, 0);
+        if (SbObject_IsTrue(b)) {
+            rv = check_divmod(a, b);
+        }
+        else {
+            rv = 0;
+        }
+        Sb_DECREF(a);
+        Sb_DECREF(b);
+        if (rv < 0) {
+            return -1 - iteration;
+        }
+    }
+    return 0;
+}
+
+/* Test: Verify the rare quotient digit corrections of Algorithm D. */
+static int
+test_int_divmod_addback(void)
+{
+    /* From the Hacker's Delight divmnu test set, scaled to 32-bit digits. */
+    static SbInt_Digit_t u1[] = { 3, 0, 0x80000000u, 0 };
+    static SbInt_Digit_t v1[] = { 1, 0, 0x20000000u };
+    static SbInt_Digit_t u2[] = { 0, 0, 0x80000000u, 0x7FFFFFFFu };
+    static SbInt_Digit_t v2[] = { 1, 0, 0x80000000u, 0 };
+    static SbInt_Digit_t u3[] = { 0, 0xFFFFFFFEu, 0, 0x80000000u, 0 };
+    static SbInt_Digit_t v3[] = { 0xFFFFFFFFu, 0, 0x80000000u, 0 };
+    SbObject *a, *b;
+    int rv;
+
+    a = SbInt_FromLengthAndDigits(4, u1);
+    b = SbInt_FromLengthAndDigits(3, v1);
+    rv = check_divmod(a, b);
+    Sb_DECREF(a);
+    Sb_DECREF(b);
+    if (rv < 0) {
+        return -1;
+    }
+
+    a = SbInt_FromLengthAndDigits(4, u2);
+    b = SbInt_FromLengthAndDigits(4, v2);
+    rv = check_divmod(a, b);
+    Sb_DECREF(a);
+    Sb_DECREF(b);
+    if (rv < 0) {
+        return -2;
+    }
+
+    a = SbInt_FromLengthAndDigits(5, u3);
+    b = SbInt_FromLengthAndDigits(4, v3);
+    rv = check_divmod(a, b);
+    Sb_DECREF(a);
+    Sb_DECREF(b);
+    if (rv < 0) {
+        return -3;
+    }
+    return 0;
+}
+
+/* Test: Verify random values survive conversion to string and back. */
+static int
+test_int_str_random(void)
+{
+    static const unsigned bases[] = { 10, 16, 2, 8 };
+    int iteration;
+
+    for (iteration = 0; iteration < 60; ++iteration) {
+        SbObject *a, *s, *b;
+        unsigned base;
+        int rv;
+
+        base = bases[iteration & 3];
+        a = make_int(rng_length(), iteration % 7 == 6 ? 1 + (iteration & 1) : 0);
+        s = SbInt_ToString(a, base);
+        if (!s) {
+            Sb_DECREF(a);
+            return -1 - iteration;
+        }
+        b = SbInt_FromString((const char *)SbStr_AsStringUnsafe(s), NULL, base);
+        rv = b ? SbObject_CompareBool(a, b, Sb_EQ) : -1;
+        Sb_DECREF(a);
+        Sb_DECREF(s);
+        Sb_XDECREF(b);
+        if (rv != 1) {
+            return -1 - iteration;
+        }
+    }
+    return 0;
+}
+
+/* Compute b ** e % m by square-and-multiply with generic operations.
+   Returns: New reference. */
+static SbObject *
+reference_powmod(SbObject *b, SbInt_Native_t e, SbObject *m)
+{
+    SbObject *r, *tmp;
+    int shift;
+
+    r = SbInt_FromNative(1);
+    for (shift = (int)sizeof(e) * 8 - 2; shift >= 0; --shift) {
+        tmp = SbNumber_Multiply(r, r);
+        Sb_DECREF(r);
+        r = SbNumber_Remainder(tmp, m);
+        Sb_DECREF(tmp);
+        if ((e >> shift) & 1) {
+            tmp = SbNumber_Multiply(r, b);
+            Sb_DECREF(r);
+            r = SbNumber_Remainder(tmp, m);
+            Sb_DECREF(tmp);
+        }
+    }
+    return r;
+}
+
+/* Test: Verify modular powers of random operands, odd and even moduli alike. */
+static int
+test_int_powmod_random(void)
+{
+    int iteration;
+
+    for (iteration = 0; iteration < 60; ++iteration) {
+        SbObject *b, *m, *e, *expected, *actual;
+        SbInt_Native_t ev;
+        int rv;
+
+        b = make_int(1 + rng_next() % 80, 0);
+        if (iteration % 3 == 2) {
+            SbObject *one, *shift, *low, *top;
+
+            /* Moduli just below a digit boundary exercise the final Montgomery correction. */
+            one = SbInt_FromNative(1);
+            shift = SbInt_FromNative((1 + rng_next() % 80) * SbInt_DIGIT_BITS);
+            top = SbNumber_Lshift(one, shift);
+            low = SbInt_FromNative(rng_next() % 1000);
+            m = SbNumber_Subtract(top, low);
+            Sb_DECREF(low);
+            Sb_DECREF(top);
+            Sb_DECREF(shift);
+            Sb_DECREF(one);
+        }
+        else {
+            m = make_int(1 + rng_next() % 80, 0);
+        }
+        ev = (SbInt_Native_t)(((Sb_size_t)rng_next() << 16) ^ rng_next()) & SbInt_NATIVE_MAX;
+        e = SbInt_FromNative(ev);
+        rv = -1;
+        if (!SbObject_IsTrue(m)) {
+            rv = 0;
+        }
+        else {
+            expected = reference_powmod(b, ev, m);
+            actual = SbNumber_Power(b, e, m);
+            if (actual) {
+                rv = SbObject_CompareBool(actual, expected, Sb_EQ) == 1 ? 0 : -1;
+                Sb_DECREF(actual);
+            }
+            Sb_DECREF(expected);
+        }
+        Sb_DECREF(b);
+        Sb_DECREF(m);
+        Sb_DECREF(e);
+        if (rv < 0) {
+            return -1 - iteration;
+        }
+    }
+    return 0;
+}
+
+/* Call a method of a small int with at most one int argument.
+   Returns: The result converted to native, or -1000 on failure. */
+static SbInt_Native_t
+call_small(SbObject *o, const char *method, Sb_ssize_t count, SbInt_Native_t arg)
+{
+    SbObject *result;
+    SbInt_Native_t value;
+
+    if (count) {
+        result = SbObject_CallMethodObjArgs(o, method, 1, SbInt_FromNative(arg));
+    }
+    else {
+        result = SbObject_CallMethodObjArgs(o, method, 0);
+    }
+    if (!result || !SbInt_Check(result)) {
+        Sb_XDECREF(result);
+        return -1000;
+    }
+    value = SbInt_AsNative(result);
+    Sb_DECREF(result);
+    return value;
+}
+
+/* Test: Verify dunder methods called directly on a small int leave it intact. */
+static int
+test_int_small_methods(void)
+{
+    SbObject *one, *result;
+    int rv;
+
+    one = SbInt_FromNative(1);
+#if SUPPORTS(TAGGED_INTS)
+    if (!Sb_IS_TAGGED(one)) {
+        return -1;
+    }
+#endif
+    result = SbObject_CallMethodObjArgs(one, "__init__", 1, SbInt_FromNative(7));
+    if (result != Sb_None) {
+        Sb_XDECREF(result);
+        return -2;
+    }
+    Sb_DECREF(result);
+    if (SbInt_AsNative(one) != 1) {
+        return -3;
+    }
+    if (call_small(one, "__add__", 1, 2) != 3 || call_small(one, "__lshift__", 1, 4) != 16) {
+        return -4;
+    }
+    if (call_small(one, "__hash__", 0, 0) != 1 || call_small(one, "__neg__", 0, 0) != -1) {
+        return -5;
+    }
+    result = SbObject_CallMethodObjArgs(one, "__str__", 0);
+    rv = result && SbStr_GetSizeUnsafe(result) == 1 && SbStr_AsStringUnsafe(result)[0] == '1' ? 0 : -6;
+    Sb_XDECREF(result);
+    Sb_DECREF(one);
+    return rv;
+}
+
+int
+test_int_main(int which)
+{
+    switch (which) {
+    case 0: return test_int_mul_random();
+    case 1: return test_int_sqr_random();
+    case 2: return test_int_mul_patterns();
+    case 3: return test_int_divmod_random();
+    case 4: return test_int_divmod_addback();
+    case 5: return test_int_str_random();
+    case 6: return test_int_powmod_random();
+    case 7: return test_int_small_methods();
+    default:
+        return 1;
+    }
+}
@@ -1,5 +1,14 @@
 import unittest
 
+def floordiv(a, b):
+    return a // b
+def mod(a, b):
+    return a % b
+def shl(a, b):
+    return a << b
+def shr(a, b):
+    return a >> b
+
 class Test(unittest.TestCase):
     def test_comparisons_native(self):
         a = 20
@@ -82,6 +91,23 @@ class Test(unittest.TestCase):
         a = -0x7FFFFFFF
         b = 2
         self.assertEqual(a * b, -0xFFFFFFFE)
+    def test_int64_constants(self):
+        a = 0x123456789A
+        b = -0x123456789A
+        self.assertEqual(a + b, 0)
+        self.assertEqual(a >> 32, 0x12)
+        self.assertEqual(0x7FFFFFFFFFFFFFFF + 1, 0x10000000000000000 >> 1)
+        self.assertEqual(-0x8000000000000000 - 1, -(0x10000000000000000 >> 1) - 1)
+    def test_native_overflow_64(self):
+        a = 0x7FFFFFFFFFFFFFFF
+        b = -0x8000000000000000
+        self.assertEqual(a + 1, 0x8000000000000000)
+        self.assertEqual(b - 1, -0x8000000000000001)
+        self.assertEqual(a * 2, 0xFFFFFFFFFFFFFFFE)
+        self.assertEqual(b * -1, 0x8000000000000000)
+        self.assertEqual(0x100000000 * 0x100000000, 0x10000000000000000)
+        self.assertEqual(0xFFFFFFFF * 0xFFFFFFFF, 0xFFFFFFFE00000001)
+        self.assertEqual((a + 1) - 1, a)
 
     def test_shl_native_simple(self):
         a = 0x03200
@@ -112,6 +138,201 @@ class Test(unittest.TestCase):
     def test_shl_long_simple2(self):
         a = -0x123400000L
         self.assertEqual(a >> 4, -0x12340000L)
+    def test_shr_long_all_out(self):
+        a = 0x123456789ABCDEF0123L
+        self.assertEqual(a >> 200, 0)
+        self.assertEqual(-a >> 200, -1)
+    def test_shift_huge_count(self):
+        big = int('4294967297')
+        self.assertRaises(OverflowError, shl, 1, big)
+        self.assertRaises(OverflowError, shl, 1, 1 << 70)
+        self.assertEqual(5 >> int('4294967300'), 0)
+        self.assertEqual(-5 >> big, -1)
+        self.assertEqual(0x123456789ABCDEF0123L >> (1 << 70), 0)
+    def test_shift_negative_count(self):
+        self.assertRaises(ValueError, shl, 1, -1)
+        self.assertRaises(ValueError, shr, 1, -1)
+        self.assertRaises(ValueError, shl, 1, -int('4294967297'))
+        self.assertRaises(ValueError, shr, 1, -(1 << 70))
+
+    def test_comparisons_long_negative(self):
+        a = -0x100000000000000001L
+        b = -0x100000000000000002L
+        self.assertTrue(b < a)
+        self.assertFalse(a < b)
+        self.assertTrue(a > b)
+
+    def test_long_add_carry(self):
+        a = 0xFFFFFFFFFFFFFFFFFFFFFFFFL
+        self.assertEqual(a + 1, 0x1000000000000000000000000L)
+        self.assertEqual(1 + a, 0x1000000000000000000000000L)
+    def test_long_add_mixed_sign(self):
+        a = 0x1000000000000000000000000L
+        b = -0x0FFFFFFFFFFFFFFFFFFFFFFFFL
+        self.assertEqual(a + b, 1)
+        self.assertEqual(b + a, 1)
+    def test_long_sub_borrow(self):
+        a = 0x1000000000000000000000000L
+        self.assertEqual(a - 1, 0xFFFFFFFFFFFFFFFFFFFFFFFFL)
+        self.assertEqual(1 - a, -0xFFFFFFFFFFFFFFFFFFFFFFFFL)
+    def test_long_sub_shorter_lhs(self):
+        a = 5
+        b = 0x123456789ABCDEF0123456789L
+        self.assertEqual(a - b, -0x123456789ABCDEF0123456784L)
+    def test_long_sub_to_native(self):
+        a = 0x123456789ABCDEF0123456789L
+        b = 0x123456789ABCDEF0123456788L
+        self.assertEqual(a - b, 1)
+
+    def test_long_mul(self):
+        a = 0xFFFFFFFFFFFFFFFFL
+        self.assertEqual(a * a, 0xFFFFFFFFFFFFFFFE0000000000000001L)
+    def test_long_mul_negative(self):
+        a = -0x123456789ABCDEF01L
+        b = 0xFEDCBA9876543210FL
+        self.assertEqual(a * b, -0x121FA00AD77D7422446C65B8EE8F23220FL)
+        self.assertEqual(a * -b, 0x121FA00AD77D7422446C65B8EE8F23220FL)
+    def test_long_neg(self):
+        a = 0x80000000000000000000L
+        self.assertEqual(-a, -0x80000000000000000000L)
+        self.assertEqual(-(-a), a)
+    def test_long_neg_grows(self):
+        a = -0x800000000000000000000000L
+        b = -a
+        self.assertTrue(b > 0)
+        self.assertEqual(b, 0x800000000000000000000000L)
+    def test_native_min_negate(self):
+        a = -2147483647 - 1
+        self.assertEqual(-a, 2147483648)
+
+    def test_native_floordiv(self):
+        self.assertEqual(7 // 2, 3)
+        self.assertEqual(-7 // 2, -4)
+        self.assertEqual(7 // -2, -4)
+        self.assertEqual(-7 // -2, 3)
+        self.assertEqual(7 / 2, 3)
+    def test_native_mod(self):
+        self.assertEqual(7 % 3, 1)
+        self.assertEqual(-7 % 3, 2)
+        self.assertEqual(7 % -3, -2)
+        self.assertEqual(-7 % -3, -1)
+        self.assertEqual(6 % -3, 0)
+    def test_divide_by_zero(self):
+        a = 0x123456789ABCDEF0123L
+        self.assertRaises(ZeroDivisionError, floordiv, a, 0)
+        self.assertRaises(ZeroDivisionError, mod, 1, 0)
+        self.assertRaises(ZeroDivisionError, divmod, a, 0)
+    def test_long_floordiv_single_digit(self):
+        a = 0x123456789ABCDEF0123456789L
+        self.assertEqual(a // 10, 0x1D208A5A912E31801D208A5AL)
+        self.assertEqual(a % 10, 5)
+        self.assertEqual(-a // 10, -0x1D208A5A912E31801D208A5BL)
+        self.assertEqual(-a % 10, 5)
+    def test_long_floordiv(self):
+        a = 0xFEDCBA9876543210FEDCBA9876543210L
+        b = 0x123456789ABCDEF01L
+        self.assertEqual(a // b, 0xE0000000000000D3L)
+        self.assertEqual(a % b, 0xCA8641FDB98343DL)
+        self.assertEqual(a // -b, -0xE0000000000000D4L)
+        self.assertEqual(a % -b, -0x1169D0369D035BAC4L)
+    def test_long_div_to_native(self):
+        a = 0x100000000000000000000L
+        self.assertEqual(a // a, 1)
+        self.assertEqual(a // (a + 1), 0)
+        self.assertEqual(-a // (a + 1), -1)
+    def test_native_min_div(self):
+        a = -2147483647 - 1
+        self.assertEqual(a // -1, 2147483648)
+    def test_divmod(self):
+        a = 0xFEDCBA9876543210FEDCBA9876543210L
+        b = -0x123456789ABCDEF01L
+        q, r = divmod(a, b)
+        self.assertEqual(q * b + r, a)
+        self.assertEqual(divmod(-7, 2), (-4, 1))
+    def test_str_native(self):
+        a = 0
+        b = -1234567890
+        self.assertEqual(str(a), '0')
+        self.assertEqual(str(b), '-1234567890')
+        self.assertEqual((b + 1).__repr__(), '-1234567889')
+    def test_str_long(self):
+        a = 1
+        a = a << 200
+        self.assertEqual(str(a), '1606938044258990275541962092341162602522202993782792835301376')
+        self.assertEqual(str(-a), '-1606938044258990275541962092341162602522202993782792835301376')
+    def test_str_long_split(self):
+        a = 1
+        zeros = ''
+        nines = ''
+        i = 0
+        while i < 700:
+            a = a * 10
+            zeros = zeros + '0'
+            nines = nines + '9'
+            i = i + 1
+        self.assertEqual(str(a), '1' + zeros)
+        self.assertEqual(str(a - 1), nines)
+        self.assertEqual(str(a * 10 + 1), '1' + zeros + '1')
+    def test_from_str(self):
+        self.assertEqual(int('  -42 '), -42)
+        self.assertEqual(int('010'), 10)
+        self.assertEqual(int('-ff', 16), -255)
+        self.assertEqual(int('0x10', 0), 16)
+        self.assertEqual(int('z', 36), 35)
+        self.assertEqual(int('123456789012345678901234567890'), 123456789012345678901234567890L)
+        self.assertEqual(int('-0x123456789abcdef0123456789', 16), -0x123456789abcdef0123456789L)
+        self.assertRaises(ValueError, int, '12a')
+        self.assertRaises(ValueError, int, '')
+    def test_str_round_trip(self):
+        a = 3
+        i = 0
+        while i < 11:
+            a = a * a + 1
+            self.assertEqual(int(str(a)), a)
+            self.assertEqual(int(str(-a)), -a)
+            i = i + 1
+    def test_format_long(self):
+        a = -0x123456789abcdef0123456789L
+        self.assertEqual(a.__format__('x'), '-123456789abcdef0123456789')
+        self.assertEqual(a.__format__('d'), '-90144042682896311822508713865')
+    def test_pow(self):
+        a = 3
+        self.assertEqual(a ** 4, 81)
+        self.assertEqual((-a) ** 3, -27)
+        self.assertEqual(a ** 0, 1)
+        self.assertEqual(a ** 100, 515377520732011331036461129765621272702107522001L)
+        self.assertEqual((-a) ** 41, -36472996377170786403L)
+        b = 2
+        b **= 70
+        self.assertEqual(b, 0x400000000000000000L)
+        self.assertRaises(ValueError, pow, a, -1)
+    def test_pow_mod(self):
+        self.assertEqual(pow(4, 13, 497), 445)
+        self.assertEqual(pow(-4, 13, 497), 52)
+        self.assertEqual(pow(4, 13, -497), -52)
+        self.assertEqual(pow(7, 0, 1), 0)
+        m = (1 << 127) - 1
+        self.assertEqual(pow(3, m - 1, m), 1)
+        self.assertEqual(pow(0x123456789ABCDEF0123456789L, 65537, 1 << 96), 0x22b53084b2256b2357ed6789L)
+        self.assertRaises(ValueError, pow, 2, 3, 0)
+        self.assertRaises(ValueError, pow, 2, -3, 5)
+    def test_construct(self):
+        self.assertEqual(int(), 0)
+        self.assertEqual(int('12'), 12)
+        self.assertEqual(int('ff', 16), 255)
+        self.assertEqual(int(42000000000), 42000000000)
+        self.assertRaises(TypeError, int, 12, 10)
+    def test_init_keeps_value(self):
+        a = 1
+        a.__init__(7)
+        self.assertEqual(a, 1)
+        self.assertEqual(1 + 0, 1)
+    def test_small_methods(self):
+        self.assertEqual((5).__add__(2), 7)
+        self.assertEqual((3).__hash__(), 3)
+        self.assertEqual((3).__str__(), '3')
+        self.assertEqual((1).__lshift__(4), 16)
+        self.assertEqual((-2).__neg__(), 2)
 #
 
 if __name__ == "__main__":
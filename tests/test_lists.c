@@ -39,7 +39,8 @@ test_list_dtor(void)
     SbObject *i1;
     SbObject *list;
 
-    i1 = SbInt_FromNative(1);
+    /* Ints may be immortal or tagged; strings always carry a refcount. */
+    i1 = SbStr_FromString("1001");
     list = SbList_New(1);
     if (!list) {
         return -1;
@@ -64,10 +65,10 @@ test_list_getset(void)
     SbObject *i1, *i2, *i3, *i4;
     SbObject *list;
 
-    i1 = SbInt_FromNative(1);
-    i2 = SbInt_FromNative(2);
-    i3 = SbInt_FromNative(3);
-    i4 = SbInt_FromNative(4);
+    i1 = SbStr_FromString("1001");
+    i2 = SbStr_FromString("1002");
+    i3 = SbStr_FromString("1003");
+    i4 = SbStr_FromString("1004");
 
     list = SbList_Pack(3, i1, i2, i3);
     if (!list) {
@@ -100,6 +101,198 @@ test_list_getset(void)
     return 0;
 }
 
+/* Test: Verify appends reallocate a logarithmic number of times. */
+static int
+test_list_growth(void)
+{
+    SbObject *list;
+    SbObject *o;
+    Sb_ssize_t pos;
+    Sb_ssize_t last_allocated;
+    int reallocs;
+
+    list = SbList_New(0);
+    if (!list) {
+        return -1;
+    }
+    o = SbStr_FromString("x");
+    last_allocated = SbList_GetAllocated(list);
+    reallocs = 0;
+    for (pos = 0; pos < 100000; ++pos) {
+        if (SbList_Append(list, o) < 0) {
+            return -2;
+        }
+        if (SbList_GetAllocated(list) != last_allocated) {
+            last_allocated = SbList_GetAllocated(list);
+            ++reallocs;
+        }
+    }
+    if (SbList_GetSize(list) != 100000 || reallocs > 100) {
+        return -3;
+    }
+    if (last_allocated > 100000 + 100000 / 4) {
+        return -4;
+    }
+
+    Sb_DECREF(list);
+    Sb_DECREF(o);
+    return 0;
+}
+
+/* Test: Verify SbList_Reserve() preallocates without changing the size. */
+static int
+test_list_reserve(void)
+{
+    SbObject *list;
+    SbObject *o;
+    SbObject **items;
+    Sb_ssize_t pos;
+
+    list = SbList_New(0);
+    if (!list) {
+        return -1;
+    }
+    if (SbList_Reserve(list, 1000) < 0) {
+        return -2;
+    }
+    if (SbList_GetSize(list) != 0 || SbList_GetAllocated(list) < 1000) {
+        return -3;
+    }
+    items = ((SbListObject *)list)->items;
+    o = SbStr_FromString("x");
+    for (pos = 0; pos < 1000; ++pos) {
+        SbList_Append(list, o);
+    }
+    if (((SbListObject *)list)->items != items) {
+        return -4;
+    }
+    /* Reserving less than allocated is a no-op. */
+    if (SbList_Reserve(list, 10) < 0 || SbList_GetAllocated(list) < 1000) {
+        return -5;
+    }
+
+    Sb_DECREF(list);
+    Sb_DECREF(o);
+    return 0;
+}
+
+/* Test: Verify insertion and slice deletion keep order and references. */
+static int
+test_list_insert_delete(void)
+{
+    SbObject *list;
+    SbObject *a, *b, *c;
+
+    a = SbStr_FromString("a");
+    b = SbStr_FromString("b");
+    c = SbStr_FromString("c");
+    list = SbList_New(0);
+    if (!list) {
+        return -1;
+    }
+    /* c, then a before it, then b in between */
+    if (SbList_Insert(list, 0, c) < 0 || SbList_Insert(list, -100, a) < 0 || SbList_Insert(list, -1, b) < 0) {
+        return -2;
+    }
+    if (SbList_GetSize(list) != 3
+        || SbList_GetItem(list, 0) != a
+        || SbList_GetItem(list, 1) != b
+        || SbList_GetItem(list, 2) != c) {
+        return -3;
+    }
+    if (Sb_REFCNT(b) != 2) {
+        return -4;
+    }
+    if (SbList_Insert(list, 100, a) < 0 || SbList_GetItem(list, 3) != a) {
+        return -5;
+    }
+
+    /* Drop [1, 3): b and c; the a at the end moves down. */
+    if (SbList_SetSlice(list, 1, 3, NULL) < 0) {
+        return -6;
+    }
+    if (SbList_GetSize(list) != 2
+        || SbList_GetItem(list, 0) != a
+        || SbList_GetItem(list, 1) != a) {
+        return -7;
+    }
+    if (Sb_REFCNT(b) != 1 || Sb_REFCNT(c) != 1 || Sb_REFCNT(a) != 3) {
+        return -8;
+    }
+
+    Sb_DECREF(list);
+    if (Sb_REFCNT(a) != 1) {
+        return -9;
+    }
+    Sb_DECREF(a);
+    Sb_DECREF(b);
+    Sb_DECREF(c);
+    return 0;
+}
+
+/* Test: Verify slice assignment grows and shrinks the list in place. */
+static int
+test_list_setslice(void)
+{
+    SbObject *list;
+    SbObject *other;
+    SbObject *x, *y;
+
+    x = SbStr_FromString("x");
+    y = SbStr_FromString("y");
+    list = SbList_Pack(3, x, x, x);
+    other = SbList_Pack(2, y, y);
+    if (!list || !other) {
+        return -1;
+    }
+    /* Packing steals: one reference per slot, plus our own. */
+    Sb_INCREF(x);
+    Sb_INCREF(x);
+    Sb_INCREF(x);
+    Sb_INCREF(y);
+    Sb_INCREF(y);
+
+    /* [x, x, x] -> [x, y, y, x] */
+    if (SbList_SetSlice(list, 1, 2, other) < 0) {
+        return -2;
+    }
+    if (SbList_GetSize(list) != 4
+        || SbList_GetItem(list, 0) != x
+        || SbList_GetItem(list, 1) != y
+        || SbList_GetItem(list, 2) != y
+        || SbList_GetItem(list, 3) != x) {
+        return -3;
+    }
+    if (Sb_REFCNT(x) != 3 || Sb_REFCNT(y) != 5) {
+        return -4;
+    }
+
+    /* Assigning a list to itself copies it first: [x, x, y, y, x, x] */
+    if (SbList_SetSlice(list, 1, 3, list) < 0) {
+        return -5;
+    }
+    if (SbList_GetSize(list) != 6
+        || SbList_GetItem(list, 1) != x
+        || SbList_GetItem(list, 3) != y
+        || SbList_GetItem(list, 5) != x) {
+        return -6;
+    }
+
+    /* Extending with itself doubles the list. */
+    if (SbList_Extend(list, list) < 0 || SbList_GetSize(list) != 12 || SbList_GetItem(list, 9) != y) {
+        return -7;
+    }
+
+    Sb_DECREF(list);
+    Sb_DECREF(other);
+    if (Sb_REFCNT(x) != 1 || Sb_REFCNT(y) != 1) {
+        return -8;
+    }
+    Sb_DECREF(x);
+    Sb_DECREF(y);
+    return 0;
+}
+
 int
 test_lists_main(int which)
 {
@@ -107,6 +300,10 @@ test_lists_main(int which)
     case 0: return test_list_new();
     case 1: return test_list_dtor();
     case 2: return test_list_getset();
+    case 3: return test_list_growth();
+    case 4: return test_list_reserve();
+    case 5: return test_list_insert_delete();
+    case 6: return test_list_setslice();
     default:
         return 1;
     }
@@ -0,0 +1,207 @@
+"""
+This is a test suite for list mutation methods and slicing.
+"""
+
+import unittest
+
+def render(l):
+    s = ''
+    for x in l:
+        s = s + str(x) + ','
+    return s
+
+shrunk = []
+
+class Shrinker:
+    "Empties the global list `shrunk` while being iterated over"
+    def __init__(self, count):
+        self.count = count
+    def __iter__(self):
+        return self
+    def next(self):
+        del shrunk[:]
+        if self.count == 0:
+            raise StopIteration
+        self.count -= 1
+        return 'x'
+
+def assign_extended(l, v):
+    l[::2] = v
+
+class Countdown:
+    def __init__(self, n):
+        self.n = n
+    def __iter__(self):
+        return self
+    def next(self):
+        if self.n == 0:
+            raise StopIteration
+        self.n -= 1
+        return self.n
+
+key_calls = 0
+
+def first(t):
+    global key_calls
+    key_calls += 1
+    return t[0]
+
+class Tests(unittest.TestCase):
+    def test_getslice(self):
+        "Verify slicing with defaults, negative bounds and steps"
+        l = [0, 1, 2, 3, 4, 5]
+        self.assertEqual(render(l[1:4]), '1,2,3,')
+        self.assertEqual(render(l[-2:]), '4,5,')
+        self.assertEqual(render(l[:100]), '0,1,2,3,4,5,')
+        self.assertEqual(render(l[::2]), '0,2,4,')
+        self.assertEqual(render(l[::-1]), '5,4,3,2,1,0,')
+        self.assertEqual(render(l[4:1:-2]), '4,2,')
+        self.assertEqual(render(l[3:1]), '')
+    def test_setslice_resize(self):
+        "Verify slice assignment can grow and shrink the list"
+        l = [0, 1, 2, 3]
+        l[1:3] = ['a', 'b', 'c']
+        self.assertEqual(render(l), '0,a,b,c,3,')
+        l[1:4] = []
+        self.assertEqual(render(l), '0,3,')
+        l[1:1] = (7, 8)
+        self.assertEqual(render(l), '0,7,8,3,')
+        l[:] = l
+        self.assertEqual(render(l), '0,7,8,3,')
+    def test_setslice_shrinking_source(self):
+        "Verify slice assignment copes with the source emptying the list"
+        global shrunk
+        shrunk = [0, 1, 2, 3, 4, 5, 6, 7, 8, 9]
+        shrunk[5:10] = Shrinker(2)
+        self.assertEqual(render(shrunk), 'x,x,')
+        shrunk = [0, 1, 2, 3, 4, 5]
+        self.assertRaises(ValueError, assign_extended, shrunk, Shrinker(3))
+        self.assertEqual(render(shrunk), '')
+    def test_setslice_extended(self):
+        "Verify extended slice assignment replaces items in place"
+        l = [0, 1, 2, 3, 4]
+        l[::2] = ('x', 'y', 'z')
+        self.assertEqual(render(l), 'x,1,y,3,z,')
+        def assign(l):
+            l[::2] = [1]
+        self.assertRaises(ValueError, assign, l)
+    def test_delslice(self):
+        "Verify slice deletion, including extended and reversed slices"
+        l = [0, 1, 2, 3, 4, 5, 6, 7]
+        del l[1:3]
+        self.assertEqual(render(l), '0,3,4,5,6,7,')
+        del l[::2]
+        self.assertEqual(render(l), '3,5,7,')
+        l = [0, 1, 2, 3, 4, 5]
+        del l[::-2]
+        self.assertEqual(render(l), '0,2,4,')
+        del l[:]
+        self.assertEqual(len(l), 0)
+    def test_insert(self):
+        "Verify insert() clamps the position"
+        l = [1, 2]
+        l.insert(0, 0)
+        l.insert(100, 3)
+        l.insert(-1, 'a')
+        l.insert(-100, 'b')
+        self.assertEqual(render(l), 'b,0,1,2,a,3,')
+    def test_pop(self):
+        "Verify pop() from either end and the middle"
+        l = [0, 1, 2, 3]
+        self.assertEqual(l.pop(), 3)
+        self.assertEqual(l.pop(0), 0)
+        self.assertEqual(l.pop(-2), 1)
+        self.assertEqual(render(l), '2,')
+        self.assertRaises(IndexError, l.pop, 1)
+        l.pop()
+        self.assertRaises(IndexError, l.pop)
+    def test_extend(self):
+        "Verify extend() with lists, tuples, iterators and itself"
+        l = [0]
+        l.extend([1, 2])
+        l.extend((3,))
+        l.extend(Countdown(5))
+        self.assertEqual(render(l), '0,1,2,3,4,3,2,1,0,')
+        l[5:] = []
+        l.extend(l)
+        self.assertEqual(render(l), '0,1,2,3,4,0,1,2,3,4,')
+    def test_reverse(self):
+        "Verify reverse() works for even and odd lengths"
+        l = [0, 1, 2, 3]
+        l.reverse()
+        self.assertEqual(render(l), '3,2,1,0,')
+        l.append(9)
+        l.reverse()
+        self.assertEqual(render(l), '9,0,1,2,3,')
+    def test_sort(self):
+        "Verify sort() on ints, strings and presorted input"
+        l = [5, 3, 9, 1, 7, 3, 0]
+        l.sort()
+        self.assertEqual(render(l), '0,1,3,3,5,7,9,')
+        l.sort(reverse=True)
+        self.assertEqual(render(l), '9,7,5,3,3,1,0,')
+        l = ['pear', 'fig', 'apple', 'figs']
+        l.sort()
+        self.assertEqual(render(l), 'apple,fig,figs,pear,')
+        l = []
+        i = 0
+        while i < 500:
+            l.append(i)
+            i += 1
+        l.sort()
+        self.assertEqual(l[0], 0)
+        self.assertEqual(l[499], 499)
+        l.sort(reverse=True)
+        self.assertEqual(l[0], 499)
+    def test_sort_key_stable(self):
+        "Verify sort(key=) calls the key once per item and is stable"
+        global key_calls
+        l = [(1, 'a'), (0, 'b'), (1, 'c'), (0, 'd'), (1, 'e')]
+        key_calls = 0
+        l.sort(key=first)
+        self.assertEqual(key_calls, 5)
+        self.assertEqual(render([t[1] for t in l]), 'b,d,a,c,e,')
+        l.sort(key=first, reverse=True)
+        self.assertEqual(render([t[1] for t in l]), 'a,c,e,b,d,')
+    def test_sort_long(self):
+        "Verify sorting runs long enough to be merged"
+        l = []
+        i = 0
+        while i < 1000:
+            l.append((i * 7919) % 1000)
+            i += 1
+        l.sort()
+        i = 0
+        while i < 1000:
+            if l[i] != i:
+                break
+            i += 1
+        self.assertEqual(i, 1000)
+    def test_sort_error(self):
+        "Verify a failing comparison leaves all items in the list"
+        l = [3, 'a', 1, 2]
+        self.assertRaises(TypeError, l.sort)
+        self.assertEqual(len(l), 4)
+    def test_sorted(self):
+        "Verify sorted() takes any iterable and returns a new list"
+        t = (3, 1, 2)
+        l = sorted(t)
+        self.assertEqual(render(l), '1,2,3,')
+        self.assertEqual(render(sorted(Countdown(4), reverse=True)), '3,2,1,0,')
+    def test_queue(self):
+        "Verify a long run of front deletions keeps the order"
+        l = []
+        i = 0
+        while i < 1000:
+            l.append(i)
+            i += 1
+        while len(l) > 2:
+            l.pop(0)
+        self.assertEqual(render(l), '998,999,')
+    pass
+#
+
+if __name__ == "__main__":
+    r = Tests().run()
+    print(str(r))
+    print()
@@ -6,6 +6,15 @@ import unittest
 
 del_called = False
 
+class Record:
+    def __init__(self, a, b):
+        self.a = a
+        self.b = b
+
+def unshare_while_iterating(r):
+    for key in r.__dict__.iterkeys():
+        r.__dict__[7] = 'seven'
+
 class Tests(unittest.TestCase):
     def test_del(self):
         "Verify __del__ is called when defined"
@@ -18,6 +27,50 @@ class Tests(unittest.TestCase):
         del_called = False
         del x
         self.assertTrue(del_called)
+    def test_del_assigned(self):
+        "Verify __del__ is called when assigned to the class later"
+        global del_called
+        class C:
+            pass
+        def finalizer(self):
+            global del_called
+            del_called = True
+        x = C()
+        C.__del__ = finalizer
+        del_called = False
+        del x
+        self.assertTrue(del_called)
+    def test_instance_attrs(self):
+        "Verify instances of one class keep their own attribute values"
+        r1 = Record(1, 2)
+        r2 = Record(3, 4)
+        r1.c = 5
+        del r2.a
+        self.assertEqual(r1.a + r1.b + r1.c, 8)
+        self.assertEqual(r2.b, 4)
+        self.assertEqual(len(r2.__dict__), 1)
+        self.assertRaises(AttributeError, getattr, r2, 'a')
+        self.assertRaises(AttributeError, getattr, r2, 'c')
+    def test_instance_attrs_diverge(self):
+        "Verify an instance dict keeps working past many attributes and odd keys"
+        r = Record(1, 2)
+        names = 'c d e f g h i j k l m n o p q r s t u v'.split()
+        for name in names:
+            r.__dict__[name] = name
+        r.__dict__[7] = 'seven'
+        self.assertEqual(len(r.__dict__), 23)
+        self.assertEqual(r.v + r.c, 'vc')
+        self.assertEqual(r.__dict__[7], 'seven')
+        self.assertEqual(r.a, 1)
+        other = Record(3, 4)
+        self.assertEqual(len(other.__dict__), 2)
+        self.assertEqual(other.a + other.b, 7)
+    def test_instance_attrs_iterate(self):
+        "Verify iterating an instance dict that stops sharing keys raises"
+        r = Record(1, 2)
+        self.assertRaises(RuntimeError, unshare_while_iterating, r)
+        self.assertEqual(r.__dict__[7], 'seven')
+        self.assertEqual(r.a + r.b, 3)
     pass
 #
 
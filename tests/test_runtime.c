@@ -0,0 +1,393 @@
+#include "snakebed.h"
+
+/* Differential tests of the buffer routines against plain byte loops,
+   run for every instruction set level the CPU supports. */
+
+#define BUFFER_SIZE 1200
+#define MAX_OFFSET 40
+
+static Sb_byte_t buf_a[BUFFER_SIZE];
+static Sb_byte_t buf_b[BUFFER_SIZE];
+static Sb_byte_t buf_ref[BUFFER_SIZE];
+
+static const Sb_size_t test_lengths[] = {
+    0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 23, 24, 31, 32, 33, 47, 48, 49,
+    63, 64, 65, 95, 96, 97, 127, 128, 129, 191, 255, 256, 257, 511, 1000,
+};
+#define TEST_LENGTH_COUNT (sizeof(test_lengths) / sizeof(test_lengths[0]))
+
+static unsigned long random_state = 1;
+
+static Sb_byte_t
+random_byte(void)
+{
+    random_state = random_state * 1103515245UL + 12345UL;
+    return (Sb_byte_t)(random_state >> 16);
+}
+
+static void
+random_fill(Sb_byte_t *p, Sb_size_t count)
+{
+    while (count--) {
+        *p++ = random_byte();
+    }
+}
+
+static void
+ref_memcpy(Sb_byte_t *d, const Sb_byte_t *s, Sb_size_t count)
+{
+    while (count--) {
+        *d++ = *s++;
+    }
+}
+
+static int
+ref_memcmp(const Sb_byte_t *s1, const Sb_byte_t *s2, Sb_size_t count)
+{
+    Sb_size_t pos;
+
+    for (pos = 0; pos < count; ++pos) {
+        if (s1[pos] != s2[pos]) {
+            return s1[pos] < s2[pos] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+static Sb_ssize_t
+ref_memmem(const Sb_byte_t *str, Sb_ssize_t str_len, const Sb_byte_t *pat, Sb_ssize_t pat_len, int reverse)
+{
+    Sb_ssize_t pos;
+
+    for (pos = 0; pos <= str_len - pat_len; ++pos) {
+        Sb_ssize_t at = reverse ? str_len - pat_len - pos : pos;
+
+        if (!ref_memcmp(str + at, pat, pat_len)) {
+            return at;
+        }
+    }
+    return -1;
+}
+
+static int
+sign_of(int x)
+{
+    return x < 0 ? -1 : x > 0 ? 1 : 0;
+}
+
+/* Run a check with each level of the routines; the best level is restored afterwards. */
+static int
+for_each_level(int (*check)(void))
+{
+    int level;
+    int result = 0;
+
+    for (level = SbRT_ISA_WORD; level <= SbRT_ISA_BEST && !result; ++level) {
+        if (SbRT_SelectStringRoutines(level) != level) {
+            continue;
+        }
+        result = check();
+    }
+    SbRT_SelectStringRoutines(SbRT_ISA_BEST);
+    return result;
+}
+
+/* Test: MemCpy and MemMove copy exactly the requested bytes at any alignment. */
+static int
+check_copy(void)
+{
+    Sb_size_t i, src_offset, dst_offset, length;
+    int shift;
+
+    for (i = 0; i < TEST_LENGTH_COUNT; ++i) {
+        length = test_lengths[i];
+        for (src_offset = 0; src_offset < MAX_OFFSET; ++src_offset) {
+            for (dst_offset = 0; dst_offset < MAX_OFFSET; dst_offset += 3) {
+                random_fill(buf_a, BUFFER_SIZE);
+                random_fill(buf_b, BUFFER_SIZE);
+                ref_memcpy(buf_ref, buf_b, BUFFER_SIZE);
+                SbRT_MemCpy(buf_b + dst_offset, buf_a + src_offset, length);
+                if (ref_memcmp(buf_b, buf_ref, dst_offset)
+                    || ref_memcmp(buf_b + dst_offset, buf_a + src_offset, length)
+                    || ref_memcmp(buf_b + dst_offset + length, buf_ref + dst_offset + length, BUFFER_SIZE - dst_offset - length)) {
+                    return -1;
+                }
+            }
+        }
+
+        /* Overlapping moves in both directions */
+        for (shift = -MAX_OFFSET; shift <= MAX_OFFSET; ++shift) {
+            Sb_size_t base = 2 * MAX_OFFSET;
+            Sb_size_t pos;
+
+            random_fill(buf_a, BUFFER_SIZE);
+            ref_memcpy(buf_ref, buf_a, BUFFER_SIZE);
+            for (pos = 0; pos < length; ++pos) {
+                buf_ref[base + shift + pos] = buf_a[base + pos];
+            }
+            SbRT_MemMove(buf_a + base + shift, buf_a + base, length);
+            if (ref_memcmp(buf_a, buf_ref, BUFFER_SIZE)) {
+                return -2;
+            }
+        }
+    }
+    return 0;
+}
+
+/* Test: MemSet and BZero touch nothing outside the requested range. */
+static int
+check_fill(void)
+{
+    Sb_size_t i, offset, length, pos;
+
+    for (i = 0; i < TEST_LENGTH_COUNT; ++i) {
+        length = test_lengths[i];
+        for (offset = 0; offset < MAX_OFFSET; ++offset) {
+            random_fill(buf_a, BUFFER_SIZE);
+            ref_memcpy(buf_ref, buf_a, BUFFER_SIZE);
+            for (pos = 0; pos < length; ++pos) {
+                buf_ref[offset + pos] = 0xA5;
+            }
+            SbRT_MemSet(buf_a + offset, 0x1A5, length);
+            if (ref_memcmp(buf_a, buf_ref, BUFFER_SIZE)) {
+                return -1;
+            }
+
+            for (pos = 0; pos < length; ++pos) {
+                buf_ref[offset + pos] = 0;
+            }
+            SbRT_BZero(buf_a + offset, length);
+            if (ref_memcmp(buf_a, buf_ref, BUFFER_SIZE)) {
+                return -2;
+            }
+        }
+    }
+    return 0;
+}
+
+/* Test: MemCmp orders by the first differing byte, taken as unsigned. */
+static int
+check_compare(void)
+{
+    Sb_size_t i, offset, length, diff;
+
+    for (i = 0; i < TEST_LENGTH_COUNT; ++i) {
+        length = test_lengths[i];
+        for (offset = 0; offset < MAX_OFFSET; ++offset) {
+            random_fill(buf_a, BUFFER_SIZE);
+            ref_memcpy(buf_b + offset, buf_a, length);
+            if (SbRT_MemCmp(buf_a, buf_b + offset, length) != 0) {
+                return -1;
+            }
+            for (diff = 0; diff < length; diff += 1 + diff / 4) {
+                Sb_byte_t saved = buf_b[offset + diff];
+
+                buf_b[offset + diff] = buf_a[diff] ^ (Sb_byte_t)(0x80 | random_byte());
+                if (sign_of(SbRT_MemCmp(buf_a, buf_b + offset, length)) != ref_memcmp(buf_a, buf_b + offset, length)) {
+                    return -2;
+                }
+                if (sign_of(SbRT_MemCmp(buf_b + offset, buf_a, length)) != ref_memcmp(buf_b + offset, buf_a, length)) {
+                    return -3;
+                }
+                buf_b[offset + diff] = saved;
+            }
+        }
+    }
+    return 0;
+}
+
+/* Test: MemChr and MemRChr find the first and last occurrence, or nothing. */
+static int
+check_find(void)
+{
+    Sb_size_t i, offset, length, pos, hit;
+    Sb_byte_t needle;
+    const void *first;
+    const void *last;
+
+    for (i = 0; i < TEST_LENGTH_COUNT; ++i) {
+        length = test_lengths[i];
+        for (offset = 0; offset < MAX_OFFSET; ++offset) {
+            needle = (Sb_byte_t)(0x80 + offset);
+            random_fill(buf_a, BUFFER_SIZE);
+            for (pos = 0; pos < BUFFER_SIZE; ++pos) {
+                if (buf_a[pos] == needle) {
+                    buf_a[pos] = 0;
+                }
+            }
+            /* Just outside the range, either side */
+            buf_a[offset + length] = needle;
+            if (offset > 0) {
+                buf_a[offset - 1] = needle;
+            }
+            if (SbRT_MemChr(buf_a + offset, needle, length) || SbRT_MemRChr(buf_a + offset, needle, length)) {
+                return -1;
+            }
+
+            for (hit = 0; 2 * hit < length; hit += 1 + hit / 3) {
+                buf_a[offset + hit] = needle;
+                buf_a[offset + length - 1 - hit] = needle;
+                first = SbRT_MemChr(buf_a + offset, (char)needle, length);
+                last = SbRT_MemRChr(buf_a + offset, (char)needle, length);
+                if (first != buf_a + offset + hit || last != buf_a + offset + length - 1 - hit) {
+                    return -2;
+                }
+                buf_a[offset + hit] = 0;
+                buf_a[offset + length - 1 - hit] = 0;
+            }
+        }
+    }
+    return 0;
+}
+
+/* Test: StrLen stops at the first NUL whatever the alignment. */
+static int
+check_length(void)
+{
+    Sb_size_t i, offset, length, pos;
+
+    for (i = 0; i < TEST_LENGTH_COUNT; ++i) {
+        length = test_lengths[i];
+        for (offset = 0; offset < MAX_OFFSET; ++offset) {
+            for (pos = 0; pos < BUFFER_SIZE; ++pos) {
+                buf_a[pos] = (Sb_byte_t)(1 + random_byte() % 255);
+            }
+            buf_a[offset + length] = 0;
+            buf_a[offset + length + 1 + random_byte() % 7] = 0;
+            if (SbRT_StrLen((const char *)buf_a + offset) != length) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/* Test: MemMem and MemRMem agree with a brute force search for all pattern lengths. */
+static int
+check_search(void)
+{
+    static const Sb_ssize_t str_lengths[] = { 0, 1, 2, 5, 16, 17, 31, 40, 63, 100, 300, 1000 };
+    Sb_ssize_t i, str_len, pat_len, round;
+    Sb_ssize_t pos;
+
+    for (i = 0; i < (Sb_ssize_t)(sizeof(str_lengths) / sizeof(str_lengths[0])); ++i) {
+        str_len = str_lengths[i];
+        for (pat_len = 0; pat_len <= 80 && pat_len <= str_len + 1; ++pat_len) {
+            for (round = 0; round < 6; ++round) {
+                /* Few distinct bytes, so that partial matches abound */
+                for (pos = 0; pos < str_len; ++pos) {
+                    buf_a[pos] = (Sb_byte_t)(0xFD + random_byte() % (round < 3 ? 2 : 3));
+                }
+                if (round & 1 && str_len >= pat_len) {
+                    /* Plant the pattern from the string itself */
+                    ref_memcpy(buf_b, buf_a + random_byte() % (str_len - pat_len + 1), pat_len);
+                }
+                else {
+                    for (pos = 0; pos < pat_len; ++pos) {
+                        buf_b[pos] = (Sb_byte_t)(0xFD + random_byte() % 2);
+                    }
+                }
+                if (SbRT_MemMem((const char *)buf_a, str_len, (const char *)buf_b, pat_len)
+                    != ref_memmem(buf_a, str_len, buf_b, pat_len, 0)) {
+                    return -1;
+                }
+                if (SbRT_MemRMem((const char *)buf_a, str_len, (const char *)buf_b, pat_len)
+                    != ref_memmem(buf_a, str_len, buf_b, pat_len, 1)) {
+                    return -2;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/* Test: SipHash-1-3 matches the reference implementation. */
+static int
+test_runtime_siphash(void)
+{
+    static const struct {
+        Sb_size_t length;
+        Sb_ulong64_t hash;
+    } vectors[] = {
+        { 0, 0xabac0158050fc4dcULL },
+        { 1, 0xc9f49bf37d57ca93ULL },
+        { 7, 0xd3927d989bb11140ULL },
+        { 8, 0x369095118d299a8eULL },
+        { 9, 0x25a48eb36c063de4ULL },
+        { 15, 0xd320d86d2a519956ULL },
+        { 16, 0xcc4fdd1a7d908b66ULL },
+        { 63, 0x9d199062b7bbb3a8ULL },
+    };
+    /* Key and message are the byte sequences 0, 1, 2, ... */
+    Sb_ulong64_t k0 = 0x0706050403020100ULL;
+    Sb_ulong64_t k1 = 0x0F0E0D0C0B0A0908ULL;
+    Sb_size_t i;
+
+    for (i = 0; i < 64; ++i) {
+        buf_a[i] = (Sb_byte_t)i;
+    }
+    for (i = 0; i < sizeof(vectors) / sizeof(vectors[0]); ++i) {
+        if (SbRT_SipHash13(k0, k1, buf_a, vectors[i].length) != vectors[i].hash) {
+            return -1;
+        }
+    }
+    /* Unaligned input */
+    buf_b[0] = 0xFF;
+    ref_memcpy(buf_b + 1, buf_a, 63);
+    if (SbRT_SipHash13(k0, k1, buf_b + 1, 63) != vectors[7].hash) {
+        return -2;
+    }
+    return 0;
+}
+
+static int
+test_runtime_copy(void)
+{
+    return for_each_level(check_copy);
+}
+
+static int
+test_runtime_fill(void)
+{
+    return for_each_level(check_fill);
+}
+
+static int
+test_runtime_compare(void)
+{
+    return for_each_level(check_compare);
+}
+
+static int
+test_runtime_find(void)
+{
+    return for_each_level(check_find);
+}
+
+static int
+test_runtime_length(void)
+{
+    return for_each_level(check_length);
+}
+
+static int
+test_runtime_search(void)
+{
+    return for_each_level(check_search);
+}
+
+int
+test_runtime_main(int which)
+{
+    switch (which) {
+    case 0: return test_runtime_copy();
+    case 1: return test_runtime_fill();
+    case 2: return test_runtime_compare();
+    case 3: return test_runtime_find();
+    case 4: return test_runtime_length();
+    case 5: return test_runtime_search();
+    case 6: return test_runtime_siphash();
+    default:
+        return 1;
+    }
+}
@@ -6,7 +6,7 @@ static int test_str_format()
     const char *buffer;
 
     r = SbStr_FromFormat("aaa %% %c %d %i %u %x %p %s",
-        'X', -645, 0x80000001, 0x98765432U, 0xabcdef12U, 0xdeadbabe, "testing");
+        'X', -645, 0x80000001, 0x98765432U, 0xabcdef12U, (void *)0xdeadbabe, "testing");
     buffer = SbStr_AsStringUnsafe(r);
     if (SbRT_StrCmp(buffer, "aaa % X -645 -2147483647 2557891634 abcdef12 0xdeadbabe testing")) {
         return -1;
@@ -16,11 +16,54 @@ static int test_str_format()
     return 0;
 }
 
+static int test_str_builder()
+{
+    SbStrBuilder sb;
+    SbObject *piece;
+    SbObject *r;
+    const char *buffer;
+    Sb_ssize_t i;
+
+    piece = SbStr_FromString("xyz");
+    if (SbStrBuilder_Init(&sb, 0) < 0) {
+        return -1;
+    }
+    for (i = 0; i < 1000; ++i) {
+        if (SbStrBuilder_AppendStr(&sb, piece) < 0 || SbStrBuilder_AppendChar(&sb, '.') < 0) {
+            return -1;
+        }
+    }
+    SbStrBuilder_AppendFill(&sb, '-', 3);
+    SbStrBuilder_Append(&sb, "end", 3);
+    Sb_DECREF(piece);
+    r = SbStrBuilder_Finish(&sb);
+    if (!r || sb.str) {
+        return -1;
+    }
+    if (SbStr_GetSizeUnsafe(r) != 4006) {
+        return -1;
+    }
+    buffer = SbStr_AsStringUnsafe(r);
+    if (SbRT_MemCmp(buffer, "xyz.xyz.", 8) || SbRT_StrCmp(buffer + 3996, "xyz.---end")) {
+        return -1;
+    }
+    Sb_DECREF(r);
+
+    r = SbStr_FromFormat("%s=%d", "key", 42);
+    if (SbStr_GetSizeUnsafe(r) != 6 || SbRT_StrCmp(SbStr_AsStringUnsafe(r), "key=42")) {
+        return -1;
+    }
+    Sb_DECREF(r);
+
+    return 0;
+}
+
 int
 test_str_main(int which)
 {
     switch (which) {
     case 0: return test_str_format();
+    case 1: return test_str_builder();
     default: return 1;
     }
 }
@@ -1,5 +1,23 @@
 import unittest
 
+class Words:
+    def __init__(self, n):
+        self.n = n
+    def __iter__(self):
+        return self
+    def next(self):
+        if self.n == 0:
+            raise StopIteration
+        self.n -= 1
+        return 'w' + str(self.n)
+
+def repeat(s, n):
+    r = ''
+    while n > 0:
+        r += s
+        n -= 1
+    return r
+
 class Test(unittest.TestCase):
     def test_ctor(self):
         self.assertEqual(str('aaa'), 'aaa')
@@ -26,6 +44,23 @@ class Test(unittest.TestCase):
         self.assertEqual("".rfind("", 1), -1)
         self.assertEqual("".rfind("abc"), -1)
         self.assertEqual("abc".rfind("xxx", 2800000, 1), -1)
+    def test_find_bounds(self):
+        self.assertEqual(' '.find('ab', 2, -2), -1)
+        self.assertEqual('abcabc'.find('bc', -100), 1)
+        self.assertEqual('abcabc'.find('c', -3, 100), 5)
+        self.assertEqual('abc'.find('', 2, 1), -1)
+        self.assertEqual('abc'.find('', -10, -10), 0)
+        self.assertEqual('abcabc'.rfind('ab', -100, -1), 3)
+        self.assertEqual('abc'.rfind('', 5), -1)
+        self.assertEqual('abcabc'.index('ca', -10), 2)
+        self.assertRaises(ValueError, 'abc'.index, 'c', 0, -2)
+    def test_ordering(self):
+        self.assertTrue('abc' < 'abd')
+        self.assertTrue('ab' < 'abc')
+        self.assertFalse('b' < 'abc')
+        self.assertTrue('abc' <= 'abc')
+        self.assertTrue('\xff' > 'a')
+        self.assertTrue('b' >= 'a')
     def test_format_str(self):
         self.assertEqual("meh{0}teh".format("or"), "mehorteh")
         self.assertEqual("{0:<16}".format("abc"), "abc             ")
@@ -39,6 +74,114 @@ class Test(unittest.TestCase):
         self.assertEqual("{0:^16}".format(-1024), "     -1024      ")
         self.assertEqual("{0:A=+16}".format(-1024), "-AAAAAAAAAAA1024")
         self.assertEqual("{0:A=+16}".format(1024), "+AAAAAAAAAAA1024")
+    def test_join_sequences(self):
+        self.assertEqual(', '.join(('a', 'b')), 'a, b')
+        self.assertEqual('-'.join([]), '')
+        self.assertEqual('-'.join(()), '')
+        self.assertEqual('-'.join(['abc']), 'abc')
+        self.assertEqual(''.join(['a', '', 'bc', 'd']), 'abcd')
+        self.assertEqual('+'.join(['', '']), '+')
+        self.assertRaises(TypeError, '-'.join, ['a', 1])
+        self.assertRaises(TypeError, '-'.join, ('a', None))
+    def test_join_iterator(self):
+        self.assertEqual('.'.join(Words(3)), 'w2.w1.w0')
+        self.assertEqual('.'.join(Words(0)), '')
+    def test_concat_loop(self):
+        s = ''
+        i = 0
+        while i < 1000:
+            s += 'ab'
+            i += 1
+        self.assertEqual(len(s), 2000)
+        self.assertEqual(s[1998:], 'ab')
+        t = s
+        s += 'c'
+        self.assertEqual(len(t), 2000)
+        self.assertEqual(len(s), 2001)
+        u = s + 'd'
+        self.assertEqual(len(s), 2001)
+        self.assertEqual(u[1999:], 'bcd')
+    def test_interpolate(self):
+        self.assertEqual('%s-%s' % ('a', 'b'), 'a-b')
+        self.assertEqual('%d%%' % 50, '50%')
+        self.assertEqual('[%5s|%-5s]' % ('ab', 'cd'), '[   ab|cd   ]')
+        self.assertEqual('%.2s' % 'abcdef', 'ab')
+        self.assertEqual('%05d|%+d|%x|%X|%#x|%o' % (-42, 7, 255, 255, 255, 8), '-0042|+7|ff|FF|0xff|10')
+        self.assertEqual('%*d' % (4, 1), '   1')
+        self.assertEqual('%c%c' % (65, 'b'), 'Ab')
+        self.assertEqual('%(x)s=%(y)d' % {'x': 'k', 'y': 3}, 'k=3')
+        self.assertEqual('%r' % 'q', "'q'")
+        self.assertRaises(TypeError, str.__mod__, '%s %s', ('a',))
+        self.assertRaises(TypeError, str.__mod__, '%s', ('a', 'b'))
+        self.assertRaises(TypeError, str.__mod__, '%d', 'a')
+        self.assertRaises(ValueError, str.__mod__, '%', ())
+        self.assertRaises(ValueError, str.__mod__, '%y', 1)
+    def test_find_long(self):
+        "Verify find() with patterns long enough for each search strategy"
+        s = repeat('ab', 300) + 'abc' + repeat('ab', 10)
+        self.assertEqual(s.find('abc'), 600)
+        self.assertEqual(s.find(repeat('ab', 20) + 'c'), 562)
+        self.assertEqual(s.find(repeat('ab', 40) + 'c'), 522)
+        self.assertEqual(s.find(repeat('ab', 40) + 'd'), -1)
+        self.assertEqual(s.find('bab', 601), 604)
+        self.assertEqual(s.rfind(repeat('ab', 20)), 562)
+    def test_count(self):
+        self.assertEqual('aaaa'.count('aa'), 2)
+        self.assertEqual('abcabcab'.count('ab'), 3)
+        self.assertEqual('abcabcab'.count('ab', 1), 2)
+        self.assertEqual('abcabcab'.count('ab', 1, 6), 1)
+        self.assertEqual('abc'.count(''), 4)
+        self.assertEqual('abc'.count('x'), 0)
+    def test_count_bounds(self):
+        self.assertEqual('abc'.count('b', -10, 2), 1)
+        self.assertEqual(''.count('bb', -5, -1), 0)
+        self.assertEqual('abcb'.count('b', 1, 10), 2)
+        self.assertEqual('abcb'.count('b', -2), 1)
+        self.assertEqual('abc'.count('', 3), 1)
+        self.assertEqual('abc'.count('', 5), 0)
+        self.assertEqual('abc'.count('', 2, 1), 0)
+    def test_replace(self):
+        self.assertEqual('a.b.c'.replace('.', '::'), 'a::b::c')
+        self.assertEqual('a::b::c'.replace('::', ''), 'abc')
+        self.assertEqual('aaaa'.replace('aa', 'b'), 'bb')
+        self.assertEqual('a.b.c'.replace('.', '-', 1), 'a-b.c')
+        self.assertEqual('a.b.c'.replace('.', '-', 0), 'a.b.c')
+        self.assertEqual('abc'.replace('', '-'), '-a-b-c-')
+        self.assertEqual('abc'.replace('', '-', 2), '-a-bc')
+        self.assertEqual('abc'.replace('x', 'y'), 'abc')
+        s = repeat('x,', 1000)
+        self.assertEqual(len(s.replace(',', ';;')), 3000)
+    def test_split(self):
+        self.assertEqual('|'.join('a,b,,c'.split(',')), 'a|b||c')
+        self.assertEqual('|'.join('a::b::c'.split('::', 1)), 'a|b::c')
+        self.assertEqual('|'.join('  a b\t\nc  '.split()), 'a|b|c')
+        self.assertEqual('|'.join('  a b  c  '.split(None, 1)), 'a|b  c  ')
+        self.assertEqual(len(''.split()), 0)
+        self.assertEqual(len(''.split(',')), 1)
+        self.assertEqual(len(repeat('x,', 99).split(',')), 100)
+        self.assertRaises(ValueError, 'abc'.split, '')
+    def test_strip(self):
+        self.assertEqual('  a b \n'.strip(), 'a b')
+        self.assertEqual('  a b \n'.lstrip(), 'a b \n')
+        self.assertEqual('  a b \n'.rstrip(), '  a b')
+        self.assertEqual('xyaxy'.strip('yx'), 'a')
+        self.assertEqual('xyx'.strip('xy'), '')
+        self.assertEqual('abc'.strip(), 'abc')
+    def test_endswith(self):
+        self.assertEqual('abcdef'.endswith('def'), True)
+        self.assertEqual('abcdef'.endswith('abc'), False)
+        self.assertEqual('abcdef'.endswith('cd', 0, 4), True)
+        self.assertEqual('abcdef'.endswith(('x', 'ef')), True)
+        self.assertEqual('abcdef'.startswith(('x', 'ab')), True)
+        self.assertEqual('abcdef'.startswith('cd', 2), True)
+        self.assertEqual('abc'.endswith(''), True)
+        self.assertEqual('abc'.endswith('abcd'), False)
+        self.assertRaises(TypeError, 'abc'.endswith, 1)
+    def test_endswith_bounds(self):
+        self.assertEqual('abcdef'.endswith('ef', -10, 10), True)
+        self.assertEqual('abcdef'.startswith('ab', -10), True)
+        self.assertEqual('abcdef'.startswith('', 10), False)
+        self.assertEqual('abcdef'.endswith('de', 0, -1), True)
 #
 
 if __name__ == "__main__":
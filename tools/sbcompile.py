@@ -11,7 +11,7 @@ import struct
 import argparse
 import __future__
 
-COMPILER_VERSION = 0x0102
+COMPILER_VERSION = 0x0103
 
 _strtab = []
 _count_ints = 0
@@ -39,11 +39,19 @@ def write_raw_word(output, o):
     output.write(struct.pack('<i', o))
     _count_ints += 1
 
+def write_raw_dword(output, o):
+    global _count_ints
+    output.write(struct.pack('<q', o))
+    _count_ints += 1
+
 def write_int(output, o):
     global _count_proper_ints
-    if o is int or (-2147483648L <= o <= 2147483647L):
+    if -2147483648L <= o <= 2147483647L:
         output.write('i')
         write_raw_word(output, o)
+    elif -9223372036854775808L <= o <= 9223372036854775807L:
+        output.write('I')
+        write_raw_dword(output, o)
     else:
         digits = []
         while True: